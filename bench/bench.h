@@ -0,0 +1,176 @@
+#ifndef __STL_BENCH_H
+#define __STL_BENCH_H
+
+#include <chrono>
+#include <cstddef>  // size_t
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stl_perf.h"
+
+// 微基准的公共部分: 计时、防止被优化掉、结果的收集与JSON输出
+// 每个基准是一个函数对象, 一次调用完成 ops 次操作; 预热一次后重复计时, 取每次操作耗时的最小值
+// 每次计时同时读取硬件计数器(stl_perf.h), 记录耗时最少的那一次的各计数; 计数器不可用时只有时间
+// 计数器只统计调用 run 的线程, 多线程基准中其他线程的事件不计入
+// 可选的 setup 在每次计时之前调用, 不计入时间(例如重新构造要被 destroy 的对象)
+//
+//  suite.run("alloc", "simple_alloc", 1000, churn).param("bytes", 64);
+//
+// 基准程序不使用 using namespace std, 标准库的名字都带 std:: , 避免与全局的 vector、swap 等冲突
+
+// 让编译器认为 p 指向的内存被读写过, 结果不会被当作死代码删除
+inline void bench_do_not_optimize(const void* p)
+{
+    __asm__ __volatile__("" : : "g"(p) : "memory");
+}
+
+template<class T>
+inline void bench_keep(const T& x)
+{
+    bench_do_not_optimize(&x);
+}
+
+struct bench_result
+{
+    std::string group;
+    std::string name;
+    size_t ops;             // 每次调用完成的操作数
+    size_t repeats;         // 计时的次数
+    double ns_per_op;       // 各次计时中每次操作耗时的最小值
+    perf_sample counters;   // 耗时最少的那一次计时中各计数器的增量
+    std::vector<std::pair<std::string, long> > params;      // 规模、线程数等参数
+
+    bench_result& param(const char* key, long value)
+    {
+        params.push_back(std::make_pair(std::string(key), value));
+        return *this;
+    }
+};
+
+struct __bench_no_setup
+{
+    void operator()() const {}
+};
+
+class bench_suite
+{
+private:
+    typedef std::chrono::steady_clock clock_type;
+
+    std::vector<bench_result> results;
+    double min_seconds;     // 每个基准至少计时这么久
+    size_t min_repeats;
+
+public:
+    bench_suite() : min_seconds(0.02), min_repeats(5)   {}
+
+    template<class Function>
+    bench_result& run(const char* group, const char* name, size_t ops, Function f)
+    {
+        return run(group, name, ops, __bench_no_setup(), f);
+    }
+
+    template<class Setup, class Function>
+    bench_result& run(const char* group, const char* name, size_t ops, Setup setup, Function f)
+    {
+        const perf_counters& counters = perf_counters::this_thread();
+        setup();
+        f();    // 预热
+        double best = 0, total = 0;
+        size_t repeats = 0;
+        perf_sample best_counters;
+        while(repeats < min_repeats || (total < min_seconds && repeats < 100000))
+        {
+            setup();
+            perf_sample before, after;
+            counters.read(before);
+            clock_type::time_point start = clock_type::now();
+            f();
+            double seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+            counters.read(after);
+            if(repeats == 0 || seconds < best)
+            {
+                best = seconds;
+                for(int k = 0; k < perf_event_count; ++k)
+                    best_counters.value[k] = after.value[k] - before.value[k];
+                best_counters.seconds = seconds;
+            }
+            total += seconds;
+            ++repeats;
+        }
+
+        bench_result r;
+        r.group = group;
+        r.name = name;
+        r.ops = ops;
+        r.repeats = repeats;
+        r.ns_per_op = best * 1e9 / (ops ? ops : 1);
+        r.counters = best_counters;
+        results.push_back(r);
+        return results.back();
+    }
+
+    size_t size() const {   return results.size();  }
+
+    // 一行一个基准, 供终端查看
+    void print(std::FILE* out) const
+    {
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            const bench_result& r = results[i];
+            std::string label = r.group + "/" + r.name;
+            for(size_t j = 0; j < r.params.size(); ++j)
+                label += "/" + r.params[j].first + ":" + std::to_string(r.params[j].second);
+            std::fprintf(out, "%-64s %12.3f ns/op\n", label.c_str(), r.ns_per_op);
+        }
+    }
+
+    // { "context": {...}, "benchmarks": [ {...}, ... ] }, 名字都是代码中的字面量, 不需要转义
+    // 可用的计数器以 "cycles_per_op" 等字段输出每次操作的平均值, 同时有周期与指令时输出 "ipc"
+    void write_json(std::FILE* out) const
+    {
+        const perf_counters& counters = perf_counters::this_thread();
+        std::fprintf(out, "{\n  \"context\": {\n");
+        std::fprintf(out, "    \"compiler\": \"%s\",\n", __VERSION__);
+        std::fprintf(out, "    \"cplusplus\": %ld,\n", long(__cplusplus));
+        std::fprintf(out, "    \"perf_counters\": %s,\n", counters.available() ? "true" : "false");
+        std::fprintf(out, "    \"timestamp\": %lld\n", (long long)std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::system_clock::now().time_since_epoch()).count());
+        std::fprintf(out, "  },\n  \"benchmarks\": [\n");
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            const bench_result& r = results[i];
+            std::fprintf(out, "    {\"group\": \"%s\", \"name\": \"%s\"", r.group.c_str(), r.name.c_str());
+            for(size_t j = 0; j < r.params.size(); ++j)
+                std::fprintf(out, ", \"%s\": %ld", r.params[j].first.c_str(), r.params[j].second);
+            std::fprintf(out, ", \"ops\": %lu, \"repeats\": %lu, \"ns_per_op\": %.4f",
+                         (unsigned long)r.ops, (unsigned long)r.repeats, r.ns_per_op);
+            const double ops = double(r.ops ? r.ops : 1);
+            for(int k = 0; k < perf_event_count; ++k)
+                if(counters.available(k))
+                    std::fprintf(out, ", \"%s_per_op\": %.4f", perf_event_name(k), double(r.counters.value[k]) / ops);
+            if(counters.available(perf_cycles) && counters.available(perf_instructions))
+                std::fprintf(out, ", \"ipc\": %.3f", r.counters.value[perf_cycles]
+                             ? double(r.counters.value[perf_instructions]) / double(r.counters.value[perf_cycles]) : 0.0);
+            std::fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+};
+
+// 各组基准, 分别定义在 bench_xxx.cpp 中
+void bench_alloc(bench_suite& suite);
+void bench_construct(bench_suite& suite);
+void bench_function(bench_suite& suite);
+void bench_algo(bench_suite& suite);
+void bench_hash(bench_suite& suite);
+void bench_hive(bench_suite& suite);
+void bench_slot_map(bench_suite& suite);
+void bench_soa_vector(bench_suite& suite);
+void bench_dynamic_bitset(bench_suite& suite);
+void bench_string(bench_suite& suite);
+void bench_lru_cache(bench_suite& suite);
+
+#endif // __STL_BENCH_H
\ No newline at end of file
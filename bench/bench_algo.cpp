@@ -0,0 +1,113 @@
+#include "bench/bench.h"
+#include "stl_algo.h"
+#include "stl_function.h"
+#include "stl_vector.h"
+
+// 排序与合并: 每次计时前把数据恢复为同一份随机序列
+// 以 __STL_PERF_COUNTERS 构建时, 这些算法内部的 perf_region 会在结束时由 perf_report 一并输出
+
+namespace {
+
+enum { algo_count = 1 << 16 };
+
+// 计时前复制原始数据
+struct restore
+{
+    const vector<int>* source;
+    vector<int>* data;
+    void operator()() const {   copy(source->begin(), source->end(), data->begin());    }
+};
+
+struct sort_case
+{
+    vector<int>* data;
+    void operator()() const {   sort(data->begin(), data->end());   }
+};
+
+// 自定义比较, 不走基数排序
+struct int_less
+{
+    bool operator()(int x, int y) const {   return x < y;   }
+};
+
+struct sort_compare_case
+{
+    vector<int>* data;
+    void operator()() const {   sort(data->begin(), data->end(), int_less());   }
+};
+
+struct stable_sort_case
+{
+    vector<int>* data;
+    void operator()() const {   stable_sort(data->begin(), data->end());    }
+};
+
+struct nth_element_case
+{
+    vector<int>* data;
+    void operator()() const
+    {
+        nth_element(data->begin(), data->begin() + data->size() / 2, data->end());
+        bench_keep((*data)[data->size() / 2]);
+    }
+};
+
+struct inplace_merge_case
+{
+    vector<int>* data;
+    void operator()() const
+    {
+        inplace_merge(data->begin(), data->begin() + data->size() / 2, data->end());
+    }
+};
+
+struct lower_bound_case
+{
+    const vector<int>* sorted;
+    const vector<int>* keys;
+    void operator()() const
+    {
+        size_t found = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+            found += lower_bound(sorted->begin(), sorted->end(), (*keys)[i]) - sorted->begin();
+        bench_keep(found);
+    }
+};
+
+} // namespace
+
+void bench_algo(bench_suite& suite)
+{
+    const size_t n = algo_count;
+    vector<int> source(n, 0);
+    unsigned int seed = 7;
+    for(size_t i = 0; i < n; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        source[i] = int(seed >> 1);
+    }
+    vector<int> data(n, 0);
+    restore reset = {&source, &data};
+
+    sort_case sort_int = {&data};
+    suite.run("sort", "radix", n, reset, sort_int).param("count", n);
+    sort_compare_case sort_compare = {&data};
+    suite.run("sort", "pdqsort", n, reset, sort_compare).param("count", n);
+    stable_sort_case stable = {&data};
+    suite.run("sort", "stable_sort", n, reset, stable).param("count", n);
+    nth_element_case nth = {&data};
+    suite.run("sort", "nth_element", n, reset, nth).param("count", n);
+
+    // 两半各自有序
+    vector<int> halves(source);
+    sort(halves.begin(), halves.begin() + n / 2);
+    sort(halves.begin() + n / 2, halves.end());
+    restore reset_halves = {&halves, &data};
+    inplace_merge_case merge = {&data};
+    suite.run("merge", "inplace_merge", n, reset_halves, merge).param("count", n);
+
+    vector<int> sorted(source);
+    sort(sorted.begin(), sorted.end());
+    lower_bound_case search = {&sorted, &source};
+    suite.run("search", "lower_bound", n, search).param("count", n);
+}
\ No newline at end of file
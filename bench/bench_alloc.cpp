@@ -0,0 +1,135 @@
+#include "bench/bench.h"
+#include "stl_alloc.h"
+#include <memory>
+#include <thread>
+
+// 空间配置器: simple_alloc<char, alloc>、malloc_alloc 与 std::allocator<char> 在 8~4096 字节上的反复配置与释放
+// 每轮配置 churn_blocks 个区块, 按打乱的顺序释放一半再配置回来, 最后全部逆序释放, 一次操作为一对配置与释放
+// alloc 是不加锁的单线程配置器(threads 参数为false), 多线程时每个线程使用各自的实例 __default_alloc_template<false, i>,
+// 相当于每线程一个内存池; malloc 与 std::allocator 由所有线程共享
+
+namespace {
+
+enum { churn_blocks = 256, churn_rounds = 16, churn_ops = churn_blocks * 2 * churn_rounds };
+
+const size_t churn_sizes[] = {8, 16, 32, 64, 128, 256, 512, 1024, 4096};
+
+template<int Inst>
+struct pool_policy
+{
+    static void* allocate(size_t n) {   return simple_alloc<char, __default_alloc_template<false, Inst> >::allocate(n); }
+    static void deallocate(void* p, size_t n)
+    {
+        simple_alloc<char, __default_alloc_template<false, Inst> >::deallocate(static_cast<char*>(p), n);
+    }
+};
+
+struct malloc_policy
+{
+    static void* allocate(size_t n) {   return malloc_alloc::allocate(n);   }
+    static void deallocate(void* p, size_t n)   {   malloc_alloc::deallocate(p, n); }
+};
+
+struct std_allocator_policy
+{
+    static void* allocate(size_t n) {   return std::allocator<char>().allocate(n);  }
+    static void deallocate(void* p, size_t n)   {   std::allocator<char>().deallocate(static_cast<char*>(p), n);    }
+};
+
+// 释放一半区块时的顺序, 固定种子的伪随机排列
+struct churn_order
+{
+    size_t index[churn_blocks];
+    churn_order()
+    {
+        for(size_t i = 0; i < churn_blocks; ++i)
+            index[i] = i;
+        unsigned long seed = 12345;
+        for(size_t i = churn_blocks - 1; i > 0; --i)
+        {
+            seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+            size_t j = (seed >> 33) % (i + 1);
+            size_t t = index[i];
+            index[i] = index[j];
+            index[j] = t;
+        }
+    }
+};
+
+const churn_order order;
+
+template<class Policy>
+void churn(size_t bytes)
+{
+    void* blocks[churn_blocks];
+    for(int round = 0; round < churn_rounds; ++round)
+    {
+        for(size_t i = 0; i < churn_blocks; ++i)
+            blocks[i] = Policy::allocate(bytes);
+        for(size_t i = 0; i < churn_blocks / 2; ++i)
+            Policy::deallocate(blocks[order.index[i]], bytes);
+        for(size_t i = 0; i < churn_blocks / 2; ++i)
+            blocks[order.index[i]] = Policy::allocate(bytes);
+        bench_do_not_optimize(blocks);
+        for(size_t i = churn_blocks; i > 0; --i)
+            Policy::deallocate(blocks[i - 1], bytes);
+    }
+}
+
+template<class Policy>
+struct churn_single
+{
+    size_t bytes;
+    explicit churn_single(size_t n) : bytes(n)  {}
+    void operator()() const {   churn<Policy>(bytes);   }
+};
+
+// 每个线程完成一份 churn, 计时包括线程的创建与等待
+template<class Policy0, class Policy1, class Policy2, class Policy3>
+struct churn_threads
+{
+    size_t bytes;
+    explicit churn_threads(size_t n) : bytes(n) {}
+    void operator()() const
+    {
+        std::thread t0(churn<Policy0>, bytes);
+        std::thread t1(churn<Policy1>, bytes);
+        std::thread t2(churn<Policy2>, bytes);
+        std::thread t3(churn<Policy3>, bytes);
+        t0.join();
+        t1.join();
+        t2.join();
+        t3.join();
+    }
+};
+
+} // namespace
+
+void bench_alloc(bench_suite& suite)
+{
+    for(size_t i = 0; i < sizeof(churn_sizes) / sizeof(churn_sizes[0]); ++i)
+    {
+        const size_t bytes = churn_sizes[i];
+        suite.run("alloc", "simple_alloc", churn_ops, churn_single<pool_policy<0> >(bytes))
+             .param("bytes", bytes).param("threads", 1);
+        suite.run("alloc", "malloc_alloc", churn_ops, churn_single<malloc_policy>(bytes))
+             .param("bytes", bytes).param("threads", 1);
+        suite.run("alloc", "std_allocator", churn_ops, churn_single<std_allocator_policy>(bytes))
+             .param("bytes", bytes).param("threads", 1);
+    }
+
+    for(size_t i = 0; i < sizeof(churn_sizes) / sizeof(churn_sizes[0]); ++i)
+    {
+        const size_t bytes = churn_sizes[i];
+        suite.run("alloc", "simple_alloc", churn_ops * 4,
+                  churn_threads<pool_policy<1>, pool_policy<2>, pool_policy<3>, pool_policy<4> >(bytes))
+             .param("bytes", bytes).param("threads", 4);
+        suite.run("alloc", "malloc_alloc", churn_ops * 4,
+                  churn_threads<malloc_policy, malloc_policy, malloc_policy, malloc_policy>(bytes))
+             .param("bytes", bytes).param("threads", 4);
+        suite.run("alloc", "std_allocator", churn_ops * 4,
+                  churn_threads<std_allocator_policy, std_allocator_policy,
+                                std_allocator_policy, std_allocator_policy>(bytes))
+             .param("bytes", bytes).param("threads", 4);
+    }
+}
\ No newline at end of file
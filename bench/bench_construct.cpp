@@ -0,0 +1,154 @@
+#include "bench/bench.h"
+#include "stl_construct.h"
+#include "stl_uninitialized.h"
+#include <cstdlib>
+
+// 对象的构造与销毁: uninitialized_copy / uninitialized_fill_n 在POD与非POD类型上的差别,
+// destroy 在 trivial 与 non-trivial 析构函数上的差别
+// pod_record 与 object_record 的布局相同, 只是前者通过 __type_traits 声明为POD, 走 memmove / fill_n 的路径
+
+namespace {
+
+struct pod_record
+{
+    int a, b, c, d;
+};
+
+struct object_record
+{
+    int a, b, c, d;
+    object_record(int x) : a(x), b(x), c(x), d(x)   {}
+    object_record(const object_record& x) : a(x.a), b(x.b), c(x.c), d(x.d)  {}
+};
+
+// 析构函数有可观察的副作用, 不能被省略
+int destroyed = 0;
+
+struct tracked_record
+{
+    int a, b, c, d;
+    tracked_record(int x) : a(x), b(x), c(x), d(x)  {}
+    ~tracked_record()   {   destroyed += a; }
+};
+
+} // namespace
+
+template<>
+struct __type_traits<pod_record>
+{
+    typedef __true_type has_trivial_default_constructor;
+    typedef __true_type has_trivial_copy_constructor;
+    typedef __true_type has_trivial_assignment_operator;
+    typedef __true_type has_trivial_destructor;
+    typedef __true_type is_POD_type;
+};
+
+namespace {
+
+const size_t construct_counts[] = {1024, 65536};
+
+template<class T>
+T make_value(int x)
+{
+    return T(x);
+}
+
+template<>
+pod_record make_value<pod_record>(int x)
+{
+    pod_record r = {x, x, x, x};
+    return r;
+}
+
+// 未初始化的原始空间, 每个基准一块
+template<class T>
+struct raw_buffer
+{
+    T* data;
+    size_t n;
+    explicit raw_buffer(size_t count) : data(static_cast<T*>(std::malloc(count * sizeof(T)))), n(count)    {}
+    ~raw_buffer()   {   std::free(data);    }
+};
+
+template<class T>
+struct copy_case
+{
+    const T* source;
+    T* result;
+    size_t n;
+    void operator()() const
+    {
+        uninitialized_copy(source, source + n, result);
+        bench_do_not_optimize(result);
+    }
+};
+
+template<class T>
+struct fill_case
+{
+    T* result;
+    size_t n;
+    void operator()() const
+    {
+        uninitialized_fill_n(result, n, make_value<T>(7));
+        bench_do_not_optimize(result);
+    }
+};
+
+// 计时前重新构造, 只对 destroy 计时
+template<class T>
+struct refill
+{
+    T* data;
+    size_t n;
+    void operator()() const {   uninitialized_fill_n(data, n, make_value<T>(7));    }
+};
+
+template<class T>
+struct destroy_case
+{
+    T* data;
+    size_t n;
+    void operator()() const
+    {
+        destroy(data, data + n);
+        bench_do_not_optimize(data);
+    }
+};
+
+template<class T>
+void bench_record(bench_suite& suite, const char* name, size_t n)
+{
+    raw_buffer<T> source(n), result(n);
+    uninitialized_fill_n(source.data, n, make_value<T>(3));
+
+    copy_case<T> copy = {source.data, result.data, n};
+    suite.run("uninitialized_copy", name, n, copy).param("count", n).param("bytes", sizeof(T));
+
+    fill_case<T> fill = {result.data, n};
+    suite.run("uninitialized_fill_n", name, n, fill).param("count", n).param("bytes", sizeof(T));
+}
+
+} // namespace
+
+void bench_construct(bench_suite& suite)
+{
+    for(size_t i = 0; i < sizeof(construct_counts) / sizeof(construct_counts[0]); ++i)
+    {
+        const size_t n = construct_counts[i];
+        bench_record<int>(suite, "int", n);
+        bench_record<pod_record>(suite, "pod_record", n);
+        bench_record<object_record>(suite, "object_record", n);
+
+        raw_buffer<pod_record> pods(n);
+        refill<pod_record> pod_setup = {pods.data, n};
+        destroy_case<pod_record> pod_destroy = {pods.data, n};
+        suite.run("destroy", "trivial", n, pod_setup, pod_destroy).param("count", n);
+
+        raw_buffer<tracked_record> objects(n);
+        refill<tracked_record> object_setup = {objects.data, n};
+        destroy_case<tracked_record> object_destroy = {objects.data, n};
+        suite.run("destroy", "non_trivial", n, object_setup, object_destroy).param("count", n);
+    }
+    bench_keep(destroyed);
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "bench/bench.h"
+#include "stl_dynamic_bitset.h"
+#include "stl_vector.h"
+
+// dynamic_bitset 与每个元素一个字节的 vector<char>(过滤阶段原来的做法), 一次操作为一位
+// count: 统计为1的个数; and: 两个集合求交; scan: 按顺序访问每个为1的位, 密度为1/16
+
+namespace {
+
+enum { bitset_bits = 1 << 20 };
+
+struct bytes_count
+{
+    const vector<char>* v;
+    void operator()() const
+    {
+        size_t n = 0;
+        for(size_t i = 0; i < v->size(); ++i)
+            n += (*v)[i] != 0;
+        bench_keep(n);
+    }
+};
+
+struct bitset_count
+{
+    const dynamic_bitset<>* b;
+    void operator()() const {   bench_keep(b->count()); }
+};
+
+struct bytes_and
+{
+    vector<char>* x;
+    const vector<char>* y;
+    void operator()() const
+    {
+        for(size_t i = 0; i < x->size(); ++i)
+            (*x)[i] = (*x)[i] && (*y)[i];
+        bench_do_not_optimize(x);
+    }
+};
+
+struct bitset_and
+{
+    dynamic_bitset<>* x;
+    const dynamic_bitset<>* y;
+    void operator()() const
+    {
+        x->combine(*y, logical_and<bool>());
+        bench_do_not_optimize(x);
+    }
+};
+
+struct bytes_scan
+{
+    const vector<char>* v;
+    void operator()() const
+    {
+        size_t sum = 0;
+        for(size_t i = 0; i < v->size(); ++i)
+            if((*v)[i])
+                sum += i;
+        bench_keep(sum);
+    }
+};
+
+struct add_position
+{
+    size_t* sum;
+    void operator()(size_t i) const {   *sum += i;  }
+};
+
+struct bitset_scan
+{
+    const dynamic_bitset<>* b;
+    void operator()() const
+    {
+        size_t sum = 0;
+        add_position f = {&sum};
+        b->for_each_set(f);
+        bench_keep(sum);
+    }
+};
+
+} // namespace
+
+void bench_dynamic_bitset(bench_suite& suite)
+{
+    vector<char> bytes(size_t(bitset_bits), char(0)), other(size_t(bitset_bits), char(0));
+    dynamic_bitset<> bits(bitset_bits), other_bits(bitset_bits);
+    unsigned int seed = 1;
+    for(size_t i = 0; i < bitset_bits; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if((seed >> 16) % 16 == 0)
+        {
+            bytes[i] = 1;
+            bits.set(i);
+        }
+        if((seed >> 8) % 2 == 0)
+        {
+            other[i] = 1;
+            other_bits.set(i);
+        }
+    }
+
+    bytes_count bc = {&bytes};
+    suite.run("bitset_count", "vector_char", bitset_bits, bc).param("bits", bitset_bits);
+    bitset_count sc = {&bits};
+    suite.run("bitset_count", "dynamic_bitset", bitset_bits, sc).param("bits", bitset_bits);
+
+    bytes_scan bs = {&bytes};
+    suite.run("bitset_scan", "vector_char", bitset_bits, bs).param("bits", bitset_bits);
+    bitset_scan ss = {&bits};
+    suite.run("bitset_scan", "dynamic_bitset", bitset_bits, ss).param("bits", bitset_bits);
+
+    // 求交会改变第一个集合, 放在最后; 多次重复后结果不再变化, 不影响每次的工作量
+    bytes_and ba = {&bytes, &other};
+    suite.run("bitset_and", "vector_char", bitset_bits, ba).param("bits", bitset_bits);
+    bitset_and sa = {&bits, &other_bits};
+    suite.run("bitset_and", "dynamic_bitset", bitset_bits, sa).param("bits", bitset_bits);
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "bench/bench.h"
+#include "stl_algo.h"
+#include "stl_function.h"
+#include "stl_small_function.h"
+#include "stl_vector.h"
+
+// 函数对象与配接器: 同一个计算分别用配接器链、手写的lambda、function<> 包装表达, 比较每个元素的耗时
+// 配接器都是内联的小函数, 期望与lambda持平; function<> 每次调用经过一次间接跳转
+
+namespace {
+
+enum { function_count = 1 << 16 };
+
+struct particle
+{
+    int x, v;
+    void step() {   x += v; }
+};
+
+template<class Predicate>
+struct count_case
+{
+    const vector<int>* data;
+    Predicate pred;
+    void operator()() const
+    {
+        bench_keep(count_if(data->begin(), data->end(), pred));
+    }
+};
+
+template<class Predicate>
+count_case<Predicate> make_count(const vector<int>& data, Predicate pred)
+{
+    count_case<Predicate> c = {&data, pred};
+    return c;
+}
+
+template<class Operation>
+struct transform_case
+{
+    const vector<int>* data;
+    vector<int>* result;
+    Operation op;
+    void operator()() const
+    {
+        transform(data->begin(), data->end(), result->begin(), op);
+        bench_do_not_optimize(result->data());
+    }
+};
+
+template<class Operation>
+transform_case<Operation> make_transform(const vector<int>& data, vector<int>& result, Operation op)
+{
+    transform_case<Operation> c = {&data, &result, op};
+    return c;
+}
+
+template<class Function>
+struct step_case
+{
+    vector<particle>* data;
+    Function f;
+    void operator()() const
+    {
+        for_each(data->begin(), data->end(), f);
+        bench_do_not_optimize(data->data());
+    }
+};
+
+template<class Function>
+step_case<Function> make_step(vector<particle>& data, Function f)
+{
+    step_case<Function> c = {&data, f};
+    return c;
+}
+
+} // namespace
+
+void bench_function(bench_suite& suite)
+{
+    vector<int> data(function_count, 0);
+    unsigned int seed = 1;
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = int(seed >> 16) % 2001 - 1000;
+    }
+    vector<int> result(function_count, 0);
+    vector<particle> particles(function_count, particle());
+
+    const size_t n = function_count;
+
+    // x > 0
+    suite.run("count_if_greater", "bind2nd", n, make_count(data, bind2nd(greater<int>(), 0)));
+    suite.run("count_if_greater", "lambda", n, make_count(data, [](int x) { return x > 0; }));
+    suite.run("count_if_greater", "function", n,
+              make_count(data, function<bool(int)>([](int x) { return x > 0; })));
+
+    // -100 < x < 100
+    suite.run("count_if_between", "compose2", n,
+              make_count(data, compose2(logical_and<bool>(), bind2nd(greater<int>(), -100), bind2nd(less<int>(), 100))));
+    suite.run("count_if_between", "lambda", n, make_count(data, [](int x) { return x > -100 && x < 100; }));
+
+    // x % 3 != 0
+    suite.run("count_if_not_multiple", "not1_compose1", n,
+              make_count(data, not1(compose1(bind2nd(equal_to<int>(), 0), bind2nd(modulus<int>(), 3)))));
+    suite.run("count_if_not_multiple", "lambda", n, make_count(data, [](int x) { return x % 3 != 0; }));
+
+    // 3 * x
+    suite.run("transform_scale", "bind1st", n, make_transform(data, result, bind1st(multiplies<int>(), 3)));
+    suite.run("transform_scale", "lambda", n, make_transform(data, result, [](int x) { return 3 * x; }));
+
+    // p.step()
+    suite.run("for_each_member", "mem_fun_ref", n, make_step(particles, mem_fun_ref(&particle::step)));
+    suite.run("for_each_member", "lambda", n, make_step(particles, [](particle& p) { p.step(); }));
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "bench/bench.h"
+#include "stl_hash_fun.h"
+#include "stl_hash_map.h"
+#include "stl_vector.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 散列函数: 整数与各种长度的字符串, 比较 hash<T> 与原来的散列方式(恒等或 h = 5 * h + c, 再经过 __hash_mix)
+// 以及以它们为散列函数的 hash_map 查找; 一次操作为一个键值
+
+namespace {
+
+enum { hash_keys = 1 << 14 };
+
+// 原来的散列函数: 整数返回自身, 字符串逐字节 h = 5 * h + c, 由hashtable再打散一次
+struct legacy_int_hash
+{
+    size_t operator()(int x) const  {   return size_t(x);   }
+};
+
+struct legacy_string_hash
+{
+    size_t operator()(const char* s) const
+    {
+        unsigned long h = 0;
+        for(; *s; ++s)
+            h = 5 * h + *s;
+        return size_t(h);
+    }
+};
+
+struct str_equal
+{
+    bool operator()(const char* a, const char* b) const {   return std::strcmp(a, b) == 0;  }
+};
+
+template<class Hash, class Key>
+struct hash_case
+{
+    const vector<Key>* keys;
+    void operator()() const
+    {
+        Hash h;
+        size_t sum = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+            sum += __hash_mix(h((*keys)[i]), typename __hash_is_avalanching<Hash>::type());
+        bench_keep(sum);
+    }
+};
+
+template<class Hash, class Key>
+hash_case<Hash, Key> make_hash(const vector<Key>& keys)
+{
+    hash_case<Hash, Key> c = {&keys};
+    return c;
+}
+
+template<class Map, class Key>
+struct lookup_case
+{
+    const Map* map;
+    const vector<Key>* keys;
+    void operator()() const
+    {
+        size_t found = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+            found += map->find((*keys)[i]) != map->end();
+        bench_keep(found);
+    }
+};
+
+template<class Map, class Key>
+lookup_case<Map, Key> make_lookup(const Map& map, const vector<Key>& keys)
+{
+    lookup_case<Map, Key> c = {&map, &keys};
+    return c;
+}
+
+} // namespace
+
+void bench_hash(bench_suite& suite)
+{
+    vector<int> ints;
+    unsigned int seed = 1;
+    for(int i = 0; i < hash_keys; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        ints.push_back(int(seed >> 1));
+    }
+    suite.run("hash_int", "legacy", hash_keys, make_hash<legacy_int_hash>(ints));
+    suite.run("hash_int", "hash", hash_keys, make_hash<hash<int> >(ints));
+
+    const size_t lengths[] = {8, 16, 32, 64, 256};
+    for(size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+    {
+        const size_t len = lengths[l];
+        std::vector<std::string> storage(hash_keys);
+        vector<const char*> strings;
+        for(size_t i = 0; i < storage.size(); ++i)
+        {
+            storage[i].resize(len);
+            for(size_t j = 0; j < len; ++j)
+            {
+                seed = seed * 1103515245u + 12345u;
+                storage[i][j] = char('a' + (seed >> 16) % 26);
+            }
+            strings.push_back(storage[i].c_str());
+        }
+        suite.run("hash_string", "legacy", hash_keys, make_hash<legacy_string_hash>(strings)).param("bytes", long(len));
+        suite.run("hash_string", "hash", hash_keys, make_hash<hash<const char*> >(strings)).param("bytes", long(len));
+
+        if(len == 16)
+        {
+            hash_map<const char*, int, legacy_string_hash, str_equal> legacy_map;
+            hash_map<const char*, int, hash<const char*>, str_equal> map;
+            for(size_t i = 0; i < strings.size(); ++i)
+            {
+                legacy_map[strings[i]] = int(i);
+                map[strings[i]] = int(i);
+            }
+            suite.run("hash_map_find_string", "legacy", hash_keys, make_lookup(legacy_map, strings)).param("bytes", long(len));
+            suite.run("hash_map_find_string", "hash", hash_keys, make_lookup(map, strings)).param("bytes", long(len));
+        }
+    }
+
+    hash_map<int, int, legacy_int_hash> legacy_map;
+    hash_map<int, int> map;
+    for(size_t i = 0; i < ints.size(); ++i)
+    {
+        legacy_map[ints[i]] = int(i);
+        map[ints[i]] = int(i);
+    }
+    suite.run("hash_map_find_int", "legacy", hash_keys, make_lookup(legacy_map, ints));
+    suite.run("hash_map_find_int", "hash", hash_keys, make_lookup(map, ints));
+}
\ No newline at end of file
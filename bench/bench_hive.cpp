@@ -0,0 +1,84 @@
+#include "bench/bench.h"
+#include "stl_hive.h"
+#include "stl_list.h"
+#include "stl_vector.h"
+
+// hive 与 list: 两者的元素地址都不会因其他元素的插入删除而改变
+// churn: 按随机顺序删除四分之一的元素再插入同样多个, 一次操作为一次删除加一次插入
+// iterate: 经过若干轮 churn 之后遍历求和, 一次操作为一个元素; list 的节点此时已分散在内存中
+
+namespace {
+
+enum { hive_elements = 1 << 16, hive_churn = hive_elements / 4 };
+
+struct entity
+{
+    int id;
+    int x, y, z;
+};
+
+template<class Container>
+struct churn_case
+{
+    Container* c;
+    vector<typename Container::iterator>* handles;
+    const vector<size_t>* order;
+    void operator()() const
+    {
+        for(size_t i = 0; i < order->size(); ++i)
+        {
+            typename Container::iterator& h = (*handles)[(*order)[i]];
+            entity e = *h;
+            c->erase(h);
+            h = insert(*c, e);
+        }
+        bench_do_not_optimize(c);
+    }
+};
+
+template<class Container>
+struct iterate_case
+{
+    const Container* c;
+    void operator()() const
+    {
+        long sum = 0;
+        for(typename Container::const_iterator it = c->begin(); it != c->end(); ++it)
+            sum += it->x;
+        bench_keep(sum);
+    }
+};
+
+hive<entity>::iterator insert(hive<entity>& h, const entity& e)  {   return h.insert(e); }
+list<entity>::iterator insert(list<entity>& l, const entity& e)  {   return l.insert(l.end(), e);   }
+
+template<class Container>
+void run_container(bench_suite& suite, const char* name, const vector<size_t>& order)
+{
+    Container c;
+    vector<typename Container::iterator> handles;
+    for(int i = 0; i < hive_elements; ++i)
+    {
+        entity e = {i, i, i, i};
+        handles.push_back(insert(c, e));
+    }
+    churn_case<Container> churn = {&c, &handles, &order};
+    suite.run("hive_churn", name, order.size(), churn).param("elements", hive_elements);
+    iterate_case<Container> iterate = {&c};
+    suite.run("hive_iterate", name, hive_elements, iterate).param("elements", hive_elements);
+}
+
+} // namespace
+
+void bench_hive(bench_suite& suite)
+{
+    vector<size_t> order;
+    unsigned int seed = 1;
+    for(int i = 0; i < hive_churn; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        order.push_back((seed >> 8) % hive_elements);
+    }
+    run_container<hive<entity> >(suite, "hive", order);
+    run_container<list<entity> >(suite, "list", order);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "bench/bench.h"
+#include "stl_lru_cache.h"
+#include "stl_hash_map.h"
+#include "stl_list.h"
+#include "stl_vector.h"
+
+// 有界缓存: lru_cache(LRU 与 CLOCK) 与各服务里手写的 list + hash_map<Key, list::iterator>
+// 访问序列偏斜(大约80%的访问落在20%的键上), 容量为键空间的1/8; 一次操作为一次 get, 未命中时再 put
+// get_many: 全部命中的批量查找与逐个 get 比较, 一次操作为一个键
+
+namespace {
+
+enum { cache_keys = 1 << 16, cache_capacity = cache_keys / 8, cache_accesses = 1 << 16 };
+
+// 手写的LRU: 链表表头是最近使用的
+struct list_lru
+{
+    typedef list<pair<int, int> > list_type;
+    list_type items;
+    hash_map<int, list_type::iterator> index;
+    size_t capacity;
+
+    explicit list_lru(size_t n) : capacity(n)    {}
+
+    int* get(int key)
+    {
+        hash_map<int, list_type::iterator>::iterator it = index.find(key);
+        if(it == index.end())
+            return 0;
+        items.splice(items.begin(), items, it->second);
+        return &it->second->second;
+    }
+
+    void put(int key, int value)
+    {
+        if(index.size() == capacity)
+        {
+            index.erase(items.back().first);
+            items.pop_back();
+        }
+        items.push_front(make_pair(key, value));
+        index[key] = items.begin();
+    }
+};
+
+template<class Cache>
+struct access_case
+{
+    Cache* cache;
+    const vector<int>* keys;
+    void operator()() const
+    {
+        size_t sum = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+        {
+            const int key = (*keys)[i];
+            if(int* v = cache->get(key))
+                sum += *v;
+            else
+                cache->put(key, key);
+        }
+        bench_keep(sum);
+    }
+};
+
+template<class Cache>
+access_case<Cache> make_access(Cache& cache, const vector<int>& keys)
+{
+    access_case<Cache> c = {&cache, &keys};
+    return c;
+}
+
+struct get_many_case
+{
+    lru_cache<int, int>* cache;
+    const vector<int>* keys;
+    vector<int*>* results;
+    void operator()() const
+    {
+        bench_keep(cache->get_many(keys->begin(), keys->end(), results->begin()));
+    }
+};
+
+struct get_each_case
+{
+    lru_cache<int, int>* cache;
+    const vector<int>* keys;
+    void operator()() const
+    {
+        size_t found = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+            found += cache->get((*keys)[i]) != 0;
+        bench_keep(found);
+    }
+};
+
+} // namespace
+
+void bench_lru_cache(bench_suite& suite)
+{
+    vector<int> keys;
+    unsigned int seed = 1;
+    for(int i = 0; i < cache_accesses; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        const unsigned int r = seed >> 8;
+        const int hot = cache_keys / 5;
+        keys.push_back(r % 10 < 8 ? int(r / 10 % hot) : int(hot + r / 10 % (cache_keys - hot)));
+    }
+
+    list_lru manual(cache_capacity);
+    suite.run("cache_access", "list_hash_map", cache_accesses, make_access(manual, keys)).param("capacity", cache_capacity);
+    lru_cache<int, int> lru(cache_capacity);
+    suite.run("cache_access", "lru_cache", cache_accesses, make_access(lru, keys)).param("capacity", cache_capacity);
+    lru_cache<int, int> clock(cache_capacity, cache_clock);
+    suite.run("cache_access", "lru_cache_clock", cache_accesses, make_access(clock, keys)).param("capacity", cache_capacity);
+    std::printf("cache hit ratio: lru %.3f, clock %.3f\n", lru.stats().hit_ratio(), clock.stats().hit_ratio());
+
+    // 全部命中的查找: 缓存中的键按随机顺序访问
+    lru_cache<int, int> full(cache_capacity);
+    vector<int> resident;
+    for(int i = 0; i < cache_capacity; ++i)
+    {
+        full.put(i, i);
+        seed = seed * 1103515245u + 12345u;
+        resident.push_back(int((seed >> 8) % cache_capacity));
+    }
+    vector<int*> results(resident.size(), (int*)0);
+    get_each_case each = {&full, &resident};
+    suite.run("cache_get_batch", "get", resident.size(), each).param("capacity", cache_capacity);
+    get_many_case many = {&full, &resident, &results};
+    suite.run("cache_get_batch", "get_many", resident.size(), many).param("capacity", cache_capacity);
+}
\ No newline at end of file
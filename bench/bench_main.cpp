@@ -0,0 +1,38 @@
+#include "bench/bench.h"
+#include <cstdio>
+
+// 运行所有基准: stl_bench [输出文件], 默认写入当前目录下的 bench_output.txt
+
+int main(int argc, char* argv[])
+{
+    const char* path = argc > 1 ? argv[1] : "bench_output.txt";
+
+    bench_suite suite;
+    bench_alloc(suite);
+    bench_construct(suite);
+    bench_function(suite);
+    bench_algo(suite);
+    bench_hash(suite);
+    bench_hive(suite);
+    bench_slot_map(suite);
+    bench_soa_vector(suite);
+    bench_dynamic_bitset(suite);
+    bench_string(suite);
+    bench_lru_cache(suite);
+    suite.print(stdout);
+
+    std::FILE* out = std::fopen(path, "w");
+    if(out == 0)
+    {
+        std::perror(path);
+        return 1;
+    }
+    suite.write_json(out);
+    std::fclose(out);
+    std::printf("%lu benchmarks written to %s\n", (unsigned long)suite.size(), path);
+#ifdef __STL_PERF_COUNTERS
+    // 库内部各个热点函数累计的计数
+    perf_report(stdout);
+#endif
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "bench/bench.h"
+#include "stl_slot_map.h"
+#include "stl_hash_map.h"
+#include "stl_vector.h"
+
+// slot_map 与以前的实体表(hash_map<id, entity*>, 实体逐个 new 出来)
+// sweep: 经过随机删除与插入之后遍历所有实体求和, 一次操作为一个实体
+// lookup: 按随机顺序以句柄(或id)访问实体, 一次操作为一次访问
+
+namespace {
+
+enum { slot_map_elements = 1 << 16, slot_map_churn = slot_map_elements / 4 };
+
+struct entity
+{
+    int id;
+    int x, y, z;
+};
+
+typedef hash_map<int, entity*> entity_table;
+
+struct slot_map_sweep
+{
+    const slot_map<entity>* m;
+    void operator()() const
+    {
+        long sum = 0;
+        for(slot_map<entity>::const_iterator it = m->begin(); it != m->end(); ++it)
+            sum += it->x;
+        bench_keep(sum);
+    }
+};
+
+struct table_sweep
+{
+    const entity_table* t;
+    void operator()() const
+    {
+        long sum = 0;
+        for(entity_table::const_iterator it = t->begin(); it != t->end(); ++it)
+            sum += it->second->x;
+        bench_keep(sum);
+    }
+};
+
+struct slot_map_lookup
+{
+    const slot_map<entity>* m;
+    const vector<slot_map_handle>* handles;
+    const vector<size_t>* order;
+    void operator()() const
+    {
+        long sum = 0;
+        for(size_t i = 0; i < order->size(); ++i)
+            sum += m->find((*handles)[(*order)[i]])->x;
+        bench_keep(sum);
+    }
+};
+
+struct table_lookup
+{
+    const entity_table* t;
+    const vector<int>* ids;
+    const vector<size_t>* order;
+    void operator()() const
+    {
+        long sum = 0;
+        for(size_t i = 0; i < order->size(); ++i)
+            sum += t->find((*ids)[(*order)[i]])->second->x;
+        bench_keep(sum);
+    }
+};
+
+} // namespace
+
+void bench_slot_map(bench_suite& suite)
+{
+    vector<size_t> order;
+    unsigned int seed = 1;
+    for(int i = 0; i < slot_map_elements; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        order.push_back((seed >> 8) % slot_map_elements);
+    }
+
+    // 两边做同样的删除与插入, 让实体表的节点与 new 出来的实体分散在内存中
+    slot_map<entity> m;
+    vector<slot_map_handle> handles;
+    entity_table t;
+    vector<int> ids;
+    for(int i = 0; i < slot_map_elements; ++i)
+    {
+        entity e = {i, i, i, i};
+        handles.push_back(m.insert(e));
+        t[i] = new entity(e);
+        ids.push_back(i);
+    }
+    int next_id = slot_map_elements;
+    for(int i = 0; i < slot_map_churn; ++i)
+    {
+        size_t k = order[i];
+        entity e = m[handles[k]];
+        e.id = next_id++;
+        m.erase(handles[k]);
+        handles[k] = m.insert(e);
+        entity_table::iterator it = t.find(ids[k]);
+        delete it->second;
+        t.erase(it);
+        t[e.id] = new entity(e);
+        ids[k] = e.id;
+    }
+
+    slot_map_sweep sweep = {&m};
+    suite.run("slot_map_sweep", "slot_map", slot_map_elements, sweep).param("elements", slot_map_elements);
+    table_sweep tsweep = {&t};
+    suite.run("slot_map_sweep", "hash_map_ptr", slot_map_elements, tsweep).param("elements", slot_map_elements);
+    slot_map_lookup lookup = {&m, &handles, &order};
+    suite.run("slot_map_lookup", "slot_map", order.size(), lookup).param("elements", slot_map_elements);
+    table_lookup tlookup = {&t, &ids, &order};
+    suite.run("slot_map_lookup", "hash_map_ptr", order.size(), tlookup).param("elements", slot_map_elements);
+
+    for(entity_table::iterator it = t.begin(); it != t.end(); ++it)
+        delete it->second;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "bench/bench.h"
+#include "stl_soa_vector.h"
+#include "stl_numeric.h"
+#include "stl_vector.h"
+
+// 8个字段的记录, 只对其中一列求和: vector<record>(array of structs) 与 soa_vector(structure of arrays)
+// scan: 一次操作为一条记录; push_back: 逐条插入(包括增长时的搬移), 一次操作为一条记录
+
+namespace {
+
+enum { soa_records = 1 << 18 };
+
+struct record
+{
+    int id;
+    float price;
+    float volume;
+    double weight;
+    long timestamp;
+    int flags;
+    double score;
+    int owner;
+};
+
+typedef soa_vector<int, float, float, double, long, int, double, int> record_table;
+
+struct aos_scan
+{
+    const vector<record>* v;
+    void operator()() const
+    {
+        float sum = 0;
+        for(vector<record>::const_iterator it = v->begin(); it != v->end(); ++it)
+            sum += it->price;
+        bench_keep(sum);
+    }
+};
+
+struct soa_scan
+{
+    const record_table* v;
+    void operator()() const
+    {
+        bench_keep(accumulate(v->begin<1>(), v->end<1>(), 0.0f));
+    }
+};
+
+struct aos_push_back
+{
+    void operator()() const
+    {
+        vector<record> v;
+        for(int i = 0; i < soa_records; ++i)
+        {
+            record r = {i, float(i), 1.0f, 0.5, long(i), 0, 0.0, i};
+            v.push_back(r);
+        }
+        bench_do_not_optimize(&v);
+    }
+};
+
+struct soa_push_back
+{
+    void operator()() const
+    {
+        record_table v;
+        for(int i = 0; i < soa_records; ++i)
+            v.push_back(i, float(i), 1.0f, 0.5, long(i), 0, 0.0, i);
+        bench_do_not_optimize(&v);
+    }
+};
+
+} // namespace
+
+void bench_soa_vector(bench_suite& suite)
+{
+    vector<record> aos;
+    record_table soa;
+    for(int i = 0; i < soa_records; ++i)
+    {
+        record r = {i, float(i % 100), 1.0f, 0.5, long(i), 0, 0.0, i};
+        aos.push_back(r);
+        soa.push_back(r.id, r.price, r.volume, r.weight, r.timestamp, r.flags, r.score, r.owner);
+    }
+    aos_scan ascan = {&aos};
+    suite.run("soa_scan_column", "vector_of_struct", soa_records, ascan).param("records", soa_records);
+    soa_scan sscan = {&soa};
+    suite.run("soa_scan_column", "soa_vector", soa_records, sscan).param("records", soa_records);
+    suite.run("soa_push_back", "vector_of_struct", soa_records, aos_push_back()).param("records", soa_records);
+    suite.run("soa_push_back", "soa_vector", soa_records, soa_push_back()).param("records", soa_records);
+}
\ No newline at end of file
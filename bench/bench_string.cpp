@@ -0,0 +1,114 @@
+#include "bench/bench.h"
+#include "stl_string.h"
+#include "stl_hash_map.h"
+#include "stl_vector.h"
+#include <string>
+
+// string(SSO, 23个字符以内不分配空间) 与 std::string(libstdc++ 15个字符以内不分配)
+// construct: 由 const char* 构造再析构, 一次操作为一个键; 键长 8 / 20 / 40 个字符
+// find: 在64个字符的串中查找一个字符与一个子串, 一次操作为一次查找
+// hash_map_find: 以20个字符的 string 为键的 hash_map 查找, 一次操作为一个键
+
+namespace {
+
+enum { string_keys = 1 << 12 };
+
+template<class String>
+struct construct_case
+{
+    const vector<const char*>* keys;
+    void operator()() const
+    {
+        size_t total = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+        {
+            String s((*keys)[i]);
+            bench_do_not_optimize(&s);
+            total += s.size();
+        }
+        bench_keep(total);
+    }
+};
+
+template<class String>
+construct_case<String> make_construct(const vector<const char*>& keys)
+{
+    construct_case<String> c = {&keys};
+    return c;
+}
+
+template<class String>
+struct find_case
+{
+    const String* text;
+    void operator()() const
+    {
+        size_t found = 0;
+        for(int i = 0; i < string_keys; ++i)
+        {
+            found += text->find(char('x' + i % 2));
+            found += text->find("qrs");
+        }
+        bench_keep(found);
+    }
+};
+
+struct lookup_case
+{
+    const hash_map<string, int>* map;
+    const vector<string>* keys;
+    void operator()() const
+    {
+        size_t found = 0;
+        for(size_t i = 0; i < keys->size(); ++i)
+            found += map->find((*keys)[i]) != map->end();
+        bench_keep(found);
+    }
+};
+
+} // namespace
+
+void bench_string(bench_suite& suite)
+{
+    unsigned int seed = 1;
+    const size_t lengths[] = {8, 20, 40};
+    for(size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+    {
+        const size_t len = lengths[l];
+        std::vector<std::string> storage(string_keys);
+        vector<const char*> keys;
+        for(size_t i = 0; i < storage.size(); ++i)
+        {
+            storage[i].resize(len);
+            for(size_t j = 0; j < len; ++j)
+            {
+                seed = seed * 1103515245u + 12345u;
+                storage[i][j] = char('a' + (seed >> 16) % 26);
+            }
+            keys.push_back(storage[i].c_str());
+        }
+        suite.run("string_construct", "std_string", string_keys, make_construct<std::string>(keys)).param("chars", long(len));
+        suite.run("string_construct", "string", string_keys, make_construct<string>(keys)).param("chars", long(len));
+
+        if(len == 20)
+        {
+            hash_map<string, int> map;
+            vector<string> lookups;
+            for(size_t i = 0; i < keys.size(); ++i)
+            {
+                map[string(keys[i])] = int(i);
+                lookups.push_back(string(keys[i]));
+            }
+            lookup_case c = {&map, &lookups};
+            suite.run("string_hash_map_find", "string", string_keys, c).param("chars", long(len));
+        }
+    }
+
+    const char* text = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ!?";
+    std::string std_text(text);
+    string own_text(text);
+    find_case<std::string> sf = {&std_text};
+    suite.run("string_find", "std_string", string_keys, sf).param("chars", 64);
+    find_case<string> of = {&own_text};
+    suite.run("string_find", "string", string_keys, of).param("chars", 64);
+}
\ No newline at end of file
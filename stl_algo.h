@@ -1,13 +1,1870 @@
 #ifndef __STL_ALGO_H
 #define __STL_ALGO_H
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <cstring>  // memchr, memcmp
+
+#include "stl_algobase.h"
+#include "stl_config.h"
+#include "stl_construct.h"
+#include "stl_function.h"
+#include "stl_heap.h"
+#include "stl_iterator.h"
+#include "stl_pair.h"
+#include "stl_tempbuf.h"
+#include "stl_uninitialized.h"
+
 template<class InputIterator, class Function>
-Function for_each(InputIterator first, InputIterator last, Function f)
+__STL_CONSTEXPR14 Function for_each(InputIterator first, InputIterator last, Function f)
 {
     for(; first != last; ++first)
         f(*first);
     return f;
 }
 
+// ========================================= find / count / search
+// 字节(char, signed char, unsigned char)与32位整数(int, unsigned int)的指针区间使用向量化版本:
+//   - 字节的 find 直接调用 memchr, libc 的实现已经按CPU选择了最宽的指令
+//   - 其余情况每次比较一个向量寄存器宽度的元素, 用 movemask 得到比较结果的位图
+//     有 AVX2 时一次比较32字节, 否则使用 SSE2 的16字节, 都没有时退回逐个比较
+// 只有查找的值与元素类型相同时才使用向量化版本, 其他迭代器与类型按原来的方式逐个比较
+// 常量求值中不能使用向量指令与 reinterpret_cast, find / count 总是逐个比较
+
+// 元素按哪种宽度比较, 有符号与无符号使用同一种比较
+template<class T>
+struct __simd_lane
+{
+    typedef __false_type is_vectorizable;
+};
+
+template<> struct __simd_lane<char>             {   typedef __true_type is_vectorizable;    typedef unsigned char lane_type;    };
+template<> struct __simd_lane<signed char>      {   typedef __true_type is_vectorizable;    typedef unsigned char lane_type;    };
+template<> struct __simd_lane<unsigned char>    {   typedef __true_type is_vectorizable;    typedef unsigned char lane_type;    };
+template<> struct __simd_lane<int>              {   typedef __true_type is_vectorizable;    typedef unsigned int lane_type;     };
+template<> struct __simd_lane<unsigned int>     {   typedef __true_type is_vectorizable;    typedef unsigned int lane_type;     };
+
+template<class Iterator, class T>
+struct __simd_find_dispatch
+{
+    typedef __false_type type;
+};
+
+template<class T>
+struct __simd_find_dispatch<T*, T>
+{
+    typedef typename __simd_lane<T>::is_vectorizable type;
+};
+
+template<class T>
+struct __simd_find_dispatch<const T*, T>
+{
+    typedef typename __simd_lane<T>::is_vectorizable type;
+};
+
+// 一个向量寄存器: 加载、逐元素比较、取出比较结果的位图(每个元素对应1位)
+#if defined(__AVX2__)
+typedef __m256i __simd_vector;
+enum { __simd_bytes = 32 };
+
+inline __simd_vector __simd_load(const void* p)     {   return _mm256_loadu_si256(static_cast<const __m256i*>(p));  }
+inline __simd_vector __simd_splat(unsigned char x)  {   return _mm256_set1_epi8(char(x));   }
+inline __simd_vector __simd_splat(unsigned int x)   {   return _mm256_set1_epi32(int(x));   }
+inline __simd_vector __simd_and(__simd_vector x, __simd_vector y)   {   return _mm256_and_si256(x, y);  }
+inline __simd_vector __simd_equal(__simd_vector x, __simd_vector y, unsigned char)  {   return _mm256_cmpeq_epi8(x, y);     }
+inline __simd_vector __simd_equal(__simd_vector x, __simd_vector y, unsigned int)   {   return _mm256_cmpeq_epi32(x, y);    }
+inline unsigned int __simd_mask(__simd_vector x, unsigned char) {   return unsigned(_mm256_movemask_epi8(x));   }
+inline unsigned int __simd_mask(__simd_vector x, unsigned int)  {   return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(x)));  }
+#elif defined(__SSE2__)
+typedef __m128i __simd_vector;
+enum { __simd_bytes = 16 };
+
+inline __simd_vector __simd_load(const void* p)     {   return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+inline __simd_vector __simd_splat(unsigned char x)  {   return _mm_set1_epi8(char(x));  }
+inline __simd_vector __simd_splat(unsigned int x)   {   return _mm_set1_epi32(int(x));  }
+inline __simd_vector __simd_and(__simd_vector x, __simd_vector y)   {   return _mm_and_si128(x, y); }
+inline __simd_vector __simd_equal(__simd_vector x, __simd_vector y, unsigned char)  {   return _mm_cmpeq_epi8(x, y);    }
+inline __simd_vector __simd_equal(__simd_vector x, __simd_vector y, unsigned int)   {   return _mm_cmpeq_epi32(x, y);   }
+inline unsigned int __simd_mask(__simd_vector x, unsigned char) {   return unsigned(_mm_movemask_epi8(x));  }
+inline unsigned int __simd_mask(__simd_vector x, unsigned int)  {   return unsigned(_mm_movemask_ps(_mm_castsi128_ps(x)));  }
+#endif
+
+inline const unsigned char* __find_lanes(const unsigned char* first, const unsigned char* last, unsigned char value)
+{
+    if(first == last)
+        return last;
+    const void* p = memchr(first, value, last - first);
+    return p ? static_cast<const unsigned char*>(p) : last;
+}
+
+inline const unsigned int* __find_lanes(const unsigned int* first, const unsigned int* last, unsigned int value)
+{
+#ifdef __SSE2__
+    const ptrdiff_t lanes = __simd_bytes / sizeof(unsigned int);
+    const __simd_vector v = __simd_splat(value);
+    for(; last - first >= lanes; first += lanes)
+    {
+        unsigned int mask = __simd_mask(__simd_equal(__simd_load(first), v, value), value);
+        if(mask)
+            return first + __builtin_ctz(mask);
+    }
+#endif
+    while(first != last && *first != value)
+        ++first;
+    return first;
+}
+
+// 计数: 字节的比较结果是0或-1, 逐向量相减累加到8位计数器中, 最多255次后用 sad 横向求和, 避免每个向量都要 popcount
+inline ptrdiff_t __count_lanes(const unsigned char* first, const unsigned char* last, unsigned char value)
+{
+    ptrdiff_t n = 0;
+#ifdef __SSE2__
+    const __simd_vector v = __simd_splat(value);
+    while(last - first >= __simd_bytes)
+    {
+        ptrdiff_t blocks = (last - first) / __simd_bytes;
+        if(blocks > 255)
+            blocks = 255;
+        __simd_vector counter = __simd_splat((unsigned char)0);
+        for(; blocks > 0; --blocks, first += __simd_bytes)
+        {
+#if defined(__AVX2__)
+            counter = _mm256_sub_epi8(counter, __simd_equal(__simd_load(first), v, value));
+#else
+            counter = _mm_sub_epi8(counter, __simd_equal(__simd_load(first), v, value));
+#endif
+        }
+        unsigned long long sums[__simd_bytes / 8];
+#if defined(__AVX2__)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), _mm256_sad_epu8(counter, _mm256_setzero_si256()));
+#else
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), _mm_sad_epu8(counter, _mm_setzero_si128()));
+#endif
+        for(int j = 0; j < __simd_bytes / 8; ++j)
+            n += ptrdiff_t(sums[j]);
+    }
+#endif
+    for(; first != last; ++first)
+        if(*first == value)
+            ++n;
+    return n;
+}
+
+inline ptrdiff_t __count_lanes(const unsigned int* first, const unsigned int* last, unsigned int value)
+{
+    ptrdiff_t n = 0;
+#ifdef __SSE2__
+    const ptrdiff_t lanes = __simd_bytes / sizeof(unsigned int);
+    const __simd_vector v = __simd_splat(value);
+    for(; last - first >= lanes; first += lanes)
+        n += __builtin_popcount(__simd_mask(__simd_equal(__simd_load(first), v, value), value));
+#endif
+    for(; first != last; ++first)
+        if(*first == value)
+            ++n;
+    return n;
+}
+
+template<class InputIterator, class T>
+__STL_CONSTEXPR14 InputIterator __find(InputIterator first, InputIterator last, const T& value, __false_type)
+{
+    while(first != last && !(*first == value))
+        ++first;
+    return first;
+}
+
+template<class Pointer, class T>
+inline Pointer __find(Pointer first, Pointer last, const T& value, __true_type)
+{
+    typedef typename __simd_lane<T>::lane_type lane_type;
+    const lane_type* p = reinterpret_cast<const lane_type*>(first);
+    return first + (__find_lanes(p, p + (last - first), lane_type(value)) - p);
+}
+
+template<class InputIterator, class T>
+inline __STL_CONSTEXPR14 InputIterator find(InputIterator first, InputIterator last, const T& value)
+{
+    typedef typename __simd_find_dispatch<InputIterator, T>::type vectorizable;
+    if(__STL_CONSTANT_EVALUATED())
+        return __find(first, last, value, __false_type());
+    return __find(first, last, value, vectorizable());
+}
+
+template<class InputIterator, class Predicate>
+__STL_CONSTEXPR14 InputIterator find_if(InputIterator first, InputIterator last, Predicate pred)
+{
+    while(first != last && !pred(*first))
+        ++first;
+    return first;
+}
+
+// 谓词是与某个值比较相等时, 等同于 find
+// 只在可以向量化(元素类型与 T 相同)时才改用 find; 否则 equal_to<T> 会先把 *first 转换为 T 再比较,
+// 与直接比较 *first == value 的结果可能不同(例如 double 区间与 equal_to<int>)
+template<class InputIterator, class Predicate>
+inline __STL_CONSTEXPR14 InputIterator __find_if_equal(InputIterator first, InputIterator last, Predicate pred, __true_type)
+{
+    return find(first, last, pred.argument());
+}
+
+template<class InputIterator, class Predicate>
+inline __STL_CONSTEXPR14 InputIterator __find_if_equal(InputIterator first, InputIterator last, Predicate pred, __false_type)
+{
+    while(first != last && !pred(*first))
+        ++first;
+    return first;
+}
+
+template<class InputIterator, class T>
+inline __STL_CONSTEXPR14 InputIterator find_if(InputIterator first, InputIterator last, binder2nd<equal_to<T> > pred)
+{
+    return __find_if_equal(first, last, pred, typename __simd_find_dispatch<InputIterator, T>::type());
+}
+
+template<class InputIterator, class T>
+inline __STL_CONSTEXPR14 InputIterator find_if(InputIterator first, InputIterator last, binder1st<equal_to<T> > pred)
+{
+    return __find_if_equal(first, last, pred, typename __simd_find_dispatch<InputIterator, T>::type());
+}
+
+template<class InputIterator, class T>
+__STL_CONSTEXPR14 typename iterator_traits<InputIterator>::difference_type
+__count(InputIterator first, InputIterator last, const T& value, __false_type)
+{
+    typename iterator_traits<InputIterator>::difference_type n = 0;
+    for(; first != last; ++first)
+        if(*first == value)
+            ++n;
+    return n;
+}
+
+template<class Pointer, class T>
+inline ptrdiff_t __count(Pointer first, Pointer last, const T& value, __true_type)
+{
+    typedef typename __simd_lane<T>::lane_type lane_type;
+    const lane_type* p = reinterpret_cast<const lane_type*>(first);
+    return __count_lanes(p, p + (last - first), lane_type(value));
+}
+
+template<class InputIterator, class T>
+inline __STL_CONSTEXPR14 typename iterator_traits<InputIterator>::difference_type
+count(InputIterator first, InputIterator last, const T& value)
+{
+    typedef typename __simd_find_dispatch<InputIterator, T>::type vectorizable;
+    if(__STL_CONSTANT_EVALUATED())
+        return __count(first, last, value, __false_type());
+    return __count(first, last, value, vectorizable());
+}
+
+template<class InputIterator, class Predicate>
+__STL_CONSTEXPR14 typename iterator_traits<InputIterator>::difference_type
+count_if(InputIterator first, InputIterator last, Predicate pred)
+{
+    typename iterator_traits<InputIterator>::difference_type n = 0;
+    for(; first != last; ++first)
+        if(pred(*first))
+            ++n;
+    return n;
+}
+
+// search: 在 [first1, last1) 中查找子序列 [first2, last2) 第一次出现的位置, 找不到时返回last1
+// 字节序列:
+//   - 较短的模式串先用向量比较过滤: 一次检查一个向量宽度的起始位置, 只有首字节与尾字节都相同的位置才比较中间部分
+//   - 较长的模式串使用 Horspool 算法, 按窗口最后一个字节查表跳过
+// 32位整数序列: 用向量化的 find 找首元素, 再比较其余部分
+enum { __search_horspool_threshold = 32 };
+
+template<class Iterator1, class Iterator2>
+struct __simd_search_dispatch
+{
+    typedef __false_type type;
+};
+
+template<class T> struct __simd_search_dispatch<T*, T*>             {   typedef typename __simd_lane<T>::is_vectorizable type; };
+template<class T> struct __simd_search_dispatch<const T*, T*>       {   typedef typename __simd_lane<T>::is_vectorizable type; };
+template<class T> struct __simd_search_dispatch<T*, const T*>       {   typedef typename __simd_lane<T>::is_vectorizable type; };
+template<class T> struct __simd_search_dispatch<const T*, const T*> {   typedef typename __simd_lane<T>::is_vectorizable type; };
+
+inline const unsigned char* __search_horspool(const unsigned char* first1, const unsigned char* last1,
+                                              const unsigned char* first2, ptrdiff_t len2)
+{
+    ptrdiff_t skip[256];
+    for(int c = 0; c < 256; ++c)
+        skip[c] = len2;
+    for(ptrdiff_t j = 0; j < len2 - 1; ++j)
+        skip[first2[j]] = len2 - 1 - j;
+    const unsigned char back = first2[len2 - 1];
+    for(; last1 - first1 >= len2; first1 += skip[first1[len2 - 1]])
+        if(first1[len2 - 1] == back && memcmp(first1, first2, len2 - 1) == 0)
+            return first1;
+    return last1;
+}
+
+inline const unsigned char* __search_lanes(const unsigned char* first1, const unsigned char* last1,
+                                           const unsigned char* first2, const unsigned char* last2)
+{
+    const ptrdiff_t len2 = last2 - first2;
+    if(len2 == 0)
+        return first1;
+    if(len2 == 1)
+        return __find_lanes(first1, last1, *first2);
+    if(len2 > __search_horspool_threshold)
+        return __search_horspool(first1, last1, first2, len2);
+    const unsigned char front = first2[0];
+    const unsigned char back = first2[len2 - 1];
+#ifdef __SSE2__
+    // 每轮检查 [first1, first1 + __simd_bytes) 这些起始位置, 尾字节的读取不能越过last1
+    const __simd_vector vfront = __simd_splat(front);
+    const __simd_vector vback = __simd_splat(back);
+    for(; last1 - first1 >= len2 - 1 + __simd_bytes; first1 += __simd_bytes)
+    {
+        __simd_vector x = __simd_equal(__simd_load(first1), vfront, front);
+        __simd_vector y = __simd_equal(__simd_load(first1 + len2 - 1), vback, back);
+        for(unsigned int mask = __simd_mask(__simd_and(x, y), front); mask; mask &= mask - 1)
+        {
+            const unsigned char* candidate = first1 + __builtin_ctz(mask);
+            if(memcmp(candidate + 1, first2 + 1, len2 - 2) == 0)
+                return candidate;
+        }
+    }
+#endif
+    for(; last1 - first1 >= len2; ++first1)
+        if(first1[0] == front && first1[len2 - 1] == back && memcmp(first1 + 1, first2 + 1, len2 - 2) == 0)
+            return first1;
+    return last1;
+}
+
+inline const unsigned int* __search_lanes(const unsigned int* first1, const unsigned int* last1,
+                                          const unsigned int* first2, const unsigned int* last2)
+{
+    const ptrdiff_t len2 = last2 - first2;
+    if(len2 == 0)
+        return first1;
+    if(last1 - first1 < len2)
+        return last1;
+    // 首元素只可能出现在 [first1, limit) 中
+    const unsigned int* limit = last1 - len2 + 1;
+    for(;; ++first1)
+    {
+        first1 = __find_lanes(first1, limit, *first2);
+        if(first1 == limit)
+            return last1;
+        if(memcmp(first1 + 1, first2 + 1, sizeof(unsigned int) * (len2 - 1)) == 0)
+            return first1;
+    }
+}
+
+template<class ForwardIterator1, class ForwardIterator2>
+ForwardIterator1 __search(ForwardIterator1 first1, ForwardIterator1 last1,
+                          ForwardIterator2 first2, ForwardIterator2 last2, __false_type)
+{
+    if(first2 == last2)
+        return first1;
+    ForwardIterator2 p1 = first2;
+    if(++p1 == last2)
+        return find(first1, last1, *first2);
+    for(;;)
+    {
+        first1 = find(first1, last1, *first2);
+        if(first1 == last1)
+            return last1;
+        ForwardIterator2 p = p1;
+        ForwardIterator1 current = first1;
+        if(++current == last1)
+            return last1;
+        while(*current == *p)
+        {
+            if(++p == last2)
+                return first1;
+            if(++current == last1)
+                return last1;
+        }
+        ++first1;
+    }
+}
+
+template<class Pointer1, class Pointer2>
+inline Pointer1 __search(Pointer1 first1, Pointer1 last1, Pointer2 first2, Pointer2 last2, __true_type)
+{
+    typedef typename iterator_traits<Pointer2>::value_type value_type;
+    typedef typename __simd_lane<value_type>::lane_type lane_type;
+    const lane_type* p1 = reinterpret_cast<const lane_type*>(first1);
+    const lane_type* p2 = reinterpret_cast<const lane_type*>(first2);
+    return first1 + (__search_lanes(p1, p1 + (last1 - first1), p2, p2 + (last2 - first2)) - p1);
+}
+
+template<class ForwardIterator1, class ForwardIterator2>
+inline ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
+                               ForwardIterator2 first2, ForwardIterator2 last2)
+{
+    typedef typename __simd_search_dispatch<ForwardIterator1, ForwardIterator2>::type vectorizable;
+    return __search(first1, last1, first2, last2, vectorizable());
+}
+
+template<class ForwardIterator1, class ForwardIterator2, class BinaryPredicate>
+ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
+                        ForwardIterator2 first2, ForwardIterator2 last2, BinaryPredicate binary_pred)
+{
+    if(first2 == last2)
+        return first1;
+    for(; first1 != last1; ++first1)
+    {
+        ForwardIterator1 current = first1;
+        ForwardIterator2 p = first2;
+        while(binary_pred(*current, *p))
+        {
+            if(++p == last2)
+                return first1;
+            if(++current == last1)
+                return last1;
+        }
+    }
+    return last1;
+}
+
+// ========================================= transform
+template<class InputIterator, class OutputIterator, class UnaryOperation>
+OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op)
+{
+    for(; first != last; ++first, ++result)
+        *result = op(*first);
+    return result;
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+OutputIterator transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+                         OutputIterator result, BinaryOperation binary_op)
+{
+    for(; first1 != last1; ++first1, ++first2, ++result)
+        *result = binary_op(*first1, *first2);
+    return result;
+}
+
+
+// ========================================= lower_bound / upper_bound / equal_range / binary_search
+// 随机访问迭代器使用无分支的二分查找: 每轮区间长度减半, 只根据比较结果决定起点是否前移,
+// 编译器生成条件传送(cmov)而不是分支, 查找的键随机时不会有分支预测失败
+// 区间较大时预取下一轮可能访问的两个中点, 把两次缓存缺失重叠起来
+// 前向迭代器按原来的方式查找
+// 从C++14起都是 constexpr, 常量求值中不预取
+
+enum { __cache_line_size = 64 };
+// 区间长度超过此值时才预取, 较小的区间通常已在缓存中
+enum { __binary_search_prefetch_threshold = 1024 };
+
+inline __STL_CONSTEXPR14 void __prefetch(const void* p)
+{
+#if defined(__GNUC__)
+    if(!__STL_CONSTANT_EVALUATED())
+        __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// 不带比较函数的版本使用的 <, 两侧类型可以不同, 不先把 value 转换为元素类型
+// (例如在 int 区间中查找 2.5 时, 转换为 int 会得到错误的结果)
+struct __less
+{
+    template<class T1, class T2>
+    __STL_CONSTEXPR14 bool operator()(const T1& x, const T2& y) const  {   return x < y;   }
+};
+
+template<class ForwardIterator, class T, class Compare, class Distance>
+__STL_CONSTEXPR14 ForwardIterator __lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp,
+                              Distance*, forward_iterator_tag)
+{
+    Distance len = distance(first, last);
+    while(len > 0)
+    {
+        Distance half = len >> 1;
+        ForwardIterator middle = first;
+        advance(middle, half);
+        if(comp(*middle, value))
+        {
+            first = middle;
+            ++first;
+            len = len - half - 1;
+        }
+        else
+            len = half;
+    }
+    return first;
+}
+
+// 循环中保持答案位于 [first, first + len] 之内, 长度为1时再比较一次
+template<class RandomAccessIterator, class T, class Compare, class Distance>
+__STL_CONSTEXPR14 RandomAccessIterator __lower_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value, Compare comp,
+                                   Distance*, random_access_iterator_tag)
+{
+    Distance len = last - first;
+    if(len == 0)
+        return first;
+    while(len > 1)
+    {
+        Distance half = len >> 1;
+        if(len > __binary_search_prefetch_threshold)
+        {
+            __prefetch(&*(first + (half >> 1)));
+            __prefetch(&*(first + half + (half >> 1)));
+        }
+        first = comp(first[half], value) ? first + half : first;
+        len -= half;
+    }
+    return comp(*first, value) ? first + 1 : first;
+}
+
+template<class ForwardIterator, class T, class Compare>
+inline __STL_CONSTEXPR14 ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp)
+{
+    return __lower_bound(first, last, value, comp, distance_type(first), iterator_category(first));
+}
+
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value)
+{
+    return lower_bound(first, last, value, __less());
+}
+
+template<class ForwardIterator, class T, class Compare, class Distance>
+__STL_CONSTEXPR14 ForwardIterator __upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp,
+                              Distance*, forward_iterator_tag)
+{
+    Distance len = distance(first, last);
+    while(len > 0)
+    {
+        Distance half = len >> 1;
+        ForwardIterator middle = first;
+        advance(middle, half);
+        if(comp(value, *middle))
+            len = half;
+        else
+        {
+            first = middle;
+            ++first;
+            len = len - half - 1;
+        }
+    }
+    return first;
+}
+
+template<class RandomAccessIterator, class T, class Compare, class Distance>
+__STL_CONSTEXPR14 RandomAccessIterator __upper_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value, Compare comp,
+                                   Distance*, random_access_iterator_tag)
+{
+    Distance len = last - first;
+    if(len == 0)
+        return first;
+    while(len > 1)
+    {
+        Distance half = len >> 1;
+        if(len > __binary_search_prefetch_threshold)
+        {
+            __prefetch(&*(first + (half >> 1)));
+            __prefetch(&*(first + half + (half >> 1)));
+        }
+        first = comp(value, first[half]) ? first : first + half;
+        len -= half;
+    }
+    return comp(value, *first) ? first : first + 1;
+}
+
+template<class ForwardIterator, class T, class Compare>
+inline __STL_CONSTEXPR14 ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp)
+{
+    return __upper_bound(first, last, value, comp, distance_type(first), iterator_category(first));
+}
+
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value)
+{
+    return upper_bound(first, last, value, __less());
+}
+
+template<class ForwardIterator, class T, class Compare>
+inline __STL_CONSTEXPR14 pair<ForwardIterator, ForwardIterator>
+equal_range(ForwardIterator first, ForwardIterator last, const T& value, Compare comp)
+{
+    ForwardIterator i = lower_bound(first, last, value, comp);
+    return pair<ForwardIterator, ForwardIterator>(i, upper_bound(i, last, value, comp));
+}
+
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 pair<ForwardIterator, ForwardIterator> equal_range(ForwardIterator first, ForwardIterator last, const T& value)
+{
+    return equal_range(first, last, value, __less());
+}
+
+template<class ForwardIterator, class T, class Compare>
+inline __STL_CONSTEXPR14 bool binary_search(ForwardIterator first, ForwardIterator last, const T& value, Compare comp)
+{
+    ForwardIterator i = lower_bound(first, last, value, comp);
+    return i != last && !comp(value, *i);
+}
+
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 bool binary_search(ForwardIterator first, ForwardIterator last, const T& value)
+{
+    return binary_search(first, last, value, __less());
+}
+
+
+// ========================================= merge / inplace_merge / set_union / set_intersection / set_difference / includes
+// 两个随机访问区间按以下方式合并:
+//   先逐个比较; 一侧连续胜出 __min_gallop 次后, 认为它领先另一侧很远,
+//   改用指数搜索(galloping)找出它领先的整段, 整段复制或跳过, 然后回到逐个比较
+// 指数搜索自当前位置以 1, 2, 4, 8... 的步长试探, 再在最后一步内二分, 代价为 O(log d), d为这一段的长度
+// 两个区间长度相近且交错时与逐个合并相同; 长度为m与n (m << n)的区间只需 O(m log(n/m)) 次比较
+// (merge, set_union 仍需复制全部 m + n 个元素; set_intersection, set_difference, includes 不需要)
+// 其他迭代器逐个比较
+
+enum { __min_gallop = 7 };
+
+// [first, last) 中第一个不小于value的元素, 从first开始指数搜索
+template<class RandomAccessIterator, class T, class Compare>
+RandomAccessIterator __gallop_lower_bound(RandomAccessIterator first, RandomAccessIterator last,
+                                          const T& value, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    const Distance len = last - first;
+    if(len == 0 || !comp(*first, value))
+        return first;
+    Distance lo = 0;    // first[lo] < value
+    Distance step = 1;
+    while(lo + step < len && comp(first[lo + step], value))
+    {
+        lo += step;
+        step <<= 1;
+    }
+    return lower_bound(first + lo + 1, first + min(lo + step, len), value, comp);
+}
+
+// [first, last) 中第一个大于value的元素, 从first开始指数搜索
+template<class RandomAccessIterator, class T, class Compare>
+RandomAccessIterator __gallop_upper_bound(RandomAccessIterator first, RandomAccessIterator last,
+                                          const T& value, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    const Distance len = last - first;
+    if(len == 0 || comp(value, *first))
+        return first;
+    Distance lo = 0;    // first[lo] <= value
+    Distance step = 1;
+    while(lo + step < len && !comp(value, first[lo + step]))
+    {
+        lo += step;
+        step <<= 1;
+    }
+    return upper_bound(first + lo + 1, first + min(lo + step, len), value, comp);
+}
+
+// 合并到其中一个区间用完为止, first1 与 first2 返回各自剩余部分的开头
+// 相等的元素优先取第一个区间的, 保持稳定
+template<class RandomAccessIterator1, class RandomAccessIterator2, class OutputIterator, class Compare>
+OutputIterator __merge_gallop(RandomAccessIterator1& first1, RandomAccessIterator1 last1,
+                              RandomAccessIterator2& first2, RandomAccessIterator2 last2,
+                              OutputIterator result, Compare comp)
+{
+    int run1 = 0, run2 = 0;
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first2, *first1))
+        {
+            *result = *first2;
+            ++result;
+            ++first2;
+            run1 = 0;
+            if(++run2 >= __min_gallop)
+            {
+                RandomAccessIterator2 i = __gallop_lower_bound(first2, last2, *first1, comp);
+                result = copy(first2, i, result);
+                first2 = i;
+                run2 = 0;
+            }
+        }
+        else
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+            run2 = 0;
+            if(++run1 >= __min_gallop && first1 != last1)
+            {
+                RandomAccessIterator1 i = __gallop_upper_bound(first1, last1, *first2, comp);
+                result = copy(first1, i, result);
+                first1 = i;
+                run1 = 0;
+            }
+        }
+    }
+    return result;
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+OutputIterator __merge(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                       OutputIterator result, Compare comp, input_iterator_tag, input_iterator_tag)
+{
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first2, *first1))
+        {
+            *result = *first2;
+            ++first2;
+        }
+        else
+        {
+            *result = *first1;
+            ++first1;
+        }
+        ++result;
+    }
+    return copy(first2, last2, copy(first1, last1, result));
+}
+
+template<class RandomAccessIterator1, class RandomAccessIterator2, class OutputIterator, class Compare>
+inline OutputIterator __merge(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                              RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                              OutputIterator result, Compare comp, random_access_iterator_tag, random_access_iterator_tag)
+{
+    result = __merge_gallop(first1, last1, first2, last2, result, comp);
+    return copy(first2, last2, copy(first1, last1, result));
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+inline OutputIterator merge(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result, Compare comp)
+{
+    return __merge(first1, last1, first2, last2, result, comp, iterator_category(first1), iterator_category(first2));
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator merge(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result)
+{
+    return merge(first1, last1, first2, last2, result, __less());
+}
+
+// 把左半部分复制到缓冲区, 与右半部分合并回原区间; 输出位置不会超过右半部分的读取位置
+// 右半部分剩下的元素已经在正确的位置上
+// 双向迭代器逐个比较, 随机访问迭代器用 galloping
+template<class BidirectionalIterator, class Pointer, class Compare>
+void __merge_with_buffer(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+                         Pointer buffer, Compare comp, bidirectional_iterator_tag)
+{
+    Pointer buffer_end = uninitialized_copy(first, middle, buffer);
+    Pointer b = buffer;
+    BidirectionalIterator out = first;
+    while(b != buffer_end && middle != last)
+    {
+        if(comp(*middle, *b))
+        {
+            *out = *middle;
+            ++middle;
+        }
+        else
+        {
+            *out = *b;
+            ++b;
+        }
+        ++out;
+    }
+    copy(b, buffer_end, out);
+    destroy(buffer, buffer_end);
+}
+
+template<class RandomAccessIterator, class Pointer, class Compare>
+void __merge_with_buffer(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last,
+                         Pointer buffer, Compare comp, random_access_iterator_tag)
+{
+    Pointer buffer_end = uninitialized_copy(first, middle, buffer);
+    Pointer b = buffer;
+    RandomAccessIterator out = __merge_gallop(b, buffer_end, middle, last, first, comp);
+    copy(b, buffer_end, out);
+    destroy(buffer, buffer_end);
+}
+
+// 右半部分较短时: 把右半部分复制到缓冲区, 从后往前合并
+template<class BidirectionalIterator, class Pointer, class Compare>
+void __merge_backward_with_buffer(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+                                  Pointer buffer, Compare comp)
+{
+    Pointer buffer_end = uninitialized_copy(middle, last, buffer);
+    Pointer b = buffer_end;
+    BidirectionalIterator l = middle;
+    BidirectionalIterator out = last;
+    while(b != buffer && l != first)
+    {
+        BidirectionalIterator prev = l;
+        --prev;
+        // 相等时右半部分的元素排在后面
+        if(comp(*(b - 1), *prev))
+        {
+            *--out = *prev;
+            l = prev;
+        }
+        else
+            *--out = *--b;
+    }
+    copy_backward(buffer, b, out);
+    destroy(buffer, buffer_end);
+}
+
+// 合并相邻的两个有序区间 [first, middle) 与 [middle, last), 结果稳定
+// 先用二分查找去掉两端已经在正确位置上的元素, 缓冲区只需容纳剩余部分中较短的一半, 从alloc配置
+template<class BidirectionalIterator, class Compare>
+void inplace_merge(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last, Compare comp)
+{
+    __STL_PERF_SCOPE("inplace_merge");
+    typedef typename iterator_traits<BidirectionalIterator>::value_type T;
+    typedef typename iterator_traits<BidirectionalIterator>::difference_type Distance;
+    if(first == middle || middle == last)
+        return;
+    BidirectionalIterator left_last = middle;
+    --left_last;
+    if(!comp(*middle, *left_last))
+        return;
+    first = upper_bound(first, middle, *middle, comp);
+    last = lower_bound(middle, last, *left_last, comp);
+    Distance len1 = distance(first, middle);
+    Distance len2 = distance(middle, last);
+    temporary_buffer<T> buf(min(len1, len2));
+    if(len1 <= len2)
+        __merge_with_buffer(first, middle, last, buf.begin(), comp, iterator_category(first));
+    else
+        __merge_backward_with_buffer(first, middle, last, buf.begin(), comp);
+}
+
+template<class BidirectionalIterator>
+inline void inplace_merge(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+{
+    inplace_merge(first, middle, last, less<typename iterator_traits<BidirectionalIterator>::value_type>());
+}
+
+// 并集: 两个区间中相等的元素只输出第一个区间的
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+OutputIterator __set_union(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                           OutputIterator result, Compare comp, input_iterator_tag, input_iterator_tag)
+{
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++first1;
+        }
+        else if(comp(*first2, *first1))
+        {
+            *result = *first2;
+            ++first2;
+        }
+        else
+        {
+            *result = *first1;
+            ++first1;
+            ++first2;
+        }
+        ++result;
+    }
+    return copy(first2, last2, copy(first1, last1, result));
+}
+
+template<class RandomAccessIterator1, class RandomAccessIterator2, class OutputIterator, class Compare>
+OutputIterator __set_union(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                           RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                           OutputIterator result, Compare comp, random_access_iterator_tag, random_access_iterator_tag)
+{
+    int run1 = 0, run2 = 0;
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+            run2 = 0;
+            if(++run1 >= __min_gallop)
+            {
+                RandomAccessIterator1 i = __gallop_lower_bound(first1, last1, *first2, comp);
+                result = copy(first1, i, result);
+                first1 = i;
+                run1 = 0;
+            }
+        }
+        else if(comp(*first2, *first1))
+        {
+            *result = *first2;
+            ++result;
+            ++first2;
+            run1 = 0;
+            if(++run2 >= __min_gallop)
+            {
+                RandomAccessIterator2 i = __gallop_lower_bound(first2, last2, *first1, comp);
+                result = copy(first2, i, result);
+                first2 = i;
+                run2 = 0;
+            }
+        }
+        else
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+            ++first2;
+            run1 = run2 = 0;
+        }
+    }
+    return copy(first2, last2, copy(first1, last1, result));
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+inline OutputIterator set_union(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, Compare comp)
+{
+    return __set_union(first1, last1, first2, last2, result, comp, iterator_category(first1), iterator_category(first2));
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_union(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result)
+{
+    return set_union(first1, last1, first2, last2, result, __less());
+}
+
+// 交集: 输出第一个区间中的元素
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+OutputIterator __set_intersection(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                  OutputIterator result, Compare comp, input_iterator_tag, input_iterator_tag)
+{
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first1, *first2))
+            ++first1;
+        else if(comp(*first2, *first1))
+            ++first2;
+        else
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+            ++first2;
+        }
+    }
+    return result;
+}
+
+template<class RandomAccessIterator1, class RandomAccessIterator2, class OutputIterator, class Compare>
+OutputIterator __set_intersection(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                  RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                  OutputIterator result, Compare comp, random_access_iterator_tag, random_access_iterator_tag)
+{
+    int run1 = 0, run2 = 0;
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first1, *first2))
+        {
+            ++first1;
+            run2 = 0;
+            if(++run1 >= __min_gallop)
+            {
+                first1 = __gallop_lower_bound(first1, last1, *first2, comp);
+                run1 = 0;
+            }
+        }
+        else if(comp(*first2, *first1))
+        {
+            ++first2;
+            run1 = 0;
+            if(++run2 >= __min_gallop)
+            {
+                first2 = __gallop_lower_bound(first2, last2, *first1, comp);
+                run2 = 0;
+            }
+        }
+        else
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+            ++first2;
+            run1 = run2 = 0;
+        }
+    }
+    return result;
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+inline OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                       OutputIterator result, Compare comp)
+{
+    return __set_intersection(first1, last1, first2, last2, result, comp, iterator_category(first1), iterator_category(first2));
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                       OutputIterator result)
+{
+    return set_intersection(first1, last1, first2, last2, result, __less());
+}
+
+// 差集: 在第一个区间而不在第二个区间中的元素
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+OutputIterator __set_difference(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, Compare comp, input_iterator_tag, input_iterator_tag)
+{
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+        }
+        else if(comp(*first2, *first1))
+            ++first2;
+        else
+        {
+            ++first1;
+            ++first2;
+        }
+    }
+    return copy(first1, last1, result);
+}
+
+template<class RandomAccessIterator1, class RandomAccessIterator2, class OutputIterator, class Compare>
+OutputIterator __set_difference(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                OutputIterator result, Compare comp, random_access_iterator_tag, random_access_iterator_tag)
+{
+    int run1 = 0, run2 = 0;
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++result;
+            ++first1;
+            run2 = 0;
+            if(++run1 >= __min_gallop)
+            {
+                RandomAccessIterator1 i = __gallop_lower_bound(first1, last1, *first2, comp);
+                result = copy(first1, i, result);
+                first1 = i;
+                run1 = 0;
+            }
+        }
+        else if(comp(*first2, *first1))
+        {
+            ++first2;
+            run1 = 0;
+            if(++run2 >= __min_gallop)
+            {
+                first2 = __gallop_lower_bound(first2, last2, *first1, comp);
+                run2 = 0;
+            }
+        }
+        else
+        {
+            ++first1;
+            ++first2;
+            run1 = run2 = 0;
+        }
+    }
+    return copy(first1, last1, result);
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+inline OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                     OutputIterator result, Compare comp)
+{
+    return __set_difference(first1, last1, first2, last2, result, comp, iterator_category(first1), iterator_category(first2));
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                                     OutputIterator result)
+{
+    return set_difference(first1, last1, first2, last2, result, __less());
+}
+
+// 第二个区间的每个元素是否都在第一个区间中
+template<class InputIterator1, class InputIterator2, class Compare>
+bool __includes(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+                Compare comp, input_iterator_tag, input_iterator_tag)
+{
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first2, *first1))
+            return false;
+        if(!comp(*first1, *first2))
+            ++first2;
+        ++first1;
+    }
+    return first2 == last2;
+}
+
+template<class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+bool __includes(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                Compare comp, random_access_iterator_tag, random_access_iterator_tag)
+{
+    int run1 = 0;
+    while(first1 != last1 && first2 != last2)
+    {
+        if(comp(*first2, *first1))
+            return false;
+        if(comp(*first1, *first2))
+        {
+            ++first1;
+            if(++run1 >= __min_gallop)
+            {
+                first1 = __gallop_lower_bound(first1, last1, *first2, comp);
+                run1 = 0;
+            }
+        }
+        else
+        {
+            ++first1;
+            ++first2;
+            run1 = 0;
+        }
+    }
+    return first2 == last2;
+}
+
+template<class InputIterator1, class InputIterator2, class Compare>
+inline bool includes(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2, Compare comp)
+{
+    return __includes(first1, last1, first2, last2, comp, iterator_category(first1), iterator_category(first2));
+}
+
+template<class InputIterator1, class InputIterator2>
+inline bool includes(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
+{
+    return includes(first1, last1, first2, last2, __less());
+}
+
+
+// ========================================= sort
+// pdqsort (pattern-defeating quicksort): 以introsort为基础
+//   - 小区间使用插入排序; 非最左侧的区间左边必有不大于所有元素的值, 可以省去边界检查
+//   - 大区间用 ninther(三组三数取中) 选择枢轴, 小区间用三数取中
+//   - 分割后若没有发生交换(区间可能已经有序), 尝试有限次数的插入排序, 有序和逆序输入接近线性时间
+//   - 枢轴等于左边的元素时, 说明区间内有大量与之相等的元素, 把相等的元素一次分到左边后不再处理,
+//     大量重复元素的输入为 O(n*k), k为不同值的个数
+//   - 分割严重不平衡时打乱部分元素破坏输入的规律, 不平衡次数超过 log(n) 后改用堆排序, 最坏 O(n log n)
+// comp 必须是严格弱序(例如 less, greater, not2(greater_equal)), 分割时的查找不检查边界,
+// less_equal 这样的比较会越界
+
+enum { __insertion_sort_threshold = 24 };
+enum { __ninther_threshold = 128 };
+enum { __partial_insertion_sort_limit = 8 };
+
+template<class Size>
+inline Size __lg(Size n)
+{
+    Size k = 0;
+    for(; n > 1; n >>= 1)
+        ++k;
+    return k;
+}
+
+template<class RandomAccessIterator, class Compare>
+void __insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    if(first == last)
+        return;
+    for(RandomAccessIterator cur = first + 1; cur != last; ++cur)
+    {
+        if(comp(*cur, *(cur - 1)))
+        {
+            T tmp = *cur;
+            RandomAccessIterator sift = cur;
+            do
+            {
+                *sift = *(sift - 1);
+                --sift;
+            } while(sift != first && comp(tmp, *(sift - 1)));
+            *sift = tmp;
+        }
+    }
+}
+
+// first之前的元素不大于区间内的所有元素, 向前移动时不需要检查边界
+template<class RandomAccessIterator, class Compare>
+void __unguarded_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    if(first == last)
+        return;
+    for(RandomAccessIterator cur = first + 1; cur != last; ++cur)
+    {
+        if(comp(*cur, *(cur - 1)))
+        {
+            T tmp = *cur;
+            RandomAccessIterator sift = cur;
+            do
+            {
+                *sift = *(sift - 1);
+                --sift;
+            } while(comp(tmp, *(sift - 1)));
+            *sift = tmp;
+        }
+    }
+}
+
+// 移动的元素个数超过限制时放弃并返回false, 区间处于部分排序的状态
+template<class RandomAccessIterator, class Compare>
+bool __partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    if(first == last)
+        return true;
+    size_t limit = 0;
+    for(RandomAccessIterator cur = first + 1; cur != last; ++cur)
+    {
+        if(limit > __partial_insertion_sort_limit)
+            return false;
+        if(comp(*cur, *(cur - 1)))
+        {
+            T tmp = *cur;
+            RandomAccessIterator sift = cur;
+            do
+            {
+                *sift = *(sift - 1);
+                --sift;
+            } while(sift != first && comp(tmp, *(sift - 1)));
+            *sift = tmp;
+            limit += cur - sift;
+        }
+    }
+    return true;
+}
+
+template<class RandomAccessIterator, class Compare>
+inline void __sort2(RandomAccessIterator a, RandomAccessIterator b, Compare comp)
+{
+    if(comp(*b, *a))
+        iter_swap(a, b);
+}
+
+// 排序后 *a <= *b <= *c
+template<class RandomAccessIterator, class Compare>
+inline void __sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare comp)
+{
+    __sort2(a, b, comp);
+    __sort2(b, c, comp);
+    __sort2(a, b, comp);
+}
+
+// 以 *first 为枢轴分割, 小于枢轴的元素放在左边, 不小于的放在右边
+// 要求区间内存在不小于枢轴的元素(三数取中保证了这一点), 左边还有不大于枢轴的元素或者first就是最左侧
+// 返回枢轴的最终位置, 以及分割过程中是否没有交换任何元素
+template<class RandomAccessIterator, class Compare>
+pair<RandomAccessIterator, bool> __partition_right(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    T pivot = *begin;
+    RandomAccessIterator first = begin;
+    RandomAccessIterator last = end;
+
+    while(comp(*++first, pivot))
+        ;
+    // first之前没有元素时, 右边的查找需要检查边界
+    if(first - 1 == begin)
+        while(first < last && !comp(*--last, pivot))
+            ;
+    else
+        while(!comp(*--last, pivot))
+            ;
+
+    bool already_partitioned = first >= last;
+    while(first < last)
+    {
+        iter_swap(first, last);
+        while(comp(*++first, pivot))
+            ;
+        while(!comp(*--last, pivot))
+            ;
+    }
+
+    RandomAccessIterator pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+}
+
+// 与 __partition_right 相反, 与枢轴相等的元素都放在左边
+// 用于枢轴与区间左边的元素相等的情况, 此时左边的元素都等于枢轴, 不需要再排序
+template<class RandomAccessIterator, class Compare>
+RandomAccessIterator __partition_left(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    T pivot = *begin;
+    RandomAccessIterator first = begin;
+    RandomAccessIterator last = end;
+
+    while(comp(pivot, *--last))
+        ;
+    if(last + 1 == end)
+        while(first < last && !comp(pivot, *++first))
+            ;
+    else
+        while(!comp(pivot, *++first))
+            ;
+
+    while(first < last)
+    {
+        iter_swap(first, last);
+        while(comp(pivot, *--last))
+            ;
+        while(!comp(pivot, *++first))
+            ;
+    }
+
+    RandomAccessIterator pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+// 把选出的枢轴放到 *begin
+template<class RandomAccessIterator, class Compare>
+inline void __choose_pivot(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    Distance size = end - begin;
+    Distance s2 = size / 2;
+    if(size > __ninther_threshold)
+    {
+        __sort3(begin, begin + s2, end - 1, comp);
+        __sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+        __sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+        __sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+        iter_swap(begin, begin + s2);
+    }
+    else
+        __sort3(begin + s2, begin, end - 1, comp);
+}
+
+template<class RandomAccessIterator, class Compare, class Distance>
+void __pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end, Compare comp,
+                    Distance bad_allowed, bool leftmost)
+{
+    for(;;)
+    {
+        Distance size = end - begin;
+        if(size < __insertion_sort_threshold)
+        {
+            if(leftmost)
+                __insertion_sort(begin, end, comp);
+            else
+                __unguarded_insertion_sort(begin, end, comp);
+            return;
+        }
+
+        __choose_pivot(begin, end, comp);
+
+        // 枢轴等于左边的元素: 与它相等的元素都分到左边, 只需处理右边
+        if(!leftmost && !comp(*(begin - 1), *begin))
+        {
+            begin = __partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        pair<RandomAccessIterator, bool> part = __partition_right(begin, end, comp);
+        RandomAccessIterator pivot_pos = part.first;
+        Distance l_size = pivot_pos - begin;
+        Distance r_size = end - (pivot_pos + 1);
+
+        if(l_size < size / 8 || r_size < size / 8)
+        {
+            // 不平衡次数过多, 改用堆排序
+            if(--bad_allowed == 0)
+            {
+                make_heap(begin, end, comp);
+                sort_heap(begin, end, comp);
+                return;
+            }
+            // 交换若干元素, 打乱可能导致不平衡的规律
+            if(l_size >= __insertion_sort_threshold)
+            {
+                iter_swap(begin, begin + l_size / 4);
+                iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if(l_size > __ninther_threshold)
+                {
+                    iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if(r_size >= __insertion_sort_threshold)
+            {
+                iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                iter_swap(end - 1, end - r_size / 4);
+                if(r_size > __ninther_threshold)
+                {
+                    iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    iter_swap(end - 2, end - (1 + r_size / 4));
+                    iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        }
+        // 分割时没有交换, 两边可能已经有序, 用有限次数的插入排序试一试
+        else if(part.second && __partial_insertion_sort(begin, pivot_pos, comp)
+                            && __partial_insertion_sort(pivot_pos + 1, end, comp))
+            return;
+
+        // 递归处理左边, 循环处理右边
+        __pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template<class RandomAccessIterator, class Compare>
+inline void __sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __STL_PERF_SCOPE("sort");
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    if(last - first > 1)
+        __pdqsort_loop(first, last, comp, Distance(__lg(last - first)), true);
+}
+
+// 常量求值中使用堆排序: 不需要递归与临时缓冲区, 也不经过计数器与基数排序
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void __constant_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    make_heap(first, last, comp);
+    sort_heap(first, last, comp);
+}
+
+// 算术类型的指针区间以 less / greater 排序时, 由后面的重载版本转用基数排序
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    if(__STL_CONSTANT_EVALUATED())
+        return __constant_sort(first, last, comp);
+    __sort(first, last, comp);
+}
+
+template<class ForwardIterator, class Compare>
+__STL_CONSTEXPR14 bool is_sorted(ForwardIterator first, ForwardIterator last, Compare comp)
+{
+    if(first == last)
+        return true;
+    ForwardIterator next = first;
+    for(++next; next != last; first = next, ++next)
+        if(comp(*next, *first))
+            return false;
+    return true;
+}
+
+template<class ForwardIterator>
+inline __STL_CONSTEXPR14 bool is_sorted(ForwardIterator first, ForwardIterator last)
+{
+    return is_sorted(first, last, less<typename iterator_traits<ForwardIterator>::value_type>());
+}
+
+// ========================================= partial_sort
+// 使 [first, middle) 成为整个区间中最小的 middle-first 个元素并排好序, 其余元素顺序不确定
+// 对前半部分建大顶堆, 后面的元素比堆顶小时替换堆顶, O(n log m)
+template<class RandomAccessIterator, class Compare>
+void partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare comp)
+{
+    __STL_PERF_SCOPE("partial_sort");
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    if(first == middle)
+        return;
+    make_heap(first, middle, comp);
+    const Distance len = middle - first;
+    for(RandomAccessIterator i = middle; i < last; ++i)
+    {
+        if(comp(*i, *first))
+        {
+            T value = *i;
+            *i = *first;
+            __dary_adjust_heap<2>(first, Distance(0), len, value, comp);
+        }
+    }
+    sort_heap(first, middle, comp);
+}
+
+template<class RandomAccessIterator>
+inline void partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+{
+    partial_sort(first, middle, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+// ========================================= nth_element
+// 使 *nth 为排序后应处于该位置的元素, 之前的元素都不大于它, 之后的都不小于它
+// introselect: 与sort相同的枢轴选择和分割, 只进入包含nth的一侧, 平均 O(n)
+// 不平衡次数超过 log(n) 后改用 partial_sort, 最坏 O(n log n)
+template<class RandomAccessIterator, class Compare>
+void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare comp)
+{
+    __STL_PERF_SCOPE("nth_element");
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    if(nth == last)
+        return;
+    Distance bad_allowed = __lg(last - first);
+    bool leftmost = true;
+    while(last - first >= __insertion_sort_threshold)
+    {
+        __choose_pivot(first, last, comp);
+        if(!leftmost && !comp(*(first - 1), *first))
+        {
+            // [first, pivot_pos] 都等于左边的元素, 已经在最终位置上
+            RandomAccessIterator pivot_pos = __partition_left(first, last, comp);
+            if(nth <= pivot_pos)
+                return;
+            first = pivot_pos + 1;
+            continue;
+        }
+
+        Distance size = last - first;
+        RandomAccessIterator pivot_pos = __partition_right(first, last, comp).first;
+        if(pivot_pos - first < size / 8 || last - (pivot_pos + 1) < size / 8)
+        {
+            if(--bad_allowed == 0)
+            {
+                partial_sort(first, nth + 1, last, comp);
+                return;
+            }
+        }
+
+        if(nth == pivot_pos)
+            return;
+        if(nth < pivot_pos)
+            last = pivot_pos;
+        else
+        {
+            first = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+    __insertion_sort(first, last, comp);
+}
+
+template<class RandomAccessIterator>
+inline void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+{
+    nth_element(first, nth, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+// ========================================= stable_sort
+// 自顶向下的归并排序, 小区间用插入排序(插入排序是稳定的)
+// 归并时只把左半部分复制到缓冲区(__merge_with_buffer), 缓冲区大小为区间长度的一半, 从alloc配置
+// 左半部分的最后一个元素不大于右半部分的第一个时跳过归并, 已经有序的输入为 O(n)
+
+enum { __stable_sort_chunk_size = 32 };
+
+template<class RandomAccessIterator, class Pointer, class Compare>
+void __stable_sort_adaptive(RandomAccessIterator first, RandomAccessIterator last, Pointer buffer, Compare comp)
+{
+    if(last - first <= __stable_sort_chunk_size)
+    {
+        __insertion_sort(first, last, comp);
+        return;
+    }
+    RandomAccessIterator middle = first + (last - first) / 2;
+    __stable_sort_adaptive(first, middle, buffer, comp);
+    __stable_sort_adaptive(middle, last, buffer, comp);
+    if(comp(*middle, *(middle - 1)))
+        __merge_with_buffer(first, middle, last, buffer, comp, random_access_iterator_tag());
+}
+
+template<class RandomAccessIterator, class Compare>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __STL_PERF_SCOPE("stable_sort");
+    typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+    if(last - first <= __stable_sort_chunk_size)
+    {
+        __insertion_sort(first, last, comp);
+        return;
+    }
+    temporary_buffer<T> buf((last - first) / 2);
+    __stable_sort_adaptive(first, last, buf.begin(), comp);
+}
+
+template<class RandomAccessIterator>
+inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    stable_sort(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+// ========================================= radix_sort
+// LSD基数排序: 把键值映射为保持大小顺序的无符号整数, 从低位到高位逐位做稳定的计数排序
+//   - 一次遍历统计出每一趟的直方图; 所有元素在某一趟的位上都相同时跳过这一趟(键值范围小时很常见)
+//   - 元素在原区间与缓冲区之间来回搬移, 缓冲区由 temporary_buffer 从alloc配置
+// 时间 O(n * sizeof(key)), 与比较次数无关, n较大时比比较排序快数倍; 排序是稳定的
+// 只用于指针区间(vector的迭代器就是指针), 元素必须是POD类型
+
+// 键值到无符号整数的保序映射, 只有算术类型提供
+template<class T>
+struct __radix_traits
+{
+    typedef __false_type is_radix_sortable;
+};
+
+// 无符号整数不需要变换
+#define __STL_RADIX_UNSIGNED(T)                                         \
+template<>                                                              \
+struct __radix_traits<T>                                                \
+{                                                                       \
+    typedef __true_type is_radix_sortable;                              \
+    typedef T key_type;                                                 \
+    static key_type to_key(T x)    {   return x;   }                    \
+};
+
+// 有符号整数翻转符号位, 负数排在正数前面
+#define __STL_RADIX_SIGNED(T, UT)                                       \
+template<>                                                              \
+struct __radix_traits<T>                                                \
+{                                                                       \
+    typedef __true_type is_radix_sortable;                              \
+    typedef UT key_type;                                                \
+    static key_type to_key(T x)                                         \
+    {                                                                   \
+        return key_type(x) ^ (key_type(1) << (sizeof(UT) * 8 - 1));     \
+    }                                                                   \
+};
+
+__STL_RADIX_UNSIGNED(unsigned char)
+__STL_RADIX_UNSIGNED(unsigned short)
+__STL_RADIX_UNSIGNED(unsigned int)
+__STL_RADIX_UNSIGNED(unsigned long)
+__STL_RADIX_UNSIGNED(unsigned long long)
+__STL_RADIX_SIGNED(signed char, unsigned char)
+__STL_RADIX_SIGNED(short, unsigned short)
+__STL_RADIX_SIGNED(int, unsigned int)
+__STL_RADIX_SIGNED(long, unsigned long)
+__STL_RADIX_SIGNED(long long, unsigned long long)
+
+#undef __STL_RADIX_UNSIGNED
+#undef __STL_RADIX_SIGNED
+
+template<>
+struct __radix_traits<bool>
+{
+    typedef __true_type is_radix_sortable;
+    typedef unsigned char key_type;
+    static key_type to_key(bool x)  {   return x;   }
+};
+
+// char是否有符号由实现决定
+template<>
+struct __radix_traits<char>
+{
+    typedef __true_type is_radix_sortable;
+    typedef unsigned char key_type;
+    static key_type to_key(char x)
+    {
+        return key_type(x) ^ (char(-1) < 0 ? 0x80 : 0);
+    }
+};
+
+// 浮点数: 正数翻转符号位, 负数翻转所有位, 得到的整数顺序与浮点数相同(-0.0排在0.0之前)
+template<>
+struct __radix_traits<float>
+{
+    typedef __true_type is_radix_sortable;
+    typedef unsigned int key_type;
+    static key_type to_key(float x)
+    {
+        key_type bits;
+        memcpy(&bits, &x, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+};
+
+template<>
+struct __radix_traits<double>
+{
+    typedef __true_type is_radix_sortable;
+    typedef unsigned long long key_type;
+    static key_type to_key(double x)
+    {
+        key_type bits;
+        memcpy(&bits, &x, sizeof(bits));
+        return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+    }
+};
+
+// 元素 -> 无符号键值; 降序时取反
+template<class Key, class KeyOfValue, class Descending>
+struct __radix_key_of_value
+{
+    typedef typename __radix_traits<Key>::key_type result_type;
+
+    KeyOfValue key_of_value;
+    __radix_key_of_value(const KeyOfValue& k) : key_of_value(k)   {}
+
+    template<class Value>
+    result_type operator()(const Value& v) const
+    {
+        return convert(__radix_traits<Key>::to_key(key_of_value(v)), Descending());
+    }
+
+    static result_type convert(result_type k, __false_type)   {   return k;   }
+    static result_type convert(result_type k, __true_type)    {   return ~k;  }
+};
+
+// n小于此值时比较排序更快
+enum { __radix_sort_threshold = 2048 };
+
+template<class Value, class RadixKey>
+void __radix_sort(Value* first, Value* last, Value* buffer, RadixKey key)
+{
+    __STL_PERF_SCOPE("radix_sort");
+    typedef typename RadixKey::result_type key_type;
+    // 超过16位的键值每趟处理11位: 64位键值6趟, 32位键值3趟, 直方图仍能放在L2中
+    enum { radix_bits = sizeof(key_type) > 2 ? 11 : 8 };
+    enum { radix = 1 << radix_bits };
+    enum { passes = (sizeof(key_type) * 8 + radix_bits - 1) / radix_bits };
+    const size_t n = last - first;
+
+    size_t count[passes][radix];
+    memset(count, 0, sizeof(count));
+    for(Value* p = first; p != last; ++p)
+    {
+        key_type k = key(*p);
+        for(int d = 0; d < passes; ++d)
+            ++count[d][(k >> (d * radix_bits)) & (radix - 1)];
+    }
+
+    Value* src = first;
+    Value* dst = buffer;
+    for(int d = 0; d < passes; ++d)
+    {
+        const int shift = d * radix_bits;
+        size_t* c = count[d];
+        // 所有元素这一位都相同, 顺序不变
+        if(c[(key(*first) >> shift) & (radix - 1)] == n)
+            continue;
+        size_t sum = 0;
+        for(int i = 0; i < radix; ++i)
+        {
+            size_t tmp = c[i];
+            c[i] = sum;
+            sum += tmp;
+        }
+        for(Value* p = src; p != src + n; ++p)
+            dst[c[(key(*p) >> shift) & (radix - 1)]++] = *p;
+        ::swap(src, dst);
+    }
+    if(src != first)
+        copy(src, src + n, first);
+}
+
+template<class Value, class RadixKey>
+inline void __radix_sort(Value* first, Value* last, RadixKey key)
+{
+    if(last - first < 2)
+        return;
+    temporary_buffer<Value> buf(last - first);
+    __radix_sort(first, last, buf.begin(), key);
+}
+
+template<class Key, class KeyOfValue>
+struct __key_of_value_compare
+{
+    KeyOfValue key_of_value;
+    __key_of_value_compare(const KeyOfValue& k) : key_of_value(k)   {}
+
+    template<class Value>
+    bool operator()(const Value& x, const Value& y) const
+    {
+        return key_of_value(x) < key_of_value(y);
+    }
+};
+
+// 按 key_of_value(元素) 升序稳定排序, 例如以 select1st 对pair按first排序
+// 元素不是POD时不能在缓冲区中随意搬移, 改用 stable_sort
+template<class Value, class KeyOfValue>
+inline void __radix_sort_records(Value* first, Value* last, KeyOfValue key_of_value, __true_type)
+{
+    typedef typename KeyOfValue::result_type Key;
+    __radix_sort(first, last, __radix_key_of_value<Key, KeyOfValue, __false_type>(key_of_value));
+}
+
+template<class Value, class KeyOfValue>
+inline void __radix_sort_records(Value* first, Value* last, KeyOfValue key_of_value, __false_type)
+{
+    typedef typename KeyOfValue::result_type Key;
+    stable_sort(first, last, __key_of_value_compare<Key, KeyOfValue>(key_of_value));
+}
+
+template<class Value, class KeyOfValue>
+inline void radix_sort(Value* first, Value* last, KeyOfValue key_of_value)
+{
+    typedef typename __type_traits<Value>::is_POD_type is_POD;
+    __radix_sort_records(first, last, key_of_value, is_POD());
+}
+
+template<class T>
+inline void radix_sort(T* first, T* last)
+{
+    __radix_sort(first, last, __radix_key_of_value<T, identity<T>, __false_type>(identity<T>()));
+}
+
+template<class T>
+inline void radix_sort(T* first, T* last, less<T>)
+{
+    radix_sort(first, last);
+}
+
+template<class T>
+inline void radix_sort(T* first, T* last, greater<T>)
+{
+    __radix_sort(first, last, __radix_key_of_value<T, identity<T>, __true_type>(identity<T>()));
+}
+
+// sort 对算术类型的分派: 元素足够多时用基数排序
+template<class T, class Compare, class Descending>
+inline void __sort_arithmetic(T* first, T* last, Compare comp, Descending, __true_type)
+{
+    if(last - first < __radix_sort_threshold)
+        __sort(first, last, comp);
+    else
+        __radix_sort(first, last, __radix_key_of_value<T, identity<T>, Descending>(identity<T>()));
+}
+
+template<class T, class Compare, class Descending>
+inline void __sort_arithmetic(T* first, T* last, Compare comp, Descending, __false_type)
+{
+    __sort(first, last, comp);
+}
+
+template<class T>
+inline __STL_CONSTEXPR14 void sort(T* first, T* last, less<T> comp)
+{
+    if(__STL_CONSTANT_EVALUATED())
+        return __constant_sort(first, last, comp);
+    typedef typename __radix_traits<T>::is_radix_sortable is_radix_sortable;
+    __sort_arithmetic(first, last, comp, __false_type(), is_radix_sortable());
+}
+
+template<class T>
+inline __STL_CONSTEXPR14 void sort(T* first, T* last, greater<T> comp)
+{
+    if(__STL_CONSTANT_EVALUATED())
+        return __constant_sort(first, last, comp);
+    typedef typename __radix_traits<T>::is_radix_sortable is_radix_sortable;
+    __sort_arithmetic(first, last, comp, __true_type(), is_radix_sortable());
+}
+
+template<class RandomAccessIterator>
+inline __STL_CONSTEXPR14 void sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    sort(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
 
 #endif // __STL_ALGO_H
\ No newline at end of file
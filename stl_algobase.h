@@ -1,5 +1,281 @@
 #ifndef __STL_ALGOBASE_H
 #define __STL_ALGOBASE_H
 
+#include <cstring>  // memmove, memset
+
+#include "stl_config.h"
+#include "stl_iterator.h"
+#include "type_traits.h"
+
+// 基本算法: 容器和其他算法都会用到的最基础的操作
+// min, max, swap, iter_swap
+// fill, fill_n, copy, copy_backward
+// equal, lexicographical_compare
+
+// ========================================= min, max
+template<class T>
+inline constexpr const T& min(const T& a, const T& b)
+{
+    return b < a ? b : a;
+}
+
+template<class T>
+inline constexpr const T& max(const T& a, const T& b)
+{
+    return a < b ? b : a;
+}
+
+template<class T, class Compare>
+inline constexpr const T& min(const T& a, const T& b, Compare comp)
+{
+    return comp(b, a) ? b : a;
+}
+
+template<class T, class Compare>
+inline constexpr const T& max(const T& a, const T& b, Compare comp)
+{
+    return comp(a, b) ? b : a;
+}
+
+// ========================================= swap, iter_swap
+template<class T>
+inline __STL_CONSTEXPR14 void swap(T& a, T& b)
+{
+    T tmp = a;
+    a = b;
+    b = tmp;
+}
+
+template<class ForwardIterator1, class ForwardIterator2, class T>
+inline __STL_CONSTEXPR14 void __iter_swap(ForwardIterator1 a, ForwardIterator2 b, T*)
+{
+    T tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+// 交换两个迭代器所指的对象
+template<class ForwardIterator1, class ForwardIterator2>
+inline __STL_CONSTEXPR14 void iter_swap(ForwardIterator1 a, ForwardIterator2 b)
+{
+    __iter_swap(a, b, value_type(a));
+}
+
+// ========================================= fill, fill_n
+template<class ForwardIterator, class T>
+__STL_CONSTEXPR14 void fill(ForwardIterator first, ForwardIterator last, const T& value)
+{
+    for(; first != last; ++first)
+        *first = value;
+}
+
+template<class OutputIterator, class Size, class T>
+__STL_CONSTEXPR14 OutputIterator fill_n(OutputIterator first, Size n, const T& value)
+{
+    for(; n > 0; --n, ++first)
+        *first = value;
+    return first;
+}
+
+// 单字节类型的特化版本, 直接使用memset
+inline void fill(char* first, char* last, const char& c)
+{
+    memset(first, c, last - first);
+}
+
+inline void fill(unsigned char* first, unsigned char* last, const unsigned char& c)
+{
+    memset(first, c, last - first);
+}
+
+inline void fill(signed char* first, signed char* last, const signed char& c)
+{
+    memset(first, c, last - first);
+}
+
+// ========================================= copy
+// 根据迭代器类型以及元素是否具有trivial assignment operator, 派送到最高效的版本
+
+// input iterator: 以迭代器是否相等决定循环是否继续, 速度慢
+template<class InputIterator, class OutputIterator>
+inline OutputIterator __copy(InputIterator first, InputIterator last, OutputIterator result, input_iterator_tag)
+{
+    for(; first != last; ++result, ++first)
+        *result = *first;
+    return result;
+}
+
+// random access iterator: 以n决定循环次数, 速度快
+template<class RandomAccessIterator, class OutputIterator, class Distance>
+inline OutputIterator __copy_d(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result, Distance*)
+{
+    for(Distance n = last - first; n > 0; --n, ++result, ++first)
+        *result = *first;
+    return result;
+}
+
+template<class RandomAccessIterator, class OutputIterator>
+inline OutputIterator __copy(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result, random_access_iterator_tag)
+{
+    return __copy_d(first, last, result, distance_type(first));
+}
+
+// 指针所指对象具有 trivial assignment operator, 直接memmove
+template<class T>
+inline T* __copy_t(const T* first, const T* last, T* result, __true_type)
+{
+    const ptrdiff_t n = last - first;
+    if(n > 0)   // 空区间的指针可能为空, 不能传给memmove
+        memmove(result, first, sizeof(T) * n);
+    return result + n;
+}
+
+template<class T>
+inline T* __copy_t(const T* first, const T* last, T* result, __false_type)
+{
+    return __copy_d(first, last, result, (ptrdiff_t*)0);
+}
+
+// 泛化版本
+template<class InputIterator, class OutputIterator>
+struct __copy_dispatch
+{
+    OutputIterator operator()(InputIterator first, InputIterator last, OutputIterator result)
+    {
+        return __copy(first, last, result, iterator_category(first));
+    }
+};
+
+// 偏特化版本, 两个参数都是 T* 指针
+template<class T>
+struct __copy_dispatch<T*, T*>
+{
+    T* operator()(T* first, T* last, T* result)
+    {
+        typedef typename __type_traits<T>::has_trivial_assignment_operator t;
+        return __copy_t(first, last, result, t());
+    }
+};
+
+// 偏特化版本, 第一个参数是 const T* 指针, 第二个参数是 T* 指针
+template<class T>
+struct __copy_dispatch<const T*, T*>
+{
+    T* operator()(const T* first, const T* last, T* result)
+    {
+        typedef typename __type_traits<T>::has_trivial_assignment_operator t;
+        return __copy_t(first, last, result, t());
+    }
+};
+
+// 将 [first, last) 复制到 [result, result + (last - first))
+template<class InputIterator, class OutputIterator>
+inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result)
+{
+    return __copy_dispatch<InputIterator, OutputIterator>()(first, last, result);
+}
+
+inline char* copy(const char* first, const char* last, char* result)
+{
+    if(first != last)
+        memmove(result, first, last - first);
+    return result + (last - first);
+}
+
+inline wchar_t* copy(const wchar_t* first, const wchar_t* last, wchar_t* result)
+{
+    if(first != last)
+        memmove(result, first, sizeof(wchar_t) * (last - first));
+    return result + (last - first);
+}
+
+// ========================================= copy_backward
+// 从后往前复制, 用于目的区间与源区间重叠且目的区间在后的情况
+template<class BidirectionalIterator1, class BidirectionalIterator2>
+inline BidirectionalIterator2 __copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                              BidirectionalIterator2 result, __false_type)
+{
+    while(first != last)
+        *--result = *--last;
+    return result;
+}
+
+template<class T>
+inline T* __copy_backward(const T* first, const T* last, T* result, __true_type)
+{
+    const ptrdiff_t n = last - first;
+    if(n > 0)
+        memmove(result - n, first, sizeof(T) * n);
+    return result - n;
+}
+
+template<class BidirectionalIterator1, class BidirectionalIterator2>
+inline BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                            BidirectionalIterator2 result)
+{
+    return __copy_backward(first, last, result, __false_type());
+}
+
+template<class T>
+inline T* copy_backward(T* first, T* last, T* result)
+{
+    typedef typename __type_traits<T>::has_trivial_assignment_operator t;
+    return __copy_backward((const T*)first, (const T*)last, result, t());
+}
+
+template<class T>
+inline T* copy_backward(const T* first, const T* last, T* result)
+{
+    typedef typename __type_traits<T>::has_trivial_assignment_operator t;
+    return __copy_backward(first, last, result, t());
+}
+
+// ========================================= equal, lexicographical_compare
+template<class InputIterator1, class InputIterator2>
+inline __STL_CONSTEXPR14 bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    for(; first1 != last1; ++first1, ++first2)
+        if(!(*first1 == *first2))
+            return false;
+    return true;
+}
+
+template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+inline __STL_CONSTEXPR14 bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred)
+{
+    for(; first1 != last1; ++first1, ++first2)
+        if(!pred(*first1, *first2))
+            return false;
+    return true;
+}
+
+// 字典序比较 [first1, last1) < [first2, last2)
+template<class InputIterator1, class InputIterator2>
+__STL_CONSTEXPR14 bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                             InputIterator2 first2, InputIterator2 last2)
+{
+    for(; first1 != last1 && first2 != last2; ++first1, ++first2)
+    {
+        if(*first1 < *first2)
+            return true;
+        if(*first2 < *first1)
+            return false;
+    }
+    return first1 == last1 && first2 != last2;
+}
+
+template<class InputIterator1, class InputIterator2, class Compare>
+__STL_CONSTEXPR14 bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                             InputIterator2 first2, InputIterator2 last2, Compare comp)
+{
+    for(; first1 != last1 && first2 != last2; ++first1, ++first2)
+    {
+        if(comp(*first1, *first2))
+            return true;
+        if(comp(*first2, *first1))
+            return false;
+    }
+    return first1 == last1 && first2 != last2;
+}
 
 #endif // __STL_ALGOBASE_H
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <cstring> // memcpy
 #include <iostream>
 
+#include "stl_config.h"
+
 // 内存空间不足, 并且没有设置malloc_handler时采取的动作
 #define __THROW_BAD_ALLOC exit(1)
 
@@ -32,6 +34,29 @@ public:
     {
         Alloc::deallocate(p, sizeof(T));
     }
+    // 把n个对象的空间调整为new_n个, 保留前 min(n, new_n) 个对象的内容
+    // 内容按字节复制(大块直接realloc), 只适用于可以按字节搬移的类型
+    static T* reallocate(T* p, size_t n, size_t new_n)
+    {
+        if(0 == n)
+            return allocate(new_n);
+        if(0 == new_n)
+        {
+            deallocate(p, n);
+            return NULL;
+        }
+        return (T*)Alloc::reallocate(p, n * sizeof(T), new_n * sizeof(T));
+    }
+    // 批量分配n个对象, 以每个对象开头的指针大小空间串成单链表返回, 链表以NULL结尾
+    static T* allocate_chain(size_t n)
+    {
+        return 0 == n ? NULL : (T*)Alloc::allocate_chain(sizeof(T), n);
+    }
+    // [first, last] 是以对象开头的指针串起来的链表, 整条链一次归还
+    static void deallocate_chain(T* first, T* last)
+    {
+        Alloc::deallocate_chain(first, last, sizeof(T));
+    }
 };
 
 // ==============================================  一级分配器
@@ -69,6 +94,30 @@ public:
             result = oom_realloc(p, new_sz);
         return result;
     }
+    // 批量分配count个n字节的区块, 以区块开头的指针串成单链表
+    static void* allocate_chain(size_t n, size_t count)
+    {
+        void* head = NULL;
+        while(count--)
+        {
+            void** p = (void**)allocate(n);
+            *p = head;
+            head = p;
+        }
+        return head;
+    }
+    static void deallocate_chain(void* first, void* last, size_t)
+    {
+        for(;;)
+        {
+            bool done = (first == last);
+            void* next = *(void**)first;
+            free(first);
+            if(done)
+                break;
+            first = next;
+        }
+    }
     // 模拟new_hander, set_new_handler, 客户端指定内存不足时的处理例程
     // static void (* set_malloc_handler(void (*f)()))()  看不懂???
     static malloc_handler set_malloc_handler(malloc_handler f)
@@ -210,6 +259,53 @@ public:
         deallocate(p, old_sz);
         return result;
     }
+
+    // 批量分配count个n字节的区块, 以obj::next串成单链表返回, 链表以NULL结尾
+    // 先整段取走自由链表上现有的区块, 不够时直接从暂备池切出连续的空间, 不必逐个弹出
+    static void* allocate_chain(size_t n, size_t count)
+    {
+        if(n > (size_t) __MAX_BYTES)
+            return malloc_alloc::allocate_chain(n, count);
+
+        n = ROUND_UP(n);
+        obj* head = nullptr;
+        obj** tail = &head;
+        obj** my_free_list = free_list + FREELIST_INDEX(n);
+        while(count > 0 && *my_free_list != nullptr)
+        {
+            *tail = *my_free_list;
+            tail = &(*tail)->next;
+            *my_free_list = *tail;
+            --count;
+        }
+        while(count > 0)
+        {
+            int nobjs = count > 128 ? 128 : (int)count;
+            char* chunk = chunk_alloc(n, nobjs);    // 可能少于要求的个数
+            for(int i = 0; i < nobjs; ++i)
+            {
+                obj* cur = (obj*)(chunk + i * n);
+                *tail = cur;
+                tail = &cur->next;
+            }
+            count -= nobjs;
+        }
+        *tail = nullptr;
+        return head;
+    }
+
+    // [first, last] 是以obj::next串起来的区块链表, 整条链一次接到自由链表头部, O(1)
+    static void deallocate_chain(void* first, void* last, size_t n)
+    {
+        if(n > (size_t)__MAX_BYTES)
+        {
+            malloc_alloc::deallocate_chain(first, last, n);
+            return;
+        }
+        obj** my_free_list = free_list + FREELIST_INDEX(n);
+        ((obj*)last)->next = *my_free_list;
+        *my_free_list = (obj*)first;
+    }
 };
 
 // 静态数据成员的定义
@@ -231,6 +327,7 @@ __default_alloc_template<threads, inst>::free_list[__NFREELISTS] = {0, 0, 0, 0,
 template <bool threads, int inst>
 char* __default_alloc_template<threads, inst>::chunk_alloc(size_t size, int &nobjs)
 {
+    __STL_PERF_SCOPE("chunk_alloc");
     char *result;
     size_t total_bytes = size * nobjs;
     size_t bytes_left = end_free - start_free;
@@ -296,6 +393,7 @@ char* __default_alloc_template<threads, inst>::chunk_alloc(size_t size, int &nob
 template <bool threads, int inst>
 void* __default_alloc_template<threads, inst>::refill(size_t n)
 {
+    __STL_PERF_SCOPE("refill");
     int nobjs = 20;
     char* chunk = chunk_alloc(n, nobjs);    // 向暂备池要空间
     if(1 == nobjs)
@@ -313,7 +411,7 @@ void* __default_alloc_template<threads, inst>::refill(size_t n)
         cur = next;
         next = (obj*)((char*)cur + n);
         if(i == nobjs - 1)
-            cur->next == nullptr;
+            cur->next = nullptr;
         else
             cur->next = next;
     }
@@ -0,0 +1,873 @@
+#ifndef __STL_BTREE_H
+#define __STL_BTREE_H
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_iterator.h"
+#include "stl_pair.h"
+#include "stl_uninitialized.h"
+#include "type_traits.h"
+
+// B树, map / set / multimap 的底层实现, 接口与SGI的rb_tree保持一致
+// 红黑树每个节点只存放一个元素, 查找时每向下一层就是一次指针跳转和一次缓存未命中
+// B树每个节点连续存放多个元素, 节点大小按缓存行调整(约256字节), 树高只有红黑树的 1/4 左右,
+// 节点内部二分查找只访问少数几条缓存行, 顺序遍历基本是连续访问, 每个元素也不需要额外的指针开销
+//
+// 节点结构:
+//   叶子节点:  parent | position | count | leaf | values[node_values]
+//   内部节点:  叶子节点的所有字段 + children[node_values + 1]
+// values[i] 位于 children[i] 与 children[i + 1] 之间
+// 除根节点外, 每个节点至少有 min_node_values 个元素
+
+static const size_t __btree_target_node_size = 256;
+
+template<class Value>
+struct __btree_node
+{
+    typedef __btree_node<Value>* node_ptr;
+
+    // 每个节点存放的元素个数, 至少为3
+    enum { node_values = (__btree_target_node_size - 2 * sizeof(void*)) / sizeof(Value) > 3 ?
+                         (__btree_target_node_size - 2 * sizeof(void*)) / sizeof(Value) : 3 };
+    enum { min_node_values = node_values / 2 };
+
+    node_ptr parent;            // 根节点的parent为空
+    unsigned short position;    // 在父节点children中的下标
+    unsigned short count;       // 元素个数
+    bool leaf;
+    alignas(Value) unsigned char data[node_values * sizeof(Value)];   // 元素在其中原地构造
+
+    Value* values()             {   return reinterpret_cast<Value*>(data);  }
+    Value& value(size_t i)      {   return values()[i]; }
+
+    node_ptr& child(size_t i);
+    void set_child(size_t i, node_ptr c)
+    {
+        child(i) = c;
+        c->parent = this;
+        c->position = (unsigned short)i;
+    }
+};
+
+template<class Value>
+struct __btree_internal_node : public __btree_node<Value>
+{
+    __btree_node<Value>* children[__btree_node<Value>::node_values + 1];
+};
+
+// 只能在内部节点上调用
+template<class Value>
+inline typename __btree_node<Value>::node_ptr& __btree_node<Value>::child(size_t i)
+{
+    return static_cast<__btree_internal_node<Value>*>(this)->children[i];
+}
+
+// 将 [first, last) 的元素搬移到 result 开始的未初始化空间, 源对象随后被销毁, 区间可以重叠
+template<class T>
+inline void __btree_relocate_aux(T* first, T* last, T* result, __true_type)
+{
+    memmove(result, first, sizeof(T) * (last - first));
+}
+
+template<class T>
+void __btree_relocate_aux(T* first, T* last, T* result, __false_type)
+{
+    if(result < first)
+    {
+        for(; first != last; ++first, ++result)
+        {
+            construct(result, *first);
+            destroy(first);
+        }
+    }
+    else if(result > first)
+    {
+        result += last - first;
+        while(first != last)
+        {
+            construct(--result, *--last);
+            destroy(last);
+        }
+    }
+}
+
+template<class T>
+inline void __btree_relocate(T* first, T* last, T* result)
+{
+    typedef typename __type_traits<T>::is_POD_type is_POD;
+    __btree_relocate_aux(first, last, result, is_POD());
+}
+
+
+// ========================================= B树的迭代器
+// (节点, 节点内下标), end() 为 (最右叶子节点, 元素个数)
+template<class Value, class Ref, class Ptr>
+struct __btree_iterator
+{
+    typedef __btree_iterator<Value, Value&, Value*> iterator;
+    typedef __btree_iterator<Value, const Value&, const Value*> const_iterator;
+    typedef __btree_iterator<Value, Ref, Ptr> self;
+    typedef __btree_node<Value>* node_ptr;
+
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+
+    node_ptr node;
+    size_t position;
+
+    __btree_iterator() : node(0), position(0)   {}
+    __btree_iterator(node_ptr x, size_t pos) : node(x), position(pos)   {}
+    __btree_iterator(const iterator& x) : node(x.node), position(x.position)    {}
+    // 对 iterator 来说上一行就是复制构造函数, 复制赋值需要显式声明
+    self& operator=(const self& x) = default;
+
+    reference operator*() const {   return node->value(position);   }
+    pointer operator->() const  {   return &node->value(position);  }
+
+    bool operator==(const self& x) const    {   return node == x.node && position == x.position;    }
+    bool operator!=(const self& x) const    {   return !(*this == x);   }
+
+    self& operator++()  {   increment(); return *this;  }
+    self operator++(int)
+    {
+        self tmp = *this;
+        increment();
+        return tmp;
+    }
+    self& operator--()  {   decrement(); return *this;  }
+    self operator--(int)
+    {
+        self tmp = *this;
+        decrement();
+        return tmp;
+    }
+
+    void increment()
+    {
+        if(node->leaf)
+        {
+            if(++position < node->count)
+                return;
+            // 叶子节点已走完, 向上找到第一个还有后续元素的祖先
+            self save = *this;
+            while(position == node->count && node->parent != 0)
+            {
+                position = node->position;
+                node = node->parent;
+            }
+            if(position == node->count) // 已经是最后一个元素, 停在end()
+                *this = save;
+        }
+        else
+        {
+            // 内部节点的后继是右子树的最左元素
+            node = node->child(position + 1);
+            while(!node->leaf)
+                node = node->child(0);
+            position = 0;
+        }
+    }
+
+    void decrement()
+    {
+        if(node->leaf)
+        {
+            if(position > 0)
+            {
+                --position;
+                return;
+            }
+            self save = *this;
+            while(position == 0 && node->parent != 0)
+            {
+                position = node->position;
+                node = node->parent;
+            }
+            if(position == 0)   // begin() 再向前, 保持不动
+                *this = save;
+            else
+                --position;
+        }
+        else
+        {
+            // 内部节点的前驱是左子树的最右元素
+            node = node->child(position);
+            while(!node->leaf)
+                node = node->child(node->count);
+            position = node->count - 1;
+        }
+    }
+};
+
+
+// ========================================= B树
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = alloc>
+class btree
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __btree_iterator<Value, Value&, Value*> iterator;
+    typedef __btree_iterator<Value, const Value&, const Value*> const_iterator;
+
+protected:
+    typedef __btree_node<Value> node_type;
+    typedef __btree_internal_node<Value> internal_node_type;
+    typedef node_type* node_ptr;
+    typedef simple_alloc<node_type, Alloc> leaf_node_allocator;
+    typedef simple_alloc<internal_node_type, Alloc> internal_node_allocator;
+
+    enum { node_values = node_type::node_values };
+    enum { min_node_values = node_type::min_node_values };
+
+    node_ptr root;
+    node_ptr leftmost;      // begin() 所在的叶子节点
+    node_ptr rightmost;     // end() 所在的叶子节点
+    size_type node_count;   // 元素个数
+    Compare key_compare;
+
+public:
+    explicit btree(const Compare& comp = Compare())
+        : root(0), leftmost(0), rightmost(0), node_count(0), key_compare(comp) {}
+
+    btree(const btree& x)
+        : root(0), leftmost(0), rightmost(0), node_count(0), key_compare(x.key_compare)
+    {
+        if(x.root != 0)
+        {
+            root = copy_node(x.root, 0);
+            node_count = x.node_count;
+            update_extremes();
+        }
+    }
+
+    btree& operator=(const btree& x)
+    {
+        if(this != &x)
+        {
+            btree tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~btree()    {   clear();    }
+
+public:
+    Compare key_comp() const    {   return key_compare; }
+
+    iterator begin()    {   return iterator(leftmost, 0);   }
+    iterator end()      {   return iterator(rightmost, rightmost == 0 ? 0 : rightmost->count);  }
+    const_iterator begin() const    {   return const_iterator(leftmost, 0); }
+    const_iterator end() const      {   return const_iterator(rightmost, rightmost == 0 ? 0 : rightmost->count);    }
+
+    bool empty() const          {   return node_count == 0; }
+    size_type size() const      {   return node_count;  }
+    size_type max_size() const  {   return size_type(-1) / sizeof(value_type);  }
+
+    void swap(btree& t)
+    {
+        ::swap(root, t.root);
+        ::swap(leftmost, t.leftmost);
+        ::swap(rightmost, t.rightmost);
+        ::swap(node_count, t.node_count);
+        ::swap(key_compare, t.key_compare);
+    }
+
+    void clear()
+    {
+        if(root != 0)
+        {
+            delete_subtree(root);
+            root = leftmost = rightmost = 0;
+            node_count = 0;
+        }
+    }
+
+public:
+    // 键值不允许重复
+    pair<iterator, bool> insert_unique(const value_type& v)
+    {
+        if(root == 0)
+            new_root();
+        iterator pos = locate_lower_bound(KeyOfValue()(v));
+        iterator last = internal_last(pos);
+        if(last.node != 0 && !key_compare(KeyOfValue()(v), key(last)))
+            return pair<iterator, bool>(last, false);
+        return pair<iterator, bool>(internal_insert(pos, v), true);
+    }
+
+    // 键值可以重复, 插入到所有等价元素之后
+    iterator insert_equal(const value_type& v)
+    {
+        if(root == 0)
+            new_root();
+        return internal_insert(locate_upper_bound(KeyOfValue()(v)), v);
+    }
+
+    // 带提示位置的插入, v 恰好应该放在 hint 之前时不需要从根节点查找
+    // 有序序列的批量插入每次都以 end() 为提示, 均摊O(1)
+    iterator insert_unique(iterator hint, const value_type& v)
+    {
+        if(fits_before(hint, v, true))
+            return internal_insert(hint, v);
+        return insert_unique(v).first;
+    }
+
+    iterator insert_equal(iterator hint, const value_type& v)
+    {
+        if(fits_before(hint, v, false))
+            return internal_insert(hint, v);
+        return insert_equal(v);
+    }
+
+    template<class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+        for(; first != last; ++first)
+            insert_unique(end(), *first);
+    }
+
+    template<class InputIterator>
+    void insert_equal(InputIterator first, InputIterator last)
+    {
+        for(; first != last; ++first)
+            insert_equal(end(), *first);
+    }
+
+    // 删除元素, 返回下一个元素的迭代器, 其他迭代器全部失效
+    iterator erase(iterator it)
+    {
+        bool internal_delete = !it.node->leaf;
+        if(internal_delete)
+        {
+            // 内部节点的元素用其前驱(必定在叶子节点上)替换, 转化为删除叶子节点上的元素
+            iterator internal_it = it;
+            --it;
+            destroy(&*internal_it);
+            construct(&*internal_it, *it);
+        }
+        remove_value(it.node, it.position);
+        --node_count;
+
+        iterator res = rebalance_after_delete(it);
+        if(internal_delete && res.node != 0)
+            ++res;
+        return res.node == 0 ? end() : res;
+    }
+
+    size_type erase(const key_type& k)
+    {
+        pair<iterator, iterator> p = equal_range(k);
+        size_type n = distance(p.first, p.second);
+        erase(p.first, p.second);
+        return n;
+    }
+
+    void erase(iterator first, iterator last)
+    {
+        if(first == begin() && last == end())
+        {
+            clear();
+            return;
+        }
+        for(size_type n = distance(first, last); n > 0; --n)
+            first = erase(first);
+    }
+
+public:
+    iterator find(const key_type& k)
+    {
+        iterator j = lower_bound(k);
+        return (j == end() || key_compare(k, key(j))) ? end() : j;
+    }
+    const_iterator find(const key_type& k) const
+    {
+        const_iterator j = lower_bound(k);
+        return (j == end() || key_compare(k, key(j))) ? end() : j;
+    }
+
+    size_type count(const key_type& k) const
+    {
+        pair<const_iterator, const_iterator> p = equal_range(k);
+        return distance(p.first, p.second);
+    }
+
+    iterator lower_bound(const key_type& k)
+    {
+        if(root == 0)
+            return end();
+        iterator it = internal_last(locate_lower_bound(k));
+        return it.node == 0 ? end() : it;
+    }
+    const_iterator lower_bound(const key_type& k) const
+    {
+        return const_cast<btree*>(this)->lower_bound(k);
+    }
+
+    iterator upper_bound(const key_type& k)
+    {
+        if(root == 0)
+            return end();
+        iterator it = internal_last(locate_upper_bound(k));
+        return it.node == 0 ? end() : it;
+    }
+    const_iterator upper_bound(const key_type& k) const
+    {
+        return const_cast<btree*>(this)->upper_bound(k);
+    }
+
+    pair<iterator, iterator> equal_range(const key_type& k)
+    {
+        return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+    {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+
+protected:
+    static const key_type& key(const value_type& v)     {   return KeyOfValue()(v); }
+    static const key_type& key(const iterator& it)      {   return KeyOfValue()(*it);   }
+    static const key_type& key(const const_iterator& it)    {   return KeyOfValue()(*it);   }
+
+    // ================================ 节点的分配与释放
+    static node_ptr new_leaf_node(node_ptr parent)
+    {
+        node_ptr x = leaf_node_allocator::allocate();
+        x->parent = parent;
+        x->position = 0;
+        x->count = 0;
+        x->leaf = true;
+        return x;
+    }
+
+    static node_ptr new_internal_node(node_ptr parent)
+    {
+        node_ptr x = internal_node_allocator::allocate();
+        x->parent = parent;
+        x->position = 0;
+        x->count = 0;
+        x->leaf = false;
+        return x;
+    }
+
+    static void delete_node(node_ptr x)
+    {
+        if(x->leaf)
+            leaf_node_allocator::deallocate(x);
+        else
+            internal_node_allocator::deallocate(static_cast<internal_node_type*>(x));
+    }
+
+    static void delete_subtree(node_ptr x)
+    {
+        if(!x->leaf)
+            for(size_t i = 0; i <= x->count; ++i)
+                delete_subtree(x->child(i));
+        destroy(x->values(), x->values() + x->count);
+        delete_node(x);
+    }
+
+    static node_ptr copy_node(node_ptr x, node_ptr parent)
+    {
+        node_ptr y = x->leaf ? new_leaf_node(parent) : new_internal_node(parent);
+        uninitialized_copy(x->values(), x->values() + x->count, y->values());
+        y->count = x->count;
+        if(!x->leaf)
+            for(size_t i = 0; i <= x->count; ++i)
+                y->set_child(i, copy_node(x->child(i), y));
+        return y;
+    }
+
+    void new_root()
+    {
+        root = leftmost = rightmost = new_leaf_node(0);
+    }
+
+    // 只在复制整棵树后调用; 插入与删除时只有最右叶子节点分裂或被合并才需要更新, 见 split_for_insert 与 merge_nodes
+    void update_extremes()
+    {
+        if(root == 0)
+        {
+            leftmost = rightmost = 0;
+            return;
+        }
+        for(leftmost = root; !leftmost->leaf; leftmost = leftmost->child(0))   {}
+        for(rightmost = root; !rightmost->leaf; rightmost = rightmost->child(rightmost->count)) {}
+    }
+
+    // ================================ 查找
+    size_t node_lower_bound(node_ptr x, const key_type& k) const
+    {
+        size_t lo = 0, hi = x->count;
+        while(lo < hi)
+        {
+            size_t mid = (lo + hi) >> 1;
+            if(key_compare(key(x->value(mid)), k))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    size_t node_upper_bound(node_ptr x, const key_type& k) const
+    {
+        size_t lo = 0, hi = x->count;
+        while(lo < hi)
+        {
+            size_t mid = (lo + hi) >> 1;
+            if(key_compare(k, key(x->value(mid))))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // 自根向下查找, 停在叶子节点上, 返回的位置可能等于叶子节点的count
+    iterator locate_lower_bound(const key_type& k) const
+    {
+        node_ptr x = root;
+        for(;;)
+        {
+            size_t i = node_lower_bound(x, k);
+            if(x->leaf)
+                return iterator(x, i);
+            x = x->child(i);
+        }
+    }
+
+    iterator locate_upper_bound(const key_type& k) const
+    {
+        node_ptr x = root;
+        for(;;)
+        {
+            size_t i = node_upper_bound(x, k);
+            if(x->leaf)
+                return iterator(x, i);
+            x = x->child(i);
+        }
+    }
+
+    // 位置越过节点末尾时, 向上找到真正的后继元素, 没有后继时返回的node为空
+    static iterator internal_last(iterator it)
+    {
+        while(it.node != 0 && it.position == it.node->count)
+        {
+            it.position = it.node->position;
+            it.node = it.node->parent;
+        }
+        return it;
+    }
+
+    // v 是否可以直接插入到 hint 之前
+    bool fits_before(iterator hint, const value_type& v, bool unique)
+    {
+        if(root == 0 || node_count == 0)
+            return false;
+        const key_type& k = KeyOfValue()(v);
+        if(hint != end())
+        {
+            if(unique ? !key_compare(k, key(hint)) : key_compare(key(hint), k))
+                return false;
+        }
+        if(hint != begin())
+        {
+            iterator prev = hint;
+            --prev;
+            if(unique ? !key_compare(key(prev), k) : key_compare(k, key(prev)))
+                return false;
+        }
+        return true;
+    }
+
+    // ================================ 插入
+    // 在节点的第i个位置插入元素, 内部节点的孩子[i + 1, count] 同时后移, children[i + 1] 由调用者设置
+    static void insert_value(node_ptr x, size_t i, const value_type& v)
+    {
+        __btree_relocate(x->values() + i, x->values() + x->count, x->values() + i + 1);
+        construct(x->values() + i, v);
+        if(!x->leaf)
+            for(size_t j = x->count + 1; j > i + 1; --j)
+                x->set_child(j, x->child(j - 1));
+        ++x->count;
+    }
+
+    // 在 it 之前插入, 插入总是发生在叶子节点上
+    iterator internal_insert(iterator it, const value_type& v)
+    {
+        if(!it.node->leaf)
+        {
+            --it;
+            ++it.position;
+        }
+        if(it.node->count == node_values)
+            split_for_insert(it);
+        insert_value(it.node, it.position, v);
+        ++node_count;
+        return it;
+    }
+
+    // 节点已满, 分裂出右兄弟节点, 并调整插入位置
+    void split_for_insert(iterator& it)
+    {
+        node_ptr x = it.node;
+        size_t insert_position = it.position;
+        node_ptr parent = x->parent;
+        if(parent == 0)     // 根节点分裂, 树高加1
+        {
+            parent = new_internal_node(0);
+            parent->set_child(0, x);
+            root = parent;
+        }
+        else if(parent->count == node_values)
+        {
+            iterator parent_it(parent, x->position);
+            split_for_insert(parent_it);
+            parent = x->parent;
+        }
+        node_ptr dest = x->leaf ? new_leaf_node(parent) : new_internal_node(parent);
+        split(x, insert_position, dest);
+        // 分裂总是把后半部分移到新的右兄弟, 最左叶子节点不变
+        if(x == rightmost)
+            rightmost = dest;
+        if(insert_position > x->count)
+        {
+            insert_position -= x->count + 1;
+            x = dest;
+        }
+        it = iterator(x, insert_position);
+    }
+
+    // 根据插入位置决定分裂点: 在末尾插入(顺序插入)时左节点保持满载, 在开头插入时右节点保持满载
+    static void split(node_ptr x, size_t insert_position, node_ptr dest)
+    {
+        size_t dest_count;
+        if(insert_position == 0)
+            dest_count = x->count - 1;
+        else if(insert_position == node_values)
+            dest_count = 0;
+        else
+            dest_count = x->count / 2;
+
+        // 后半部分搬到右兄弟
+        __btree_relocate(x->values() + x->count - dest_count, x->values() + x->count, dest->values());
+        dest->count = (unsigned short)dest_count;
+        x->count = (unsigned short)(x->count - dest_count - 1);
+
+        // 左节点剩余的最大元素作为分隔值放到父节点上
+        node_ptr parent = x->parent;
+        insert_value(parent, x->position, x->value(x->count));
+        destroy(x->values() + x->count);
+        parent->set_child(x->position + 1, dest);
+
+        if(!x->leaf)
+            for(size_t i = 0; i <= dest_count; ++i)
+                dest->set_child(i, x->child(x->count + 1 + i));
+    }
+
+    // ================================ 删除
+    static void remove_value(node_ptr x, size_t i)
+    {
+        destroy(x->values() + i);
+        __btree_relocate(x->values() + i + 1, x->values() + x->count, x->values() + i);
+        --x->count;
+    }
+
+    // 将右兄弟以及父节点中的分隔值合并到左节点, 释放右兄弟; 被释放的总是右边的节点, 最左叶子节点不变
+    void merge_nodes(node_ptr left, node_ptr right)
+    {
+        node_ptr parent = left->parent;
+        size_t pos = left->position;
+        __btree_relocate(parent->values() + pos, parent->values() + pos + 1, left->values() + left->count);
+        __btree_relocate(right->values(), right->values() + right->count, left->values() + left->count + 1);
+        if(!left->leaf)
+            for(size_t i = 0; i <= right->count; ++i)
+                left->set_child(left->count + 1 + i, right->child(i));
+        left->count = (unsigned short)(left->count + 1 + right->count);
+
+        // 父节点删除分隔值以及指向右兄弟的孩子
+        __btree_relocate(parent->values() + pos + 1, parent->values() + parent->count, parent->values() + pos);
+        for(size_t j = pos + 1; j < parent->count; ++j)
+            parent->set_child(j, parent->child(j + 1));
+        --parent->count;
+        if(right == rightmost)
+            rightmost = left;
+        delete_node(right);
+    }
+
+    // 从右兄弟借 to_move 个元素给左节点
+    static void rebalance_right_to_left(node_ptr left, node_ptr right, size_t to_move)
+    {
+        node_ptr parent = left->parent;
+        size_t pos = left->position;
+        // 父节点的分隔值下移到左节点, 右兄弟的 to_move - 1 个元素移到左节点
+        __btree_relocate(parent->values() + pos, parent->values() + pos + 1, left->values() + left->count);
+        __btree_relocate(right->values(), right->values() + to_move - 1, left->values() + left->count + 1);
+        // 右兄弟的第 to_move 个元素成为新的分隔值
+        __btree_relocate(right->values() + to_move - 1, right->values() + to_move, parent->values() + pos);
+        __btree_relocate(right->values() + to_move, right->values() + right->count, right->values());
+        if(!left->leaf)
+        {
+            for(size_t i = 0; i < to_move; ++i)
+                left->set_child(left->count + 1 + i, right->child(i));
+            for(size_t i = 0; i <= right->count - to_move; ++i)
+                right->set_child(i, right->child(i + to_move));
+        }
+        left->count = (unsigned short)(left->count + to_move);
+        right->count = (unsigned short)(right->count - to_move);
+    }
+
+    // 从左兄弟借 to_move 个元素给右节点
+    static void rebalance_left_to_right(node_ptr left, node_ptr right, size_t to_move)
+    {
+        node_ptr parent = left->parent;
+        size_t pos = left->position;
+        __btree_relocate(right->values(), right->values() + right->count, right->values() + to_move);
+        __btree_relocate(parent->values() + pos, parent->values() + pos + 1, right->values() + to_move - 1);
+        __btree_relocate(left->values() + left->count - (to_move - 1), left->values() + left->count, right->values());
+        __btree_relocate(left->values() + left->count - to_move, left->values() + left->count - (to_move - 1),
+                         parent->values() + pos);
+        if(!left->leaf)
+        {
+            for(size_t i = right->count + 1; i > 0; --i)
+                right->set_child(i - 1 + to_move, right->child(i - 1));
+            for(size_t i = 1; i <= to_move; ++i)
+                right->set_child(i - 1, left->child(left->count - to_move + i));
+        }
+        left->count = (unsigned short)(left->count - to_move);
+        right->count = (unsigned short)(right->count + to_move);
+    }
+
+    // 元素个数不足的节点与兄弟合并或者从兄弟借元素, it 随元素的移动而调整
+    // 返回true表示发生了合并, 父节点的元素个数减少了
+    bool try_merge_or_rebalance(iterator& it)
+    {
+        node_ptr x = it.node;
+        node_ptr parent = x->parent;
+        if(x->position > 0)
+        {
+            node_ptr left = parent->child(x->position - 1);
+            if(1u + left->count + x->count <= (size_t)node_values)
+            {
+                it.position += 1 + left->count;
+                merge_nodes(left, x);
+                it.node = left;
+                return true;
+            }
+        }
+        if(x->position < parent->count)
+        {
+            node_ptr right = parent->child(x->position + 1);
+            if(1u + x->count + right->count <= (size_t)node_values)
+            {
+                merge_nodes(x, right);
+                return true;
+            }
+            // 删除的是节点的第一个元素时不借, 从头部连续删除的场景可以少搬移元素
+            if(right->count > (size_t)min_node_values && (x->count == 0 || it.position > 0))
+            {
+                size_t to_move = (right->count - x->count) / 2;
+                to_move = min(to_move, size_t(right->count - 1));
+                rebalance_right_to_left(x, right, to_move);
+                return false;
+            }
+        }
+        if(x->position > 0)
+        {
+            // 删除的是节点的最后一个元素时不借, 从尾部连续删除的场景可以少搬移元素
+            node_ptr left = parent->child(x->position - 1);
+            if(left->count > (size_t)min_node_values && (x->count == 0 || it.position < x->count))
+            {
+                size_t to_move = (left->count - x->count) / 2;
+                to_move = min(to_move, size_t(left->count - 1));
+                rebalance_left_to_right(left, x, to_move);
+                it.position += to_move;
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // 根节点没有元素时树高减1
+    void try_shrink()
+    {
+        if(root->count > 0)
+            return;
+        node_ptr old_root = root;
+        if(root->leaf)
+            root = leftmost = rightmost = 0;
+        else
+        {
+            root = root->child(0);
+            root->parent = 0;
+            root->position = 0;
+        }
+        delete_node(old_root);
+    }
+
+    // 自底向上恢复B树的性质, 返回被删除元素之后的位置
+    iterator rebalance_after_delete(iterator it)
+    {
+        iterator res = it;
+        bool first_iteration = true;
+        for(;;)
+        {
+            if(it.node == root)
+            {
+                try_shrink();
+                if(root == 0)
+                    return iterator();
+                break;
+            }
+            if(it.node->count >= (size_t)min_node_values)
+                break;
+            bool merged = try_merge_or_rebalance(it);
+            if(first_iteration)
+            {
+                res = it;
+                first_iteration = false;
+            }
+            if(!merged)
+                break;
+            it.position = it.node->position;
+            it.node = it.node->parent;
+        }
+        // 位置越过节点末尾时, 后继元素在祖先节点上; 已经是最后一个元素时停在end()
+        if(res.position == res.node->count)
+        {
+            res.position = res.node->count - 1;
+            res.increment();
+        }
+        return res;
+    }
+};
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator==(const btree<Key, Value, KeyOfValue, Compare, Alloc>& x,
+                       const btree<Key, Value, KeyOfValue, Compare, Alloc>& y)
+{
+    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator<(const btree<Key, Value, KeyOfValue, Compare, Alloc>& x,
+                      const btree<Key, Value, KeyOfValue, Compare, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#endif // __STL_BTREE_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef __STL_CONFIG_H
+#define __STL_CONFIG_H
+
+// 编译选项, 由使用者在包含任何头文件之前定义
+//
+// __STL_PERF_COUNTERS: 空间配置器的 chunk_alloc / refill、__uninitialized_copy_aux 与排序、合并等算法
+//                      用硬件性能计数器计量, 每个函数一个 perf_region, 程序结束前调用 perf_report 输出, 见 stl_perf.h
+// __STL_PARALLEL_THREADS: 并行算法的总线程数(包括调用线程), 默认为 hardware_concurrency, 见 stl_parallel.h
+
+// C++11 的 constexpr 函数只能有一条 return 语句, 函数对象、pair、min/max 直接声明为 constexpr;
+// 含循环与局部变量的算法(distance、advance、for_each、二分查找、排序、堆...)从C++14起才能是 constexpr
+#if __cplusplus >= 201402L
+#define __STL_CONSTEXPR14 constexpr
+#else
+#define __STL_CONSTEXPR14
+#endif
+
+// 当前是否在常量求值中: 编译期执行时绕开 memmove、SIMD、预取、配置缓冲区等只能在运行期使用的快速路径
+// 只在 __STL_CONSTEXPR14 的函数中使用; C++11 或编译器不提供时恒为false, 这些算法在编译期使用会报错, 运行期不受影响
+#if __cplusplus >= 201402L
+#ifdef __has_builtin
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define __STL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#if !defined(__STL_CONSTANT_EVALUATED) && defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#define __STL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#ifndef __STL_CONSTANT_EVALUATED
+#define __STL_CONSTANT_EVALUATED() false
+#endif
+
+#ifdef __STL_PERF_COUNTERS
+#include "stl_perf.h"
+// 函数模板的每个实例各有一个同名的区域
+#define __STL_PERF_SCOPE(name)                          \
+    static perf_region __stl_perf_region(name);         \
+    perf_scope __stl_perf_scope(__stl_perf_region)
+#else
+#define __STL_PERF_SCOPE(name)
+#endif
+
+#endif // __STL_CONFIG_H
\ No newline at end of file
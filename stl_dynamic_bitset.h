@@ -0,0 +1,519 @@
+#ifndef __STL_DYNAMIC_BITSET_H
+#define __STL_DYNAMIC_BITSET_H
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <cstddef>  // size_t, ptrdiff_t
+#include <cstring>  // memset
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_function.h"
+#include "stl_iterator.h"
+#include "stl_uninitialized.h"
+
+// dynamic_bitset: 长度在运行期确定的位集合, 按64位的字存放
+// 1. 集合运算(&= |= ^= -=)逐字进行, 一次处理64位, 循环可以被编译器向量化
+// 2. count() 有 AVX2 时用 vpshufb 查表一次统计256位, 否则逐字 popcnt; 没有 popcnt 指令时用移位相加
+// 3. find_first / find_next 跳过全0的字, 在非0字中用 ctz(有 BMI 时是 tzcnt)找到最低的1
+// 4. begin_set() / end_set() 按从小到大的顺序遍历所有为1的位, 每步 x &= x - 1 去掉最低的1
+// 5. combine(x, op) 接受 stl_function.h 中的 logical_and / logical_or / not_equal_to / equal_to,
+//    编译期映射到 & | ^ 与同或的整字运算; 其他函数对象逐位调用
+// 最后一个字中超出 size() 的位始终为0, count 与集合运算不需要特别处理它们
+//
+//  dynamic_bitset<> a(n), b(n);
+//  a.set(3);  b.set(3);  b.set(70);
+//  a.combine(b, logical_or<bool>());                   // 等价于 a |= b
+//  for(dynamic_bitset<>::set_iterator it = a.begin_set(); it != a.end_set(); ++it)
+//      use(*it);                                       // 3, 70
+//
+// 两个集合之间的运算要求长度相同
+
+typedef unsigned long long __bitset_block;
+
+enum { __bitset_block_bits = 64 };
+
+// ========================================= 字的运算
+inline size_t __bitset_popcount(__bitset_block x)
+{
+#ifdef __POPCNT__
+    return __builtin_popcountll(x);
+#else
+    // 没有 popcnt 指令时 __builtin_popcountll 是一次库函数调用, 直接移位相加
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return size_t((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline size_t __bitset_ctz(__bitset_block x)
+{
+    return __builtin_ctzll(x);
+}
+
+// n个字中1的个数
+inline size_t __bitset_count(const __bitset_block* p, size_t n)
+{
+    size_t i = 0;
+    size_t total = 0;
+#ifdef __AVX2__
+    // 每个字节拆成高低两个4位, 用 vpshufb 查表得到各自的1的个数, 再用 sad 把字节累加到64位
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    for(; i + 4 <= n; i += 4)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+        const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), zero));
+    }
+    total = size_t(_mm256_extract_epi64(acc, 0)) + size_t(_mm256_extract_epi64(acc, 1))
+          + size_t(_mm256_extract_epi64(acc, 2)) + size_t(_mm256_extract_epi64(acc, 3));
+#else
+    // 四个独立的累加器, popcnt 的延迟可以重叠
+    size_t t1 = 0, t2 = 0, t3 = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        total += __bitset_popcount(p[i]);
+        t1 += __bitset_popcount(p[i + 1]);
+        t2 += __bitset_popcount(p[i + 2]);
+        t3 += __bitset_popcount(p[i + 3]);
+    }
+    total += t1 + t2 + t3;
+#endif
+    for(; i < n; ++i)
+        total += __bitset_popcount(p[i]);
+    return total;
+}
+
+// ========================================= 函数对象到整字运算的映射
+template<class Operation>
+struct __bitset_word_op
+{
+    typedef __false_type is_wordwise;
+};
+
+template<class T>
+struct __bitset_word_op<logical_and<T> >
+{
+    typedef __true_type is_wordwise;
+    static __bitset_block apply(__bitset_block x, __bitset_block y)  {   return x & y;   }
+};
+
+template<class T>
+struct __bitset_word_op<logical_or<T> >
+{
+    typedef __true_type is_wordwise;
+    static __bitset_block apply(__bitset_block x, __bitset_block y)  {   return x | y;   }
+};
+
+template<class T>
+struct __bitset_word_op<not_equal_to<T> >
+{
+    typedef __true_type is_wordwise;
+    static __bitset_block apply(__bitset_block x, __bitset_block y)  {   return x ^ y;   }
+};
+
+// 同或会把末尾多余的位置为1, 由调用者清除
+template<class T>
+struct __bitset_word_op<equal_to<T> >
+{
+    typedef __true_type is_wordwise;
+    static __bitset_block apply(__bitset_block x, __bitset_block y)  {   return ~(x ^ y);    }
+};
+
+// ========================================= 遍历为1的位
+struct __bitset_set_iterator
+{
+    typedef __bitset_set_iterator self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef size_t value_type;
+    typedef const size_t* pointer;
+    typedef size_t reference;
+    typedef ptrdiff_t difference_type;
+
+    const __bitset_block* words;
+    size_t num_blocks;
+    size_t block;           // 当前字的下标, 结束时为 num_blocks
+    __bitset_block rest;    // 当前字中尚未访问的1
+
+    __bitset_set_iterator() : words(0), num_blocks(0), block(0), rest(0) {}
+    __bitset_set_iterator(const __bitset_block* w, size_t n, size_t b) : words(w), num_blocks(n), block(b), rest(0)
+    {
+        if(block < num_blocks)
+        {
+            rest = words[block];
+            skip_empty();
+        }
+    }
+
+    // 当前字已经没有1时前进到下一个非0字
+    void skip_empty()
+    {
+        while(!rest && ++block < num_blocks)
+            rest = words[block];
+    }
+
+    bool operator==(const self& x) const    {   return block == x.block && rest == x.rest;  }
+    bool operator!=(const self& x) const    {   return !(*this == x);   }
+
+    reference operator*() const {   return block * __bitset_block_bits + __bitset_ctz(rest);    }
+
+    self& operator++()
+    {
+        rest &= rest - 1;
+        skip_empty();
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+// ========================================= dynamic_bitset
+template<class Alloc = alloc>
+class dynamic_bitset
+{
+public:
+    typedef __bitset_block block_type;
+    typedef size_t size_type;
+    typedef __bitset_set_iterator set_iterator;
+
+    static const size_type npos = size_type(-1);
+    enum { bits_per_block = __bitset_block_bits };
+
+protected:
+    typedef simple_alloc<block_type, Alloc> data_allocator;
+
+    block_type* words;
+    size_type num_bits;
+    size_type block_capacity;
+
+protected:
+    static size_type blocks_for(size_type n)    {   return (n + bits_per_block - 1) / bits_per_block;  }
+    static size_type block_index(size_type i)   {   return i / bits_per_block;  }
+    static block_type bit_mask(size_type i)     {   return block_type(1) << (i % bits_per_block);   }
+
+    // 清除最后一个字中超出 size() 的位
+    void trim()
+    {
+        const size_type extra = num_bits % bits_per_block;
+        if(extra)
+            words[num_blocks() - 1] &= (block_type(1) << extra) - 1;
+    }
+
+    void reallocate(size_type n)
+    {
+        block_type* new_words = data_allocator::allocate(n);
+        uninitialized_copy(words, words + num_blocks(), new_words);
+        data_allocator::deallocate(words, block_capacity);
+        words = new_words;
+        block_capacity = n;
+    }
+
+    template<class Operation>
+    void combine_aux(const dynamic_bitset& x, Operation, __true_type)
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            words[i] = __bitset_word_op<Operation>::apply(words[i], x.words[i]);
+        trim();
+    }
+
+    template<class Operation>
+    void combine_aux(const dynamic_bitset& x, Operation op, __false_type)
+    {
+        for(size_type i = 0; i < num_bits; ++i)
+            set(i, op(test(i), x.test(i)));
+    }
+
+public:
+    dynamic_bitset() : words(0), num_bits(0), block_capacity(0) {}
+    explicit dynamic_bitset(size_type n, bool value = false) : words(0), num_bits(0), block_capacity(0)
+    {
+        resize(n, value);
+    }
+    dynamic_bitset(const dynamic_bitset& x) : words(0), num_bits(0), block_capacity(0)
+    {
+        *this = x;
+    }
+    ~dynamic_bitset()   {   data_allocator::deallocate(words, block_capacity);  }
+
+    dynamic_bitset& operator=(const dynamic_bitset& x)
+    {
+        if(this != &x)
+        {
+            num_bits = 0;
+            if(block_capacity < x.num_blocks())
+                reallocate(x.num_blocks());
+            uninitialized_copy(x.words, x.words + x.num_blocks(), words);
+            num_bits = x.num_bits;
+        }
+        return *this;
+    }
+
+public:
+    size_type size() const          {   return num_bits;    }
+    bool empty() const              {   return num_bits == 0;   }
+    size_type num_blocks() const    {   return blocks_for(num_bits);    }
+    const block_type* data() const  {   return words;   }
+
+    void reserve(size_type n)
+    {
+        if(blocks_for(n) > block_capacity)
+            reallocate(blocks_for(n));
+    }
+
+    // 新增的位为value
+    void resize(size_type n, bool value = false)
+    {
+        const size_type old_blocks = num_blocks();
+        const size_type new_blocks = blocks_for(n);
+        if(new_blocks > block_capacity)
+            reallocate(max(new_blocks, 2 * block_capacity));
+        if(value && n > num_bits)
+        {
+            // 原来最后一个字的空余部分置1, 之后的字整字填充
+            const size_type extra = num_bits % bits_per_block;
+            if(extra)
+                words[old_blocks - 1] |= ~((block_type(1) << extra) - 1);
+        }
+        if(new_blocks > old_blocks)
+            uninitialized_fill_n(words + old_blocks, new_blocks - old_blocks, value ? ~block_type(0) : block_type(0));
+        num_bits = n;
+        trim();
+    }
+
+    void push_back(bool value)
+    {
+        if(num_bits % bits_per_block == 0 && num_blocks() == block_capacity)
+            reallocate(block_capacity ? 2 * block_capacity : 1);
+        const size_type i = num_bits++;
+        if(i % bits_per_block == 0)
+            words[block_index(i)] = 0;
+        set(i, value);
+    }
+
+    void clear()    {   num_bits = 0;   }
+
+    // ------------------------------------- 单个位
+    bool test(size_type i) const        {   return (words[block_index(i)] & bit_mask(i)) != 0;  }
+    bool operator[](size_type i) const  {   return test(i); }
+
+    dynamic_bitset& set(size_type i)
+    {
+        words[block_index(i)] |= bit_mask(i);
+        return *this;
+    }
+    dynamic_bitset& set(size_type i, bool value)
+    {
+        // 不带分支地写入: 先清除再按value置位
+        block_type& w = words[block_index(i)];
+        w = (w & ~bit_mask(i)) | (block_type(value) << (i % bits_per_block));
+        return *this;
+    }
+    dynamic_bitset& reset(size_type i)
+    {
+        words[block_index(i)] &= ~bit_mask(i);
+        return *this;
+    }
+    dynamic_bitset& flip(size_type i)
+    {
+        words[block_index(i)] ^= bit_mask(i);
+        return *this;
+    }
+
+    // ------------------------------------- 全部位
+    dynamic_bitset& set()
+    {
+        if(num_bits)
+            memset(words, 0xff, num_blocks() * sizeof(block_type));
+        trim();
+        return *this;
+    }
+    dynamic_bitset& reset()
+    {
+        if(num_bits)
+            memset(words, 0, num_blocks() * sizeof(block_type));
+        return *this;
+    }
+    dynamic_bitset& flip()
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            words[i] = ~words[i];
+        trim();
+        return *this;
+    }
+
+    size_type count() const {   return __bitset_count(words, num_blocks()); }
+
+    bool any() const
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            if(words[i])
+                return true;
+        return false;
+    }
+    bool none() const   {   return !any();  }
+    bool all() const    {   return count() == num_bits; }
+
+    // ------------------------------------- 查找
+    // 第一个为1的位, 没有时返回npos
+    size_type find_first() const    {   return find_from(0);    }
+
+    // pos之后第一个为1的位, 没有时返回npos
+    size_type find_next(size_type pos) const
+    {
+        ++pos;
+        if(pos >= num_bits)
+            return npos;
+        size_type b = block_index(pos);
+        block_type w = words[b] & ~(bit_mask(pos) - 1);
+        if(w)
+            return b * bits_per_block + __bitset_ctz(w);
+        return find_from(b + 1);
+    }
+
+    // 从第b个字开始找第一个非0字
+    size_type find_from(size_type b) const
+    {
+        const size_type n = num_blocks();
+        for(; b < n; ++b)
+            if(words[b])
+                return b * bits_per_block + __bitset_ctz(words[b]);
+        return npos;
+    }
+
+    set_iterator begin_set() const  {   return set_iterator(words, num_blocks(), 0);   }
+    set_iterator end_set() const    {   return set_iterator(words, num_blocks(), num_blocks()); }
+
+    // 按从小到大的顺序对每个为1的位调用 f(pos), 比 set_iterator 少一次比较
+    template<class Function>
+    Function for_each_set(Function f) const
+    {
+        const size_type n = num_blocks();
+        for(size_type b = 0; b < n; ++b)
+            for(block_type w = words[b]; w; w &= w - 1)
+                f(b * bits_per_block + __bitset_ctz(w));
+        return f;
+    }
+
+    // ------------------------------------- 集合运算
+    dynamic_bitset& operator&=(const dynamic_bitset& x)
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            words[i] &= x.words[i];
+        return *this;
+    }
+    dynamic_bitset& operator|=(const dynamic_bitset& x)
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            words[i] |= x.words[i];
+        return *this;
+    }
+    dynamic_bitset& operator^=(const dynamic_bitset& x)
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            words[i] ^= x.words[i];
+        return *this;
+    }
+    // 差集(and not): 去掉x中为1的位
+    dynamic_bitset& operator-=(const dynamic_bitset& x)
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            words[i] &= ~x.words[i];
+        return *this;
+    }
+
+    // 第i位改为 op(test(i), x.test(i))
+    template<class Operation>
+    dynamic_bitset& combine(const dynamic_bitset& x, Operation op)
+    {
+        combine_aux(x, op, typename __bitset_word_op<Operation>::is_wordwise());
+        return *this;
+    }
+
+    bool is_subset_of(const dynamic_bitset& x) const
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            if(words[i] & ~x.words[i])
+                return false;
+        return true;
+    }
+    bool intersects(const dynamic_bitset& x) const
+    {
+        const size_type n = num_blocks();
+        for(size_type i = 0; i < n; ++i)
+            if(words[i] & x.words[i])
+                return true;
+        return false;
+    }
+
+    bool operator==(const dynamic_bitset& x) const
+    {
+        return num_bits == x.num_bits && equal(words, words + num_blocks(), x.words);
+    }
+    bool operator!=(const dynamic_bitset& x) const  {   return !(*this == x);   }
+
+    void swap(dynamic_bitset& x)
+    {
+        ::swap(words, x.words);
+        ::swap(num_bits, x.num_bits);
+        ::swap(block_capacity, x.block_capacity);
+    }
+};
+
+template<class Alloc>
+const typename dynamic_bitset<Alloc>::size_type dynamic_bitset<Alloc>::npos;
+
+template<class Alloc>
+inline dynamic_bitset<Alloc> operator&(const dynamic_bitset<Alloc>& x, const dynamic_bitset<Alloc>& y)
+{
+    dynamic_bitset<Alloc> r(x);
+    return r &= y;
+}
+
+template<class Alloc>
+inline dynamic_bitset<Alloc> operator|(const dynamic_bitset<Alloc>& x, const dynamic_bitset<Alloc>& y)
+{
+    dynamic_bitset<Alloc> r(x);
+    return r |= y;
+}
+
+template<class Alloc>
+inline dynamic_bitset<Alloc> operator^(const dynamic_bitset<Alloc>& x, const dynamic_bitset<Alloc>& y)
+{
+    dynamic_bitset<Alloc> r(x);
+    return r ^= y;
+}
+
+template<class Alloc>
+inline dynamic_bitset<Alloc> operator-(const dynamic_bitset<Alloc>& x, const dynamic_bitset<Alloc>& y)
+{
+    dynamic_bitset<Alloc> r(x);
+    return r -= y;
+}
+
+template<class Alloc>
+inline void swap(dynamic_bitset<Alloc>& x, dynamic_bitset<Alloc>& y)
+{
+    x.swap(y);
+}
+
+#endif // __STL_DYNAMIC_BITSET_H
\ No newline at end of file
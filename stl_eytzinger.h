@@ -0,0 +1,209 @@
+#ifndef __STL_EYTZINGER_H
+#define __STL_EYTZINGER_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+
+#include "stl_alloc.h"
+#include "stl_algo.h"
+#include "stl_construct.h"
+#include "stl_function.h"
+
+// eytzinger_index: 把有序数组按完全二叉树的层序(BFS)重新排列后查找
+// 下标从1开始, 节点k的左右孩子为 2k 与 2k+1, 树根与前几层集中在数组开头的几个缓存行中, 总是命中缓存
+// 查找沿根向下走 k = 2k + (tree[k] < x), 没有分支; 第k个节点往下4层的16个后代在数组中是连续的,
+// 每一步预取它们所在的缓存行, 访问到时通常已经在缓存中
+// 与有序数组上的二分查找相比, 大表上每次查找的缓存缺失更少, 代价是迭代顺序变为层序而不是有序
+//
+//  eytzinger_index<int> idx(sorted.begin(), sorted.end());
+//  eytzinger_index<int>::const_iterator i = idx.lower_bound(42);   // 第一个不小于42的元素, 没有时为end()
+
+template<class T, class Compare = less<T>, class Alloc = alloc>
+class eytzinger_index
+{
+public:
+    typedef T value_type;
+    typedef Compare key_compare;
+    typedef const value_type* const_pointer;
+    typedef const value_type* const_iterator;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+private:
+    typedef simple_alloc<char, Alloc> data_allocator;
+
+    // 一个缓存行中的元素个数, 预取时向下跳过的距离
+    enum { line_elements = sizeof(T) < __cache_line_size ? __cache_line_size / sizeof(T) : 1 };
+
+    size_type len;
+    char* raw;          // 配置的原始空间, 多出一个缓存行用于对齐
+    T* tree;            // tree[1..len] 为层序排列的元素, tree[0] 不使用, tree 按缓存行对齐
+    Compare comp;
+
+private:
+    size_type raw_size() const  {   return (len + 1) * sizeof(T) + __cache_line_size;   }
+
+    void allocate()
+    {
+        raw = 0;
+        tree = 0;
+        if(len == 0)
+            return;
+        raw = data_allocator::allocate(raw_size());
+        size_t offset = size_t(__cache_line_size) - reinterpret_cast<size_t>(raw) % __cache_line_size;
+        tree = reinterpret_cast<T*>(raw + offset % __cache_line_size);
+    }
+
+    void deallocate()
+    {
+        if(raw)
+            data_allocator::deallocate(raw, raw_size());
+    }
+
+    // 按中序遍历的顺序依次放入有序的元素, 得到的就是层序排列的二叉搜索树
+    // built 记录已构造的元素个数, 供抛出异常时析构
+    template<class ForwardIterator>
+    ForwardIterator build(ForwardIterator first, size_type k, size_type& built)
+    {
+        if(k <= len)
+        {
+            first = build(first, 2 * k, built);
+            construct(tree + k, *first);
+            ++built;
+            ++first;
+            first = build(first, 2 * k + 1, built);
+        }
+        return first;
+    }
+
+    // 按同样的中序析构最先构造的 n 个元素
+    void destroy_built(size_type k, size_type& n)
+    {
+        if(k <= len && n > 0)
+        {
+            destroy_built(2 * k, n);
+            if(n > 0)
+            {
+                destroy(tree + k);
+                --n;
+            }
+            destroy_built(2 * k + 1, n);
+        }
+    }
+
+    // 下降结束时 k 的二进制为: 答案节点, 之后一个1(在答案处向左走了一次), 再之后全是0(一直向右)
+    // 去掉末尾的这些位得到答案; 一直向右走(所有元素都小于x)时结果为0, 表示不存在
+    const_iterator answer(size_type k) const
+    {
+        k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+        return k ? tree + k : end();
+    }
+
+public:
+    eytzinger_index() : len(0), raw(0), tree(0)    {}
+
+    // [first, last) 必须已按comp排好序
+    template<class ForwardIterator>
+    eytzinger_index(ForwardIterator first, ForwardIterator last, const Compare& c = Compare())
+        : len(distance(first, last)), comp(c)
+    {
+        allocate();
+        size_type built = 0;
+        try
+        {
+            build(first, 1, built);
+        }
+        catch(...)
+        {
+            destroy_built(1, built);
+            deallocate();
+            throw;
+        }
+    }
+
+    eytzinger_index(const eytzinger_index& x) : len(x.len), comp(x.comp)
+    {
+        allocate();
+        size_type i = 1;
+        try
+        {
+            for(; i <= len; ++i)
+                construct(tree + i, x.tree[i]);
+        }
+        catch(...)
+        {
+            destroy(tree + 1, tree + i);
+            deallocate();
+            throw;
+        }
+    }
+
+    eytzinger_index& operator=(const eytzinger_index& x)
+    {
+        if(this != &x)
+        {
+            eytzinger_index tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~eytzinger_index()
+    {
+        if(len)
+            destroy(tree + 1, tree + len + 1);
+        deallocate();
+    }
+
+public:
+    // 按层序迭代
+    const_iterator begin() const    {   return tree ? tree + 1 : 0; }
+    const_iterator end() const      {   return tree ? tree + len + 1 : 0;   }
+
+    size_type size() const  {   return len; }
+    bool empty() const      {   return len == 0;    }
+    key_compare key_comp() const    {   return comp;    }
+
+    void swap(eytzinger_index& x)
+    {
+        ::swap(len, x.len);
+        ::swap(raw, x.raw);
+        ::swap(tree, x.tree);
+        ::swap(comp, x.comp);
+    }
+
+public:
+    // 第一个不小于x的元素
+    const_iterator lower_bound(const value_type& x) const
+    {
+        size_type k = 1;
+        while(k <= len)
+        {
+            __prefetch(tree + k * line_elements);
+            k = 2 * k + comp(tree[k], x);
+        }
+        return answer(k);
+    }
+
+    // 第一个大于x的元素
+    const_iterator upper_bound(const value_type& x) const
+    {
+        size_type k = 1;
+        while(k <= len)
+        {
+            __prefetch(tree + k * line_elements);
+            k = 2 * k + !comp(x, tree[k]);
+        }
+        return answer(k);
+    }
+
+    const_iterator find(const value_type& x) const
+    {
+        const_iterator i = lower_bound(x);
+        return i == end() || comp(x, *i) ? end() : i;
+    }
+
+    bool contains(const value_type& x) const    {   return find(x) != end();    }
+};
+
+#endif // __STL_EYTZINGER_H
\ No newline at end of file
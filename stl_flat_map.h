@@ -0,0 +1,135 @@
+#ifndef __STL_FLAT_MAP_H
+#define __STL_FLAT_MAP_H
+
+#include "stl_alloc.h"
+#include "stl_flat_tree.h"
+#include "stl_function.h"
+#include "stl_pair.h"
+
+// flat_map: 元素为 pair<Key, T>, 按键值有序连续存放且不允许重复, 以flat_tree为底层实现
+// 元素在数组中整体搬移, 需要可以赋值, 所以键值类型不带const, 不要通过迭代器修改键值
+// 插入删除会使所有迭代器失效
+
+template<class Key, class T, class Compare = less<Key>, class Alloc = alloc>
+class flat_map
+{
+public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef pair<Key, T> value_type;
+    typedef Compare key_compare;
+
+    // 元素比较, 只比较键值
+    class value_compare : public binary_function<value_type, value_type, bool>
+    {
+        friend class flat_map<Key, T, Compare, Alloc>;
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c)  {}
+    public:
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    typedef flat_tree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+public:
+    flat_map() : t(Compare())   {}
+    explicit flat_map(const Compare& comp) : t(comp)    {}
+
+    template<class InputIterator>
+    flat_map(InputIterator first, InputIterator last) : t(Compare())
+    {
+        t.insert_unique(first, last);
+    }
+
+    template<class InputIterator>
+    flat_map(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+
+public:
+    key_compare key_comp() const        {   return t.key_comp();    }
+    value_compare value_comp() const    {   return value_compare(t.key_comp()); }
+
+    iterator begin()    {   return t.begin();   }
+    iterator end()      {   return t.end(); }
+    const_iterator begin() const    {   return t.begin();   }
+    const_iterator end() const      {   return t.end(); }
+
+    bool empty() const          {   return t.empty();   }
+    size_type size() const      {   return t.size();    }
+    size_type max_size() const  {   return t.max_size();    }
+    size_type capacity() const  {   return t.capacity();    }
+    void reserve(size_type n)   {   t.reserve(n);   }
+    void swap(flat_map& x)      {   t.swap(x.t);    }
+
+    // 键值不存在时在查找到的位置插入 pair(k, T())
+    T& operator[](const key_type& k)
+    {
+        iterator i = lower_bound(k);
+        if(i == end() || key_comp()(k, (*i).first))
+            i = t.insert_unique(i, value_type(k, T()));
+        return (*i).second;
+    }
+
+public:
+    pair<iterator, bool> insert(const value_type& x)        {   return t.insert_unique(x);  }
+    iterator insert(iterator position, const value_type& x) {   return t.insert_unique(position, x);    }
+    // 整批排序后一次归并, O(n + k log k)
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   t.insert_unique(first, last);   }
+
+    iterator erase(iterator position)           {   return t.erase(position);   }
+    size_type erase(const key_type& x)          {   return t.erase(x);  }
+    void erase(iterator first, iterator last)   {   t.erase(first, last);   }
+    void clear()    {   t.clear();  }
+
+public:
+    iterator find(const key_type& x)                {   return t.find(x);   }
+    const_iterator find(const key_type& x) const    {   return t.find(x);   }
+    size_type count(const key_type& x) const        {   return t.find(x) == t.end() ? 0 : 1;    }
+
+    iterator lower_bound(const key_type& x)                 {   return t.lower_bound(x);    }
+    const_iterator lower_bound(const key_type& x) const     {   return t.lower_bound(x);    }
+    iterator upper_bound(const key_type& x)                 {   return t.upper_bound(x);    }
+    const_iterator upper_bound(const key_type& x) const     {   return t.upper_bound(x);    }
+
+    pair<iterator, iterator> equal_range(const key_type& x)     {   return t.equal_range(x);    }
+    pair<const_iterator, const_iterator> equal_range(const key_type& x) const   {   return t.equal_range(x);    }
+
+    template<class K1, class T1, class C1, class A1>
+    friend bool operator==(const flat_map<K1, T1, C1, A1>&, const flat_map<K1, T1, C1, A1>&);
+    template<class K1, class T1, class C1, class A1>
+    friend bool operator<(const flat_map<K1, T1, C1, A1>&, const flat_map<K1, T1, C1, A1>&);
+};
+
+template<class Key, class T, class Compare, class Alloc>
+inline bool operator==(const flat_map<Key, T, Compare, Alloc>& x, const flat_map<Key, T, Compare, Alloc>& y)
+{
+    return x.t == y.t;
+}
+
+template<class Key, class T, class Compare, class Alloc>
+inline bool operator<(const flat_map<Key, T, Compare, Alloc>& x, const flat_map<Key, T, Compare, Alloc>& y)
+{
+    return x.t < y.t;
+}
+
+#endif // __STL_FLAT_MAP_H
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef __STL_FLAT_SET_H
+#define __STL_FLAT_SET_H
+
+#include "stl_alloc.h"
+#include "stl_flat_tree.h"
+#include "stl_function.h"
+#include "stl_pair.h"
+
+// flat_set: 元素即键值, 有序连续存放且不允许重复, 以flat_tree为底层实现
+// 元素不允许修改, 迭代器都是const_iterator; 插入删除会使所有迭代器失效
+
+template<class Key, class Compare = less<Key>, class Alloc = alloc>
+class flat_set
+{
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef flat_tree<key_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+    typedef typename rep_type::iterator rep_iterator;
+    rep_type t;
+
+public:
+    typedef typename rep_type::const_pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::const_reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+public:
+    flat_set() : t(Compare())   {}
+    explicit flat_set(const Compare& comp) : t(comp)    {}
+
+    template<class InputIterator>
+    flat_set(InputIterator first, InputIterator last) : t(Compare())
+    {
+        t.insert_unique(first, last);
+    }
+
+    template<class InputIterator>
+    flat_set(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+
+public:
+    key_compare key_comp() const    {   return t.key_comp();    }
+    value_compare value_comp() const    {   return t.key_comp();    }
+
+    iterator begin() const  {   return t.begin();   }
+    iterator end() const    {   return t.end(); }
+
+    bool empty() const          {   return t.empty();   }
+    size_type size() const      {   return t.size();    }
+    size_type max_size() const  {   return t.max_size();    }
+    size_type capacity() const  {   return t.capacity();    }
+    void reserve(size_type n)   {   t.reserve(n);   }
+    void swap(flat_set& x)      {   t.swap(x.t);    }
+
+public:
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        pair<rep_iterator, bool> p = t.insert_unique(x);
+        return pair<iterator, bool>(p.first, p.second);
+    }
+    iterator insert(iterator position, const value_type& x)
+    {
+        return t.insert_unique(const_cast<rep_iterator>(position), x);
+    }
+    // 整批排序后一次归并, O(n + k log k)
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   t.insert_unique(first, last);   }
+
+    iterator erase(iterator position)   {   return t.erase(const_cast<rep_iterator>(position)); }
+    size_type erase(const key_type& x)  {   return t.erase(x);  }
+    void erase(iterator first, iterator last)
+    {
+        t.erase(const_cast<rep_iterator>(first), const_cast<rep_iterator>(last));
+    }
+    void clear()    {   t.clear();  }
+
+public:
+    iterator find(const key_type& x) const          {   return t.find(x);   }
+    size_type count(const key_type& x) const        {   return t.find(x) == t.end() ? 0 : 1;    }
+    iterator lower_bound(const key_type& x) const   {   return t.lower_bound(x);    }
+    iterator upper_bound(const key_type& x) const   {   return t.upper_bound(x);    }
+    pair<iterator, iterator> equal_range(const key_type& x) const   {   return t.equal_range(x);    }
+
+    template<class K1, class C1, class A1>
+    friend bool operator==(const flat_set<K1, C1, A1>&, const flat_set<K1, C1, A1>&);
+    template<class K1, class C1, class A1>
+    friend bool operator<(const flat_set<K1, C1, A1>&, const flat_set<K1, C1, A1>&);
+};
+
+template<class Key, class Compare, class Alloc>
+inline bool operator==(const flat_set<Key, Compare, Alloc>& x, const flat_set<Key, Compare, Alloc>& y)
+{
+    return x.t == y.t;
+}
+
+template<class Key, class Compare, class Alloc>
+inline bool operator<(const flat_set<Key, Compare, Alloc>& x, const flat_set<Key, Compare, Alloc>& y)
+{
+    return x.t < y.t;
+}
+
+#endif // __STL_FLAT_SET_H
\ No newline at end of file
@@ -0,0 +1,260 @@
+#ifndef __STL_FLAT_TREE_H
+#define __STL_FLAT_TREE_H
+
+#include "stl_alloc.h"
+#include "stl_algo.h"
+#include "stl_algobase.h"
+#include "stl_pair.h"
+#include "stl_vector.h"
+
+// flat_tree: flat_map / flat_set 的底层实现, 接口与btree保持一致
+// 元素按键值有序地连续存放在vector中, 没有节点和指针开销, 查找是对连续内存的二分查找
+// 适合读多写少的查找表: 单个插入删除需要搬移插入点之后的所有元素(POD类型直接memmove), O(n)
+//
+// 批量插入 insert_unique(first, last):
+//   1. 新元素先复制到临时区并排序, O(k log k)
+//   2. 去掉批内重复的键, 以及表中已经存在的键
+//   3. 表尾扩展出k个位置, 从后往前把两个有序序列归并到位, O(n + k)
+// 比起k次单独插入的 O(k * n) 要快得多; 批内有重复的键时, 保留其中哪一个是不确定的
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = alloc>
+class flat_tree
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+
+private:
+    typedef vector<value_type, Alloc> rep_type;
+
+    // 元素比较, 只比较键值, 用于排序新插入的元素
+    struct value_compare
+    {
+        Compare comp;
+        value_compare(const Compare& c) : comp(c)   {}
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(KeyOfValue()(x), KeyOfValue()(y));
+        }
+    };
+
+    rep_type c;
+    Compare key_compare;
+
+    static const key_type& key(const value_type& v) {   return KeyOfValue()(v); }
+
+    // 在 [first, last) 中查找第一个不小于k的元素
+    // 无分支的二分查找, 与 stl_algo.h 中的 lower_bound 相同, 只是比较元素的键
+    template<class Iterator>
+    Iterator lower_bound(Iterator first, Iterator last, const key_type& k) const
+    {
+        difference_type len = last - first;
+        if(len == 0)
+            return first;
+        while(len > 1)
+        {
+            difference_type half = len >> 1;
+            first = key_compare(key(first[half]), k) ? first + half : first;
+            len -= half;
+        }
+        return key_compare(key(*first), k) ? first + 1 : first;
+    }
+
+    // 在 [first, last) 中查找第一个大于k的元素
+    template<class Iterator>
+    Iterator upper_bound(Iterator first, Iterator last, const key_type& k) const
+    {
+        difference_type len = last - first;
+        if(len == 0)
+            return first;
+        while(len > 1)
+        {
+            difference_type half = len >> 1;
+            first = key_compare(k, key(first[half])) ? first : first + half;
+            len -= half;
+        }
+        return key_compare(k, key(*first)) ? first : first + 1;
+    }
+
+    void sort_batch(iterator first, iterator last)
+    {
+        ::sort(first, last, value_compare(key_compare));
+    }
+
+    // batch 已排序且与表中的键互不重复, 归并到表中
+    void merge_sorted(rep_type& batch)
+    {
+        if(batch.empty())
+            return;
+        const size_type n = c.size();
+        // 新元素都排在最后时直接追加
+        if(n == 0 || key_compare(key(c.back()), key(batch.front())))
+        {
+            c.insert(c.end(), batch.begin(), batch.end());
+            return;
+        }
+        c.insert(c.end(), batch.begin(), batch.end());  // 扩展出k个位置, 内容随后被覆盖
+        iterator a = c.begin() + n;
+        iterator b = batch.end();
+        iterator out = c.end();
+        // batch用完时, 剩下的原有元素已经在正确的位置上
+        while(b != batch.begin())
+        {
+            if(a != c.begin() && key_compare(key(*(b - 1)), key(*(a - 1))))
+                *--out = *--a;
+            else
+                *--out = *--b;
+        }
+    }
+
+public:
+    flat_tree(const Compare& comp = Compare()) : key_compare(comp)  {}
+
+public:
+    Compare key_comp() const    {   return key_compare; }
+
+    iterator begin()    {   return c.begin();   }
+    iterator end()      {   return c.end(); }
+    const_iterator begin() const    {   return c.begin();   }
+    const_iterator end() const      {   return c.end(); }
+
+    bool empty() const          {   return c.empty();   }
+    size_type size() const      {   return c.size();    }
+    size_type max_size() const  {   return c.max_size();    }
+    size_type capacity() const  {   return c.capacity();    }
+    void reserve(size_type n)   {   c.reserve(n);   }
+
+    void swap(flat_tree& t)
+    {
+        c.swap(t.c);
+        ::swap(key_compare, t.key_compare);
+    }
+
+public:
+    pair<iterator, bool> insert_unique(const value_type& v)
+    {
+        iterator i = lower_bound(c.begin(), c.end(), key(v));
+        if(i != c.end() && !key_compare(key(v), key(*i)))
+            return pair<iterator, bool>(i, false);
+        return pair<iterator, bool>(c.insert(i, v), true);
+    }
+
+    iterator insert_equal(const value_type& v)
+    {
+        return c.insert(upper_bound(c.begin(), c.end(), key(v)), v);
+    }
+
+    // hint正好是插入位置时不需要查找
+    iterator insert_unique(iterator position, const value_type& v)
+    {
+        if((position == c.begin() || key_compare(key(*(position - 1)), key(v))) &&
+           (position == c.end() || key_compare(key(v), key(*position))))
+            return c.insert(position, v);
+        return insert_unique(v).first;
+    }
+
+    template<class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+        rep_type batch(first, last);
+        if(batch.empty())
+            return;
+        sort_batch(batch.begin(), batch.end());
+
+        // 就地压缩batch, 只保留第一次出现且表中不存在的键
+        // 表中的查找位置随batch单调后移, 每次只在剩余部分中二分
+        iterator out = batch.begin();
+        iterator pos = c.begin();
+        for(iterator it = batch.begin(); it != batch.end(); ++it)
+        {
+            if(out != batch.begin() && !key_compare(key(*(out - 1)), key(*it)))
+                continue;
+            pos = lower_bound(pos, c.end(), key(*it));
+            if(pos != c.end() && !key_compare(key(*it), key(*pos)))
+                continue;
+            if(out != it)
+                *out = *it;
+            ++out;
+        }
+        batch.erase(out, batch.end());
+        merge_sorted(batch);
+    }
+
+    iterator erase(iterator position)   {   return c.erase(position);   }
+
+    size_type erase(const key_type& k)
+    {
+        iterator first = lower_bound(c.begin(), c.end(), k);
+        iterator last = upper_bound(first, c.end(), k);
+        size_type n = last - first;
+        c.erase(first, last);
+        return n;
+    }
+
+    iterator erase(iterator first, iterator last)   {   return c.erase(first, last);    }
+    void clear()    {   c.clear();  }
+
+public:
+    iterator find(const key_type& k)
+    {
+        iterator i = lower_bound(c.begin(), c.end(), k);
+        return (i == c.end() || key_compare(k, key(*i))) ? c.end() : i;
+    }
+    const_iterator find(const key_type& k) const
+    {
+        const_iterator i = lower_bound(c.begin(), c.end(), k);
+        return (i == c.end() || key_compare(k, key(*i))) ? c.end() : i;
+    }
+
+    size_type count(const key_type& k) const
+    {
+        const_iterator first = lower_bound(c.begin(), c.end(), k);
+        return upper_bound(first, c.end(), k) - first;
+    }
+
+    iterator lower_bound(const key_type& k)     {   return lower_bound(c.begin(), c.end(), k);  }
+    const_iterator lower_bound(const key_type& k) const {   return lower_bound(c.begin(), c.end(), k);  }
+    iterator upper_bound(const key_type& k)     {   return upper_bound(c.begin(), c.end(), k);  }
+    const_iterator upper_bound(const key_type& k) const {   return upper_bound(c.begin(), c.end(), k);  }
+
+    pair<iterator, iterator> equal_range(const key_type& k)
+    {
+        iterator first = lower_bound(k);
+        return pair<iterator, iterator>(first, upper_bound(first, c.end(), k));
+    }
+    pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+    {
+        const_iterator first = lower_bound(k);
+        return pair<const_iterator, const_iterator>(first, upper_bound(first, c.end(), k));
+    }
+
+    template<class K1, class V1, class KoV1, class C1, class A1>
+    friend bool operator==(const flat_tree<K1, V1, KoV1, C1, A1>&, const flat_tree<K1, V1, KoV1, C1, A1>&);
+    template<class K1, class V1, class KoV1, class C1, class A1>
+    friend bool operator<(const flat_tree<K1, V1, KoV1, C1, A1>&, const flat_tree<K1, V1, KoV1, C1, A1>&);
+};
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator==(const flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& x,
+                       const flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& y)
+{
+    return x.c == y.c;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator<(const flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& x,
+                      const flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& y)
+{
+    return x.c < y.c;
+}
+
+#endif // __STL_FLAT_TREE_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __STL_FUNCTION_H
 
 // STL函数对象及函数适配器的实现
+// 函数对象、适配器及其辅助函数都是 constexpr, 可以在常量表达式与C++14的 constexpr 算法中使用
 
 // 融入STL中的仿函数和函数适配器必须继承自下面两个基类
 // 一元函数对象的基类, 提供参数类型和返回值类型供函数适配器使用
@@ -25,82 +26,82 @@ struct binary_function
 template<class T>
 struct plus : public binary_function<T, T, T>
 {
-    T operator()(const T& x, const T& y) const   {   return x + y; }
+    constexpr T operator()(const T& x, const T& y) const   {   return x + y; }
 };
 
 template<class T>
 struct minus : public binary_function<T, T, T>
 {
-    T operator()(const T& x, const T& y) const   {   return x - y; }
+    constexpr T operator()(const T& x, const T& y) const   {   return x - y; }
 };
 
 template<class T>
 struct multiplies : public binary_function<T, T, T>
 {
-    T operator()(const T& x, const T& y) const  {   return x * y; }
+    constexpr T operator()(const T& x, const T& y) const  {   return x * y; }
 };
 
 template<class T>
 struct divides : public binary_function<T, T, T>
 {
-    T operator()(const T& x, const T& y) const    {   return x / y; }
+    constexpr T operator()(const T& x, const T& y) const    {   return x / y; }
 };
 
 template<class T>
 struct modulus : public binary_function<T, T, T>
 {
-    T operator()(const T& x, const T& y) const    {   return x % y; }
+    constexpr T operator()(const T& x, const T& y) const    {   return x % y; }
 };
 
 template<class T>
 struct negate : public unary_function<T, T>
 {
-    T operator()(const T& x) const   {   return -x; }
+    constexpr T operator()(const T& x) const   {   return -x; }
 };
 
 // 某种运算的证同元素, A和该元素做运算, 得到自身
 template<class T>
-inline T identity_element(plus<T>)  {   return T(0);   }
+inline constexpr T identity_element(plus<T>)  {   return T(0);   }
 
 template<class T>
-inline T identity_element(multiplies<T>)  {   return T(1);   }
+inline constexpr T identity_element(multiplies<T>)  {   return T(1);   }
 
 
 // ============================================ 关系类函数对象
 template <class T>
 struct equal_to : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x == y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x == y; }
 };
 
 template <class T>
 struct not_equal_to : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x != y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x != y; }
 };
 
 template <class T>
 struct greater : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x > y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x > y; }
 };
 
 template <class T>
 struct less : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x < y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x < y; }
 };
 
 template <class T>
 struct greater_equal : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x >= y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x >= y; }
 };
 
 template <class T>
 struct less_equal : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x <= y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x <= y; }
 };
 
 
@@ -108,32 +109,32 @@ struct less_equal : public binary_function<T, T, bool>
 template <class T>
 struct logical_and : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x && y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x && y; }
 };
 
 template <class T>
 struct logical_or : public binary_function<T, T, bool> 
 {
-    bool operator()(const T& x, const T& y) const { return x || y; }
+    constexpr bool operator()(const T& x, const T& y) const { return x || y; }
 };
 
 template <class T>
 struct logical_not : public unary_function<T, bool> 
 {
-    bool operator()(const T& x) const { return !x; }
+    constexpr bool operator()(const T& x) const { return !x; }
 };
 
 // =========================================== SGI STL 额外补充
 template<class T>
 struct identity : public unary_function<T, T>
 {
-    const T& operator()(const T& x) const   {   return x;   }
+    constexpr const T& operator()(const T& x) const   {   return x;   }
 };
 
 template<class Pair>
 struct select1st : public unary_function<Pair, typename Pair::first_type>
 {
-    const typename Pair::first_type& operator()(const Pair& x) const
+    constexpr const typename Pair::first_type& operator()(const Pair& x) const
     {
         return x.first;
     }
@@ -142,7 +143,7 @@ struct select1st : public unary_function<Pair, typename Pair::first_type>
 template<class Pair>
 struct select2nd : public unary_function<Pair, typename Pair::second_type>
 {
-    const typename Pair::second_type& operator()(const Pair& x) const
+    constexpr const typename Pair::second_type& operator()(const Pair& x) const
     {
         return x.second;
     }
@@ -151,13 +152,42 @@ struct select2nd : public unary_function<Pair, typename Pair::second_type>
 template<class Arg1, class Arg2>
 struct project1st : public binary_function<Arg1, Arg2, Arg1>
 {
-    Arg1 operator()(const Arg1& x, const Arg2& y) const     {   return x;   }
+    constexpr Arg1 operator()(const Arg1& x, const Arg2& y) const     {   return x;   }
 };
 
 template<class Arg1, class Arg2>
 struct project2nd : public binary_function<Arg1, Arg2, Arg2>
 {
-    Arg2 operator()(const Arg1& x, const Arg2& y) const    {   return y;   }
+    constexpr Arg2 operator()(const Arg1& x, const Arg2& y) const    {   return y;   }
+};
+
+
+// ============================ 空函数对象不占空间
+// 适配器保存的函数对象大多是空类(less<T>, plus<T>...), 作为数据成员时每个仍要占至少1字节, 再加上对齐
+// __ebo_storage 对空类使用私有继承, 借助空基类优化不占空间; 非空类型(包括函数指针)仍作为数据成员
+// Index 用于区分同一个适配器中类型相同的多个函数对象
+// 适配器自己声明 argument_type / result_type, 不再继承 unary_function / binary_function,
+// 否则函数对象本身也继承自同一个 unary_function 时, 同一个基类会出现两次
+template<class T, int Index = 0, bool Empty = __is_empty(T) && !__is_final(T)>
+class __ebo_storage
+{
+private:
+    T value;
+public:
+    constexpr __ebo_storage() : value() {}
+    constexpr explicit __ebo_storage(const T& x) : value(x) {}
+    T& get()                        {   return value;   }
+    constexpr const T& get() const  {   return value;   }
+};
+
+template<class T, int Index>
+class __ebo_storage<T, Index, true> : private T
+{
+public:
+    constexpr __ebo_storage() : T() {}
+    constexpr explicit __ebo_storage(const T& x) : T(x) {}
+    T& get()                        {   return *this;   }
+    constexpr const T& get() const  {   return *this;   }
 };
 
 
@@ -165,86 +195,98 @@ struct project2nd : public binary_function<Arg1, Arg2, Arg2>
 // 原来函数对象的返回值是bool类型
 
 // 一元
-template<class Predicate>   // 修饰的函数对象的类型, 继承是为了能够再次被适配
-class unary_negate : public unary_function<typename Predicate::argument_type, bool>
+template<class Predicate>   // 修饰的函数对象的类型, 提供参数类型是为了能够再次被适配
+class unary_negate : private __ebo_storage<Predicate>
 {
-protected:
-    Predicate pred;
 public:
-    explicit unary_negate(const Predicate& x) : pred(x) {}
-    bool operator()(const typename Predicate::argument_type& x) const {   return !pred(x);    }
+    typedef typename Predicate::argument_type argument_type;
+    typedef bool result_type;
+
+    constexpr explicit unary_negate(const Predicate& x) : __ebo_storage<Predicate>(x) {}
+    constexpr bool operator()(const argument_type& x) const {   return !this->get()(x);    }
 };
 
 template<class Predicate>
-inline unary_negate<Predicate> not1(const Predicate& x)
+inline constexpr unary_negate<Predicate> not1(const Predicate& x)
 {
     return unary_negate<Predicate>(x);      // 返回一个容器适配器对象
 }
 
 // 二元
 template<class Predicate>   // 修饰的函数对象的类型
-class binary_negate : public binary_function<typename Predicate::first_argument_type, 
-                                            typename Predicate::second_argument_type, bool>
+class binary_negate : private __ebo_storage<Predicate>
 {
-protected:
-    Predicate pred;
 public:
-    binary_negate(const Predicate& x) : pred(x) {}
-    bool operator()(const typename Predicate::first_argument_type& x, const typename Predicate::second_argument_type& y) const
+    typedef typename Predicate::first_argument_type first_argument_type;
+    typedef typename Predicate::second_argument_type second_argument_type;
+    typedef bool result_type;
+
+    constexpr binary_negate(const Predicate& x) : __ebo_storage<Predicate>(x) {}
+    constexpr bool operator()(const first_argument_type& x, const second_argument_type& y) const
     {
-        return !pred(x, y);
+        return !this->get()(x, y);
     }
 };
 
 template<class Predicate>
-inline binary_negate<Predicate> not2(const Predicate& x)
+inline constexpr binary_negate<Predicate> not2(const Predicate& x)
 {
     return binary_negate<Predicate>(x);
 }
 
 
 // ============================ 对参数进行绑定 bind1st, bind2nd
+// 空的函数对象不占空间, bind2nd(less<int>(), 0) 的大小与一个int相同
 template<class Operation>
-class binder1st : binary_function<typename Operation::first_argument_type, typename Operation::second_argument_type,
-                                typename Operation::result_type>
+class binder1st : private __ebo_storage<Operation>
 {
+public:
+    typedef typename Operation::second_argument_type argument_type;
+    typedef typename Operation::result_type result_type;
+
 protected:
-    Operation op;
     typename Operation::first_argument_type arg1;
 
 public:
-    explicit binder1st(const Operation& x, const typename Operation::first_argument_type& y) : op(x), arg1(y)  {}
-    typename Operation::result_type operator()(const typename Operation::second_argument_type& x) const
+    constexpr explicit binder1st(const Operation& x, const typename Operation::first_argument_type& y)
+        : __ebo_storage<Operation>(x), arg1(y)  {}
+    constexpr result_type operator()(const argument_type& x) const
     {
-        return op(arg1, x);
+        return this->get()(arg1, x);
     }
+    // 被绑定的参数, 供算法识别 bind1st(equal_to<T>(), value) 这类谓词
+    constexpr const typename Operation::first_argument_type& argument() const {   return arg1;    }
 };
 
 template<class Operation, class T>
-inline binder1st<Operation> bind1st(const Operation& op, const T& x)
+inline constexpr binder1st<Operation> bind1st(const Operation& op, const T& x)
 {   
     typedef typename Operation::first_argument_type first_argument_type;
     return binder1st<Operation>(op, first_argument_type(x));    // 进行类型转换
 }
 
 template<class Operation>
-class binder2nd : binary_function<typename Operation::first_argument_type, typename Operation::second_argument_type,
-                                typename Operation::result_type>
+class binder2nd : private __ebo_storage<Operation>
 {
+public:
+    typedef typename Operation::first_argument_type argument_type;
+    typedef typename Operation::result_type result_type;
+
 protected:
-    Operation op;
     typename Operation::second_argument_type arg2;
 
 public:
-    explicit binder2nd(const Operation& x, const typename Operation::second_argument_type& y) : op(x), arg2(y)  {}
-    typename Operation::result_type operator()(const typename Operation::first_argument_type& x) const
+    constexpr explicit binder2nd(const Operation& x, const typename Operation::second_argument_type& y)
+        : __ebo_storage<Operation>(x), arg2(y)  {}
+    constexpr result_type operator()(const argument_type& x) const
     {
-        return op(x, arg2);
+        return this->get()(x, arg2);
     }
+    constexpr const typename Operation::second_argument_type& argument() const    {   return arg2;    }
 };
 
 template<class Operation, class T>
-inline binder2nd<Operation> bind2nd(const Operation& op, const T& x)
+inline constexpr binder2nd<Operation> bind2nd(const Operation& op, const T& x)
 {
     typedef typename Operation::second_argument_type second_argument_type;
     return binder2nd<Operation>(op, second_argument_type(x));
@@ -253,43 +295,50 @@ inline binder2nd<Operation> bind2nd(const Operation& op, const T& x)
 // ============================ 用于函数复合 compose1, compose2
 // compose1  h = f(g(x))
 template<class Operation1, class Operation2>
-class unary_compose : public unary_function<typename Operation2::argument_type, typename Operation1::result_type>
+class unary_compose : private __ebo_storage<Operation1, 0>, private __ebo_storage<Operation2, 1>
 {
-protected:
-    Operation1 f;
-    Operation2 g;
+private:
+    typedef __ebo_storage<Operation1, 0> f;
+    typedef __ebo_storage<Operation2, 1> g;
 public:
-    unary_compose(const Operation1& _f, const Operation2& _g) : f(_f), g(_g)    {}
-    typename Operation1::result_type operator()(const typename Operation2::argument_type& x) const 
+    typedef typename Operation2::argument_type argument_type;
+    typedef typename Operation1::result_type result_type;
+
+    constexpr unary_compose(const Operation1& _f, const Operation2& _g) : f(_f), g(_g)    {}
+    constexpr result_type operator()(const argument_type& x) const 
     {
-        return f(g(x));
+        return f::get()(g::get()(x));
     }
 };
 
 template<class Operation1, class Operation2>
-inline unary_compose<Operation1, Operation2> compose1(const Operation1& f, const Operation2& g)
+inline constexpr unary_compose<Operation1, Operation2> compose1(const Operation1& f, const Operation2& g)
 {
     return unary_compose<Operation1, Operation2>(f, g);
 }
 
 // compose2 h = f(g1(x), g2(x))
 template<class Operation1, class Operation2, class Operation3>
-class binary_compose : public unary_function<typename Operation2::argument_type, typename Operation1::result_type>
+class binary_compose : private __ebo_storage<Operation1, 0>, private __ebo_storage<Operation2, 1>,
+                       private __ebo_storage<Operation3, 2>
 {
-protected:
-    Operation1 f;
-    Operation2 g1;
-    Operation3 g2;
+private:
+    typedef __ebo_storage<Operation1, 0> f;
+    typedef __ebo_storage<Operation2, 1> g1;
+    typedef __ebo_storage<Operation3, 2> g2;
 public:
-    binary_compose(const Operation1& _f, const Operation2& _g1, const Operation3& _g2) : f(_f), g1(_g1), g2(_g2)    {}
-    typename Operation1::result_type operator()(const typename Operation2::argument_type& x) const 
+    typedef typename Operation2::argument_type argument_type;
+    typedef typename Operation1::result_type result_type;
+
+    constexpr binary_compose(const Operation1& _f, const Operation2& _g1, const Operation3& _g2) : f(_f), g1(_g1), g2(_g2)    {}
+    constexpr result_type operator()(const argument_type& x) const 
     {
-        return f(g1(x), g2(x));
+        return f::get()(g1::get()(x), g2::get()(x));
     }
 };
 
 template<class Operation1, class Operation2, class Operation3>
-inline binary_compose<Operation1, Operation2, Operation3> compose2(const Operation1& f, const Operation2& g1, const Operation3& g2)
+inline constexpr binary_compose<Operation1, Operation2, Operation3> compose2(const Operation1& f, const Operation2& g1, const Operation3& g2)
 {
     return binary_compose<Operation1, Operation2, Operation3>(f, g1, g2);
 }
@@ -302,15 +351,15 @@ class pointer_to_unary_function : public unary_function<Arg, Result>
 protected:
     Result (*ptr)(Arg);
 public:
-    pointer_to_unary_function(Result (*x)(Arg)) : ptr(x) {}
-    Result operator()(const Arg& arg) const
+    constexpr pointer_to_unary_function(Result (*x)(Arg)) : ptr(x) {}
+    constexpr Result operator()(const Arg& arg) const
     {
         return ptr(arg);
     }
 };
 
 template<class Arg, class Result>
-inline pointer_to_unary_function<Arg, Result> ptr_fun(Result(*x)(Arg))
+inline constexpr pointer_to_unary_function<Arg, Result> ptr_fun(Result(*x)(Arg))
 {
     return pointer_to_unary_function<Arg, Result>(x);
 }
@@ -321,15 +370,15 @@ class pointer_to_binary_function : public binary_function<Arg1, Arg2, Result>
 protected:
     Result (*ptr)(Arg1, Arg2);
 public:
-    pointer_to_binary_function(Result (*x)(Arg1, Arg2)) : ptr(x) {}
-    Result operator()(const Arg1& arg1, const Arg2& arg2) const
+    constexpr pointer_to_binary_function(Result (*x)(Arg1, Arg2)) : ptr(x) {}
+    constexpr Result operator()(const Arg1& arg1, const Arg2& arg2) const
     {
         return ptr(arg1, arg2);
     }
 };
 
 template<class Arg1, class Arg2, class Result>
-inline pointer_to_binary_function<Arg1, Arg2, Result> ptr_fun(Result(*x)(Arg1, Arg2))
+inline constexpr pointer_to_binary_function<Arg1, Arg2, Result> ptr_fun(Result(*x)(Arg1, Arg2))
 {
     return pointer_to_binary_function<Arg1, Arg2, Result>(x);
 }
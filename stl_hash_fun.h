@@ -0,0 +1,287 @@
+#ifndef __STL_HASH_FUN_H
+#define __STL_HASH_FUN_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>  // size_t
+#include <cstring>  // memcpy, strlen
+
+#include "type_traits.h"
+
+// hash函数对象, 供hashtable计算键值的散列值
+// 泛化版本没有定义 operator(), 使用未特化的类型会在编译期报错
+//
+// 整数与指针: 与一个奇常数做64x64->128位乘法, 高低两半异或(multiply-xorshift), 一次乘法即可让每一位影响全部输出
+// 字符串: wyhash 风格, 长度不超过16字节时只读两次, 更长时每步读入16字节, 超过48字节时三路并行每步48字节
+// 输出的各位已经充分打散, hashtable 不再对它们做一次 __hash_mix (见 __hash_is_avalanching)
+//
+// hash<T> 使用固定的种子, 结果在同一平台上是确定的; 键值可能由外部构造(哈希碰撞攻击)时使用 seeded_hash<T>,
+// 每个对象在构造时取一个随机种子, 也可以显式指定:
+//
+//  hash_map<const char*, int, seeded_hash<const char*>, str_equal> m;
+//  seeded_hash<int> h(42);
+
+template<class Key>
+struct hash {};
+
+// ========================================= 基本运算
+static const unsigned long long __hash_p0 = 0xa0761d6478bd642fULL;
+static const unsigned long long __hash_p1 = 0xe7037ed1a0b428dbULL;
+static const unsigned long long __hash_p2 = 0x8ebc6af09c88c6e3ULL;
+static const unsigned long long __hash_p3 = 0x589965cc75374cc3ULL;
+static const unsigned long long __hash_golden = 0x9e3779b97f4a7c15ULL;
+
+// 128位乘积的低64位与高64位
+inline void __hash_mul128(unsigned long long a, unsigned long long b, unsigned long long& lo, unsigned long long& hi)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = (unsigned __int128)a * b;
+    lo = (unsigned long long)r;
+    hi = (unsigned long long)(r >> 64);
+#else
+    unsigned long long ha = a >> 32, la = (unsigned int)a, hb = b >> 32, lb = (unsigned int)b;
+    unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    unsigned long long t = rl + (rm0 << 32);
+    unsigned long long c = t < rl;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline unsigned long long __hash_mum(unsigned long long a, unsigned long long b)
+{
+    unsigned long long lo, hi;
+    __hash_mul128(a, b, lo, hi);
+    return lo ^ hi;
+}
+
+// 按小端序读入, 不要求对齐
+inline unsigned long long __hash_read8(const unsigned char* p)
+{
+    unsigned long long v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline unsigned long long __hash_read4(const unsigned char* p)
+{
+    unsigned int v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// 1~3字节: 首、中、尾三个字节
+inline unsigned long long __hash_read3(const unsigned char* p, size_t len)
+{
+    return ((unsigned long long)p[0] << 16) | ((unsigned long long)p[len >> 1] << 8) | p[len - 1];
+}
+
+// ========================================= 整数与字节串
+inline size_t __hash_int(unsigned long long x, unsigned long long seed)
+{
+    return size_t(__hash_mum(x ^ seed, __hash_golden));
+}
+
+inline size_t __hash_bytes(const void* key, size_t len, unsigned long long seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(key);
+    seed ^= __hash_mum(seed ^ __hash_p0, __hash_p1);
+    unsigned long long a, b;
+    if(len <= 16)
+    {
+        if(len >= 4)
+        {
+            // 两次读入覆盖全部字节, 中间可能重叠
+            const size_t mid = (len >> 3) << 2;
+            a = (__hash_read4(p) << 32) | __hash_read4(p + mid);
+            b = (__hash_read4(p + len - 4) << 32) | __hash_read4(p + len - 4 - mid);
+        }
+        else if(len > 0)
+        {
+            a = __hash_read3(p, len);
+            b = 0;
+        }
+        else
+            a = b = 0;
+    }
+    else
+    {
+        size_t i = len;
+        if(i > 48)
+        {
+            // 三条独立的依赖链, 乘法可以重叠执行
+            unsigned long long see1 = seed, see2 = seed;
+            do
+            {
+                seed = __hash_mum(__hash_read8(p) ^ __hash_p1, __hash_read8(p + 8) ^ seed);
+                see1 = __hash_mum(__hash_read8(p + 16) ^ __hash_p2, __hash_read8(p + 24) ^ see1);
+                see2 = __hash_mum(__hash_read8(p + 32) ^ __hash_p3, __hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while(i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while(i > 16)
+        {
+            seed = __hash_mum(__hash_read8(p) ^ __hash_p1, __hash_read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // 最后16字节, 可能与已处理的部分重叠
+        a = __hash_read8(p + i - 16);
+        b = __hash_read8(p + i - 8);
+    }
+    __hash_mul128(a ^ __hash_p1, b ^ seed, a, b);
+    return size_t(__hash_mum(a ^ __hash_p0 ^ len, b ^ __hash_p1));
+}
+
+inline size_t __hash_string(const char* s, unsigned long long seed)
+{
+    return __hash_bytes(s, strlen(s), seed);
+}
+
+// 时间与栈、静态区的地址(ASLR)混合而成, 不是密码学意义上的随机数, 只用于让攻击者无法预先构造碰撞
+inline unsigned long long __hash_random_seed()
+{
+    static std::atomic<unsigned long long> counter(0);
+    int local;
+    unsigned long long t = (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count();
+    unsigned long long seed = __hash_mum(t ^ __hash_p0, (unsigned long long)(size_t)&local ^ __hash_p1);
+    return __hash_mum(seed ^ (unsigned long long)(size_t)&counter, counter.fetch_add(1) ^ __hash_p2);
+}
+
+// ========================================= hash
+// 字符串
+template<>
+struct hash<char*>
+{
+    size_t operator()(const char* s) const  {   return __hash_string(s, 0);    }
+};
+
+template<>
+struct hash<const char*>
+{
+    size_t operator()(const char* s) const  {   return __hash_string(s, 0);    }
+};
+
+// 整数, 有符号类型先转换为 unsigned long long (符号扩展)
+template<class T>
+struct __integer_hash
+{
+    size_t operator()(T x) const    {   return __hash_int((unsigned long long)x, 0);    }
+};
+
+template<> struct hash<bool> : public __integer_hash<bool> {};
+template<> struct hash<char> : public __integer_hash<char> {};
+template<> struct hash<signed char> : public __integer_hash<signed char> {};
+template<> struct hash<unsigned char> : public __integer_hash<unsigned char> {};
+template<> struct hash<wchar_t> : public __integer_hash<wchar_t> {};
+template<> struct hash<short> : public __integer_hash<short> {};
+template<> struct hash<unsigned short> : public __integer_hash<unsigned short> {};
+template<> struct hash<int> : public __integer_hash<int> {};
+template<> struct hash<unsigned int> : public __integer_hash<unsigned int> {};
+template<> struct hash<long> : public __integer_hash<long> {};
+template<> struct hash<unsigned long> : public __integer_hash<unsigned long> {};
+template<> struct hash<long long> : public __integer_hash<long long> {};
+template<> struct hash<unsigned long long> : public __integer_hash<unsigned long long> {};
+
+// 其他指针按地址散列; char* 与 const char* 是字符串, 使用上面的完全特化版本
+template<class T>
+struct hash<T*>
+{
+    size_t operator()(T* p) const   {   return __hash_int((unsigned long long)(size_t)p, 0);    }
+};
+
+// ========================================= seeded_hash
+// 与 hash<Key> 支持相同的类型, 多保存一个种子
+template<class Key>
+struct seeded_hash
+{
+    unsigned long long seed;
+
+    seeded_hash() : seed(__hash_random_seed())  {}
+    explicit seeded_hash(unsigned long long s) : seed(s)    {}
+
+    size_t operator()(Key x) const  {   return __hash_int((unsigned long long)x, seed);    }
+};
+
+template<>
+struct seeded_hash<char*>
+{
+    unsigned long long seed;
+
+    seeded_hash() : seed(__hash_random_seed())  {}
+    explicit seeded_hash(unsigned long long s) : seed(s)    {}
+
+    size_t operator()(const char* s) const  {   return __hash_string(s, seed);  }
+};
+
+template<>
+struct seeded_hash<const char*> : public seeded_hash<char*>
+{
+    seeded_hash()   {}
+    explicit seeded_hash(unsigned long long s) : seeded_hash<char*>(s)  {}
+};
+
+template<class T>
+struct seeded_hash<T*>
+{
+    unsigned long long seed;
+
+    seeded_hash() : seed(__hash_random_seed())  {}
+    explicit seeded_hash(unsigned long long s) : seed(s)    {}
+
+    size_t operator()(T* p) const   {   return __hash_int((unsigned long long)(size_t)p, seed);  }
+};
+
+// ========================================= __hash_is_avalanching
+// 散列值的每一位是否都已充分打散; 是则hashtable直接使用, 否则先经过 __hash_mix
+// 用户自定义的散列函数默认不是, 可以为它特化此模板
+// 只为上面定义的整数、指针、字符串版本特化; 用户为自己的类型特化的 hash<Key> 仍要经过 __hash_mix
+template<class HashFcn>
+struct __hash_is_avalanching
+{
+    typedef __false_type type;
+};
+
+struct __avalanching_hash
+{
+    typedef __true_type type;
+};
+
+template<> struct __hash_is_avalanching<hash<bool> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<char> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<signed char> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<unsigned char> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<wchar_t> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<short> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<unsigned short> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<int> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<unsigned int> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<unsigned long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<long long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<unsigned long long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<char*> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<hash<const char*> > : public __avalanching_hash {};
+template<class T> struct __hash_is_avalanching<hash<T*> > : public __avalanching_hash {};
+
+template<> struct __hash_is_avalanching<seeded_hash<bool> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<char> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<signed char> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<unsigned char> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<wchar_t> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<short> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<unsigned short> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<int> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<unsigned int> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<unsigned long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<long long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<unsigned long long> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<char*> > : public __avalanching_hash {};
+template<> struct __hash_is_avalanching<seeded_hash<const char*> > : public __avalanching_hash {};
+template<class T> struct __hash_is_avalanching<seeded_hash<T*> > : public __avalanching_hash {};
+
+#endif // __STL_HASH_FUN_H
\ No newline at end of file
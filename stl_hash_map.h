@@ -0,0 +1,90 @@
+#ifndef __STL_HASH_MAP_H
+#define __STL_HASH_MAP_H
+
+#include "stl_alloc.h"
+#include "stl_function.h"
+#include "stl_hash_fun.h"
+#include "stl_hashtable.h"
+#include "stl_pair.h"
+
+// hash_map: 元素为 pair<const Key, T>, 以hashtable为底层实现, 所有操作都转调用hashtable的接口
+// 通过 select1st 从元素中取出键值
+
+template<class Key, class T, class HashFcn = hash<Key>, class EqualKey = equal_to<Key>, class Alloc = alloc>
+class hash_map
+{
+private:
+    typedef hashtable<pair<const Key, T>, Key, HashFcn, select1st<pair<const Key, T> >, EqualKey, Alloc> ht;
+    ht rep;
+
+public:
+    typedef typename ht::key_type key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef typename ht::value_type value_type;
+    typedef typename ht::hasher hasher;
+    typedef typename ht::key_equal key_equal;
+
+    typedef typename ht::size_type size_type;
+    typedef typename ht::difference_type difference_type;
+    typedef typename ht::pointer pointer;
+    typedef typename ht::const_pointer const_pointer;
+    typedef typename ht::reference reference;
+    typedef typename ht::const_reference const_reference;
+
+    typedef typename ht::iterator iterator;
+    typedef typename ht::const_iterator const_iterator;
+
+    hasher hash_funct() const   {   return rep.hash_funct();    }
+    key_equal key_eq() const    {   return rep.key_eq();    }
+
+public:
+    // 默认不分配任何槽位, 第一次插入时才分配
+    hash_map() : rep(0, hasher(), key_equal())  {}
+    explicit hash_map(size_type n) : rep(n, hasher(), key_equal())  {}
+    hash_map(size_type n, const hasher& hf) : rep(n, hf, key_equal())   {}
+    hash_map(size_type n, const hasher& hf, const key_equal& eql) : rep(n, hf, eql) {}
+
+    template<class InputIterator>
+    hash_map(InputIterator first, InputIterator last) : rep(0, hasher(), key_equal())
+    {
+        rep.insert_unique(first, last);
+    }
+
+public:
+    size_type size() const      {   return rep.size();  }
+    size_type max_size() const  {   return rep.max_size();  }
+    bool empty() const          {   return rep.empty(); }
+    void swap(hash_map& hm)     {   rep.swap(hm.rep);   }
+
+    iterator begin()    {   return rep.begin(); }
+    iterator end()      {   return rep.end();   }
+    const_iterator begin() const    {   return rep.begin(); }
+    const_iterator end() const      {   return rep.end();   }
+
+public:
+    pair<iterator, bool> insert(const value_type& obj)  {   return rep.insert_unique(obj);  }
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   rep.insert_unique(first, last); }
+
+    iterator find(const key_type& key)              {   return rep.find(key);   }
+    const_iterator find(const key_type& key) const  {   return rep.find(key);   }
+    size_type count(const key_type& key) const      {   return rep.count(key);  }
+
+    // 键值不存在时插入 pair(key, T())
+    T& operator[](const key_type& key)
+    {
+        return rep.find_or_insert(value_type(key, T())).second;
+    }
+
+    size_type erase(const key_type& key)    {   return rep.erase(key);  }
+    void erase(iterator it)                 {   rep.erase(it);  }
+    void erase(iterator first, iterator last)   {   rep.erase(first, last); }
+    void clear()    {   rep.clear();    }
+
+public:
+    void resize(size_type hint)     {   rep.resize(hint);   }
+    size_type bucket_count() const  {   return rep.bucket_count();  }
+};
+
+#endif // __STL_HASH_MAP_H
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef __STL_HASH_SET_H
+#define __STL_HASH_SET_H
+
+#include "stl_alloc.h"
+#include "stl_function.h"
+#include "stl_hash_fun.h"
+#include "stl_hashtable.h"
+#include "stl_pair.h"
+
+// hash_set: 元素即键值, 以hashtable为底层实现, 所有操作都转调用hashtable的接口
+// 元素不允许修改, 迭代器都是const_iterator
+
+template<class Value, class HashFcn = hash<Value>, class EqualKey = equal_to<Value>, class Alloc = alloc>
+class hash_set
+{
+private:
+    typedef hashtable<Value, Value, HashFcn, identity<Value>, EqualKey, Alloc> ht;
+    ht rep;
+
+public:
+    typedef typename ht::key_type key_type;
+    typedef typename ht::value_type value_type;
+    typedef typename ht::hasher hasher;
+    typedef typename ht::key_equal key_equal;
+
+    typedef typename ht::size_type size_type;
+    typedef typename ht::difference_type difference_type;
+    typedef typename ht::const_pointer pointer;
+    typedef typename ht::const_pointer const_pointer;
+    typedef typename ht::const_reference reference;
+    typedef typename ht::const_reference const_reference;
+
+    typedef typename ht::const_iterator iterator;
+    typedef typename ht::const_iterator const_iterator;
+
+    hasher hash_funct() const   {   return rep.hash_funct();    }
+    key_equal key_eq() const    {   return rep.key_eq();    }
+
+public:
+    // 默认不分配任何槽位, 第一次插入时才分配
+    hash_set() : rep(0, hasher(), key_equal())  {}
+    explicit hash_set(size_type n) : rep(n, hasher(), key_equal())  {}
+    hash_set(size_type n, const hasher& hf) : rep(n, hf, key_equal())   {}
+    hash_set(size_type n, const hasher& hf, const key_equal& eql) : rep(n, hf, eql) {}
+
+    template<class InputIterator>
+    hash_set(InputIterator first, InputIterator last) : rep(0, hasher(), key_equal())
+    {
+        rep.insert_unique(first, last);
+    }
+
+public:
+    size_type size() const      {   return rep.size();  }
+    size_type max_size() const  {   return rep.max_size();  }
+    bool empty() const          {   return rep.empty(); }
+    void swap(hash_set& hs)     {   rep.swap(hs.rep);   }
+
+    iterator begin() const  {   return rep.begin(); }
+    iterator end() const    {   return rep.end();   }
+
+public:
+    pair<iterator, bool> insert(const value_type& obj)
+    {
+        pair<typename ht::iterator, bool> p = rep.insert_unique(obj);
+        return pair<iterator, bool>(p.first, p.second);
+    }
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   rep.insert_unique(first, last); }
+
+    iterator find(const key_type& key) const    {   return rep.find(key);   }
+    size_type count(const key_type& key) const  {   return rep.count(key);  }
+
+    size_type erase(const key_type& key)    {   return rep.erase(key);  }
+    void erase(iterator it)                 {   rep.erase(it);  }
+    void erase(iterator first, iterator last)   {   rep.erase(first, last); }
+    void clear()    {   rep.clear();    }
+
+public:
+    void resize(size_type hint)     {   rep.resize(hint);   }
+    size_type bucket_count() const  {   return rep.bucket_count();  }
+};
+
+#endif // __STL_HASH_SET_H
\ No newline at end of file
@@ -0,0 +1,585 @@
+#ifndef __STL_HASHTABLE_H
+#define __STL_HASHTABLE_H
+
+#include <cstring>  // memset
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_hash_fun.h"
+#include "stl_iterator.h"
+#include "stl_pair.h"
+#include "type_traits.h"
+
+// 开放定址法的hashtable (Swiss table 风格), hash_set 和 hash_map 的底层实现
+// 1. 每个槽位对应一个字节的控制信息 ctrl, 槽位本身只存放元素
+//    empty:    0b10000000    空槽位, 探测遇到它即可停止
+//    deleted:  0b11111110    被删除的槽位(墓碑)
+//    sentinel: 0b11111111    ctrl数组末尾的哨兵, 迭代器遍历到此结束
+//    full:     0b0xxxxxxx    已占用, 低7位保存散列值的低7位(h2)
+// 2. 槽位以16个为一组, 散列值的高位(h1)决定起始组, 组间做三角探测
+//    查找时用SSE2一次比较一组16个ctrl字节, 只有h2匹配的槽位才需要比较键值,
+//    因此一次查找通常只访问一条ctrl缓存行和一条槽位缓存行
+// 3. 删除元素时, 如果所在组中还有empty槽位, 说明没有任何探测序列越过该组,
+//    可以直接标记为empty, 不必留下墓碑
+
+typedef signed char __ctrl_t;
+
+static const __ctrl_t __ctrl_empty = -128;
+static const __ctrl_t __ctrl_deleted = -2;
+static const __ctrl_t __ctrl_sentinel = -1;
+static const size_t __group_width = 16;
+
+inline unsigned __hashtable_ctz(unsigned x)
+{
+    return __builtin_ctz(x);
+}
+
+// 对用户提供的散列值再打散一次: 一轮 xorshift-乘法-xorshift (murmur3 fmix64 的前半部分, 少一次乘法),
+// 乘法把低位扩散到高位, 右移再把高位折回低位, 足以避免恒等散列让连续的键值挤在同一组中;
+// hash<T> 与 seeded_hash<T> 的结果已经打散, 直接使用
+inline size_t __hash_mix(size_t h, __false_type)
+{
+    unsigned long long x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return size_t(x);
+}
+
+inline size_t __hash_mix(size_t h, __true_type)
+{
+    return h;
+}
+
+inline size_t __hash_h1(size_t h)       {   return h >> 7;  }
+inline __ctrl_t __hash_h2(size_t h)     {   return __ctrl_t(h & 0x7f);  }
+
+// 一组16个ctrl字节, 各个match函数返回位图, 第i位为1表示第i个槽位满足条件
+struct __hashtable_group
+{
+    const __ctrl_t* ctrl;
+
+    explicit __hashtable_group(const __ctrl_t* p) : ctrl(p) {}
+
+#ifdef __SSE2__
+    unsigned match(__ctrl_t h2) const
+    {
+        __m128i c = _mm_loadu_si128((const __m128i*)ctrl);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), c));
+    }
+    unsigned match_empty() const
+    {
+        return match(__ctrl_empty);
+    }
+    // empty 和 deleted 都小于 sentinel
+    unsigned match_empty_or_deleted() const
+    {
+        __m128i c = _mm_loadu_si128((const __m128i*)ctrl);
+        return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(__ctrl_sentinel), c));
+    }
+#else
+    unsigned match(__ctrl_t h2) const
+    {
+        unsigned mask = 0;
+        for(size_t i = 0; i < __group_width; ++i)
+            if(ctrl[i] == h2)
+                mask |= 1u << i;
+        return mask;
+    }
+    unsigned match_empty() const
+    {
+        return match(__ctrl_empty);
+    }
+    unsigned match_empty_or_deleted() const
+    {
+        unsigned mask = 0;
+        for(size_t i = 0; i < __group_width; ++i)
+            if(ctrl[i] < __ctrl_sentinel)
+                mask |= 1u << i;
+        return mask;
+    }
+#endif
+    // 组首部连续的 empty 或 deleted 槽位个数
+    unsigned count_leading_empty_or_deleted() const
+    {
+        return __hashtable_ctz(~match_empty_or_deleted());
+    }
+};
+
+
+// ========================================= hashtable 的迭代器
+// ctrl 与 slot 同步前进, 跳过 empty 和 deleted 槽位, 遇到 sentinel 停止
+template<class Value, class Ref, class Ptr>
+struct __hashtable_iterator
+{
+    typedef __hashtable_iterator<Value, Value&, Value*> iterator;
+    typedef __hashtable_iterator<Value, const Value&, const Value*> const_iterator;
+    typedef __hashtable_iterator<Value, Ref, Ptr> self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+
+    const __ctrl_t* ctrl;
+    Value* slot;
+
+    __hashtable_iterator() : ctrl(0), slot(0) {}
+    __hashtable_iterator(const __ctrl_t* c, Value* s) : ctrl(c), slot(s)  {}
+    __hashtable_iterator(const iterator& x) : ctrl(x.ctrl), slot(x.slot)  {}
+    self& operator=(const self& x) = default;
+
+    reference operator*() const {   return *slot;   }
+    pointer operator->() const  {   return slot;    }
+
+    self& operator++()
+    {
+        ++ctrl;
+        ++slot;
+        skip_empty_or_deleted();
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& x) const    {   return ctrl == x.ctrl;  }
+    bool operator!=(const self& x) const    {   return ctrl != x.ctrl;  }
+
+    // 一次跳过一组中开头的所有空槽位
+    void skip_empty_or_deleted()
+    {
+        while(*ctrl < __ctrl_sentinel)
+        {
+            unsigned shift = __hashtable_group(ctrl).count_leading_empty_or_deleted();
+            ctrl += shift;
+            slot += shift;
+        }
+    }
+};
+
+
+// ========================================= hashtable
+// Value: 元素类型, Key: 键值类型, HashFcn: 散列函数, ExtractKey: 从元素中取出键值
+// EqualKey: 判断键值是否相等, Alloc: 空间配置器
+template<class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc = alloc>
+class hashtable
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+
+    typedef __hashtable_iterator<Value, Value&, Value*> iterator;
+    typedef __hashtable_iterator<Value, const Value&, const Value*> const_iterator;
+
+    hasher hash_funct() const   {   return hash;    }
+    key_equal key_eq() const    {   return equals;  }
+
+private:
+    typedef simple_alloc<__ctrl_t, Alloc> ctrl_allocator;
+    typedef simple_alloc<value_type, Alloc> slot_allocator;
+
+    static const size_type npos = size_type(-1);
+
+    hasher hash;
+    key_equal equals;
+    ExtractKey get_key;
+
+    __ctrl_t* ctrl;             // capacity + __group_width 个字节, 末尾一组都是 sentinel
+    value_type* slots;          // capacity 个槽位
+    size_type capacity;         // 0 或者 __group_width 乘以2的幂
+    size_type num_elements;
+    size_type growth_left;      // 还能填充多少个empty槽位而不需要扩容, 最大负载因子为 7/8
+
+public:
+    hashtable(size_type n, const HashFcn& hf, const EqualKey& eql, const ExtractKey& ext)
+        : hash(hf), equals(eql), get_key(ext),
+          ctrl(0), slots(0), capacity(0), num_elements(0), growth_left(0)
+    {
+        resize(n);
+    }
+
+    hashtable(size_type n, const HashFcn& hf, const EqualKey& eql)
+        : hash(hf), equals(eql), get_key(ExtractKey()),
+          ctrl(0), slots(0), capacity(0), num_elements(0), growth_left(0)
+    {
+        resize(n);
+    }
+
+    hashtable(const hashtable& ht)
+        : hash(ht.hash), equals(ht.equals), get_key(ht.get_key),
+          ctrl(0), slots(0), capacity(0), num_elements(0), growth_left(0)
+    {
+        copy_from(ht);
+    }
+
+    hashtable& operator=(const hashtable& ht)
+    {
+        if(&ht != this)
+        {
+            hashtable tmp(ht);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~hashtable()
+    {
+        destroy_slots();
+        deallocate_table();
+    }
+
+    size_type size() const      {   return num_elements;    }
+    size_type max_size() const  {   return size_type(-1) / sizeof(value_type);  }
+    bool empty() const          {   return num_elements == 0;   }
+    size_type bucket_count() const  {   return capacity;    }
+
+    void swap(hashtable& ht)
+    {
+        ::swap(hash, ht.hash);
+        ::swap(equals, ht.equals);
+        ::swap(get_key, ht.get_key);
+        ::swap(ctrl, ht.ctrl);
+        ::swap(slots, ht.slots);
+        ::swap(capacity, ht.capacity);
+        ::swap(num_elements, ht.num_elements);
+        ::swap(growth_left, ht.growth_left);
+    }
+
+    iterator begin()
+    {
+        iterator it = iterator_at(0);
+        if(capacity != 0)
+            it.skip_empty_or_deleted();
+        return it;
+    }
+    iterator end()  {   return iterator_at(capacity);   }
+
+    const_iterator begin() const
+    {
+        const_iterator it = iterator_at(0);
+        if(capacity != 0)
+            it.skip_empty_or_deleted();
+        return it;
+    }
+    const_iterator end() const  {   return iterator_at(capacity);   }
+
+public:
+    // 插入元素, 键值不允许重复
+    pair<iterator, bool> insert_unique(const value_type& obj)
+    {
+        size_t h = hash_of(get_key(obj));
+        size_type pos = find_index(get_key(obj), h);
+        if(pos != npos)
+            return pair<iterator, bool>(iterator_at(pos), false);
+        return pair<iterator, bool>(insert_at(h, obj), true);
+    }
+
+    template<class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+        insert_unique(first, last, iterator_category(first));
+    }
+
+    // 键值存在则返回该元素, 否则插入obj, hash_map::operator[] 使用
+    reference find_or_insert(const value_type& obj)
+    {
+        size_t h = hash_of(get_key(obj));
+        size_type pos = find_index(get_key(obj), h);
+        if(pos != npos)
+            return slots[pos];
+        return *insert_at(h, obj);
+    }
+
+    iterator find(const key_type& key)
+    {
+        size_type pos = find_index(key, hash_of(key));
+        return pos == npos ? end() : iterator_at(pos);
+    }
+
+    const_iterator find(const key_type& key) const
+    {
+        size_type pos = find_index(key, hash_of(key));
+        return pos == npos ? end() : iterator_at(pos);
+    }
+
+    size_type count(const key_type& key) const
+    {
+        return find_index(key, hash_of(key)) == npos ? 0 : 1;
+    }
+
+    size_type erase(const key_type& key)
+    {
+        size_type pos = find_index(key, hash_of(key));
+        if(pos == npos)
+            return 0;
+        erase_at(pos);
+        return 1;
+    }
+
+    // 删除元素不会移动其他元素, 其他迭代器依然有效
+    void erase(const iterator& it)          {   erase_at(it.ctrl - ctrl);   }
+    void erase(const const_iterator& it)    {   erase_at(it.ctrl - ctrl);   }
+
+    void erase(iterator first, iterator last)
+    {
+        while(first != last)
+            erase(first++);
+    }
+    void erase(const_iterator first, const_iterator last)
+    {
+        while(first != last)
+            erase(first++);
+    }
+
+    // 保证容纳 num_elements_hint 个元素时不需要扩容
+    void resize(size_type num_elements_hint)
+    {
+        size_type n = capacity_for(num_elements_hint);
+        if(n > capacity)
+            rehash(n);
+    }
+
+    void clear()
+    {
+        if(capacity == 0)
+            return;
+        destroy_slots();
+        memset(ctrl, __ctrl_empty, capacity);
+        num_elements = 0;
+        growth_left = max_load(capacity);
+    }
+
+private:
+    static size_type max_load(size_type n)  {   return n - n / 8;   }
+
+    // 容纳n个元素需要的槽位数
+    static size_type capacity_for(size_type n)
+    {
+        if(n == 0)
+            return 0;
+        size_type cap = __group_width;
+        while(max_load(cap) < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    iterator iterator_at(size_type pos)
+    {
+        return iterator(ctrl + pos, slots + pos);
+    }
+    const_iterator iterator_at(size_type pos) const
+    {
+        return const_iterator(ctrl + pos, slots + pos);
+    }
+
+    size_t hash_of(const key_type& key) const
+    {
+        return __hash_mix(hash(key), typename __hash_is_avalanching<hasher>::type());
+    }
+
+    // 查找键值所在的槽位, 不存在返回npos
+    size_type find_index(const key_type& key, size_t h) const
+    {
+        if(capacity == 0)
+            return npos;
+        const __ctrl_t h2 = __hash_h2(h);
+        const size_type mask = capacity / __group_width - 1;
+        size_type g = __hash_h1(h) & mask;
+        for(size_type step = 0; ; )
+        {
+            const size_type base = g * __group_width;
+            __hashtable_group group(ctrl + base);
+            for(unsigned m = group.match(h2); m != 0; m &= m - 1)
+            {
+                size_type pos = base + __hashtable_ctz(m);
+                if(equals(get_key(slots[pos]), key))
+                    return pos;
+            }
+            if(group.match_empty()) // 该组有空槽位, 键值不可能在后续的组中
+                return npos;
+            g = (g + ++step) & mask;  // 三角探测, 组数为2的幂时可以访问到所有组
+        }
+    }
+
+    // 探测序列上第一个 empty 或 deleted 的槽位
+    size_type find_first_non_full(size_t h) const
+    {
+        const size_type mask = capacity / __group_width - 1;
+        size_type g = __hash_h1(h) & mask;
+        for(size_type step = 0; ; )
+        {
+            const size_type base = g * __group_width;
+            unsigned m = __hashtable_group(ctrl + base).match_empty_or_deleted();
+            if(m != 0)
+                return base + __hashtable_ctz(m);
+            g = (g + ++step) & mask;
+        }
+    }
+
+    // 键值已确认不存在, 插入新元素
+    iterator insert_at(size_t h, const value_type& obj)
+    {
+        if(capacity == 0)
+            rehash_and_grow();
+        size_type pos = find_first_non_full(h);
+        if(growth_left == 0 && ctrl[pos] != __ctrl_deleted)
+        {
+            rehash_and_grow();
+            pos = find_first_non_full(h);
+        }
+        construct(slots + pos, obj);
+        growth_left -= (ctrl[pos] == __ctrl_empty);
+        ctrl[pos] = __hash_h2(h);
+        ++num_elements;
+        return iterator_at(pos);
+    }
+
+    void erase_at(size_type pos)
+    {
+        destroy(slots + pos);
+        --num_elements;
+        // 所在组中还有empty槽位, 查找不会越过该组, 直接置为empty
+        if(__hashtable_group(ctrl + (pos & ~(__group_width - 1))).match_empty())
+        {
+            ctrl[pos] = __ctrl_empty;
+            ++growth_left;
+        }
+        else
+            ctrl[pos] = __ctrl_deleted;
+    }
+
+    void rehash_and_grow()
+    {
+        if(capacity == 0)
+            rehash(__group_width);
+        else if(num_elements * 32 <= capacity * 25)  // 墓碑较多, 原地重整即可
+            rehash(capacity);
+        else
+            rehash(capacity * 2);
+    }
+
+    // 分配新的ctrl和槽位数组, 将所有元素重新放置
+    void rehash(size_type new_capacity)
+    {
+        __ctrl_t* old_ctrl = ctrl;
+        value_type* old_slots = slots;
+        size_type old_capacity = capacity;
+
+        initialize_table(new_capacity);
+        for(size_type i = 0; i < old_capacity; ++i)
+        {
+            if(old_ctrl[i] >= 0)
+            {
+                size_t h = hash_of(get_key(old_slots[i]));
+                size_type pos = find_first_non_full(h);
+                construct(slots + pos, old_slots[i]);
+                ctrl[pos] = __hash_h2(h);
+                destroy(old_slots + i);
+            }
+        }
+        if(old_capacity != 0)
+        {
+            ctrl_allocator::deallocate(old_ctrl, old_capacity + __group_width);
+            slot_allocator::deallocate(old_slots, old_capacity);
+        }
+    }
+
+    // 每个槽位占用一个ctrl字节和一个 value_type, 总字节数不能超过 ptrdiff_t 的范围
+    static size_type max_capacity() {   return (size_type(-1) >> 1) / (sizeof(value_type) + 1);  }
+
+    // n 是组宽的整数倍; ctrl字节数由组数乘组宽得到, 上界为 max_capacity()
+    void initialize_table(size_type n)
+    {
+        if(n > max_capacity())
+            __THROW_BAD_ALLOC;
+        const size_t groups = n / __group_width;
+        const size_t ctrl_bytes = groups * __group_width;
+        ctrl = ctrl_allocator::allocate(ctrl_bytes + __group_width);
+        if(ctrl_bytes != 0)
+            memset(ctrl, __ctrl_empty, ctrl_bytes);
+        memset(ctrl + ctrl_bytes, __ctrl_sentinel, __group_width);
+        slots = slot_allocator::allocate(n);
+        capacity = n;
+        growth_left = max_load(n) - num_elements;
+    }
+
+    void deallocate_table()
+    {
+        if(capacity == 0)
+            return;
+        ctrl_allocator::deallocate(ctrl, capacity + __group_width);
+        slot_allocator::deallocate(slots, capacity);
+        ctrl = 0;
+        slots = 0;
+        capacity = num_elements = growth_left = 0;
+    }
+
+    void copy_from(const hashtable& ht)
+    {
+        if(ht.num_elements == 0)
+            return;
+        initialize_table(capacity_for(ht.num_elements));
+        for(size_type i = 0; i < ht.capacity; ++i)
+        {
+            if(ht.ctrl[i] >= 0)
+            {
+                size_t h = hash_of(get_key(ht.slots[i]));
+                size_type pos = find_first_non_full(h);
+                construct(slots + pos, ht.slots[i]);
+                ctrl[pos] = __hash_h2(h);
+                ++num_elements;
+                --growth_left;
+            }
+        }
+    }
+
+    // 元素具有trivial destructor时不必遍历ctrl数组
+    void destroy_slots()
+    {
+        typedef typename __type_traits<value_type>::has_trivial_destructor trivial_destructor;
+        destroy_slots_aux(trivial_destructor());
+    }
+    void destroy_slots_aux(__true_type) {}
+    void destroy_slots_aux(__false_type)
+    {
+        for(size_type i = 0; i < capacity; ++i)
+            if(ctrl[i] >= 0)
+                destroy(slots + i);
+    }
+
+    template<class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        for(; first != last; ++first)
+            insert_unique(*first);
+    }
+
+    // 可以预先算出元素个数, 一次扩容到位
+    template<class ForwardIterator>
+    void insert_unique(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+    {
+        resize(num_elements + distance(first, last));
+        for(; first != last; ++first)
+            insert_unique(*first);
+    }
+};
+
+#endif // __STL_HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,196 @@
+#ifndef __STL_HEAP_H
+#define __STL_HEAP_H
+
+#include <cstddef>  // size_t
+
+#include "stl_config.h"
+#include "stl_function.h"
+#include "stl_iterator.h"
+
+// 堆算法: 以随机访问区间 [first, last) 表示的隐式D叉堆, 下标i的子节点为 D*i+1 ... D*i+D, 父节点为 (i-1)/D
+// comp(a, b) 为真表示a的优先级低于b, 堆顶为"最大"的元素
+// push_heap / pop_heap / make_heap / sort_heap 使用二叉堆(D = 2), 与标准库的堆布局一致
+// priority_queue 使用4叉堆: 树高减半, 且一个节点的4个子节点通常位于同一cache line, 下沉时的访存次数更少
+//
+// 上浮和下沉都采用"空洞"的方式: 把待放置的元素取出, 沿路径移动其他元素, 最后只赋值一次
+// 下沉时不与待放置元素比较, 直接把空洞推到叶子, 再从叶子上浮(Floyd), pop时每层少一次比较
+// 从C++14起全部是 constexpr, 编译期排序(见 stl_algo.h 的 sort)也借助 make_heap / sort_heap
+
+// 空洞hole处放置value, 向上不超过top
+template<size_t D, class RandomAccessIterator, class Distance, class T, class Compare>
+__STL_CONSTEXPR14 void __dary_push_heap(RandomAccessIterator first, Distance hole, Distance top, T value, Compare comp)
+{
+    Distance parent = (hole - 1) / D;
+    while(hole > top && comp(*(first + parent), value))
+    {
+        *(first + hole) = *(first + parent);
+        hole = parent;
+        parent = (hole - 1) / D;
+    }
+    *(first + hole) = value;
+}
+
+// 将空洞hole沿较大的子节点下沉到叶子, 再把value从叶子上浮到合适的位置
+template<size_t D, class RandomAccessIterator, class Distance, class T, class Compare>
+__STL_CONSTEXPR14 void __dary_adjust_heap(RandomAccessIterator first, Distance hole, Distance len, T value, Compare comp)
+{
+    const Distance top = hole;
+    Distance child = D * hole + 1;
+    // 子节点齐全的部分, 内层循环次数固定, 编译器可以展开
+    while(child + Distance(D) <= len)
+    {
+        Distance best = child;
+        for(Distance i = 1; i < Distance(D); ++i)
+            if(comp(*(first + best), *(first + (child + i))))
+                best = child + i;
+        *(first + hole) = *(first + best);
+        hole = best;
+        child = D * hole + 1;
+    }
+    // 最后一个子节点不满的父节点
+    if(child < len)
+    {
+        Distance best = child;
+        for(Distance i = child + 1; i < len; ++i)
+            if(comp(*(first + best), *(first + i)))
+                best = i;
+        *(first + hole) = *(first + best);
+        hole = best;
+    }
+    __dary_push_heap<D>(first, hole, top, value, comp);
+}
+
+// [first, last-1) 已经是堆, 将 *(last-1) 加入堆中
+template<size_t D, class RandomAccessIterator, class Compare, class Distance, class T>
+inline __STL_CONSTEXPR14 void __dary_push_heap_aux(RandomAccessIterator first, RandomAccessIterator last, Compare comp, Distance*, T*)
+{
+    __dary_push_heap<D>(first, Distance((last - first) - 1), Distance(0), T(*(last - 1)), comp);
+}
+
+template<size_t D, class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void __dary_push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __dary_push_heap_aux<D>(first, last, comp, distance_type(first), value_type(first));
+}
+
+// 堆顶移到 *(last-1), [first, last-1) 重新成为堆
+template<size_t D, class RandomAccessIterator, class Compare, class Distance, class T>
+inline __STL_CONSTEXPR14 void __dary_pop_heap_aux(RandomAccessIterator first, RandomAccessIterator last, Compare comp, Distance*, T*)
+{
+    T value = *(last - 1);
+    *(last - 1) = *first;
+    __dary_adjust_heap<D>(first, Distance(0), Distance(last - first - 1), value, comp);
+}
+
+template<size_t D, class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void __dary_pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    if(last - first > 1)
+        __dary_pop_heap_aux<D>(first, last, comp, distance_type(first), value_type(first));
+}
+
+// 自底向上建堆(Floyd), O(n)
+template<size_t D, class RandomAccessIterator, class Compare, class Distance, class T>
+__STL_CONSTEXPR14 void __dary_make_heap_aux(RandomAccessIterator first, RandomAccessIterator last, Compare comp, Distance*, T*)
+{
+    const Distance len = last - first;
+    if(len < 2)
+        return;
+    Distance parent = (len - 2) / D;    // 最后一个非叶子节点
+    for(;;)
+    {
+        __dary_adjust_heap<D>(first, parent, len, T(*(first + parent)), comp);
+        if(parent == 0)
+            return;
+        --parent;
+    }
+}
+
+template<size_t D, class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void __dary_make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __dary_make_heap_aux<D>(first, last, comp, distance_type(first), value_type(first));
+}
+
+template<size_t D, class RandomAccessIterator, class Compare>
+__STL_CONSTEXPR14 void __dary_sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    while(last - first > 1)
+        __dary_pop_heap<D>(first, last--, comp);
+}
+
+// 返回第一个破坏堆性质的位置
+template<size_t D, class RandomAccessIterator, class Compare>
+__STL_CONSTEXPR14 RandomAccessIterator __dary_is_heap_until(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    const Distance len = last - first;
+    for(Distance child = 1; child < len; ++child)
+        if(comp(*(first + (child - 1) / D), *(first + child)))
+            return first + child;
+    return last;
+}
+
+
+// ========================================= 二叉堆
+template<class RandomAccessIterator>
+inline __STL_CONSTEXPR14 void push_heap(RandomAccessIterator first, RandomAccessIterator last)
+{
+    __dary_push_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __dary_push_heap<2>(first, last, comp);
+}
+
+template<class RandomAccessIterator>
+inline __STL_CONSTEXPR14 void pop_heap(RandomAccessIterator first, RandomAccessIterator last)
+{
+    __dary_pop_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __dary_pop_heap<2>(first, last, comp);
+}
+
+template<class RandomAccessIterator>
+inline __STL_CONSTEXPR14 void make_heap(RandomAccessIterator first, RandomAccessIterator last)
+{
+    __dary_make_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __dary_make_heap<2>(first, last, comp);
+}
+
+template<class RandomAccessIterator>
+inline __STL_CONSTEXPR14 void sort_heap(RandomAccessIterator first, RandomAccessIterator last)
+{
+    __dary_sort_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    __dary_sort_heap<2>(first, last, comp);
+}
+
+template<class RandomAccessIterator>
+inline __STL_CONSTEXPR14 bool is_heap(RandomAccessIterator first, RandomAccessIterator last)
+{
+    return __dary_is_heap_until<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>()) == last;
+}
+
+template<class RandomAccessIterator, class Compare>
+inline __STL_CONSTEXPR14 bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    return __dary_is_heap_until<2>(first, last, comp) == last;
+}
+
+#endif // __STL_HEAP_H
\ No newline at end of file
@@ -0,0 +1,622 @@
+#ifndef __STL_HIVE_H
+#define __STL_HIVE_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+#include <cstring>  // memset
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_iterator.h"
+#include "type_traits.h"
+
+// hive (colony): 元素地址永远不变的无序容器, 插入与删除都是O(1), 删除只会使被删除元素的指针与迭代器失效
+// 1. 元素存放在一串块中, 每块是一段连续的槽位, 新块的容量随元素总数几何增长, 介于 [min_block, max_block] 之间;
+//    min_block == max_block 时所有块大小相同
+// 2. 删除的槽位留在原处成为空洞, 由跳跃计数(jump-counting)的跳跃字段记录: 每段连续空洞的首尾两个槽位
+//    保存这段空洞的长度, 其余槽位为0; 迭代器前进时 ++i; i += skip[i], 后退时 --i; i -= skip[i],
+//    遍历的代价只与元素个数有关, 不会逐个检查空洞
+// 3. 每块中各段空洞的起点串成一条双向链表(链接保存在空洞自身的槽位中), 有空洞的块再串成一条链表,
+//    插入时优先复用某段空洞的第一个槽位, 都没有时才使用最后一块的尾部或新块
+// 4. 块中的元素全部被删除时整块归还, 最多保留一块备用, 避免在边界上反复配置; reserve 预留的块也作为备用
+//
+//  hive<particle> h;
+//  particle* p = &*h.insert(particle());     // 之后无论插入删除多少其他元素, p始终有效
+//  h.erase(h.get_iterator(p));
+
+typedef unsigned short __hive_skip_type;
+
+static const __hive_skip_type __hive_npos = 0xffff;
+enum { __hive_min_block = 8, __hive_max_block = 8192 };
+
+// 每块容量的上下限
+struct hive_limits
+{
+    size_t min;
+    size_t max;
+
+    hive_limits(size_t mn, size_t mx) : min(mn), max(mx)    {}
+};
+
+// 空洞段的双向链表, 保存在段首的槽位中
+struct __hive_links
+{
+    __hive_skip_type prev;
+    __hive_skip_type next;
+};
+
+// 槽位: 存活时是元素, 是空洞段的起点时是链表节点; 本身从不构造, 元素在 value 上就地构造
+template<class T>
+union __hive_slot
+{
+    T value;
+    __hive_links links;
+
+    __hive_slot()   {}
+    ~__hive_slot()  {}
+};
+
+template<class T>
+struct __hive_block
+{
+    __hive_slot<T>* slots;
+    __hive_skip_type* skip;         // capacity + 1 项, skip[top] 恒为0, 作为块的结束标志
+    size_t capacity;
+    size_t top;                     // [0, top) 中的槽位被使用过, 之后的从未使用
+    size_t size;                    // 存活的元素个数
+    __hive_skip_type free_head;     // 第一段空洞的起点, 没有空洞时为 __hive_npos
+    __hive_block* prev;             // 所有块按顺序串成双向链表
+    __hive_block* next;
+    __hive_block* prev_free;        // 有空洞的块
+    __hive_block* next_free;
+};
+
+// ========================================= hive 的迭代器
+// 双向迭代器, 每块中的第一个存活元素是 skip[0] (第0个槽位被删除时跳过开头的整段空洞)
+template<class T, class Ref, class Ptr>
+struct __hive_iterator
+{
+    typedef __hive_iterator<T, T&, T*> iterator;
+    typedef __hive_iterator<T, const T&, const T*> const_iterator;
+    typedef __hive_iterator<T, Ref, Ptr> self;
+
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __hive_block<T>* block_pointer;
+
+    block_pointer block;
+    size_t index;
+
+    __hive_iterator() : block(0), index(0)  {}
+    __hive_iterator(block_pointer b, size_t i) : block(b), index(i) {}
+    __hive_iterator(const iterator& x) : block(x.block), index(x.index) {}
+    self& operator=(const self& x) = default;
+
+    bool operator==(const self& x) const    {   return index == x.index && block == x.block;    }
+    bool operator!=(const self& x) const    {   return !(*this == x);   }
+
+    reference operator*() const {   return block->slots[index].value;   }
+    pointer operator->() const  {   return &block->slots[index].value;  }
+
+    self& operator++()
+    {
+        ++index;
+        index += block->skip[index];
+        if(index == block->top && block->next)
+        {
+            block = block->next;
+            index = block->skip[0];
+        }
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--()
+    {
+        if(index == block->skip[0])
+        {
+            block = block->prev;
+            index = block->top;
+        }
+        --index;
+        index -= block->skip[index];
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};
+
+
+// ========================================= hive
+template<class T, class Alloc = alloc>
+class hive
+{
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __hive_iterator<T, T&, T*> iterator;
+    typedef __hive_iterator<T, const T&, const T*> const_iterator;
+
+protected:
+    typedef __hive_block<T> block;
+    typedef __hive_slot<T> slot;
+    typedef simple_alloc<block, Alloc> block_allocator;
+    typedef simple_alloc<slot, Alloc> slot_allocator;
+    typedef simple_alloc<__hive_skip_type, Alloc> skip_allocator;
+
+protected:
+    block* first;           // 存放元素的块, 每块至少有一个元素
+    block* last;
+    block* free_blocks;     // 有空洞的块
+    block* spare;           // 备用的空块, 按next串起来
+    size_type num_elements;
+    size_type total_capacity;   // 包括备用块
+    size_type min_block;
+    size_type max_block;
+
+protected:
+    // ------------------------------------- 块的配置与链接
+    block* allocate_block(size_type n)
+    {
+        block* b = block_allocator::allocate();
+        b->slots = slot_allocator::allocate(n);
+        b->skip = skip_allocator::allocate(n + 1);
+        b->capacity = n;
+        reset_block(b);
+        total_capacity += n;
+        return b;
+    }
+
+    void deallocate_block(block* b)
+    {
+        total_capacity -= b->capacity;
+        skip_allocator::deallocate(b->skip, b->capacity + 1);
+        slot_allocator::deallocate(b->slots, b->capacity);
+        block_allocator::deallocate(b);
+    }
+
+    void reset_block(block* b)
+    {
+        memset(b->skip, 0, (b->capacity + 1) * sizeof(__hive_skip_type));
+        b->top = 0;
+        b->size = 0;
+        b->free_head = __hive_npos;
+        b->prev = b->next = 0;
+        b->prev_free = b->next_free = 0;
+    }
+
+    // 新块优先取备用块, 否则按元素总数几何增长
+    block* new_block()
+    {
+        if(spare)
+        {
+            block* b = spare;
+            spare = b->next;
+            reset_block(b);
+            return b;
+        }
+        size_type n = num_elements;
+        if(n < min_block)
+            n = min_block;
+        if(n > max_block)
+            n = max_block;
+        return allocate_block(n);
+    }
+
+    void link_back(block* b)
+    {
+        b->prev = last;
+        b->next = 0;
+        if(last)
+            last->next = b;
+        else
+            first = b;
+        last = b;
+    }
+
+    void unlink(block* b)
+    {
+        if(b->prev)
+            b->prev->next = b->next;
+        else
+            first = b->next;
+        if(b->next)
+            b->next->prev = b->prev;
+        else
+            last = b->prev;
+    }
+
+    void push_free_block(block* b)
+    {
+        b->prev_free = 0;
+        b->next_free = free_blocks;
+        if(free_blocks)
+            free_blocks->prev_free = b;
+        free_blocks = b;
+    }
+
+    void remove_free_block(block* b)
+    {
+        if(b->prev_free)
+            b->prev_free->next_free = b->next_free;
+        else
+            free_blocks = b->next_free;
+        if(b->next_free)
+            b->next_free->prev_free = b->prev_free;
+    }
+
+    // 元素全部被删除的块: 没有备用块时留作备用, 否则归还
+    void retire_block(block* b)
+    {
+        unlink(b);
+        if(b->free_head != __hive_npos)
+            remove_free_block(b);
+        if(spare == 0)
+        {
+            b->next = 0;
+            spare = b;
+        }
+        else
+            deallocate_block(b);
+    }
+
+    void deallocate_blocks(block* b)
+    {
+        while(b)
+        {
+            block* next = b->next;
+            deallocate_block(b);
+            b = next;
+        }
+    }
+
+    // ------------------------------------- 块内空洞段的链表
+    static __hive_links& links(block* b, size_type s)   {   return b->slots[s].links;   }
+
+    void push_run(block* b, size_type s)
+    {
+        if(b->free_head != __hive_npos)
+            links(b, b->free_head).prev = __hive_skip_type(s);
+        links(b, s).prev = __hive_npos;
+        links(b, s).next = b->free_head;
+        b->free_head = __hive_skip_type(s);
+    }
+
+    void unlink_run(block* b, size_type s)
+    {
+        __hive_links l = links(b, s);
+        if(l.prev != __hive_npos)
+            links(b, l.prev).next = l.next;
+        else
+            b->free_head = l.next;
+        if(l.next != __hive_npos)
+            links(b, l.next).prev = l.prev;
+    }
+
+    // 把空洞段移到块的链表头部, 下一次插入就复用它
+    void run_to_front(block* b, size_type s)
+    {
+        if(b->free_head != s)
+        {
+            unlink_run(b, s);
+            push_run(b, s);
+        }
+    }
+
+    // 空洞段的起点由from变为to, 链表节点随之移动
+    void move_run(block* b, size_type from, size_type to)
+    {
+        __hive_links l = links(b, from);
+        links(b, to) = l;
+        if(l.prev != __hive_npos)
+            links(b, l.prev).next = __hive_skip_type(to);
+        else
+            b->free_head = __hive_skip_type(to);
+        if(l.next != __hive_npos)
+            links(b, l.next).prev = __hive_skip_type(to);
+    }
+
+    // ------------------------------------- 槽位的取得与释放
+    // 取得一个可以构造元素的槽位: 某段空洞的第一个槽位, 或者最后一块尾部的槽位
+    iterator take_slot()
+    {
+        block* b = free_blocks;
+        size_type s;
+        if(b)
+        {
+            s = b->free_head;
+            const size_type len = b->skip[s];
+            if(len == 1)
+            {
+                unlink_run(b, s);
+                if(b->free_head == __hive_npos)
+                    remove_free_block(b);
+            }
+            else
+            {
+                // 段 [s, s + len) 变为 [s + 1, s + len)
+                move_run(b, s, s + 1);
+                b->skip[s + 1] = __hive_skip_type(len - 1);
+                b->skip[s + len - 1] = __hive_skip_type(len - 1);
+            }
+            b->skip[s] = 0;
+        }
+        else
+        {
+            b = last;
+            if(b == 0 || b->top == b->capacity)
+            {
+                b = new_block();
+                link_back(b);
+            }
+            s = b->top++;
+        }
+        ++b->size;
+        ++num_elements;
+        return iterator(b, s);
+    }
+
+    // 槽位s上的元素已经析构, 与左右相邻的空洞合并成一段; 块变空时返回true, 块已被摘下
+    // 合并后的段移到块的链表头部, 块移到有空洞的块的链表头部: 紧接着的插入复用刚释放的、仍在缓存中的槽位
+    bool release_slot(block* b, size_type s)
+    {
+        __hive_skip_type* skip = b->skip;
+        const bool had_runs = b->free_head != __hive_npos;
+        const size_type left = s > 0 ? skip[s - 1] : 0;     // 左边空洞段的长度, s-1是它的终点
+        const size_type right = skip[s + 1];                // 右边空洞段的长度, s+1是它的起点
+        if(left == 0 && right == 0)
+        {
+            skip[s] = 1;
+            push_run(b, s);
+        }
+        else if(right == 0)
+        {
+            const size_type start = s - left;
+            skip[start] = skip[s] = __hive_skip_type(left + 1);
+            run_to_front(b, start);
+        }
+        else if(left == 0)
+        {
+            const size_type len = right + 1;
+            move_run(b, s + 1, s);
+            skip[s] = skip[s + len - 1] = __hive_skip_type(len);
+            run_to_front(b, s);
+        }
+        else
+        {
+            const size_type start = s - left;
+            const size_type len = left + 1 + right;
+            unlink_run(b, s + 1);
+            skip[start] = skip[start + len - 1] = __hive_skip_type(len);
+            run_to_front(b, start);
+        }
+        if(free_blocks != b)
+        {
+            if(had_runs)
+                remove_free_block(b);
+            push_free_block(b);
+        }
+        --num_elements;
+        if(--b->size == 0)
+        {
+            retire_block(b);
+            return true;
+        }
+        return false;
+    }
+
+    // 两个参数都是整数时按 (个数, 值) 处理
+    template<class Integer>
+    void insert_dispatch(Integer n, Integer value, __true_type)
+    {
+        insert(size_type(n), T(value));
+    }
+
+    template<class InputIterator>
+    void insert_dispatch(InputIterator first, InputIterator last, __false_type)
+    {
+        for(; first != last; ++first)
+            insert(*first);
+    }
+
+    void initialize(size_type min_n, size_type max_n)
+    {
+        first = last = free_blocks = spare = 0;
+        num_elements = total_capacity = 0;
+        if(max_n > __hive_max_block)
+            max_n = __hive_max_block;
+        if(min_n < 1)
+            min_n = 1;
+        if(min_n > max_n)
+            min_n = max_n;
+        min_block = min_n;
+        max_block = max_n;
+    }
+
+public:
+    // ------------------------------------- 构造与析构
+    hive()  {   initialize(__hive_min_block, __hive_max_block); }
+    // 每块的容量限制在 [limits.min, limits.max] 之内, 最大为 __hive_max_block
+    explicit hive(hive_limits limits)   {   initialize(limits.min, limits.max); }
+    hive(size_type n, const T& value)
+    {
+        initialize(__hive_min_block, __hive_max_block);
+        insert(n, value);
+    }
+    // 两个参数都是整数时(例如 hive<int>(5, 7))等同于 hive(n, value)
+    template<class InputIterator>
+    hive(InputIterator first, InputIterator last)
+    {
+        initialize(__hive_min_block, __hive_max_block);
+        insert(first, last);
+    }
+    hive(const hive& x)
+    {
+        initialize(x.min_block, x.max_block);
+        reserve(x.size());
+        insert(x.begin(), x.end());
+    }
+    ~hive()
+    {
+        clear();
+        trim();
+    }
+
+    hive& operator=(const hive& x)
+    {
+        if(this != &x)
+        {
+            clear();
+            insert(x.begin(), x.end());
+        }
+        return *this;
+    }
+
+public:
+    // ------------------------------------- 迭代器与容量
+    iterator begin()                {   return first ? iterator(first, first->skip[0]) : iterator();    }
+    const_iterator begin() const    {   return first ? const_iterator(first, first->skip[0]) : const_iterator();    }
+    iterator end()                  {   return last ? iterator(last, last->top) : iterator();   }
+    const_iterator end() const      {   return last ? const_iterator(last, last->top) : const_iterator();   }
+
+    size_type size() const      {   return num_elements;    }
+    bool empty() const          {   return num_elements == 0;   }
+    size_type max_size() const  {   return size_type(-1) / sizeof(T);   }
+    // 所有块(包括备用块)的槽位总数
+    size_type capacity() const  {   return total_capacity;  }
+
+    // 预留至少能容纳n个元素的空间, 新配置的块作为备用
+    void reserve(size_type n)
+    {
+        while(total_capacity < n)
+        {
+            size_type m = n - total_capacity;
+            if(m < min_block)
+                m = min_block;
+            if(m > max_block)
+                m = max_block;
+            block* b = allocate_block(m);
+            b->next = spare;
+            spare = b;
+        }
+    }
+
+    // 归还所有备用块
+    void trim()
+    {
+        deallocate_blocks(spare);
+        spare = 0;
+    }
+
+    // 由元素的地址得到迭代器, p必须指向本容器中存活的元素; 需要逐块比较地址范围
+    iterator get_iterator(const_pointer p)
+    {
+        const slot* s = reinterpret_cast<const slot*>(p);
+        for(block* b = first; b; b = b->next)
+            if(s >= b->slots && s < b->slots + b->top)
+                return iterator(b, s - b->slots);
+        return end();
+    }
+
+public:
+    // ------------------------------------- 插入与删除
+    iterator insert(const T& x)
+    {
+        iterator it = take_slot();
+        construct(&*it, x);
+        return it;
+    }
+
+    void insert(size_type n, const T& x)
+    {
+        reserve(num_elements + n);
+        for(; n > 0; --n)
+            insert(x);
+    }
+
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        insert_dispatch(first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    // 返回下一个元素的迭代器
+    iterator erase(iterator position)
+    {
+        iterator next = position;
+        ++next;
+        block* b = position.block;
+        destroy(&*position);
+        if(release_slot(b, position.index) && next.block == b)
+            next = end();       // b是最后一块且已被摘下
+        return next;
+    }
+
+    // last是end()时, 最后一块被摘下后end()会改变, 每次重新取得
+    iterator erase(iterator first, iterator last)
+    {
+        if(last == end())
+        {
+            while(first != end())
+                first = erase(first);
+            return end();
+        }
+        while(first != last)
+            first = erase(first);
+        return last;
+    }
+
+    // 元素具有trivial destructor时不需要遍历, 直接归还所有块
+    void clear()
+    {
+        destroy(begin(), end());
+        block* b = first;
+        if(b && spare == 0)
+        {
+            b = b->next;
+            first->next = 0;
+            spare = first;
+        }
+        deallocate_blocks(b);
+        first = last = free_blocks = 0;
+        num_elements = 0;
+    }
+
+    void swap(hive& x)
+    {
+        ::swap(first, x.first);
+        ::swap(last, x.last);
+        ::swap(free_blocks, x.free_blocks);
+        ::swap(spare, x.spare);
+        ::swap(num_elements, x.num_elements);
+        ::swap(total_capacity, x.total_capacity);
+        ::swap(min_block, x.min_block);
+        ::swap(max_block, x.max_block);
+    }
+};
+
+template<class T, class Alloc>
+inline void swap(hive<T, Alloc>& x, hive<T, Alloc>& y)
+{
+    x.swap(y);
+}
+
+#endif // __STL_HIVE_H
\ No newline at end of file
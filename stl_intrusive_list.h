@@ -0,0 +1,361 @@
+#ifndef __STL_INTRUSIVE_LIST_H
+#define __STL_INTRUSIVE_LIST_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+
+#include "stl_iterator.h"
+
+// 侵入式链表: 链表指针(hook)嵌在对象内部, 链表只负责把对象串起来, 不分配节点也不管理对象的生命周期
+// 对象通过继承 intrusive_list_hook<Tag> 获得hook, 同一个对象可以继承多个不同Tag的hook, 同时挂在多条链表上
+//
+//  struct task : public intrusive_list_hook<>  { ... };
+//  intrusive_list<task> ready;
+//  ready.push_back(t);     // 不分配内存
+//  ready.erase(ready.iterator_to(t));
+
+struct __default_hook_tag {};
+
+// ========================================= 双向链表
+template<class Tag = __default_hook_tag>
+struct intrusive_list_hook
+{
+    intrusive_list_hook* next;
+    intrusive_list_hook* prev;
+
+    intrusive_list_hook() : next(0), prev(0)    {}
+    // 复制对象时不复制链接关系
+    intrusive_list_hook(const intrusive_list_hook&) : next(0), prev(0)  {}
+    intrusive_list_hook& operator=(const intrusive_list_hook&)  {   return *this;   }
+
+    bool is_linked() const  {   return next != 0;   }
+
+    // 从所在链表上摘下, O(1), 不需要知道链表本身
+    void unlink()
+    {
+        next->prev = prev;
+        prev->next = next;
+        next = prev = 0;
+    }
+};
+
+template<class T, class Tag, class Ref, class Ptr>
+struct __intrusive_list_iterator
+{
+    typedef __intrusive_list_iterator<T, Tag, T&, T*> iterator;
+    typedef __intrusive_list_iterator<T, Tag, Ref, Ptr> self;
+    typedef intrusive_list_hook<Tag> hook_type;
+
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef ptrdiff_t difference_type;
+
+    hook_type* node;
+
+    __intrusive_list_iterator() : node(0)   {}
+    explicit __intrusive_list_iterator(hook_type* x) : node(x)  {}
+    __intrusive_list_iterator(const iterator& x) : node(x.node) {}
+    self& operator=(const self& x) = default;
+
+    bool operator==(const self& x) const    {   return node == x.node;  }
+    bool operator!=(const self& x) const    {   return node != x.node;  }
+
+    reference operator*() const {   return *static_cast<T*>(node);  }
+    pointer operator->() const  {   return static_cast<T*>(node);   }
+
+    self& operator++()
+    {
+        node = node->next;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        node = node->next;
+        return tmp;
+    }
+    self& operator--()
+    {
+        node = node->prev;
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        node = node->prev;
+        return tmp;
+    }
+};
+
+// 以成员root作为哨兵的环状双向链表, 链表对象不可复制
+template<class T, class Tag = __default_hook_tag>
+class intrusive_list
+{
+public:
+    typedef intrusive_list_hook<Tag> hook_type;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __intrusive_list_iterator<T, Tag, T&, T*> iterator;
+    typedef __intrusive_list_iterator<T, Tag, const T&, const T*> const_iterator;
+
+private:
+    hook_type root;
+
+    intrusive_list(const intrusive_list&);
+    intrusive_list& operator=(const intrusive_list&);
+
+    static hook_type* hook(T& x)    {   return static_cast<hook_type*>(&x); }
+
+    static void link_before(hook_type* position, hook_type* x)
+    {
+        x->next = position;
+        x->prev = position->prev;
+        position->prev->next = x;
+        position->prev = x;
+    }
+
+public:
+    intrusive_list()    {   root.next = root.prev = &root;  }
+    // 链表析构时把所有对象摘下, 对象本身不受影响
+    ~intrusive_list()   {   clear();    }
+
+    iterator begin()    {   return iterator(root.next); }
+    iterator end()      {   return iterator(&root); }
+    const_iterator begin() const    {   return const_iterator(root.next);   }
+    const_iterator end() const      {   return const_iterator(const_cast<hook_type*>(&root));   }
+
+    bool empty() const  {   return root.next == &root;  }
+    size_type size() const  {   return distance(begin(), end());    }
+
+    reference front()   {   return *begin();    }
+    reference back()    {   return *iterator(root.prev);    }
+
+    // 由对象直接得到迭代器, O(1)
+    static iterator iterator_to(T& x)   {   return iterator(hook(x));   }
+
+    iterator insert(iterator position, T& x)
+    {
+        link_before(position.node, hook(x));
+        return iterator(hook(x));
+    }
+    void push_front(T& x)   {   link_before(root.next, hook(x));    }
+    void push_back(T& x)    {   link_before(&root, hook(x));    }
+
+    iterator erase(iterator position)
+    {
+        hook_type* next = position.node->next;
+        position.node->unlink();
+        return iterator(next);
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        while(first != last)
+            first = erase(first);
+        return last;
+    }
+    void pop_front()    {   root.next->unlink();    }
+    void pop_back()     {   root.prev->unlink();    }
+
+    // 逐个清除对象的链接状态, 使 is_linked() 保持正确
+    void clear()
+    {
+        hook_type* cur = root.next;
+        while(cur != &root)
+        {
+            hook_type* next = cur->next;
+            cur->next = cur->prev = 0;
+            cur = next;
+        }
+        root.next = root.prev = &root;
+    }
+
+    void swap(intrusive_list& x)
+    {
+        if(empty() && x.empty())
+            return;
+        intrusive_list tmp;
+        tmp.splice(tmp.end(), *this);
+        splice(end(), x);
+        x.splice(x.end(), tmp);
+    }
+
+    // 将 [first, last) 移动到 position 之前, O(1), first与last可以属于其他链表
+    void splice(iterator position, intrusive_list&, iterator first, iterator last)
+    {
+        if(first == last || position == last)
+            return;
+        hook_type* f = first.node;
+        hook_type* l = last.node->prev;
+        // 从原链表上摘下
+        f->prev->next = last.node;
+        last.node->prev = f->prev;
+        // 接到position之前
+        f->prev = position.node->prev;
+        l->next = position.node;
+        position.node->prev->next = f;
+        position.node->prev = l;
+    }
+    void splice(iterator position, intrusive_list& x)
+    {
+        splice(position, x, x.begin(), x.end());
+    }
+    void splice(iterator position, intrusive_list& x, iterator i)
+    {
+        iterator j = i;
+        splice(position, x, i, ++j);
+    }
+};
+
+
+// ========================================= 单向链表
+template<class Tag = __default_hook_tag>
+struct intrusive_slist_hook
+{
+    intrusive_slist_hook* next;
+
+    intrusive_slist_hook() : next(0)    {}
+    intrusive_slist_hook(const intrusive_slist_hook&) : next(0) {}
+    intrusive_slist_hook& operator=(const intrusive_slist_hook&)    {   return *this;   }
+};
+
+template<class T, class Tag, class Ref, class Ptr>
+struct __intrusive_slist_iterator
+{
+    typedef __intrusive_slist_iterator<T, Tag, T&, T*> iterator;
+    typedef __intrusive_slist_iterator<T, Tag, Ref, Ptr> self;
+    typedef intrusive_slist_hook<Tag> hook_type;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef ptrdiff_t difference_type;
+
+    hook_type* node;
+
+    __intrusive_slist_iterator() : node(0)  {}
+    explicit __intrusive_slist_iterator(hook_type* x) : node(x) {}
+    __intrusive_slist_iterator(const iterator& x) : node(x.node)    {}
+    self& operator=(const self& x) = default;
+
+    bool operator==(const self& x) const    {   return node == x.node;  }
+    bool operator!=(const self& x) const    {   return node != x.node;  }
+
+    reference operator*() const {   return *static_cast<T*>(node);  }
+    pointer operator->() const  {   return static_cast<T*>(node);   }
+
+    self& operator++()
+    {
+        node = node->next;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        node = node->next;
+        return tmp;
+    }
+};
+
+// 以空指针结尾的单向链表, 适合做栈和空闲对象池
+template<class T, class Tag = __default_hook_tag>
+class intrusive_slist
+{
+public:
+    typedef intrusive_slist_hook<Tag> hook_type;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __intrusive_slist_iterator<T, Tag, T&, T*> iterator;
+    typedef __intrusive_slist_iterator<T, Tag, const T&, const T*> const_iterator;
+
+private:
+    hook_type head;
+
+    intrusive_slist(const intrusive_slist&);
+    intrusive_slist& operator=(const intrusive_slist&);
+
+    static hook_type* hook(T& x)    {   return static_cast<hook_type*>(&x); }
+
+public:
+    intrusive_slist()   {}
+    ~intrusive_slist()  {   clear();    }
+
+    iterator before_begin() {   return iterator(&head); }
+    iterator begin()    {   return iterator(head.next); }
+    iterator end()      {   return iterator(0); }
+    const_iterator begin() const    {   return const_iterator(head.next);   }
+    const_iterator end() const      {   return const_iterator(0);   }
+
+    bool empty() const  {   return head.next == 0;  }
+    size_type size() const  {   return distance(begin(), end());    }
+
+    reference front()   {   return *begin();    }
+
+    void push_front(T& x)
+    {
+        hook(x)->next = head.next;
+        head.next = hook(x);
+    }
+    void pop_front()
+    {
+        hook_type* first = head.next;
+        head.next = first->next;
+        first->next = 0;
+    }
+
+    iterator insert_after(iterator pos, T& x)
+    {
+        hook(x)->next = pos.node->next;
+        pos.node->next = hook(x);
+        return iterator(hook(x));
+    }
+    iterator erase_after(iterator pos)
+    {
+        hook_type* x = pos.node->next;
+        pos.node->next = x->next;
+        x->next = 0;
+        return iterator(pos.node->next);
+    }
+
+    void clear()
+    {
+        hook_type* cur = head.next;
+        while(cur)
+        {
+            hook_type* next = cur->next;
+            cur->next = 0;
+            cur = next;
+        }
+        head.next = 0;
+    }
+
+    void swap(intrusive_slist& x)
+    {
+        hook_type* tmp = head.next;
+        head.next = x.head.next;
+        x.head.next = tmp;
+    }
+
+    // 将 (before_first, before_last] 移动到pos之后, O(1)
+    void splice_after(iterator pos, iterator before_first, iterator before_last)
+    {
+        if(before_first == before_last || pos == before_first || pos == before_last)
+            return;
+        hook_type* first = before_first.node->next;
+        before_first.node->next = before_last.node->next;
+        before_last.node->next = pos.node->next;
+        pos.node->next = first;
+    }
+};
+
+#endif // __STL_INTRUSIVE_LIST_H
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <cstddef>  // ptrdiff_t
 
+#include "stl_config.h"
+
 // 迭代器类型, 类比type_traits中的 __true_type, __false_type
 struct input_iterator_tag {};
 struct output_iterator_tag {};
@@ -59,21 +61,21 @@ struct iterator_traits<T*>
 //=================================== 萃取迭代器特性的一些工具函数
 // 返回一个迭代器类型的对象
 template<class Iterator>
-inline typename iterator_traits<Iterator>::iterator_category 
+inline constexpr typename iterator_traits<Iterator>::iterator_category 
 iterator_category(const Iterator&)
 {
     return typename iterator_traits<Iterator>::iterator_category();
 }
 
 template<class Iterator>
-inline typename iterator_traits<Iterator>::difference_type* 
+inline constexpr typename iterator_traits<Iterator>::difference_type* 
 distance_type(const Iterator&)
 {
     return static_cast<typename iterator_traits<Iterator>::difference_type*>(0);
 }
 
 template<class Iterator>
-inline typename iterator_traits<Iterator>::value_type* 
+inline constexpr typename iterator_traits<Iterator>::value_type* 
 value_type(const Iterator&)
 {
     return static_cast<typename iterator_traits<Iterator>::value_type*>(0);
@@ -81,7 +83,7 @@ value_type(const Iterator&)
 
 //================================= distance 函数
 template<class InputIterator>
-inline typename iterator_traits<InputIterator>::difference_type
+inline __STL_CONSTEXPR14 typename iterator_traits<InputIterator>::difference_type
 __distance(InputIterator first, InputIterator last, input_iterator_tag)
 {
     typename iterator_traits<InputIterator>::difference_type n = 0;
@@ -93,7 +95,7 @@ __distance(InputIterator first, InputIterator last, input_iterator_tag)
 }
 
 template<class RandomAccessIterator>
-inline typename iterator_traits<RandomAccessIterator>::difference_type
+inline constexpr typename iterator_traits<RandomAccessIterator>::difference_type
 __distance(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag)
 {
     return last - first;    
@@ -101,7 +103,7 @@ __distance(RandomAccessIterator first, RandomAccessIterator last, random_access_
 
 // [first, last) 之间的距离
 template<class InputIterator>
-inline typename iterator_traits<InputIterator>::difference_type
+inline __STL_CONSTEXPR14 typename iterator_traits<InputIterator>::difference_type
 distance(InputIterator first, InputIterator last)
 {
     // 根据迭代器类型不同，在编译期进行不同的function dispatch
@@ -110,7 +112,7 @@ distance(InputIterator first, InputIterator last)
 
 //================================= advance 函数
 template<class InputIterator, class Distance>
-inline void __advance(InputIterator& i, Distance n, input_iterator_tag)
+inline __STL_CONSTEXPR14 void __advance(InputIterator& i, Distance n, input_iterator_tag)
 {
     if(n > 0)
         while(n--)
@@ -121,14 +123,14 @@ inline void __advance(InputIterator& i, Distance n, input_iterator_tag)
 }
 
 template<class RandomAccessIterator, class Distance>
-inline void __advance(RandomAccessIterator& i, Distance n, RandomAccessIterator)
+inline __STL_CONSTEXPR14 void __advance(RandomAccessIterator& i, Distance n, random_access_iterator_tag)
 {
     i += n;
 }
 
 // i += n
 template<class InputIterator, class Distance>
-inline void advance(InputIterator& i, Distance n)
+inline __STL_CONSTEXPR14 void advance(InputIterator& i, Distance n)
 {
     __advance(i, n, iterator_category(i));
 }
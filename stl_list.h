@@ -0,0 +1,508 @@
+#ifndef __STL_LIST_H
+#define __STL_LIST_H
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_iterator.h"
+#include "type_traits.h"
+
+// list: 带哨兵节点的环状双向链表
+// 节点的分配与释放按整段进行:
+// 1. 由区间构造或插入n个元素时, 调用 allocate_chain 一次取得n个节点
+// 2. clear / erase(first, last) 把摘下的整段节点用 deallocate_chain 一次接回自由链表,
+//    元素具有trivial destructor时完全不需要遍历这段节点
+
+template<class T>
+struct __list_node
+{
+    // next必须是第一个成员, 这样按next串起来的节点链本身就是分配器可以直接回收的区块链
+    __list_node<T>* next;
+    __list_node<T>* prev;
+    T data;
+};
+
+template<class T, class Ref, class Ptr>
+struct __list_iterator
+{
+    typedef __list_iterator<T, T&, T*> iterator;
+    typedef __list_iterator<T, const T&, const T*> const_iterator;
+    typedef __list_iterator<T, Ref, Ptr> self;
+
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef __list_node<T>* link_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    link_type node;
+
+    __list_iterator() : node(0) {}
+    __list_iterator(link_type x) : node(x)  {}
+    __list_iterator(const iterator& x) : node(x.node)   {}
+    // 对 iterator 来说上一行就是复制构造函数, 复制赋值需要显式声明
+    self& operator=(const self& x) = default;
+
+    bool operator==(const self& x) const    {   return node == x.node;  }
+    bool operator!=(const self& x) const    {   return node != x.node;  }
+
+    reference operator*() const {   return node->data;  }
+    pointer operator->() const  {   return &node->data; }
+
+    self& operator++()
+    {
+        node = node->next;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--()
+    {
+        node = node->prev;
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};
+
+
+template<class T, class Alloc = alloc>
+class list
+{
+protected:
+    typedef __list_node<T> list_node;
+    typedef simple_alloc<list_node, Alloc> list_node_allocator;
+
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef list_node* link_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __list_iterator<T, T&, T*> iterator;
+    typedef __list_iterator<T, const T&, const T*> const_iterator;
+
+protected:
+    link_type node;     // 哨兵节点, node即end(), node->next即begin()
+
+protected:
+    link_type get_node()            {   return list_node_allocator::allocate(); }
+    void put_node(link_type p)      {   list_node_allocator::deallocate(p); }
+
+    link_type create_node(const T& x)
+    {
+        link_type p = get_node();
+        construct(&p->data, x);
+        return p;
+    }
+    void destroy_node(link_type p)
+    {
+        destroy(&p->data);
+        put_node(p);
+    }
+
+    void empty_initialize()
+    {
+        node = get_node();
+        node->next = node;
+        node->prev = node;
+    }
+
+    // [first, last] 是一段已经从链表上摘下、按next串起来的节点, 析构元素后整段归还
+    void destroy_chain(link_type first, link_type last)
+    {
+        typedef typename __type_traits<T>::has_trivial_destructor trivial_destructor;
+        destroy_chain_aux(first, last, trivial_destructor());
+        list_node_allocator::deallocate_chain(first, last);
+    }
+    void destroy_chain_aux(link_type, link_type, __true_type)   {}
+    void destroy_chain_aux(link_type first, link_type last, __false_type)
+    {
+        for(link_type cur = first; ; cur = cur->next)
+        {
+            destroy(&cur->data);
+            if(cur == last)
+                break;
+        }
+    }
+
+    // 从allocate_chain得到的节点链上依次取节点构造元素, 整段链接到position之前
+    template<class InputIterator>
+    void link_chain(iterator position, link_type chain, InputIterator first, size_type n)
+    {
+        link_type prev = position.node->prev;
+        for(; n > 0; --n, ++first)
+        {
+            link_type cur = chain;
+            chain = chain->next;
+            construct(&cur->data, *first);
+            prev->next = cur;
+            cur->prev = prev;
+            prev = cur;
+        }
+        prev->next = position.node;
+        position.node->prev = prev;
+    }
+
+    void fill_link_chain(iterator position, link_type chain, size_type n, const T& x)
+    {
+        link_type prev = position.node->prev;
+        for(; n > 0; --n)
+        {
+            link_type cur = chain;
+            chain = chain->next;
+            construct(&cur->data, x);
+            prev->next = cur;
+            cur->prev = prev;
+            prev = cur;
+        }
+        prev->next = position.node;
+        position.node->prev = prev;
+    }
+
+    template<class InputIterator>
+    void range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        for(; first != last; ++first)
+            insert(position, *first);
+    }
+
+    // 可以预先算出元素个数, 一次取得所有节点
+    template<class ForwardIterator>
+    void range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+    {
+        size_type n = distance(first, last);
+        if(n != 0)
+            link_chain(position, list_node_allocator::allocate_chain(n), first, n);
+    }
+
+    // 两个参数都是整数时按 (个数, 值) 处理
+    template<class Integer>
+    void insert_dispatch(iterator position, Integer n, Integer x, __true_type)  {   insert(position, size_type(n), T(x));   }
+
+    template<class InputIterator>
+    void insert_dispatch(iterator position, InputIterator first, InputIterator last, __false_type)
+    {
+        range_insert(position, first, last, iterator_category(first));
+    }
+
+    // 将 [first, last) 移动到 position 之前
+    void transfer(iterator position, iterator first, iterator last)
+    {
+        if(position != last)
+        {
+            last.node->prev->next = position.node;
+            first.node->prev->next = last.node;
+            position.node->prev->next = first.node;
+            link_type tmp = position.node->prev;
+            position.node->prev = last.node->prev;
+            last.node->prev = first.node->prev;
+            first.node->prev = tmp;
+        }
+    }
+
+public:
+    list()  {   empty_initialize(); }
+
+    list(size_type n, const T& value)
+    {
+        empty_initialize();
+        insert(begin(), n, value);
+    }
+    list(int n, const T& value)
+    {
+        empty_initialize();
+        insert(begin(), (size_type)n, value);
+    }
+    list(long n, const T& value)
+    {
+        empty_initialize();
+        insert(begin(), (size_type)n, value);
+    }
+    explicit list(size_type n)
+    {
+        empty_initialize();
+        insert(begin(), n, T());
+    }
+
+    template<class InputIterator>
+    list(InputIterator first, InputIterator last)
+    {
+        empty_initialize();
+        insert_dispatch(begin(), first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    list(const list& x)
+    {
+        empty_initialize();
+        insert(begin(), x.begin(), x.end());
+    }
+
+    list& operator=(const list& x)
+    {
+        if(this != &x)
+        {
+            list tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~list()
+    {
+        clear();
+        put_node(node);
+    }
+
+public:
+    iterator begin()    {   return node->next;  }
+    iterator end()      {   return node;    }
+    const_iterator begin() const    {   return node->next;  }
+    const_iterator end() const      {   return node;    }
+
+    bool empty() const  {   return node->next == node;  }
+    size_type size() const  {   return distance(begin(), end());    }
+    size_type max_size() const  {   return size_type(-1);   }
+
+    reference front()   {   return *begin();    }
+    reference back()    {   return *(--end());  }
+    const_reference front() const   {   return *begin();    }
+    const_reference back() const    {   return *(--end());  }
+
+    void swap(list& x)  {   ::swap(node, x.node);   }
+
+public:
+    iterator insert(iterator position, const T& x)
+    {
+        link_type tmp = create_node(x);
+        tmp->next = position.node;
+        tmp->prev = position.node->prev;
+        position.node->prev->next = tmp;
+        position.node->prev = tmp;
+        return tmp;
+    }
+
+    void insert(iterator position, size_type n, const T& x)
+    {
+        if(n != 0)
+            fill_link_chain(position, list_node_allocator::allocate_chain(n), n, x);
+    }
+    void insert(iterator position, int n, const T& x)   {   insert(position, (size_type)n, x);  }
+    void insert(iterator position, long n, const T& x)  {   insert(position, (size_type)n, x);  }
+
+    template<class InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last)
+    {
+        insert_dispatch(position, first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    void push_front(const T& x) {   insert(begin(), x); }
+    void push_back(const T& x)  {   insert(end(), x);   }
+
+    iterator erase(iterator position)
+    {
+        link_type next_node = position.node->next;
+        link_type prev_node = position.node->prev;
+        prev_node->next = next_node;
+        next_node->prev = prev_node;
+        destroy_node(position.node);
+        return next_node;
+    }
+
+    // 整段摘下后一次归还
+    iterator erase(iterator first, iterator last)
+    {
+        if(first != last)
+        {
+            link_type first_node = first.node;
+            link_type last_node = last.node->prev;
+            first_node->prev->next = last.node;
+            last.node->prev = first_node->prev;
+            destroy_chain(first_node, last_node);
+        }
+        return last;
+    }
+
+    void pop_front()    {   erase(begin()); }
+    void pop_back()
+    {
+        iterator tmp = end();
+        erase(--tmp);
+    }
+
+    void clear()
+    {
+        if(node->next == node)
+            return;
+        link_type first = node->next;
+        link_type last = node->prev;
+        node->next = node;
+        node->prev = node;
+        destroy_chain(first, last);
+    }
+
+    void resize(size_type new_size, const T& x)
+    {
+        iterator i = begin();
+        size_type len = 0;
+        for(; i != end() && len < new_size; ++i, ++len)
+            ;
+        if(len == new_size)
+            erase(i, end());
+        else
+            insert(end(), new_size - len, x);
+    }
+    void resize(size_type new_size) {   resize(new_size, T());  }
+
+public:
+    // 将x的所有元素移动到position之前
+    void splice(iterator position, list& x)
+    {
+        if(!x.empty())
+            transfer(position, x.begin(), x.end());
+    }
+    // 将i所指元素移动到position之前
+    void splice(iterator position, list&, iterator i)
+    {
+        iterator j = i;
+        ++j;
+        if(position == i || position == j)
+            return;
+        transfer(position, i, j);
+    }
+    // 将[first, last)移动到position之前, O(1)
+    void splice(iterator position, list&, iterator first, iterator last)
+    {
+        if(first != last)
+            transfer(position, first, last);
+    }
+
+    void remove(const T& value)
+    {
+        iterator first = begin();
+        iterator last = end();
+        while(first != last)
+        {
+            iterator next = first;
+            ++next;
+            if(*first == value)
+                erase(first);
+            first = next;
+        }
+    }
+
+    // 删除连续重复的元素
+    void unique()
+    {
+        iterator first = begin();
+        iterator last = end();
+        if(first == last)
+            return;
+        iterator next = first;
+        while(++next != last)
+        {
+            if(*first == *next)
+                erase(next);
+            else
+                first = next;
+            next = first;
+        }
+    }
+
+    // 将有序的x合并到有序的*this中
+    void merge(list& x)
+    {
+        iterator first1 = begin();
+        iterator last1 = end();
+        iterator first2 = x.begin();
+        iterator last2 = x.end();
+        while(first1 != last1 && first2 != last2)
+        {
+            if(*first2 < *first1)
+            {
+                iterator next = first2;
+                transfer(first1, first2, ++next);
+                first2 = next;
+            }
+            else
+                ++first1;
+        }
+        if(first2 != last2)
+            transfer(last1, first2, last2);
+    }
+
+    void reverse()
+    {
+        if(node->next == node || node->next->next == node)
+            return;
+        iterator first = begin();
+        ++first;
+        while(first != end())
+        {
+            iterator old = first;
+            ++first;
+            transfer(begin(), old, first);
+        }
+    }
+
+    // 归并排序, counter[i] 存放 2^i 个元素的有序链表
+    void sort()
+    {
+        if(node->next == node || node->next->next == node)
+            return;
+        list carry;
+        list counter[64];
+        int fill = 0;
+        while(!empty())
+        {
+            carry.splice(carry.begin(), *this, begin());
+            int i = 0;
+            while(i < fill && !counter[i].empty())
+            {
+                counter[i].merge(carry);
+                carry.swap(counter[i++]);
+            }
+            carry.swap(counter[i]);
+            if(i == fill)
+                ++fill;
+        }
+        for(int i = 1; i < fill; ++i)
+            counter[i].merge(counter[i - 1]);
+        swap(counter[fill - 1]);
+    }
+};
+
+template<class T, class Alloc>
+inline bool operator==(const list<T, Alloc>& x, const list<T, Alloc>& y)
+{
+    typedef typename list<T, Alloc>::const_iterator const_iterator;
+    const_iterator end1 = x.end();
+    const_iterator end2 = y.end();
+    const_iterator i1 = x.begin();
+    const_iterator i2 = y.begin();
+    for(; i1 != end1 && i2 != end2 && *i1 == *i2; ++i1, ++i2)
+        ;
+    return i1 == end1 && i2 == end2;
+}
+
+template<class T, class Alloc>
+inline bool operator<(const list<T, Alloc>& x, const list<T, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#endif // __STL_LIST_H
\ No newline at end of file
@@ -0,0 +1,535 @@
+#ifndef __STL_LRU_CACHE_H
+#define __STL_LRU_CACHE_H
+
+#include <cstddef>  // size_t
+#include <mutex>
+
+#include "stl_alloc.h"
+#include "stl_algo.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_function.h"
+#include "stl_hash_fun.h"
+#include "stl_hashtable.h"
+#include "stl_intrusive_list.h"
+#include "stl_pair.h"
+#include "stl_uninitialized.h"
+
+// lru_cache<Key, Value>: 容量固定的缓存, 满了以后插入新键时淘汰一个旧键, 查找、插入、删除都是O(1)
+// 1. 索引是线性探测的开放寻址表, 槽位中存放 散列值 与 节点指针, 大小为容量的四倍以上(负载不超过1/4);
+//    删除时把后面的槽位向前移(backward shift), 不留墓碑
+// 2. 节点通过 intrusive_list_hook 串成一条链表, 表头是最近使用的, 淘汰时从表尾取
+// 3. 节点在构造时用 simple_alloc<node, Alloc>::allocate_chain 一次全部取得(默认来自 __default_alloc_template 的内存池),
+//    之后淘汰与删除的节点留在缓存自己的空闲链表上复用, 不再调用配置器
+// 两种淘汰策略:
+//   cache_lru:   命中时把节点移到表头, 淘汰表尾
+//   cache_clock: 命中时只置位节点的 referenced 标志, 不改动链表(second chance);
+//                淘汰时检查表尾, 被引用过的清除标志后移到表头, 直到遇到没有被引用的节点
+// 命中不分配内存; sharded_lru_cache 按散列值的高位把键分到若干个各自加锁的分片, 没有全局锁,
+// 但键与值的复制只在所在分片的锁内进行, 见 sharded_lru_cache 前的说明
+//
+//  lru_cache<int, string> c(1000);
+//  c.put(42, "answer");
+//  if(string* v = c.get(42)) ...               // 未命中时返回0
+//  c.stats().hit_ratio();
+//
+// get 返回的指针在下一次 put / erase / clear 之前有效
+
+enum cache_policy { cache_lru, cache_clock };
+
+struct cache_stats
+{
+    size_t hits;
+    size_t misses;
+    size_t insertions;
+    size_t evictions;
+
+    cache_stats() : hits(0), misses(0), insertions(0), evictions(0)    {}
+
+    double hit_ratio() const
+    {
+        const size_t lookups = hits + misses;
+        return lookups ? double(hits) / double(lookups) : 0.0;
+    }
+
+    cache_stats& operator+=(const cache_stats& x)
+    {
+        hits += x.hits;
+        misses += x.misses;
+        insertions += x.insertions;
+        evictions += x.evictions;
+        return *this;
+    }
+};
+
+template<class Key, class Value>
+struct __cache_node : public intrusive_list_hook<>
+{
+    Key key;
+    Value value;
+    size_t hash;
+    bool referenced;    // cache_clock: 上次经过表尾之后是否被命中过
+
+    __cache_node(const Key& k, const Value& v, size_t h) : key(k), value(v), hash(h), referenced(false)   {}
+};
+
+// 索引的槽位, node 为0表示空
+struct __cache_slot
+{
+    size_t hash;
+    void* node;
+};
+
+template<>
+struct __type_traits<__cache_slot>
+{
+    typedef __true_type has_trivial_default_constructor;
+    typedef __true_type has_trivial_copy_constructor;
+    typedef __true_type has_trivial_assignment_operator;
+    typedef __true_type has_trivial_destructor;
+    typedef __true_type is_POD_type;
+};
+
+// ========================================= lru_cache
+template<class Key, class Value, class HashFcn = hash<Key>, class EqualKey = equal_to<Key>, class Alloc = alloc>
+class lru_cache
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+    typedef size_t size_type;
+
+protected:
+    typedef __cache_node<Key, Value> node;
+    typedef simple_alloc<node, Alloc> node_allocator;
+    typedef simple_alloc<__cache_slot, Alloc> slot_allocator;
+
+    // 批量查找时一次先算出这么多个键的散列值并预取槽位
+    enum { batch_size = 8 };
+
+    hasher hash;
+    key_equal equals;
+    cache_policy policy;
+    size_type max_entries;
+    size_type num_entries;
+    __cache_slot* slots;
+    size_type mask;             // 槽位数减一, 槽位数是2的幂且不少于容量的4倍, 未命中的探测大多很短
+    intrusive_list<node> recency;
+    node* free_nodes;           // 空闲节点以开头的指针串成单链表
+    cache_stats counters;
+
+    // 禁止复制: 节点的地址被 get 返回给调用者
+    lru_cache(const lru_cache&);
+    lru_cache& operator=(const lru_cache&);
+
+protected:
+    size_t hash_of(const Key& key) const
+    {
+        return __hash_mix(hash(key), typename __hash_is_avalanching<hasher>::type());
+    }
+
+    static node* next_free(node* p)             {   return *reinterpret_cast<node**>(p);    }
+    static void set_next_free(node* p, node* n) {   *reinterpret_cast<node**>(p) = n;   }
+
+    // 键所在的槽位; 不存在时返回探测序列上的第一个空槽位
+    size_type find_slot(const Key& key, size_t h) const
+    {
+        size_type i = h & mask;
+        while(slots[i].node)
+        {
+            if(slots[i].hash == h && equals(static_cast<node*>(slots[i].node)->key, key))
+                return i;
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    // 节点p所在的槽位, 只比较指针, 不必读取其他节点的键
+    size_type slot_of(const node* p) const
+    {
+        size_type i = p->hash & mask;
+        while(slots[i].node != p)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    // 删除槽位i: 其后探测序列上的槽位, 理想位置不在 (i, j] 之间的前移填补空位; 返回最后空出的槽位
+    size_type erase_slot(size_type i)
+    {
+        size_type j = i;
+        for(;;)
+        {
+            j = (j + 1) & mask;
+            if(!slots[j].node)
+                break;
+            const size_type k = slots[j].hash & mask;
+            if((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j))
+            {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i].node = 0;
+        return i;
+    }
+
+    void touch(node* p)
+    {
+        if(policy == cache_clock)
+            p->referenced = true;
+        else if(&recency.front() != p)
+        {
+            p->unlink();
+            recency.push_front(*p);
+        }
+    }
+
+    // 选出要淘汰的节点, cache_clock 下被引用过的节点得到第二次机会
+    node* victim()
+    {
+        node* p = &recency.back();
+        while(policy == cache_clock && p->referenced)
+        {
+            p->referenced = false;
+            p->unlink();
+            recency.push_front(*p);
+            p = &recency.back();
+        }
+        return p;
+    }
+
+    // 从索引与链表中摘下并析构, 节点的空间归还空闲链表; 返回 erase_slot 最后空出的槽位
+    size_type remove(node* p, size_type slot)
+    {
+        const size_type freed = erase_slot(slot);
+        p->unlink();
+        destroy(p);
+        set_next_free(p, free_nodes);
+        free_nodes = p;
+        --num_entries;
+        return freed;
+    }
+
+    void free_storage()
+    {
+        while(free_nodes)
+        {
+            node* p = free_nodes;
+            free_nodes = next_free(p);
+            node_allocator::deallocate(p);
+        }
+        slot_allocator::deallocate(slots, mask + 1);
+    }
+
+public:
+    explicit lru_cache(size_type capacity, cache_policy p = cache_lru,
+                       const hasher& hf = hasher(), const key_equal& eql = key_equal())
+        : hash(hf), equals(eql), policy(p), max_entries(max(capacity, size_type(1))), num_entries(0)
+    {
+        size_type n = 8;
+        while(n < 4 * max_entries)
+            n <<= 1;
+        slots = slot_allocator::allocate(n);
+        mask = n - 1;
+        __cache_slot empty = {0, 0};
+        uninitialized_fill_n(slots, n, empty);
+        free_nodes = node_allocator::allocate_chain(max_entries);
+    }
+
+    ~lru_cache()
+    {
+        clear();
+        free_storage();
+    }
+
+public:
+    size_type size() const      {   return num_entries; }
+    size_type capacity() const  {   return max_entries; }
+    bool empty() const          {   return num_entries == 0;    }
+    cache_policy eviction_policy() const    {   return policy;  }
+
+    const cache_stats& stats() const    {   return counters;    }
+    void reset_stats()                  {   counters = cache_stats();   }
+
+    // ------------------------------------- 查找
+    // 命中时更新最近使用的信息, 返回值的地址; 未命中返回0
+    Value* get(const Key& key)  {   return get_hashed(key, hash_of(key));   }
+
+    // 已经算出散列值(hasher 的结果再经过 __hash_mix)的版本, sharded_lru_cache 选择分片后直接使用
+    Value* get_hashed(const Key& key, size_t h)
+    {
+        const size_type i = find_slot(key, h);
+        node* p = static_cast<node*>(slots[i].node);
+        if(!p)
+        {
+            ++counters.misses;
+            return 0;
+        }
+        ++counters.hits;
+        touch(p);
+        return &p->value;
+    }
+
+    bool get(const Key& key, Value& result)
+    {
+        Value* v = get(key);
+        if(v)
+            result = *v;
+        return v != 0;
+    }
+
+    // 不更新最近使用的信息与统计
+    bool contains(const Key& key) const
+    {
+        return slots[find_slot(key, hash_of(key))].node != 0;
+    }
+
+    // 对 [first, last) 中的每个键向result写入 get 的结果(Value*, 未命中为0), 返回命中的个数
+    // 每批先算出所有散列值并预取对应的槽位, 各个键的缓存缺失可以重叠
+    template<class ForwardIterator, class OutputIterator>
+    size_type get_many(ForwardIterator first, ForwardIterator last, OutputIterator result)
+    {
+        size_type found = 0;
+        const Key* keys[batch_size];
+        size_t hashes[batch_size];
+        while(first != last)
+        {
+            int n = 0;
+            for(; n < batch_size && first != last; ++n, ++first)
+            {
+                keys[n] = &*first;
+                hashes[n] = hash_of(*first);
+                __builtin_prefetch(slots + (hashes[n] & mask));
+            }
+            for(int i = 0; i < n; ++i)
+            {
+                Value* v = get_hashed(*keys[i], hashes[i]);
+                found += v != 0;
+                *result++ = v;
+            }
+        }
+        return found;
+    }
+
+    // ------------------------------------- 插入与删除
+    // 键已存在时更新值并视为一次使用, 返回false; 否则插入, 满了先淘汰一个, 返回true
+    bool put(const Key& key, const Value& value)    {   return put_hashed(key, value, hash_of(key));    }
+
+    bool put_hashed(const Key& key, const Value& value, size_t h)
+    {
+        size_type i = find_slot(key, h);
+        if(slots[i].node)
+        {
+            node* p = static_cast<node*>(slots[i].node);
+            p->value = value;
+            touch(p);
+            return false;
+        }
+        if(num_entries == max_entries)
+        {
+            // 前移只会把槽位挪向各自的理想位置, 空槽位i仍然是空的; 只有新空出的槽位落在
+            // [h & mask, i) 之间时, 它才成为新键探测序列上的第一个空槽位, 不必重新探测
+            node* v = victim();
+            const size_type freed = remove(v, slot_of(v));
+            ++counters.evictions;
+            if(((freed - (h & mask)) & mask) < ((i - (h & mask)) & mask))
+                i = freed;
+        }
+        node* p = free_nodes;
+        free_nodes = next_free(p);
+        new (static_cast<void*>(p)) node(key, value, h);
+        recency.push_front(*p);
+        slots[i].hash = h;
+        slots[i].node = p;
+        ++num_entries;
+        ++counters.insertions;
+        return true;
+    }
+
+    // [first, last) 的元素是 pair<Key, Value>, 逐个 put; 返回新插入的个数
+    template<class ForwardIterator>
+    size_type put_many(ForwardIterator first, ForwardIterator last)
+    {
+        size_type inserted = 0;
+        size_t hashes[batch_size];
+        while(first != last)
+        {
+            ForwardIterator batch = first;
+            int n = 0;
+            for(; n < batch_size && first != last; ++n, ++first)
+            {
+                hashes[n] = hash_of(first->first);
+                __builtin_prefetch(slots + (hashes[n] & mask));
+            }
+            for(int i = 0; i < n; ++i, ++batch)
+                inserted += put_hashed(batch->first, batch->second, hashes[i]);
+        }
+        return inserted;
+    }
+
+    bool erase(const Key& key)  {   return erase_hashed(key, hash_of(key)); }
+
+    bool erase_hashed(const Key& key, size_t h)
+    {
+        const size_type i = find_slot(key, h);
+        node* p = static_cast<node*>(slots[i].node);
+        if(!p)
+            return false;
+        remove(p, i);
+        return true;
+    }
+
+    void clear()
+    {
+        while(!recency.empty())
+        {
+            node* p = &recency.back();
+            recency.pop_back();
+            destroy(p);
+            set_next_free(p, free_nodes);
+            free_nodes = p;
+        }
+        __cache_slot empty = {0, 0};
+        fill_n(slots, mask + 1, empty);
+        num_entries = 0;
+    }
+};
+
+// ========================================= sharded_lru_cache
+// 按散列值的高位分到各个分片, 每个分片是一个独立加锁的 lru_cache, 容量平均分配
+// 不同分片上的操作互不等待; 散列值只计算一次, 低位在分片内部选择槽位
+// 值通过复制返回, 不返回指向缓存内部的指针
+// 注意: 分片的锁只保护各自的分片. 不同分片上的 put / get 会在多个线程中同时复制 Key 与 Value,
+// 而 __default_alloc_template 的内存池没有加锁, 所以 Key 与 Value 复制时不能经过 alloc 配置空间
+// (例如 string 超过短串长度时); 这样的类型应当改用线程安全的配置器, 如 basic_string<char, malloc_alloc>
+// 缓存自己的节点、索引和分片只在构造与析构时配置
+template<class Key, class Value, class HashFcn = hash<Key>, class EqualKey = equal_to<Key>, class Alloc = alloc>
+class sharded_lru_cache
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+    typedef size_t size_type;
+    typedef lru_cache<Key, Value, HashFcn, EqualKey, Alloc> cache_type;
+
+protected:
+    // 每个分片按缓存行对齐, 大小也是缓存行的整数倍, 相邻分片的锁不会落在同一个缓存行上
+    struct alignas(__cache_line_size) shard
+    {
+        std::mutex lock;
+        cache_type cache;
+
+        shard(size_type capacity, cache_policy p, const hasher& hf, const key_equal& eql) : cache(capacity, p, hf, eql) {}
+    };
+    typedef simple_alloc<char, Alloc> raw_allocator;
+
+    hasher hash;
+    char* raw;                  // 配置的原始空间, 多出一个缓存行用于对齐
+    shard* shards;              // 按缓存行对齐
+    size_type num_shards;
+
+    sharded_lru_cache(const sharded_lru_cache&);
+    sharded_lru_cache& operator=(const sharded_lru_cache&);
+
+protected:
+    size_type raw_size() const  {   return num_shards * sizeof(shard) + __cache_line_size;  }
+
+    size_t hash_of(const Key& key) const
+    {
+        return __hash_mix(hash(key), typename __hash_is_avalanching<hasher>::type());
+    }
+
+    // 最高8位选择分片, 分片内部使用低位
+    shard& shard_of(size_t h) const
+    {
+        return shards[(h >> (sizeof(size_t) * 8 - 8)) % num_shards];
+    }
+
+public:
+    // 分片数最多256个
+    explicit sharded_lru_cache(size_type capacity, size_type n = 16, cache_policy p = cache_lru,
+                               const hasher& hf = hasher(), const key_equal& eql = key_equal())
+        : hash(hf), num_shards(min(max(n, size_type(1)), size_type(256)))
+    {
+        const size_type per_shard = (capacity + num_shards - 1) / num_shards;
+        raw = raw_allocator::allocate(raw_size());
+        size_t offset = size_t(__cache_line_size) - reinterpret_cast<size_t>(raw) % __cache_line_size;
+        shards = reinterpret_cast<shard*>(raw + offset % __cache_line_size);
+        for(size_type i = 0; i < num_shards; ++i)
+            new (static_cast<void*>(shards + i)) shard(per_shard, p, hf, eql);
+    }
+
+    ~sharded_lru_cache()
+    {
+        destroy(shards, shards + num_shards);
+        raw_allocator::deallocate(raw, raw_size());
+    }
+
+public:
+    size_type shard_count() const   {   return num_shards;  }
+
+    bool get(const Key& key, Value& result)
+    {
+        const size_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> guard(s.lock);
+        Value* v = s.cache.get_hashed(key, h);
+        if(v)
+            result = *v;
+        return v != 0;
+    }
+
+    bool put(const Key& key, const Value& value)
+    {
+        const size_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.cache.put_hashed(key, value, h);
+    }
+
+    bool erase(const Key& key)
+    {
+        const size_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.cache.erase_hashed(key, h);
+    }
+
+    // 以下逐个分片加锁, 结果不是同一时刻的快照
+    size_type size() const
+    {
+        size_type n = 0;
+        for(size_type i = 0; i < num_shards; ++i)
+        {
+            std::lock_guard<std::mutex> guard(shards[i].lock);
+            n += shards[i].cache.size();
+        }
+        return n;
+    }
+
+    cache_stats stats() const
+    {
+        cache_stats total;
+        for(size_type i = 0; i < num_shards; ++i)
+        {
+            std::lock_guard<std::mutex> guard(shards[i].lock);
+            total += shards[i].cache.stats();
+        }
+        return total;
+    }
+
+    void clear()
+    {
+        for(size_type i = 0; i < num_shards; ++i)
+        {
+            std::lock_guard<std::mutex> guard(shards[i].lock);
+            shards[i].cache.clear();
+        }
+    }
+};
+
+#endif // __STL_LRU_CACHE_H
\ No newline at end of file
@@ -0,0 +1,132 @@
+#ifndef __STL_MAP_H
+#define __STL_MAP_H
+
+#include "stl_alloc.h"
+#include "stl_btree.h"
+#include "stl_function.h"
+#include "stl_pair.h"
+
+// map: 元素为 pair<const Key, T>, 按键值有序且不允许重复, 以B树为底层实现
+// 通过 select1st 从元素中取出键值, 所有操作都转调用btree的接口
+
+template<class Key, class T, class Compare = less<Key>, class Alloc = alloc>
+class map
+{
+public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef pair<const Key, T> value_type;
+    typedef Compare key_compare;
+
+    // 元素比较, 只比较键值
+    class value_compare : public binary_function<value_type, value_type, bool>
+    {
+        friend class map<Key, T, Compare, Alloc>;
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c)  {}
+    public:
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    typedef btree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+public:
+    map() : t(Compare())    {}
+    explicit map(const Compare& comp) : t(comp) {}
+
+    template<class InputIterator>
+    map(InputIterator first, InputIterator last) : t(Compare())
+    {
+        t.insert_unique(first, last);
+    }
+
+    template<class InputIterator>
+    map(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+
+public:
+    key_compare key_comp() const        {   return t.key_comp();    }
+    value_compare value_comp() const    {   return value_compare(t.key_comp()); }
+
+    iterator begin()    {   return t.begin();   }
+    iterator end()      {   return t.end(); }
+    const_iterator begin() const    {   return t.begin();   }
+    const_iterator end() const      {   return t.end(); }
+
+    bool empty() const          {   return t.empty();   }
+    size_type size() const      {   return t.size();    }
+    size_type max_size() const  {   return t.max_size();    }
+    void swap(map& x)           {   t.swap(x.t);    }
+
+    // 键值不存在时插入 pair(k, T())
+    T& operator[](const key_type& k)
+    {
+        iterator i = lower_bound(k);
+        if(i == end() || key_comp()(k, (*i).first))
+            i = t.insert_unique(value_type(k, T())).first;
+        return (*i).second;
+    }
+
+public:
+    pair<iterator, bool> insert(const value_type& x)        {   return t.insert_unique(x);  }
+    iterator insert(iterator position, const value_type& x) {   return t.insert_unique(position, x);    }
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   t.insert_unique(first, last);   }
+
+    // B树删除元素时会搬移其他元素, 返回下一个元素的迭代器
+    iterator erase(iterator position)           {   return t.erase(position);   }
+    size_type erase(const key_type& x)          {   return t.erase(x);  }
+    void erase(iterator first, iterator last)   {   t.erase(first, last);   }
+    void clear()    {   t.clear();  }
+
+public:
+    iterator find(const key_type& x)                {   return t.find(x);   }
+    const_iterator find(const key_type& x) const    {   return t.find(x);   }
+    size_type count(const key_type& x) const        {   return t.find(x) == t.end() ? 0 : 1;    }
+
+    iterator lower_bound(const key_type& x)                 {   return t.lower_bound(x);    }
+    const_iterator lower_bound(const key_type& x) const     {   return t.lower_bound(x);    }
+    iterator upper_bound(const key_type& x)                 {   return t.upper_bound(x);    }
+    const_iterator upper_bound(const key_type& x) const     {   return t.upper_bound(x);    }
+
+    pair<iterator, iterator> equal_range(const key_type& x)     {   return t.equal_range(x);    }
+    pair<const_iterator, const_iterator> equal_range(const key_type& x) const   {   return t.equal_range(x);    }
+
+    template<class K1, class T1, class C1, class A1>
+    friend bool operator==(const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+    template<class K1, class T1, class C1, class A1>
+    friend bool operator<(const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+};
+
+template<class Key, class T, class Compare, class Alloc>
+inline bool operator==(const map<Key, T, Compare, Alloc>& x, const map<Key, T, Compare, Alloc>& y)
+{
+    return x.t == y.t;
+}
+
+template<class Key, class T, class Compare, class Alloc>
+inline bool operator<(const map<Key, T, Compare, Alloc>& x, const map<Key, T, Compare, Alloc>& y)
+{
+    return x.t < y.t;
+}
+
+#endif // __STL_MAP_H
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef __STL_MULTIMAP_H
+#define __STL_MULTIMAP_H
+
+#include "stl_alloc.h"
+#include "stl_btree.h"
+#include "stl_function.h"
+#include "stl_pair.h"
+
+// multimap: 与map相同, 但键值可以重复, 插入使用 btree::insert_equal
+
+template<class Key, class T, class Compare = less<Key>, class Alloc = alloc>
+class multimap
+{
+public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef pair<const Key, T> value_type;
+    typedef Compare key_compare;
+
+    class value_compare : public binary_function<value_type, value_type, bool>
+    {
+        friend class multimap<Key, T, Compare, Alloc>;
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c)  {}
+    public:
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    typedef btree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+public:
+    multimap() : t(Compare())   {}
+    explicit multimap(const Compare& comp) : t(comp)    {}
+
+    template<class InputIterator>
+    multimap(InputIterator first, InputIterator last) : t(Compare())
+    {
+        t.insert_equal(first, last);
+    }
+
+    template<class InputIterator>
+    multimap(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
+    {
+        t.insert_equal(first, last);
+    }
+
+public:
+    key_compare key_comp() const        {   return t.key_comp();    }
+    value_compare value_comp() const    {   return value_compare(t.key_comp()); }
+
+    iterator begin()    {   return t.begin();   }
+    iterator end()      {   return t.end(); }
+    const_iterator begin() const    {   return t.begin();   }
+    const_iterator end() const      {   return t.end(); }
+
+    bool empty() const          {   return t.empty();   }
+    size_type size() const      {   return t.size();    }
+    size_type max_size() const  {   return t.max_size();    }
+    void swap(multimap& x)      {   t.swap(x.t);    }
+
+public:
+    iterator insert(const value_type& x)                    {   return t.insert_equal(x);   }
+    iterator insert(iterator position, const value_type& x) {   return t.insert_equal(position, x); }
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   t.insert_equal(first, last);    }
+
+    iterator erase(iterator position)           {   return t.erase(position);   }
+    size_type erase(const key_type& x)          {   return t.erase(x);  }
+    void erase(iterator first, iterator last)   {   t.erase(first, last);   }
+    void clear()    {   t.clear();  }
+
+public:
+    iterator find(const key_type& x)                {   return t.find(x);   }
+    const_iterator find(const key_type& x) const    {   return t.find(x);   }
+    size_type count(const key_type& x) const        {   return t.count(x);  }
+
+    iterator lower_bound(const key_type& x)                 {   return t.lower_bound(x);    }
+    const_iterator lower_bound(const key_type& x) const     {   return t.lower_bound(x);    }
+    iterator upper_bound(const key_type& x)                 {   return t.upper_bound(x);    }
+    const_iterator upper_bound(const key_type& x) const     {   return t.upper_bound(x);    }
+
+    pair<iterator, iterator> equal_range(const key_type& x)     {   return t.equal_range(x);    }
+    pair<const_iterator, const_iterator> equal_range(const key_type& x) const   {   return t.equal_range(x);    }
+
+    template<class K1, class T1, class C1, class A1>
+    friend bool operator==(const multimap<K1, T1, C1, A1>&, const multimap<K1, T1, C1, A1>&);
+    template<class K1, class T1, class C1, class A1>
+    friend bool operator<(const multimap<K1, T1, C1, A1>&, const multimap<K1, T1, C1, A1>&);
+};
+
+template<class Key, class T, class Compare, class Alloc>
+inline bool operator==(const multimap<Key, T, Compare, Alloc>& x, const multimap<Key, T, Compare, Alloc>& y)
+{
+    return x.t == y.t;
+}
+
+template<class Key, class T, class Compare, class Alloc>
+inline bool operator<(const multimap<Key, T, Compare, Alloc>& x, const multimap<Key, T, Compare, Alloc>& y)
+{
+    return x.t < y.t;
+}
+
+#endif // __STL_MULTIMAP_H
\ No newline at end of file
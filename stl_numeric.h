@@ -1,5 +1,502 @@
 #ifndef __STL_NUMERIC_H
 #define __STL_NUMERIC_H
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "stl_config.h"
+#include "stl_function.h"
+#include "stl_iterator.h"
+#include "type_traits.h"
+
+// 数值算法: accumulate, inner_product, partial_sum, adjacent_difference, iota
+//
+// 向量化: 区间是算术类型T的指针(vector的迭代器就是指针), 运算是 plus<T> / multiplies<T> / minus<T> 时,
+// 编译期选择专门的实现:
+//   - 归约(accumulate, inner_product)使用多个独立的累加器, 打断循环间的依赖链, 编译器可以把它们向量化
+//   - adjacent_difference 按块先读后写, 没有别名问题, 块内的循环可以向量化
+//   - partial_sum 对32位整数使用SSE2的寄存器内前缀和
+//   - iota 对整数按下标计算
+// 整数运算满足结合律, 改变运算顺序不影响结果, 总是使用向量化版本
+// 浮点运算改变顺序会改变舍入结果, 默认按顺序计算; 用 reassociate(op) 包装运算后才允许重排:
+//
+//   float s = accumulate(v.begin(), v.end(), 0.0f, reassociate(plus<float>()));
+
+// 允许重排运算顺序的包装, 运算本身不变
+template<class Operation>
+struct reassociable : public Operation
+{
+    reassociable()  {}
+    reassociable(const Operation& op) : Operation(op)   {}
+};
+
+template<class Operation>
+inline reassociable<Operation> reassociate(const Operation& op)
+{
+    return reassociable<Operation>(op);
+}
+
+// ========================================= 归约的分派
+// (T, Operation) 能否重排: 整数的 plus / multiplies / minus 总是可以, 浮点数需要 reassociable 包装
+template<class T, class Operation>
+struct __reduction_kind
+{
+    typedef __false_type type;
+};
+
+template<class T> struct __reduction_kind<T, plus<T> >          {   typedef typename __is_integer<T>::type type;    };
+template<class T> struct __reduction_kind<T, multiplies<T> >    {   typedef typename __is_integer<T>::type type;    };
+template<class T> struct __reduction_kind<T, minus<T> >         {   typedef typename __is_integer<T>::type type;    };
+template<class T> struct __reduction_kind<T, reassociable<plus<T> > >       {   typedef typename __is_arithmetic<T>::type type; };
+template<class T> struct __reduction_kind<T, reassociable<multiplies<T> > > {   typedef typename __is_arithmetic<T>::type type; };
+template<class T> struct __reduction_kind<T, reassociable<minus<T> > >      {   typedef typename __is_arithmetic<T>::type type; };
+
+// 只有元素类型与初值类型相同的指针区间才使用向量化版本
+template<class Iterator, class T, class Operation>
+struct __reduction_dispatch
+{
+    typedef __false_type type;
+};
+
+template<class T, class Operation>
+struct __reduction_dispatch<T*, T, Operation> : public __reduction_kind<T, Operation>   {};
+
+template<class T, class Operation>
+struct __reduction_dispatch<const T*, T, Operation> : public __reduction_kind<T, Operation>  {};
+
+// 逐元素的运算, 不涉及重排
+template<class T, class Operation>
+struct __elementwise_kind
+{
+    typedef __false_type type;
+};
+
+template<class T> struct __elementwise_kind<T, plus<T> >        {   typedef typename __is_arithmetic<T>::type type; };
+template<class T> struct __elementwise_kind<T, minus<T> >       {   typedef typename __is_arithmetic<T>::type type; };
+template<class T> struct __elementwise_kind<T, multiplies<T> >  {   typedef typename __is_arithmetic<T>::type type; };
+template<class T, class Operation>
+struct __elementwise_kind<T, reassociable<Operation> > : public __elementwise_kind<T, Operation> {};
+
+// 累加器的初值, 每个元素如何并入累加器, 以及最后如何与init合并
+// minus: init - a - b - c = init - (a + b + c)
+template<class T>
+inline T __reduction_identity(plus<T>)          {   return identity_element(plus<T>()); }
+template<class T>
+inline T __reduction_identity(multiplies<T>)    {   return identity_element(multiplies<T>());   }
+template<class T>
+inline T __reduction_identity(minus<T>)         {   return T(0);    }
+
+template<class T>
+inline T __reduction_combine(plus<T>, const T& x, const T& y)       {   return x + y;   }
+template<class T>
+inline T __reduction_combine(multiplies<T>, const T& x, const T& y) {   return x * y;   }
+template<class T>
+inline T __reduction_combine(minus<T>, const T& x, const T& y)      {   return x + y;   }
+
+template<class T>
+inline T __reduction_finish(plus<T>, const T& init, const T& total)         {   return init + total;    }
+template<class T>
+inline T __reduction_finish(multiplies<T>, const T& init, const T& total)   {   return init * total;    }
+template<class T>
+inline T __reduction_finish(minus<T>, const T& init, const T& total)        {   return init - total;    }
+
+// 独立累加器的个数: 覆盖加法的延迟, 并凑满若干个向量寄存器
+enum { __reduce_lanes = 16 };
+
+// ========================================= accumulate
+template<class T, class BinaryOperation>
+T __accumulate_kernel(const T* first, const T* last, T init, BinaryOperation op)
+{
+    T acc[__reduce_lanes];
+    for(int j = 0; j < __reduce_lanes; ++j)
+        acc[j] = __reduction_identity(op);
+    for(; last - first >= __reduce_lanes; first += __reduce_lanes)
+        for(int j = 0; j < __reduce_lanes; ++j)
+            acc[j] = __reduction_combine(op, acc[j], first[j]);
+    // 两两合并累加器
+    for(int w = __reduce_lanes / 2; w > 0; w /= 2)
+        for(int j = 0; j < w; ++j)
+            acc[j] = __reduction_combine(op, acc[j], acc[j + w]);
+    T total = acc[0];
+    for(; first != last; ++first)
+        total = __reduction_combine(op, total, *first);
+    return __reduction_finish(op, init, total);
+}
+
+template<class InputIterator, class T, class BinaryOperation>
+inline __STL_CONSTEXPR14 T __accumulate(InputIterator first, InputIterator last, T init, BinaryOperation binary_op, __false_type)
+{
+    for(; first != last; ++first)
+        init = binary_op(init, *first);
+    return init;
+}
+
+template<class InputIterator, class T, class BinaryOperation>
+inline T __accumulate(InputIterator first, InputIterator last, T init, BinaryOperation binary_op, __true_type)
+{
+    return __accumulate_kernel(static_cast<const T*>(first), static_cast<const T*>(last), init, binary_op);
+}
+
+// 以init为初值, 依次累加区间内的每个元素, 或者依次执行 init = binary_op(init, *i)
+// 常量求值中按顺序逐个累加
+template<class InputIterator, class T, class BinaryOperation>
+inline __STL_CONSTEXPR14 T accumulate(InputIterator first, InputIterator last, T init, BinaryOperation binary_op)
+{
+    typedef typename __reduction_dispatch<InputIterator, T, BinaryOperation>::type vectorizable;
+    if(__STL_CONSTANT_EVALUATED())
+        return __accumulate(first, last, init, binary_op, __false_type());
+    return __accumulate(first, last, init, binary_op, vectorizable());
+}
+
+template<class InputIterator, class T>
+inline __STL_CONSTEXPR14 T __accumulate(InputIterator first, InputIterator last, T init, __false_type)
+{
+    for(; first != last; ++first)
+        init = init + *first;
+    return init;
+}
+
+template<class InputIterator, class T>
+inline T __accumulate(InputIterator first, InputIterator last, T init, __true_type)
+{
+    return __accumulate_kernel(static_cast<const T*>(first), static_cast<const T*>(last), init, plus<T>());
+}
+
+template<class InputIterator, class T>
+inline __STL_CONSTEXPR14 T accumulate(InputIterator first, InputIterator last, T init)
+{
+    typedef typename __reduction_dispatch<InputIterator, T, plus<T> >::type vectorizable;
+    if(__STL_CONSTANT_EVALUATED())
+        return __accumulate(first, last, init, __false_type());
+    return __accumulate(first, last, init, vectorizable());
+}
+
+// ========================================= inner_product
+// init = binary_op1(init, binary_op2(*first1, *first2)), 默认为 init + (*first1) * (*first2)
+template<class Iterator1, class Iterator2, class T, class BinaryOperation1, class BinaryOperation2>
+struct __inner_product_dispatch
+{
+    typedef __false_type type;
+};
+
+template<class T, class BinaryOperation1, class BinaryOperation2>
+struct __inner_product_dispatch<const T*, const T*, T, BinaryOperation1, BinaryOperation2>
+{
+    typedef typename __type_and<typename __reduction_kind<T, BinaryOperation1>::type,
+                                typename __elementwise_kind<T, BinaryOperation2>::type>::type type;
+};
+
+template<class T, class BinaryOperation1, class BinaryOperation2>
+struct __inner_product_dispatch<T*, T*, T, BinaryOperation1, BinaryOperation2>
+    : public __inner_product_dispatch<const T*, const T*, T, BinaryOperation1, BinaryOperation2>   {};
+
+template<class T, class BinaryOperation1, class BinaryOperation2>
+struct __inner_product_dispatch<const T*, T*, T, BinaryOperation1, BinaryOperation2>
+    : public __inner_product_dispatch<const T*, const T*, T, BinaryOperation1, BinaryOperation2>   {};
+
+template<class T, class BinaryOperation1, class BinaryOperation2>
+struct __inner_product_dispatch<T*, const T*, T, BinaryOperation1, BinaryOperation2>
+    : public __inner_product_dispatch<const T*, const T*, T, BinaryOperation1, BinaryOperation2>   {};
+
+template<class T, class BinaryOperation1, class BinaryOperation2>
+T __inner_product_kernel(const T* first1, const T* last1, const T* first2, T init,
+                         BinaryOperation1 binary_op1, BinaryOperation2 binary_op2)
+{
+    T acc[__reduce_lanes];
+    for(int j = 0; j < __reduce_lanes; ++j)
+        acc[j] = __reduction_identity(binary_op1);
+    for(; last1 - first1 >= __reduce_lanes; first1 += __reduce_lanes, first2 += __reduce_lanes)
+        for(int j = 0; j < __reduce_lanes; ++j)
+            acc[j] = __reduction_combine(binary_op1, acc[j], binary_op2(first1[j], first2[j]));
+    for(int w = __reduce_lanes / 2; w > 0; w /= 2)
+        for(int j = 0; j < w; ++j)
+            acc[j] = __reduction_combine(binary_op1, acc[j], acc[j + w]);
+    T total = acc[0];
+    for(; first1 != last1; ++first1, ++first2)
+        total = __reduction_combine(binary_op1, total, binary_op2(*first1, *first2));
+    return __reduction_finish(binary_op1, init, total);
+}
+
+template<class InputIterator1, class InputIterator2, class T, class BinaryOperation1, class BinaryOperation2>
+inline T __inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                         BinaryOperation1 binary_op1, BinaryOperation2 binary_op2, __false_type)
+{
+    for(; first1 != last1; ++first1, ++first2)
+        init = binary_op1(init, binary_op2(*first1, *first2));
+    return init;
+}
+
+template<class InputIterator1, class InputIterator2, class T, class BinaryOperation1, class BinaryOperation2>
+inline T __inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                         BinaryOperation1 binary_op1, BinaryOperation2 binary_op2, __true_type)
+{
+    return __inner_product_kernel(static_cast<const T*>(first1), static_cast<const T*>(last1),
+                                  static_cast<const T*>(first2), init, binary_op1, binary_op2);
+}
+
+template<class InputIterator1, class InputIterator2, class T, class BinaryOperation1, class BinaryOperation2>
+inline T inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                       BinaryOperation1 binary_op1, BinaryOperation2 binary_op2)
+{
+    typedef typename __inner_product_dispatch<InputIterator1, InputIterator2, T,
+                                              BinaryOperation1, BinaryOperation2>::type vectorizable;
+    return __inner_product(first1, last1, first2, init, binary_op1, binary_op2, vectorizable());
+}
+
+template<class InputIterator1, class InputIterator2, class T>
+inline T __inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init, __false_type)
+{
+    for(; first1 != last1; ++first1, ++first2)
+        init = init + *first1 * *first2;
+    return init;
+}
+
+template<class InputIterator1, class InputIterator2, class T>
+inline T __inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init, __true_type)
+{
+    return __inner_product_kernel(static_cast<const T*>(first1), static_cast<const T*>(last1),
+                                  static_cast<const T*>(first2), init, plus<T>(), multiplies<T>());
+}
+
+template<class InputIterator1, class InputIterator2, class T>
+inline T inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init)
+{
+    typedef typename __inner_product_dispatch<InputIterator1, InputIterator2, T,
+                                              plus<T>, multiplies<T> >::type vectorizable;
+    return __inner_product(first1, last1, first2, init, vectorizable());
+}
+
+// ========================================= partial_sum
+// *result = *first, *(result+1) = *first + *(first+1), ...
+// 32位整数与允许重排的float在SSE2下每次处理4个元素: 寄存器内两次移位相加得到块内前缀和, 再加上前一块的总和
+// 每块先读后写, 允许 result == first
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+struct __scan_dispatch
+{
+    typedef __false_type type;
+};
+
+#ifdef __SSE2__
+template<> struct __scan_dispatch<int*, int*, plus<int> >                           {   typedef __true_type type;   };
+template<> struct __scan_dispatch<const int*, int*, plus<int> >                     {   typedef __true_type type;   };
+template<> struct __scan_dispatch<unsigned int*, unsigned int*, plus<unsigned int> >        {   typedef __true_type type;   };
+template<> struct __scan_dispatch<const unsigned int*, unsigned int*, plus<unsigned int> >  {   typedef __true_type type;   };
+template<> struct __scan_dispatch<float*, float*, reassociable<plus<float> > >          {   typedef __true_type type;   };
+template<> struct __scan_dispatch<const float*, float*, reassociable<plus<float> > >    {   typedef __true_type type;   };
+
+template<class T>
+T* __partial_sum_kernel(const T* first, const T* last, T* result)
+{
+    __m128i carry = _mm_setzero_si128();
+    for(; last - first >= 4; first += 4, result += 4)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result), x);
+        carry = _mm_shuffle_epi32(x, 0xff);
+    }
+    T sum = T(_mm_cvtsi128_si32(carry));
+    for(; first != last; ++first, ++result)
+    {
+        sum = sum + *first;
+        *result = sum;
+    }
+    return result;
+}
+
+inline float* __partial_sum_kernel(const float* first, const float* last, float* result)
+{
+    __m128 carry = _mm_setzero_ps();
+    for(; last - first >= 4; first += 4, result += 4)
+    {
+        __m128 x = _mm_loadu_ps(first);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+        x = _mm_add_ps(x, carry);
+        _mm_storeu_ps(result, x);
+        carry = _mm_shuffle_ps(x, x, 0xff);
+    }
+    float sum = _mm_cvtss_f32(carry);
+    for(; first != last; ++first, ++result)
+    {
+        sum = sum + *first;
+        *result = sum;
+    }
+    return result;
+}
+#endif // __SSE2__
+
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+OutputIterator __partial_sum(InputIterator first, InputIterator last, OutputIterator result,
+                             BinaryOperation binary_op, __false_type)
+{
+    if(first == last)
+        return result;
+    typename iterator_traits<InputIterator>::value_type value = *first;
+    *result = value;
+    while(++first != last)
+    {
+        value = binary_op(value, *first);
+        *++result = value;
+    }
+    return ++result;
+}
+
+#ifdef __SSE2__
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+inline OutputIterator __partial_sum(InputIterator first, InputIterator last, OutputIterator result,
+                                    BinaryOperation, __true_type)
+{
+    typedef typename iterator_traits<OutputIterator>::value_type T;
+    return __partial_sum_kernel(static_cast<const T*>(first), static_cast<const T*>(last), result);
+}
+#endif
+
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+inline OutputIterator partial_sum(InputIterator first, InputIterator last, OutputIterator result,
+                                  BinaryOperation binary_op)
+{
+    typedef typename __scan_dispatch<InputIterator, OutputIterator, BinaryOperation>::type vectorizable;
+    return __partial_sum(first, last, result, binary_op, vectorizable());
+}
+
+template<class InputIterator, class OutputIterator>
+inline OutputIterator partial_sum(InputIterator first, InputIterator last, OutputIterator result)
+{
+    typedef typename iterator_traits<InputIterator>::value_type T;
+    return partial_sum(first, last, result, plus<T>());
+}
+
+// ========================================= adjacent_difference
+// *result = *first, *(result+i) = binary_op(*(first+i), *(first+i-1)), 默认为相邻元素之差
+// 指针区间按块处理: 先把整块的结果算到局部数组中, 再写回, result == first 时也正确
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+struct __adjacent_difference_dispatch
+{
+    typedef __false_type type;
+};
+
+template<class T, class BinaryOperation>
+struct __adjacent_difference_dispatch<T*, T*, BinaryOperation> : public __elementwise_kind<T, BinaryOperation>  {};
+
+template<class T, class BinaryOperation>
+struct __adjacent_difference_dispatch<const T*, T*, BinaryOperation> : public __elementwise_kind<T, BinaryOperation>    {};
+
+enum { __adjacent_difference_block = 16 };
+
+template<class T, class BinaryOperation>
+T* __adjacent_difference_kernel(const T* first, const T* last, T* result, BinaryOperation binary_op)
+{
+    T prev = *first;
+    *result = prev;
+    ++first;
+    ++result;
+    for(; last - first >= __adjacent_difference_block;
+        first += __adjacent_difference_block, result += __adjacent_difference_block)
+    {
+        T block[__adjacent_difference_block];
+        block[0] = binary_op(first[0], prev);
+        for(int j = 1; j < __adjacent_difference_block; ++j)
+            block[j] = binary_op(first[j], first[j - 1]);
+        prev = first[__adjacent_difference_block - 1];
+        for(int j = 0; j < __adjacent_difference_block; ++j)
+            result[j] = block[j];
+    }
+    for(; first != last; ++first, ++result)
+    {
+        T value = *first;
+        *result = binary_op(value, prev);
+        prev = value;
+    }
+    return result;
+}
+
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+OutputIterator __adjacent_difference(InputIterator first, InputIterator last, OutputIterator result,
+                                     BinaryOperation binary_op, __false_type)
+{
+    if(first == last)
+        return result;
+    typename iterator_traits<InputIterator>::value_type value = *first;
+    *result = value;
+    while(++first != last)
+    {
+        typename iterator_traits<InputIterator>::value_type tmp = *first;
+        *++result = binary_op(tmp, value);
+        value = tmp;
+    }
+    return ++result;
+}
+
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+inline OutputIterator __adjacent_difference(InputIterator first, InputIterator last, OutputIterator result,
+                                            BinaryOperation binary_op, __true_type)
+{
+    typedef typename iterator_traits<OutputIterator>::value_type T;
+    if(first == last)
+        return result;
+    return __adjacent_difference_kernel(static_cast<const T*>(first), static_cast<const T*>(last), result, binary_op);
+}
+
+template<class InputIterator, class OutputIterator, class BinaryOperation>
+inline OutputIterator adjacent_difference(InputIterator first, InputIterator last, OutputIterator result,
+                                          BinaryOperation binary_op)
+{
+    typedef typename __adjacent_difference_dispatch<InputIterator, OutputIterator, BinaryOperation>::type vectorizable;
+    return __adjacent_difference(first, last, result, binary_op, vectorizable());
+}
+
+template<class InputIterator, class OutputIterator>
+inline OutputIterator adjacent_difference(InputIterator first, InputIterator last, OutputIterator result)
+{
+    typedef typename iterator_traits<InputIterator>::value_type T;
+    return adjacent_difference(first, last, result, minus<T>());
+}
+
+// ========================================= iota
+// 依次填入 value, value + 1, value + 2, ...
+// 整数指针区间按下标计算 first[i] = value + i, 没有循环间的依赖
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 void __iota(ForwardIterator first, ForwardIterator last, T value, __false_type)
+{
+    while(first != last)
+        *first++ = value++;
+}
+
+template<class T>
+inline __STL_CONSTEXPR14 void __iota_kernel(T* first, T* last, T value)
+{
+    const ptrdiff_t n = last - first;
+    for(ptrdiff_t i = 0; i < n; ++i)
+        first[i] = T(value + T(i));
+}
+
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 void __iota(ForwardIterator first, ForwardIterator last, T value, __true_type)
+{
+    __iota_kernel(first, last, value);
+}
+
+template<class ForwardIterator, class T>
+struct __iota_dispatch
+{
+    typedef __false_type type;
+};
+
+template<class T>
+struct __iota_dispatch<T*, T>
+{
+    typedef typename __is_integer<T>::type type;
+};
+
+template<class ForwardIterator, class T>
+inline __STL_CONSTEXPR14 void iota(ForwardIterator first, ForwardIterator last, T value)
+{
+    typedef typename __iota_dispatch<ForwardIterator, T>::type vectorizable;
+    __iota(first, last, value, vectorizable());
+}
 
 #endif // __STL_NUMERIC_H
\ No newline at end of file
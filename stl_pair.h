@@ -0,0 +1,74 @@
+#ifndef __STL_PAIR_H
+#define __STL_PAIR_H
+
+#include "type_traits.h"
+
+// pair: 将两个数据组合成一个, 关联式容器(map, hash_map)的元素类型
+
+template<class T1, class T2>
+struct pair
+{
+    typedef T1 first_type;
+    typedef T2 second_type;
+
+    T1 first;
+    T2 second;
+
+    constexpr pair() : first(T1()), second(T2())    {}
+    constexpr pair(const T1& a, const T2& b) : first(a), second(b)  {}
+
+    // 可以由其他类型的pair隐式转换, 例如 pair<Key, T> -> pair<const Key, T>
+    template<class U1, class U2>
+    constexpr pair(const pair<U1, U2>& p) : first(p.first), second(p.second)    {}
+};
+
+template<class T1, class T2>
+inline constexpr bool operator==(const pair<T1, T2>& x, const pair<T1, T2>& y)
+{
+    return x.first == y.first && x.second == y.second;
+}
+
+// 字典序比较
+template<class T1, class T2>
+inline constexpr bool operator<(const pair<T1, T2>& x, const pair<T1, T2>& y)
+{
+    return x.first < y.first || (!(y.first < x.first) && x.second < y.second);
+}
+
+template<class T1, class T2>
+inline constexpr bool operator!=(const pair<T1, T2>& x, const pair<T1, T2>& y)  {   return !(x == y);   }
+
+template<class T1, class T2>
+inline constexpr bool operator>(const pair<T1, T2>& x, const pair<T1, T2>& y)   {   return y < x;   }
+
+template<class T1, class T2>
+inline constexpr bool operator<=(const pair<T1, T2>& x, const pair<T1, T2>& y)  {   return !(y < x);    }
+
+template<class T1, class T2>
+inline constexpr bool operator>=(const pair<T1, T2>& x, const pair<T1, T2>& y)  {   return !(x < y);    }
+
+template<class T1, class T2>
+inline constexpr pair<T1, T2> make_pair(const T1& x, const T2& y)
+{
+    return pair<T1, T2>(x, y);
+}
+
+// 两个成员的复制、赋值、析构都是trivial时, pair也可以直接memmove
+// 默认构造函数会对成员做值初始化, 不是trivial的
+template<class T1, class T2>
+struct __type_traits<pair<T1, T2> >
+{
+    typedef __true_type this_dummy_member_must_be_first;
+
+    typedef __false_type has_trivial_default_constructor;
+    typedef typename __type_and<typename __type_traits<T1>::has_trivial_copy_constructor,
+                                typename __type_traits<T2>::has_trivial_copy_constructor>::type has_trivial_copy_constructor;
+    typedef typename __type_and<typename __type_traits<T1>::has_trivial_assignment_operator,
+                                typename __type_traits<T2>::has_trivial_assignment_operator>::type has_trivial_assignment_operator;
+    typedef typename __type_and<typename __type_traits<T1>::has_trivial_destructor,
+                                typename __type_traits<T2>::has_trivial_destructor>::type has_trivial_destructor;
+    typedef typename __type_and<typename __type_traits<T1>::is_POD_type,
+                                typename __type_traits<T2>::is_POD_type>::type is_POD_type;
+};
+
+#endif // __STL_PAIR_H
\ No newline at end of file
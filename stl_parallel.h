@@ -0,0 +1,693 @@
+#ifndef __STL_PARALLEL_H
+#define __STL_PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>  // size_t
+#include <mutex>
+#include <thread>
+
+#include "stl_algo.h"
+#include "stl_construct.h"
+#include "stl_function.h"
+#include "stl_iterator.h"
+#include "stl_numeric.h"
+
+// 并行算法: for_each / transform / sort / accumulate / count_if / find_if 的执行策略版本
+//
+//   for_each(par, v.begin(), v.end(), f);
+//   sort(par, v.begin(), v.end(), greater<int>());
+//
+// 执行策略:
+//   seq        在调用线程上顺序执行, 等同于不带策略的版本
+//   par        区间切分后由线程池并行执行, 每一块内部顺序执行
+//   par_unseq  同par, 块内的循环没有顺序依赖, 编译器可以向量化
+// 只有随机访问迭代器会并行执行, 其他迭代器退化为顺序执行
+// 并行执行时函数对象会被多个线程同时调用, 必须是线程安全的, 并且不能抛出异常
+//
+// 线程池: fork/join 式的工作窃取调度
+//   - 每个工作线程有自己的双端队列, fork 的任务压入自己队列的底部, 自己也从底部取(LIFO, 缓存友好)
+//   - 空闲线程从其他队列的顶部窃取(FIFO), 窃取到的是最早fork、也就是最大的任务
+//   - join 时不阻塞, 在等待的任务完成之前继续执行自己队列中的任务或者去窃取
+// 工作线程数默认为 hardware_concurrency() - 1, 调用线程也参与执行; 可以定义 __STL_PARALLEL_THREADS 指定总线程数
+// 使用时需要链接线程库(-pthread)
+
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy : public parallel_policy {};
+
+const sequenced_policy seq = sequenced_policy();
+const parallel_policy par = parallel_policy();
+const parallel_unsequenced_policy par_unseq = parallel_unsequenced_policy();
+
+
+// ========================================= 工作窃取线程池
+struct __parallel_task
+{
+    virtual void execute() = 0;
+    virtual ~__parallel_task()  {}
+};
+
+// 任务指针的环形队列, 所有者在底部压入和弹出, 其他线程从顶部窃取
+// fork/join 的嵌套深度只有 O(log n), 容量固定即可, 队列满时由调用者直接执行
+struct __parallel_deque
+{
+    enum { capacity = 256 };
+
+    std::mutex lock;
+    __parallel_task* tasks[capacity];
+    size_t top;
+    size_t bottom;
+
+    __parallel_deque() : top(0), bottom(0)  {}
+
+    bool push(__parallel_task* t)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(bottom - top == capacity)
+            return false;
+        tasks[bottom++ % capacity] = t;
+        return true;
+    }
+
+    __parallel_task* pop()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(top == bottom)
+            return 0;
+        return tasks[--bottom % capacity];
+    }
+
+    __parallel_task* steal()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(top == bottom)
+            return 0;
+        return tasks[top++ % capacity];
+    }
+};
+
+class __parallel_pool
+{
+private:
+    size_t num_workers;         // 后台工作线程数
+    __parallel_deque* deques;   // 每个工作线程一个, 最后一个由池外的调用线程共用
+    std::thread* threads;
+
+    std::atomic<bool> stopping;
+    std::atomic<size_t> epoch;      // 每次压入任务时递增, 用于唤醒睡眠的线程
+    std::atomic<size_t> sleepers;
+    std::mutex sleep_lock;
+    std::condition_variable wakeup;
+
+    __parallel_pool(const __parallel_pool&);
+    __parallel_pool& operator=(const __parallel_pool&);
+
+    // 当前线程的队列下标, 池外线程为 num_workers
+    static int& worker_index()
+    {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    size_t local_index() const
+    {
+        int i = worker_index();
+        return i < 0 ? num_workers : size_t(i);
+    }
+
+    // 从随机位置开始依次尝试窃取
+    __parallel_task* steal(size_t self)
+    {
+        static thread_local size_t seed = 0x9e3779b97f4a7c15ull;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        const size_t n = num_workers + 1;
+        size_t start = seed % n;
+        for(size_t i = 0; i < n; ++i)
+        {
+            size_t victim = (start + i) % n;
+            if(victim == self)
+                continue;
+            if(__parallel_task* t = deques[victim].steal())
+                return t;
+        }
+        return 0;
+    }
+
+    void worker_loop(size_t self)
+    {
+        worker_index() = int(self);
+        while(!stopping.load(std::memory_order_acquire))
+        {
+            size_t seen = epoch.load(std::memory_order_acquire);
+            __parallel_task* t = deques[self].pop();
+            if(!t)
+                t = steal(self);
+            if(t)
+            {
+                t->execute();
+                continue;
+            }
+            // 没有任务: 睡眠到有新任务压入; 在检查队列之前记下的epoch保证不会错过唤醒
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            ++sleepers;
+            while(!stopping.load(std::memory_order_acquire) && epoch.load(std::memory_order_acquire) == seen)
+                wakeup.wait(guard);
+            --sleepers;
+        }
+    }
+
+    static void thread_entry(__parallel_pool* pool, size_t self)
+    {
+        pool->worker_loop(self);
+    }
+
+    explicit __parallel_pool(size_t workers)
+        : num_workers(workers), deques(new __parallel_deque[workers + 1]), threads(0),
+          stopping(false), epoch(0), sleepers(0)
+    {
+        if(num_workers)
+            threads = new std::thread[num_workers];
+        for(size_t i = 0; i < num_workers; ++i)
+            threads[i] = std::thread(thread_entry, this, i);
+    }
+
+    static size_t default_threads()
+    {
+#ifdef __STL_PARALLEL_THREADS
+        return __STL_PARALLEL_THREADS;
+#else
+        size_t n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+#endif
+    }
+
+public:
+    ~__parallel_pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            stopping.store(true, std::memory_order_release);
+        }
+        wakeup.notify_all();
+        for(size_t i = 0; i < num_workers; ++i)
+            threads[i].join();
+        delete[] threads;
+        delete[] deques;
+    }
+
+    // 第一次使用时创建
+    static __parallel_pool& instance()
+    {
+        static __parallel_pool pool(default_threads() - 1);
+        return pool;
+    }
+
+    // 参与执行的线程总数, 包括调用线程
+    size_t concurrency() const  {   return num_workers + 1; }
+
+    bool push(__parallel_task* t)
+    {
+        if(!deques[local_index()].push(t))
+            return false;
+        epoch.fetch_add(1, std::memory_order_release);
+        if(sleepers.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            wakeup.notify_one();
+        }
+        return true;
+    }
+
+    // 等待done被置位, 期间执行自己队列中的任务或者窃取其他任务
+    void wait(const std::atomic<bool>& done)
+    {
+        const size_t self = local_index();
+        while(!done.load(std::memory_order_acquire))
+        {
+            __parallel_task* t = deques[self].pop();
+            if(!t)
+                t = steal(self);
+            if(t)
+                t->execute();
+            else
+                std::this_thread::yield();
+        }
+    }
+};
+
+template<class Function>
+struct __parallel_closure : public __parallel_task
+{
+    Function& f;
+    std::atomic<bool> done;
+
+    explicit __parallel_closure(Function& x) : f(x), done(false)    {}
+
+    void execute()
+    {
+        f();
+        done.store(true, std::memory_order_release);
+    }
+};
+
+// fork/join: f2 放入队列等待其他线程窃取, 当前线程执行f1, 然后等待f2完成
+// f2 没有被窃取时会在 wait 中被当前线程自己取回执行
+template<class Function1, class Function2>
+void __parallel_invoke(Function1& f1, Function2& f2)
+{
+    __parallel_pool& pool = __parallel_pool::instance();
+    __parallel_closure<Function2> right(f2);
+    if(pool.concurrency() == 1 || !pool.push(&right))
+    {
+        f1();
+        f2();
+        return;
+    }
+    f1();
+    pool.wait(right.done);
+}
+
+// 每块的大小: 大约每个线程4块, 便于负载均衡, 但不小于min_grain
+template<class Distance>
+inline Distance __parallel_grain(Distance n, Distance min_grain)
+{
+    Distance grain = n / Distance(__parallel_pool::instance().concurrency() * 4);
+    return grain < min_grain ? min_grain : grain;
+}
+
+enum { __parallel_min_grain = 2048 };
+
+
+// ========================================= 并行切分: parallel_for / parallel_reduce
+// 递归二分区间, 长度不超过grain时交给body顺序处理
+template<class RandomAccessIterator, class Distance, class Body>
+void __parallel_for(RandomAccessIterator first, RandomAccessIterator last, Distance grain, Body& body);
+
+template<class RandomAccessIterator, class Distance, class Body>
+struct __parallel_for_task
+{
+    RandomAccessIterator first;
+    RandomAccessIterator last;
+    Distance grain;
+    Body& body;
+
+    __parallel_for_task(RandomAccessIterator f, RandomAccessIterator l, Distance g, Body& b)
+        : first(f), last(l), grain(g), body(b)  {}
+
+    void operator()()   {   __parallel_for(first, last, grain, body);   }
+};
+
+template<class RandomAccessIterator, class Distance, class Body>
+void __parallel_for(RandomAccessIterator first, RandomAccessIterator last, Distance grain, Body& body)
+{
+    if(last - first <= grain)
+    {
+        body(first, last);
+        return;
+    }
+    RandomAccessIterator middle = first + (last - first) / 2;
+    __parallel_for_task<RandomAccessIterator, Distance, Body> left(first, middle, grain, body);
+    __parallel_for_task<RandomAccessIterator, Distance, Body> right(middle, last, grain, body);
+    __parallel_invoke(left, right);
+}
+
+// 非空区间的归约, body(first, last) 返回一块的结果, combine 按从左到右的顺序合并, 只要求combine满足结合律
+template<class T, class RandomAccessIterator, class Distance, class Body, class Combine>
+T __parallel_reduce(RandomAccessIterator first, RandomAccessIterator last, Distance grain, Body& body, Combine& combine);
+
+template<class T, class RandomAccessIterator, class Distance, class Body, class Combine>
+struct __parallel_reduce_task
+{
+    RandomAccessIterator first;
+    RandomAccessIterator last;
+    Distance grain;
+    Body& body;
+    Combine& combine;
+    alignas(T) unsigned char storage[sizeof(T)];    // 执行后在其中构造结果, T不需要默认构造函数
+
+    __parallel_reduce_task(RandomAccessIterator f, RandomAccessIterator l, Distance g, Body& b, Combine& c)
+        : first(f), last(l), grain(g), body(b), combine(c)  {}
+
+    T& result() {   return *reinterpret_cast<T*>(storage);  }
+
+    void operator()()
+    {
+        construct(&result(), __parallel_reduce<T>(first, last, grain, body, combine));
+    }
+};
+
+template<class T, class RandomAccessIterator, class Distance, class Body, class Combine>
+T __parallel_reduce(RandomAccessIterator first, RandomAccessIterator last, Distance grain, Body& body, Combine& combine)
+{
+    if(last - first <= grain)
+        return body(first, last);
+    RandomAccessIterator middle = first + (last - first) / 2;
+    __parallel_reduce_task<T, RandomAccessIterator, Distance, Body, Combine> left(first, middle, grain, body, combine);
+    __parallel_reduce_task<T, RandomAccessIterator, Distance, Body, Combine> right(middle, last, grain, body, combine);
+    __parallel_invoke(left, right);
+    T result = combine(left.result(), right.result());
+    destroy(&left.result());
+    destroy(&right.result());
+    return result;
+}
+
+
+// ========================================= for_each
+template<class Function>
+struct __for_each_body
+{
+    Function f;
+    explicit __for_each_body(const Function& x) : f(x)  {}
+
+    template<class RandomAccessIterator>
+    void operator()(RandomAccessIterator first, RandomAccessIterator last) const
+    {
+        for(; first != last; ++first)
+            f(*first);
+    }
+};
+
+template<class InputIterator, class Function>
+inline void __parallel_for_each(InputIterator first, InputIterator last, Function f, input_iterator_tag)
+{
+    for_each(first, last, f);
+}
+
+template<class RandomAccessIterator, class Function>
+inline void __parallel_for_each(RandomAccessIterator first, RandomAccessIterator last, Function f,
+                                random_access_iterator_tag)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    __for_each_body<Function> body(f);
+    __parallel_for(first, last, __parallel_grain(Distance(last - first), Distance(__parallel_min_grain)), body);
+}
+
+template<class InputIterator, class Function>
+inline void for_each(const sequenced_policy&, InputIterator first, InputIterator last, Function f)
+{
+    for_each(first, last, f);
+}
+
+template<class InputIterator, class Function>
+inline void for_each(const parallel_policy&, InputIterator first, InputIterator last, Function f)
+{
+    __parallel_for_each(first, last, f, iterator_category(first));
+}
+
+// ========================================= transform
+template<class RandomAccessIterator, class OutputIterator, class UnaryOperation>
+struct __transform_body
+{
+    RandomAccessIterator base;
+    OutputIterator result;
+    UnaryOperation op;
+
+    __transform_body(RandomAccessIterator b, OutputIterator r, const UnaryOperation& o) : base(b), result(r), op(o)   {}
+
+    void operator()(RandomAccessIterator first, RandomAccessIterator last) const
+    {
+        transform(first, last, result + (first - base), op);
+    }
+};
+
+template<class InputIterator, class OutputIterator, class UnaryOperation, class Category1, class Category2>
+inline OutputIterator __parallel_transform(InputIterator first, InputIterator last, OutputIterator result,
+                                           UnaryOperation op, Category1, Category2)
+{
+    return transform(first, last, result, op);
+}
+
+template<class RandomAccessIterator1, class RandomAccessIterator2, class UnaryOperation>
+inline RandomAccessIterator2 __parallel_transform(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                                  RandomAccessIterator2 result, UnaryOperation op,
+                                                  random_access_iterator_tag, random_access_iterator_tag)
+{
+    typedef typename iterator_traits<RandomAccessIterator1>::difference_type Distance;
+    __transform_body<RandomAccessIterator1, RandomAccessIterator2, UnaryOperation> body(first, result, op);
+    __parallel_for(first, last, __parallel_grain(Distance(last - first), Distance(__parallel_min_grain)), body);
+    return result + (last - first);
+}
+
+template<class InputIterator, class OutputIterator, class UnaryOperation>
+inline OutputIterator transform(const sequenced_policy&, InputIterator first, InputIterator last,
+                                OutputIterator result, UnaryOperation op)
+{
+    return transform(first, last, result, op);
+}
+
+template<class InputIterator, class OutputIterator, class UnaryOperation>
+inline OutputIterator transform(const parallel_policy&, InputIterator first, InputIterator last,
+                                OutputIterator result, UnaryOperation op)
+{
+    typedef typename iterator_traits<OutputIterator>::iterator_category output_category;
+    return __parallel_transform(first, last, result, op, iterator_category(first), output_category());
+}
+
+// ========================================= accumulate
+// 并行版本把区间分块累加后再按顺序合并, 要求binary_op满足结合律(浮点加法的结果可能与顺序版本略有不同)
+template<class T, class BinaryOperation>
+struct __accumulate_body
+{
+    BinaryOperation op;
+    explicit __accumulate_body(const BinaryOperation& x) : op(x)    {}
+
+    template<class RandomAccessIterator>
+    T operator()(RandomAccessIterator first, RandomAccessIterator last) const
+    {
+        T init = *first;
+        return accumulate(++first, last, init, op);
+    }
+};
+
+template<class InputIterator, class T, class BinaryOperation>
+inline T __parallel_accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op, input_iterator_tag)
+{
+    return accumulate(first, last, init, op);
+}
+
+template<class RandomAccessIterator, class T, class BinaryOperation>
+T __parallel_accumulate(RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op,
+                        random_access_iterator_tag)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    if(first == last)
+        return init;
+    __accumulate_body<T, BinaryOperation> body(op);
+    T sum = __parallel_reduce<T>(first, last, __parallel_grain(Distance(last - first), Distance(__parallel_min_grain)),
+                                 body, op);
+    return op(init, sum);
+}
+
+template<class InputIterator, class T>
+inline T accumulate(const sequenced_policy&, InputIterator first, InputIterator last, T init)
+{
+    return accumulate(first, last, init);
+}
+
+template<class InputIterator, class T, class BinaryOperation>
+inline T accumulate(const sequenced_policy&, InputIterator first, InputIterator last, T init, BinaryOperation op)
+{
+    return accumulate(first, last, init, op);
+}
+
+template<class InputIterator, class T>
+inline T accumulate(const parallel_policy&, InputIterator first, InputIterator last, T init)
+{
+    return __parallel_accumulate(first, last, init, plus<T>(), iterator_category(first));
+}
+
+template<class InputIterator, class T, class BinaryOperation>
+inline T accumulate(const parallel_policy&, InputIterator first, InputIterator last, T init, BinaryOperation op)
+{
+    return __parallel_accumulate(first, last, init, op, iterator_category(first));
+}
+
+// ========================================= count_if
+template<class Predicate, class Distance>
+struct __count_if_body
+{
+    Predicate pred;
+    explicit __count_if_body(const Predicate& x) : pred(x)  {}
+
+    template<class RandomAccessIterator>
+    Distance operator()(RandomAccessIterator first, RandomAccessIterator last) const
+    {
+        return count_if(first, last, pred);
+    }
+};
+
+template<class InputIterator, class Predicate>
+inline typename iterator_traits<InputIterator>::difference_type
+__parallel_count_if(InputIterator first, InputIterator last, Predicate pred, input_iterator_tag)
+{
+    return count_if(first, last, pred);
+}
+
+template<class RandomAccessIterator, class Predicate>
+typename iterator_traits<RandomAccessIterator>::difference_type
+__parallel_count_if(RandomAccessIterator first, RandomAccessIterator last, Predicate pred, random_access_iterator_tag)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    if(first == last)
+        return 0;
+    __count_if_body<Predicate, Distance> body(pred);
+    plus<Distance> combine;
+    return __parallel_reduce<Distance>(first, last,
+                                       __parallel_grain(Distance(last - first), Distance(__parallel_min_grain)),
+                                       body, combine);
+}
+
+template<class InputIterator, class Predicate>
+inline typename iterator_traits<InputIterator>::difference_type
+count_if(const sequenced_policy&, InputIterator first, InputIterator last, Predicate pred)
+{
+    return count_if(first, last, pred);
+}
+
+template<class InputIterator, class Predicate>
+inline typename iterator_traits<InputIterator>::difference_type
+count_if(const parallel_policy&, InputIterator first, InputIterator last, Predicate pred)
+{
+    return __parallel_count_if(first, last, pred, iterator_category(first));
+}
+
+// ========================================= find_if
+// 各块并行查找, 用原子变量记录目前找到的最小位置; 起点在该位置之后的块直接跳过,
+// 正在查找的块每隔一段检查一次, 发现前面已经找到时提前结束
+template<class RandomAccessIterator, class Predicate>
+struct __find_if_body
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+
+    RandomAccessIterator base;
+    Predicate pred;
+    std::atomic<Distance>* found;
+
+    __find_if_body(RandomAccessIterator b, const Predicate& p, std::atomic<Distance>* f) : base(b), pred(p), found(f)   {}
+
+    void operator()(RandomAccessIterator first, RandomAccessIterator last) const
+    {
+        enum { check_interval = 1024 };
+        Distance pos = first - base;
+        while(first != last)
+        {
+            if(pos >= found->load(std::memory_order_relaxed))
+                return;
+            Distance n = last - first;
+            RandomAccessIterator stop = n > Distance(check_interval) ? first + Distance(check_interval) : last;
+            RandomAccessIterator i = find_if(first, stop, pred);
+            if(i != stop)
+            {
+                Distance hit = i - base;
+                Distance cur = found->load(std::memory_order_relaxed);
+                while(hit < cur && !found->compare_exchange_weak(cur, hit))
+                    ;
+                return;
+            }
+            pos += stop - first;
+            first = stop;
+        }
+    }
+};
+
+template<class InputIterator, class Predicate>
+inline InputIterator __parallel_find_if(InputIterator first, InputIterator last, Predicate pred, input_iterator_tag)
+{
+    return find_if(first, last, pred);
+}
+
+template<class RandomAccessIterator, class Predicate>
+RandomAccessIterator __parallel_find_if(RandomAccessIterator first, RandomAccessIterator last, Predicate pred,
+                                        random_access_iterator_tag)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    std::atomic<Distance> found(last - first);
+    __find_if_body<RandomAccessIterator, Predicate> body(first, pred, &found);
+    __parallel_for(first, last, __parallel_grain(Distance(last - first), Distance(__parallel_min_grain)), body);
+    return first + found.load();
+}
+
+template<class InputIterator, class Predicate>
+inline InputIterator find_if(const sequenced_policy&, InputIterator first, InputIterator last, Predicate pred)
+{
+    return find_if(first, last, pred);
+}
+
+template<class InputIterator, class Predicate>
+inline InputIterator find_if(const parallel_policy&, InputIterator first, InputIterator last, Predicate pred)
+{
+    return __parallel_find_if(first, last, pred, iterator_category(first));
+}
+
+// ========================================= sort
+// 并行快速排序: 与sort相同的方式选取枢轴并分割, 两边作为两个任务fork出去
+// 区间足够小或者分割不平衡的次数过多时, 交给顺序的sort(包括基数排序的分派)
+enum { __parallel_sort_cutoff = 1 << 15 };
+
+template<class RandomAccessIterator, class Compare>
+void __parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp, int bad_allowed);
+
+template<class RandomAccessIterator, class Compare>
+struct __parallel_sort_task
+{
+    RandomAccessIterator first;
+    RandomAccessIterator last;
+    Compare comp;
+    int bad_allowed;
+
+    __parallel_sort_task(RandomAccessIterator f, RandomAccessIterator l, const Compare& c, int b)
+        : first(f), last(l), comp(c), bad_allowed(b)    {}
+
+    void operator()()   {   __parallel_sort(first, last, comp, bad_allowed);    }
+};
+
+template<class RandomAccessIterator, class Compare>
+void __parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp, int bad_allowed)
+{
+    typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+    Distance size = last - first;
+    if(size <= Distance(__parallel_sort_cutoff) || bad_allowed == 0)
+    {
+        sort(first, last, comp);
+        return;
+    }
+    __choose_pivot(first, last, comp);
+    RandomAccessIterator pivot_pos = __partition_right(first, last, comp).first;
+    if(pivot_pos - first < size / 8 || last - (pivot_pos + 1) < size / 8)
+        --bad_allowed;
+    __parallel_sort_task<RandomAccessIterator, Compare> left(first, pivot_pos, comp, bad_allowed);
+    __parallel_sort_task<RandomAccessIterator, Compare> right(pivot_pos + 1, last, comp, bad_allowed);
+    __parallel_invoke(left, right);
+}
+
+template<class RandomAccessIterator, class Compare>
+inline void sort(const sequenced_policy&, RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    sort(first, last, comp);
+}
+
+template<class RandomAccessIterator>
+inline void sort(const sequenced_policy&, RandomAccessIterator first, RandomAccessIterator last)
+{
+    sort(first, last);
+}
+
+template<class RandomAccessIterator, class Compare>
+inline void sort(const parallel_policy&, RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    if(__parallel_pool::instance().concurrency() == 1)
+        sort(first, last, comp);
+    else
+        __parallel_sort(first, last, comp, int(__lg(last - first)));
+}
+
+template<class RandomAccessIterator>
+inline void sort(const parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last)
+{
+    sort(policy, first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+#endif // __STL_PARALLEL_H
\ No newline at end of file
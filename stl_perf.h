@@ -0,0 +1,313 @@
+#ifndef __STL_PERF_H
+#define __STL_PERF_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>  // memset
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 硬件性能计数器: 周期、指令、分支预测失败、L1数据缓存缺失、末级缓存缺失、数据TLB缺失
+// perf_counters 在Linux上通过 perf_event_open 为当前线程打开一组计数器, 只统计用户态;
+// 内核不支持、权限不足(perf_event_paranoid)或不在Linux上时, 对应的计数器不可用, 只记录时间
+//
+//  perf_region region("build index");
+//  {
+//      perf_scope scope(region);   // 进入时读一次计数器, 离开时再读一次, 差值累加到region
+//      ...
+//  }
+//  perf_report(stdout);            // 所有 perf_region 的调用次数、时间、每次调用的计数与IPC
+//
+// 编译时定义 __STL_PERF_COUNTERS, 则 chunk_alloc、refill、__uninitialized_copy_aux 与排序、合并等算法
+// 各自带有一个 perf_region, 见 stl_config.h; 默认不定义, 这些函数中没有任何额外代码
+// 每次进出 perf_scope 需要两次系统调用(约1微秒), 适合包住耗时远大于此的区域
+// perf_region 的累加不加锁, 多线程同时进入同一个region时计数不准确
+
+enum perf_event_kind
+{
+    perf_cycles,
+    perf_instructions,
+    perf_branch_misses,
+    perf_l1d_misses,
+    perf_llc_misses,
+    perf_dtlb_misses,
+    perf_event_count
+};
+
+inline const char* perf_event_name(int kind)
+{
+    static const char* const names[perf_event_count] = {
+        "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "dtlb_misses"
+    };
+    return names[kind];
+}
+
+// 某一时刻各计数器的累计值; 不可用的计数器为0
+struct perf_sample
+{
+    unsigned long long value[perf_event_count];
+    double seconds;
+};
+
+// ========================================= perf_counters
+// 各计数器作为一组打开, 一次read同时读出, 组内的计数器总是同时被调度
+// 计数器多于硬件寄存器时内核会轮流调度, 读出的值按 enabled/running 时间的比例放大
+class perf_counters
+{
+private:
+    int fd[perf_event_count];       // 不可用时为-1
+    int slot[perf_event_count];     // 在组读取结果中的位置
+    int leader;
+    int opened;
+
+private:
+    perf_counters(const perf_counters&);
+    perf_counters& operator=(const perf_counters&);
+
+#ifdef __linux__
+    static void event_attr(int kind, perf_event_attr& attr)
+    {
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        const unsigned long long read_miss =
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        switch(kind)
+        {
+        case perf_cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case perf_instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case perf_branch_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case perf_l1d_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+            break;
+        case perf_llc_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_LL | read_miss;
+            break;
+        default:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | read_miss;
+            break;
+        }
+    }
+
+    // 第一个打开成功的计数器作为组长, 其余加入它的组; 打不开的计数器跳过
+    void open_all()
+    {
+        for(int k = 0; k < perf_event_count; ++k)
+        {
+            perf_event_attr attr;
+            event_attr(k, attr);
+            fd[k] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+            if(fd[k] < 0)
+            {
+                fd[k] = -1;
+                continue;
+            }
+            if(leader < 0)
+                leader = fd[k];
+            slot[k] = opened++;
+        }
+    }
+
+    void close_all()
+    {
+        for(int k = 0; k < perf_event_count; ++k)
+            if(fd[k] >= 0)
+                close(fd[k]);
+    }
+
+    bool read_group(perf_sample& s) const
+    {
+        // nr, time_enabled, time_running, value[nr]
+        unsigned long long buffer[3 + perf_event_count];
+        ssize_t n = ::read(leader, buffer, sizeof(buffer));
+        if(n < ssize_t(3 * sizeof(unsigned long long)) || buffer[0] != (unsigned long long)opened)
+            return false;
+        const double scale = buffer[2] && buffer[2] < buffer[1] ? double(buffer[1]) / double(buffer[2]) : 1.0;
+        for(int k = 0; k < perf_event_count; ++k)
+            if(fd[k] >= 0)
+                s.value[k] = static_cast<unsigned long long>(double(buffer[3 + slot[k]]) * scale);
+        return true;
+    }
+#else
+    void open_all() {}
+    void close_all()    {}
+    bool read_group(perf_sample&) const {   return false;   }
+#endif
+
+public:
+    perf_counters() : leader(-1), opened(0)
+    {
+        for(int k = 0; k < perf_event_count; ++k)
+        {
+            fd[k] = -1;
+            slot[k] = 0;
+        }
+        open_all();
+    }
+
+    ~perf_counters()    {   close_all();    }
+
+    // 至少有一个计数器可用
+    bool available() const          {   return opened != 0; }
+    bool available(int kind) const  {   return fd[kind] >= 0;   }
+
+    void read(perf_sample& s) const
+    {
+        std::memset(s.value, 0, sizeof(s.value));
+        if(opened)
+            read_group(s);
+        s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // perf_event_open 只统计调用它的线程, 每个线程一组计数器, 第一次使用时打开
+    static perf_counters& this_thread()
+    {
+        static thread_local perf_counters counters;
+        return counters;
+    }
+};
+
+// ========================================= perf_region / perf_scope
+// 一个计量区域: 调用次数与各计数器的总和; 构造时挂到全局链表上, 析构时摘下, 供 perf_report 输出
+// 嵌套进入同一个区域(例如递归)时只计量最外层
+struct perf_region
+{
+    const char* name;
+    unsigned long long calls;
+    double seconds;
+    unsigned long long value[perf_event_count];
+    int depth;
+    perf_region* next;
+
+    static perf_region*& list()
+    {
+        static perf_region* head = 0;
+        return head;
+    }
+
+    explicit perf_region(const char* n) : name(n), next(list())
+    {
+        reset();
+        list() = this;
+    }
+
+    ~perf_region()
+    {
+        perf_region** p = &list();
+        while(*p && *p != this)
+            p = &(*p)->next;
+        if(*p)
+            *p = next;
+    }
+
+    void reset()
+    {
+        calls = 0;
+        seconds = 0;
+        std::memset(value, 0, sizeof(value));
+        depth = 0;
+    }
+
+    void add(const perf_sample& start, const perf_sample& finish)
+    {
+        ++calls;
+        seconds += finish.seconds - start.seconds;
+        for(int k = 0; k < perf_event_count; ++k)
+            value[k] += finish.value[k] - start.value[k];
+    }
+};
+
+class perf_scope
+{
+private:
+    perf_region& region;
+    bool outermost;
+    perf_sample start;
+
+    perf_scope(const perf_scope&);
+    perf_scope& operator=(const perf_scope&);
+
+public:
+    explicit perf_scope(perf_region& r) : region(r), outermost(r.depth++ == 0)
+    {
+        if(outermost)
+            perf_counters::this_thread().read(start);
+    }
+
+    ~perf_scope()
+    {
+        if(outermost)
+        {
+            perf_sample finish;
+            perf_counters::this_thread().read(finish);
+            region.add(start, finish);
+        }
+        --region.depth;
+    }
+};
+
+// 每个名字一行: 调用次数、总时间、每次调用的各计数与IPC; 同名的区域(同一函数模板的不同实例)合并, 没有调用过的不输出
+inline void perf_report(std::FILE* out)
+{
+    const perf_counters& counters = perf_counters::this_thread();
+    std::fprintf(out, "%-32s %10s %12s", "region", "calls", "seconds");
+    for(int k = 0; k < perf_event_count; ++k)
+        if(counters.available(k))
+            std::fprintf(out, " %14s", perf_event_name(k));
+    if(counters.available(perf_cycles) && counters.available(perf_instructions))
+        std::fprintf(out, " %6s", "ipc");
+    std::fprintf(out, "\n");
+
+    for(const perf_region* r = perf_region::list(); r; r = r->next)
+    {
+        // 只在同名的第一个区域处输出
+        const perf_region* first = perf_region::list();
+        while(std::strcmp(first->name, r->name) != 0)
+            first = first->next;
+        if(first != r)
+            continue;
+
+        unsigned long long calls = 0;
+        double seconds = 0;
+        unsigned long long value[perf_event_count] = {0};
+        for(const perf_region* i = r; i; i = i->next)
+        {
+            if(std::strcmp(i->name, r->name) != 0)
+                continue;
+            calls += i->calls;
+            seconds += i->seconds;
+            for(int k = 0; k < perf_event_count; ++k)
+                value[k] += i->value[k];
+        }
+        if(calls == 0)
+            continue;
+
+        std::fprintf(out, "%-32s %10llu %12.6f", r->name, calls, seconds);
+        for(int k = 0; k < perf_event_count; ++k)
+            if(counters.available(k))
+                std::fprintf(out, " %14.1f", double(value[k]) / double(calls));
+        if(counters.available(perf_cycles) && counters.available(perf_instructions))
+            std::fprintf(out, " %6.2f", value[perf_cycles] ? double(value[perf_instructions]) / double(value[perf_cycles]) : 0.0);
+        std::fprintf(out, "\n");
+    }
+}
+
+#endif // __STL_PERF_H
\ No newline at end of file
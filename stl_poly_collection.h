@@ -0,0 +1,411 @@
+#ifndef __STL_POLY_COLLECTION_H
+#define __STL_POLY_COLLECTION_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+#include <typeinfo> // type_info, typeid
+
+#include "stl_alloc.h"
+#include "stl_construct.h"
+#include "stl_function.h"
+#include "stl_iterator.h"
+#include "stl_vector.h"
+
+// poly_collection<Base>: 按动态类型分段存放的多态容器
+// 每种派生类型一个段, 段内是该类型对象(不是指针)的连续数组; 遍历时一段一段地进行,
+// 同一段内虚函数调用的目标都相同, 间接跳转总能被预测, 对象也是顺序访问的, 没有 vector<Base*> 逐个解引用的缓存缺失
+//
+//  poly_collection<shape> c;
+//  c.insert(Circle());  c.insert(Rect());  c.insert(Circle());    // 两个Circle放在同一段中
+//  for_each(c, mem_fun(&shape::display));                          // 先遍历所有Circle, 再遍历所有Rect
+//  for_each<Circle>(c, f);                                         // Circle段以 Circle& 调用f, 其余段以 shape& 调用
+//
+// 指明具体类型的 for_each 中, 函数对象拿到的是派生类的静态类型, 派生类(或其成员函数)声明为 final 时
+// 编译器可以去掉虚函数调用并内联
+// 元素按段的顺序排列, 不保持插入顺序; 插入某一段可能使该段的指针与迭代器失效, 其他段不受影响
+
+// ========================================= 段
+// 段的公共部分: 动态类型, 与各元素中 Base 子对象的地址范围
+// 同一段中相邻元素的 Base 子对象相距 stride = sizeof(Derived) 字节, 遍历时不需要知道派生类型
+template<class Base>
+struct __poly_segment_base
+{
+    const std::type_info* type;
+    size_t stride;
+    char* first;    // 第一个元素的 Base 子对象, 段为空时为0
+    char* last;     // first + size() * stride
+
+    __poly_segment_base(const std::type_info& t, size_t s) : type(&t), stride(s), first(0), last(0)  {}
+    virtual ~__poly_segment_base()  {}
+
+    size_t size() const {   return stride ? size_t(last - first) / stride : 0;  }
+
+    virtual void clear() = 0;
+    virtual __poly_segment_base* clone() const = 0;
+    virtual void release() = 0;     // 析构并归还自身的空间
+};
+
+template<class Base, class Derived, class Alloc>
+struct __poly_segment : public __poly_segment_base<Base>
+{
+    typedef __poly_segment_base<Base> base_type;
+    typedef simple_alloc<__poly_segment, Alloc> segment_allocator;
+
+    vector<Derived, Alloc> items;
+
+    __poly_segment() : base_type(typeid(Derived), sizeof(Derived))  {}
+    __poly_segment(const __poly_segment& x) : base_type(typeid(Derived), sizeof(Derived)), items(x.items)
+    {
+        refresh();
+    }
+
+    // items 每次修改后重新计算地址范围
+    void refresh()
+    {
+        this->first = items.empty() ? 0 : reinterpret_cast<char*>(static_cast<Base*>(items.data()));
+        this->last = this->first + items.size() * sizeof(Derived);
+    }
+
+    Derived* begin()    {   return items.begin();   }
+    Derived* end()      {   return items.end(); }
+
+    Derived* insert(const Derived& x)
+    {
+        items.push_back(x);
+        refresh();
+        return items.end() - 1;
+    }
+
+    Derived* erase(Derived* position)
+    {
+        Derived* i = items.erase(position);
+        refresh();
+        return i;
+    }
+
+    void reserve(size_t n)
+    {
+        items.reserve(n);
+        refresh();
+    }
+
+    virtual void clear()
+    {
+        items.clear();
+        refresh();
+    }
+
+    virtual base_type* clone() const
+    {
+        __poly_segment* p = segment_allocator::allocate();
+        construct(p, *this);
+        return p;
+    }
+
+    virtual void release()
+    {
+        __poly_segment* p = this;
+        destroy(p);
+        segment_allocator::deallocate(p);
+    }
+};
+
+// ========================================= 迭代器
+// 按段的顺序经过所有元素, 段内每次前进 stride 字节; 尾端迭代器的 cur 为0
+template<class Base, class Ref, class Ptr>
+struct __poly_iterator
+{
+    typedef __poly_iterator<Base, Base&, Base*> iterator;
+    typedef __poly_iterator<Base, const Base&, const Base*> const_iterator;
+    typedef __poly_iterator<Base, Ref, Ptr> self;
+    typedef __poly_segment_base<Base>* segment_pointer;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef Base value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef ptrdiff_t difference_type;
+
+    const segment_pointer* seg;
+    const segment_pointer* seg_last;
+    char* cur;
+
+    // 跳过空段, 停在第一个非空段的第一个元素, 没有时为尾端
+    void settle()
+    {
+        while(seg != seg_last && (*seg)->first == 0)
+            ++seg;
+        cur = seg != seg_last ? (*seg)->first : 0;
+    }
+
+    __poly_iterator() : seg(0), seg_last(0), cur(0) {}
+    __poly_iterator(const segment_pointer* s, const segment_pointer* l) : seg(s), seg_last(l)
+    {
+        settle();
+    }
+    __poly_iterator(const iterator& x) : seg(x.seg), seg_last(x.seg_last), cur(x.cur)  {}
+    self& operator=(const self& x) = default;
+
+    bool operator==(const self& x) const    {   return cur == x.cur;    }
+    bool operator!=(const self& x) const    {   return cur != x.cur;    }
+
+    reference operator*() const {   return *reinterpret_cast<Ptr>(cur); }
+    pointer operator->() const  {   return reinterpret_cast<Ptr>(cur);  }
+
+    self& operator++()
+    {
+        cur += (*seg)->stride;
+        if(cur == (*seg)->last)
+        {
+            ++seg;
+            settle();
+        }
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+// ========================================= poly_collection
+template<class Base, class Alloc = alloc>
+class poly_collection
+{
+public:
+    typedef Base value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __poly_iterator<Base, Base&, Base*> iterator;
+    typedef __poly_iterator<Base, const Base&, const Base*> const_iterator;
+
+    typedef __poly_segment_base<Base> segment_base;
+
+private:
+    vector<segment_base*, Alloc> segments;  // 段的个数就是出现过的类型个数, 通常很少, 按类型线性查找
+
+private:
+    segment_base* find_segment(const std::type_info& t) const
+    {
+        for(size_type i = 0; i < segments.size(); ++i)
+            if(*segments[i]->type == t)
+                return segments[i];
+        return 0;
+    }
+
+    template<class Derived>
+    __poly_segment<Base, Derived, Alloc>* segment() const
+    {
+        return static_cast<__poly_segment<Base, Derived, Alloc>*>(find_segment(typeid(Derived)));
+    }
+
+    // 找到或新建 Derived 的段
+    template<class Derived>
+    __poly_segment<Base, Derived, Alloc>* register_segment()
+    {
+        typedef __poly_segment<Base, Derived, Alloc> segment_type;
+        segment_type* s = segment<Derived>();
+        if(s == 0)
+        {
+            s = segment_type::segment_allocator::allocate();
+            construct(s, segment_type());
+            segments.push_back(s);
+        }
+        return s;
+    }
+
+    void release_segments()
+    {
+        for(size_type i = 0; i < segments.size(); ++i)
+            segments[i]->release();
+        segments.clear();
+    }
+
+public:
+    poly_collection()   {}
+
+    poly_collection(const poly_collection& x)
+    {
+        segments.reserve(x.segments.size());
+        for(size_type i = 0; i < x.segments.size(); ++i)
+            segments.push_back(x.segments[i]->clone());
+    }
+
+    poly_collection& operator=(const poly_collection& x)
+    {
+        if(this != &x)
+        {
+            poly_collection tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~poly_collection()  {   release_segments(); }
+
+public:
+    iterator begin()    {   return iterator(segments.begin(), segments.end());  }
+    iterator end()      {   return iterator(segments.end(), segments.end());    }
+    const_iterator begin() const
+    {
+        return const_iterator(segments.begin(), segments.end());
+    }
+    const_iterator end() const
+    {
+        return const_iterator(segments.end(), segments.end());
+    }
+
+    size_type size() const
+    {
+        size_type n = 0;
+        for(size_type i = 0; i < segments.size(); ++i)
+            n += segments[i]->size();
+        return n;
+    }
+    bool empty() const  {   return size() == 0; }
+
+    // 出现过的类型个数, clear 之后段仍然保留
+    size_type segment_count() const {   return segments.size(); }
+
+    segment_base* const* segment_begin() const  {   return segments.begin();    }
+    segment_base* const* segment_end() const    {   return segments.end();  }
+
+    void swap(poly_collection& x)   {   segments.swap(x.segments);  }
+
+    // 清空所有元素, 保留各段已配置的空间
+    void clear()
+    {
+        for(size_type i = 0; i < segments.size(); ++i)
+            segments[i]->clear();
+    }
+
+public:
+    // 以下以派生类型指明段, 段内的迭代器就是 Derived*
+    template<class Derived>
+    Derived* begin()
+    {
+        __poly_segment<Base, Derived, Alloc>* s = segment<Derived>();
+        return s ? s->begin() : 0;
+    }
+    template<class Derived>
+    Derived* end()
+    {
+        __poly_segment<Base, Derived, Alloc>* s = segment<Derived>();
+        return s ? s->end() : 0;
+    }
+    template<class Derived>
+    const Derived* begin() const    {   return const_cast<poly_collection*>(this)->template begin<Derived>();   }
+    template<class Derived>
+    const Derived* end() const      {   return const_cast<poly_collection*>(this)->template end<Derived>(); }
+
+    template<class Derived>
+    size_type size() const
+    {
+        segment_base* s = find_segment(typeid(Derived));
+        return s ? s->size() : 0;
+    }
+
+    // x 的动态类型必须就是 Derived, 通过基类引用传入的对象会被切割
+    template<class Derived>
+    Derived* insert(const Derived& x)
+    {
+        return register_segment<Derived>()->insert(x);
+    }
+
+    template<class Derived>
+    Derived* erase(Derived* position)
+    {
+        return segment<Derived>()->erase(position);
+    }
+
+    // 预先建立段并配置空间, 之后插入n个以内的 Derived 不会使该段的指针失效
+    template<class Derived>
+    void reserve(size_type n)
+    {
+        register_segment<Derived>()->reserve(n);
+    }
+};
+
+template<class Base, class Alloc>
+inline void swap(poly_collection<Base, Alloc>& x, poly_collection<Base, Alloc>& y)
+{
+    x.swap(y);
+}
+
+// ========================================= for_each
+// mem_fun 得到的函数对象接受指针, 其余函数对象接受引用
+template<class Function, class T>
+inline void __poly_call(Function& f, T& x)
+{
+    f(x);
+}
+
+template<class S, class T, class U>
+inline void __poly_call(mem_fun_t<S, T>& f, U& x)
+{
+    f(&x);
+}
+
+template<class S, class T, class U>
+inline void __poly_call(const_mem_fun_t<S, T>& f, U& x)
+{
+    f(&x);
+}
+
+// 依次检查段的类型是否为 Derived..., 是则以派生类的静态类型遍历该段
+template<class... Derived>
+struct __poly_restitute;
+
+template<>
+struct __poly_restitute<>
+{
+    template<class Base, class Function>
+    static bool apply(__poly_segment_base<Base>*, Function&) {  return false;   }
+};
+
+template<class Derived, class... Rest>
+struct __poly_restitute<Derived, Rest...>
+{
+    template<class Base, class Function>
+    static bool apply(__poly_segment_base<Base>* s, Function& f)
+    {
+        if(*s->type != typeid(Derived))
+            return __poly_restitute<Rest...>::apply(s, f);
+        if(s->first)
+        {
+            Derived* first = static_cast<Derived*>(reinterpret_cast<Base*>(s->first));
+            Derived* last = first + s->size();
+            for( ; first != last; ++first)
+                __poly_call(f, *first);
+        }
+        return true;
+    }
+};
+
+// 逐段遍历, 每段是一个只按 stride 前进的紧凑循环; Derived... 中列出的类型以派生类的静态类型调用f
+//  for_each(c, mem_fun(&shape::display));
+//  for_each<Circle, Rect>(c, update());
+template<class... Derived, class Base, class Alloc, class Function>
+Function for_each(poly_collection<Base, Alloc>& c, Function f)
+{
+    typedef __poly_segment_base<Base>* segment_pointer;
+    const segment_pointer* last = c.segment_end();
+    for(const segment_pointer* s = c.segment_begin(); s != last; ++s)
+    {
+        if(__poly_restitute<Derived...>::apply(*s, f))
+            continue;
+        const size_t stride = (*s)->stride;
+        char* const end = (*s)->last;
+        for(char* p = (*s)->first; p != end; p += stride)
+            __poly_call(f, *reinterpret_cast<Base*>(p));
+    }
+    return f;
+}
+
+#endif // __STL_POLY_COLLECTION_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef __STL_QUEUE_H
+#define __STL_QUEUE_H
+
+#include <cstddef>  // size_t
+
+#include "stl_function.h"
+#include "stl_heap.h"
+#include "stl_iterator.h"
+#include "stl_vector.h"
+
+// priority_queue: 以Sequence为底层容器的D叉堆, 默认4叉
+// Sequence 需要提供随机访问迭代器及 push_back / pop_back / front
+// Arity = 2 时与标准的二叉堆布局相同
+template<class T, class Sequence = vector<T>,
+         class Compare = less<typename Sequence::value_type>, size_t Arity = 4>
+class priority_queue
+{
+public:
+    typedef typename Sequence::value_type value_type;
+    typedef typename Sequence::size_type size_type;
+    typedef typename Sequence::reference reference;
+    typedef typename Sequence::const_reference const_reference;
+    typedef Sequence container_type;
+
+protected:
+    Sequence c;     // 底层容器
+    Compare comp;   // 元素大小比较标准
+
+public:
+    priority_queue() : c()  {}
+    explicit priority_queue(const Compare& x) : c(), comp(x)    {}
+
+    template<class InputIterator>
+    priority_queue(InputIterator first, InputIterator last) : c(first, last)
+    {
+        __dary_make_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    template<class InputIterator>
+    priority_queue(InputIterator first, InputIterator last, const Compare& x) : c(first, last), comp(x)
+    {
+        __dary_make_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    bool empty() const  {   return c.empty();   }
+    size_type size() const  {   return c.size();    }
+    const_reference top() const {   return c.front();   }
+
+    void push(const value_type& x)
+    {
+        c.push_back(x);
+        __dary_push_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    void pop()
+    {
+        __dary_pop_heap<Arity>(c.begin(), c.end(), comp);
+        c.pop_back();
+    }
+
+    // 批量插入: 新元素先全部追加到末尾
+    // 新增k个元素时逐个上浮为 O(k*log(n+k)), 整体重新建堆为 O(n+k), 选择代价较小的一种
+    template<class InputIterator>
+    void push_range(InputIterator first, InputIterator last)
+    {
+        const size_type old_size = c.size();
+        c.insert(c.end(), first, last);
+        const size_type new_size = c.size();
+        const size_type k = new_size - old_size;
+
+        size_type depth = 1;    // 堆的层数, 即逐个上浮时每个元素的最大移动次数
+        for(size_type n = new_size; n >= Arity; n /= Arity)
+            ++depth;
+
+        if(k * depth >= new_size)
+            __dary_make_heap<Arity>(c.begin(), c.end(), comp);
+        else
+        {
+            typename Sequence::iterator first_new = c.begin();
+            for(size_type i = old_size + 1; i <= new_size; ++i)
+                __dary_push_heap<Arity>(first_new, first_new + i, comp);
+        }
+    }
+
+    void swap(priority_queue& x)
+    {
+        c.swap(x.c);
+        ::swap(comp, x.comp);
+    }
+};
+
+#endif // __STL_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,115 @@
+#ifndef __STL_SET_H
+#define __STL_SET_H
+
+#include "stl_alloc.h"
+#include "stl_btree.h"
+#include "stl_function.h"
+#include "stl_pair.h"
+
+// set: 元素即键值, 有序且不允许重复, 以B树为底层实现
+// 元素不允许修改, 迭代器都是const_iterator
+
+template<class Key, class Compare = less<Key>, class Alloc = alloc>
+class set
+{
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef btree<key_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::const_pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::const_reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+public:
+    set() : t(Compare())    {}
+    explicit set(const Compare& comp) : t(comp) {}
+
+    template<class InputIterator>
+    set(InputIterator first, InputIterator last) : t(Compare())
+    {
+        t.insert_unique(first, last);
+    }
+
+    template<class InputIterator>
+    set(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+
+public:
+    key_compare key_comp() const    {   return t.key_comp();    }
+    value_compare value_comp() const    {   return t.key_comp();    }
+
+    iterator begin() const  {   return t.begin();   }
+    iterator end() const    {   return t.end(); }
+
+    bool empty() const          {   return t.empty();   }
+    size_type size() const      {   return t.size();    }
+    size_type max_size() const  {   return t.max_size();    }
+    void swap(set& x)           {   t.swap(x.t);    }
+
+public:
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        pair<typename rep_type::iterator, bool> p = t.insert_unique(x);
+        return pair<iterator, bool>(p.first, p.second);
+    }
+    iterator insert(iterator position, const value_type& x)
+    {
+        typedef typename rep_type::iterator rep_iterator;
+        return t.insert_unique(rep_iterator(position.node, position.position), x);
+    }
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)    {   t.insert_unique(first, last);   }
+
+    iterator erase(iterator position)
+    {
+        typedef typename rep_type::iterator rep_iterator;
+        return t.erase(rep_iterator(position.node, position.position));
+    }
+    size_type erase(const key_type& x)  {   return t.erase(x);  }
+    void erase(iterator first, iterator last)
+    {
+        typedef typename rep_type::iterator rep_iterator;
+        t.erase(rep_iterator(first.node, first.position), rep_iterator(last.node, last.position));
+    }
+    void clear()    {   t.clear();  }
+
+public:
+    iterator find(const key_type& x) const          {   return t.find(x);   }
+    size_type count(const key_type& x) const        {   return t.find(x) == t.end() ? 0 : 1;    }
+    iterator lower_bound(const key_type& x) const   {   return t.lower_bound(x);    }
+    iterator upper_bound(const key_type& x) const   {   return t.upper_bound(x);    }
+    pair<iterator, iterator> equal_range(const key_type& x) const   {   return t.equal_range(x);    }
+
+    template<class K1, class C1, class A1>
+    friend bool operator==(const set<K1, C1, A1>&, const set<K1, C1, A1>&);
+    template<class K1, class C1, class A1>
+    friend bool operator<(const set<K1, C1, A1>&, const set<K1, C1, A1>&);
+};
+
+template<class Key, class Compare, class Alloc>
+inline bool operator==(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y)
+{
+    return x.t == y.t;
+}
+
+template<class Key, class Compare, class Alloc>
+inline bool operator<(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y)
+{
+    return x.t < y.t;
+}
+
+#endif // __STL_SET_H
\ No newline at end of file
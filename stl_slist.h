@@ -0,0 +1,440 @@
+#ifndef __STL_SLIST_H
+#define __STL_SLIST_H
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_iterator.h"
+#include "type_traits.h"
+
+// slist: 单向链表, 只提供前向迭代器, 插入删除都在指定位置之后进行(insert_after, erase_after)
+// 与list一样按整段分配与释放节点: allocate_chain 返回的区块链本身就是按next串好的,
+// 构造元素后直接接入链表, 不需要再逐个链接
+
+struct __slist_node_base
+{
+    __slist_node_base* next;    // 必须位于节点开头, 节点链即分配器的区块链
+};
+
+template<class T>
+struct __slist_node : public __slist_node_base
+{
+    T data;
+};
+
+// 将new_node插入到prev_node之后
+inline __slist_node_base* __slist_make_link(__slist_node_base* prev_node, __slist_node_base* new_node)
+{
+    new_node->next = prev_node->next;
+    prev_node->next = new_node;
+    return new_node;
+}
+
+// 找到node的前一个节点, O(n)
+inline __slist_node_base* __slist_previous(__slist_node_base* head, const __slist_node_base* node)
+{
+    while(head && head->next != node)
+        head = head->next;
+    return head;
+}
+
+// 将 (before_first, before_last] 移动到pos之后
+inline void __slist_splice_after(__slist_node_base* pos, __slist_node_base* before_first, __slist_node_base* before_last)
+{
+    if(pos != before_first && pos != before_last)
+    {
+        __slist_node_base* first = before_first->next;
+        __slist_node_base* after = pos->next;
+        before_first->next = before_last->next;
+        pos->next = first;
+        before_last->next = after;
+    }
+}
+
+inline __slist_node_base* __slist_reverse(__slist_node_base* node)
+{
+    __slist_node_base* result = node;
+    node = node->next;
+    result->next = 0;
+    while(node)
+    {
+        __slist_node_base* next = node->next;
+        node->next = result;
+        result = node;
+        node = next;
+    }
+    return result;
+}
+
+
+template<class T, class Ref, class Ptr>
+struct __slist_iterator
+{
+    typedef __slist_iterator<T, T&, T*> iterator;
+    typedef __slist_iterator<T, const T&, const T*> const_iterator;
+    typedef __slist_iterator<T, Ref, Ptr> self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __slist_node<T> list_node;
+
+    __slist_node_base* node;
+
+    __slist_iterator() : node(0)    {}
+    __slist_iterator(__slist_node_base* x) : node(x)    {}
+    __slist_iterator(const iterator& x) : node(x.node)  {}
+    self& operator=(const self& x) = default;
+
+    bool operator==(const self& x) const    {   return node == x.node;  }
+    bool operator!=(const self& x) const    {   return node != x.node;  }
+
+    reference operator*() const {   return ((list_node*)node)->data;    }
+    pointer operator->() const  {   return &((list_node*)node)->data;   }
+
+    self& operator++()
+    {
+        node = node->next;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+
+template<class T, class Alloc = alloc>
+class slist
+{
+private:
+    typedef __slist_node<T> list_node;
+    typedef __slist_node_base list_node_base;
+    typedef simple_alloc<list_node, Alloc> list_node_allocator;
+
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __slist_iterator<T, T&, T*> iterator;
+    typedef __slist_iterator<T, const T&, const T*> const_iterator;
+
+private:
+    list_node_base head;    // 头节点, 不存放元素, head.next 为第一个节点, 最后一个节点的next为空
+
+private:
+    static list_node* create_node(const value_type& x)
+    {
+        list_node* node = list_node_allocator::allocate();
+        construct(&node->data, x);
+        node->next = 0;
+        return node;
+    }
+
+    static void destroy_node(list_node* node)
+    {
+        destroy(&node->data);
+        list_node_allocator::deallocate(node);
+    }
+
+    // 删除 (before_first, last_node) 之间的节点, 析构元素后整段归还
+    list_node_base* erase_after(list_node_base* before_first, list_node_base* last_node)
+    {
+        list_node* first = (list_node*)before_first->next;
+        if(first == last_node)
+            return last_node;
+        before_first->next = last_node;
+        typedef typename __type_traits<T>::has_trivial_destructor trivial_destructor;
+        list_node* last = destroy_chain(first, last_node, trivial_destructor());
+        list_node_allocator::deallocate_chain(first, last);
+        return last_node;
+    }
+
+    // 返回这段节点的最后一个, trivial destructor 时只需要找到链尾, 不调用析构函数
+    static list_node* destroy_chain(list_node* first, list_node_base* last_node, __true_type)
+    {
+        list_node_base* cur = first;
+        while(cur->next != last_node)
+            cur = cur->next;
+        return (list_node*)cur;
+    }
+    static list_node* destroy_chain(list_node* first, list_node_base* last_node, __false_type)
+    {
+        list_node* cur = first;
+        for(;;)
+        {
+            destroy(&cur->data);
+            if(cur->next == last_node)
+                return cur;
+            cur = (list_node*)cur->next;
+        }
+    }
+
+    list_node_base* insert_after(list_node_base* pos, const value_type& x)
+    {
+        return __slist_make_link(pos, create_node(x));
+    }
+
+    void insert_after_fill(list_node_base* pos, size_type n, const value_type& x)
+    {
+        if(n == 0)
+            return;
+        list_node* first = list_node_allocator::allocate_chain(n);
+        list_node* cur = first;
+        for(;;)
+        {
+            construct(&cur->data, x);
+            if(--n == 0)
+                break;
+            cur = (list_node*)cur->next;
+        }
+        cur->next = pos->next;
+        pos->next = first;
+    }
+
+    template<class InputIterator>
+    void insert_after_range(list_node_base* pos, InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        for(; first != last; ++first)
+            pos = __slist_make_link(pos, create_node(*first));
+    }
+
+    // 一次取得整条节点链, 链本身已经按顺序串好
+    template<class ForwardIterator>
+    void insert_after_range(list_node_base* pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+    {
+        size_type n = distance(first, last);
+        if(n == 0)
+            return;
+        list_node* chain = list_node_allocator::allocate_chain(n);
+        list_node* cur = chain;
+        for(;;)
+        {
+            construct(&cur->data, *first);
+            ++first;
+            if(--n == 0)
+                break;
+            cur = (list_node*)cur->next;
+        }
+        cur->next = pos->next;
+        pos->next = chain;
+    }
+
+    // 两个参数都是整数时按 (个数, 值) 处理
+    template<class Integer>
+    void insert_after_dispatch(list_node_base* pos, Integer n, Integer x, __true_type)
+    {
+        insert_after_fill(pos, size_type(n), value_type(x));
+    }
+
+    template<class InputIterator>
+    void insert_after_dispatch(list_node_base* pos, InputIterator first, InputIterator last, __false_type)
+    {
+        insert_after_range(pos, first, last, iterator_category(first));
+    }
+
+public:
+    slist() {   head.next = 0;  }
+
+    slist(size_type n, const value_type& x)
+    {
+        head.next = 0;
+        insert_after_fill(&head, n, x);
+    }
+    slist(int n, const value_type& x)
+    {
+        head.next = 0;
+        insert_after_fill(&head, (size_type)n, x);
+    }
+    slist(long n, const value_type& x)
+    {
+        head.next = 0;
+        insert_after_fill(&head, (size_type)n, x);
+    }
+    explicit slist(size_type n)
+    {
+        head.next = 0;
+        insert_after_fill(&head, n, value_type());
+    }
+
+    template<class InputIterator>
+    slist(InputIterator first, InputIterator last)
+    {
+        head.next = 0;
+        insert_after_dispatch(&head, first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    slist(const slist& x)
+    {
+        head.next = 0;
+        insert_after_range(&head, x.begin(), x.end(), forward_iterator_tag());
+    }
+
+    slist& operator=(const slist& x)
+    {
+        if(this != &x)
+        {
+            slist tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~slist()    {   clear();    }
+
+public:
+    iterator begin()    {   return iterator(head.next); }
+    iterator end()      {   return iterator(0); }
+    const_iterator begin() const    {   return const_iterator(head.next);   }
+    const_iterator end() const      {   return const_iterator(0);   }
+
+    // 第一个元素之前的位置, 供 insert_after / erase_after 在表头操作
+    iterator before_begin()     {   return iterator(&head); }
+
+    size_type size() const  {   return distance(begin(), end());    }
+    size_type max_size() const  {   return size_type(-1);   }
+    bool empty() const      {   return head.next == 0;  }
+
+    void swap(slist& x)     {   ::swap(head.next, x.head.next); }
+
+    reference front()   {   return ((list_node*)head.next)->data;   }
+    const_reference front() const   {   return ((list_node*)head.next)->data;   }
+
+    void push_front(const value_type& x)    {   __slist_make_link(&head, create_node(x));   }
+    void pop_front()
+    {
+        list_node* node = (list_node*)head.next;
+        head.next = node->next;
+        destroy_node(node);
+    }
+
+    // pos之前的位置, O(n)
+    iterator previous(const_iterator pos)
+    {
+        return iterator(__slist_previous(&head, pos.node));
+    }
+
+public:
+    iterator insert_after(iterator pos, const value_type& x)
+    {
+        return iterator(insert_after(pos.node, x));
+    }
+    void insert_after(iterator pos, size_type n, const value_type& x)
+    {
+        insert_after_fill(pos.node, n, x);
+    }
+    template<class InputIterator>
+    void insert_after(iterator pos, InputIterator first, InputIterator last)
+    {
+        insert_after_dispatch(pos.node, first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    // 在pos之前插入, 需要先找到前一个节点, O(n)
+    iterator insert(iterator pos, const value_type& x)
+    {
+        return iterator(insert_after(__slist_previous(&head, pos.node), x));
+    }
+
+    iterator erase_after(iterator pos)
+    {
+        list_node* next = (list_node*)pos.node->next;
+        pos.node->next = next->next;
+        destroy_node(next);
+        return iterator(pos.node->next);
+    }
+    // 删除 (before_first, last)
+    iterator erase_after(iterator before_first, iterator last)
+    {
+        return iterator(erase_after(before_first.node, last.node));
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase_after(iterator(__slist_previous(&head, pos.node)));
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        return iterator(erase_after(__slist_previous(&head, first.node), last.node));
+    }
+
+    void clear()    {   erase_after(&head, 0);  }
+
+public:
+    // 将 (before_first, before_last] 移动到pos之后, O(1)
+    void splice_after(iterator pos, iterator before_first, iterator before_last)
+    {
+        if(before_first != before_last)
+            __slist_splice_after(pos.node, before_first.node, before_last.node);
+    }
+
+    // 将prev之后的一个元素移动到pos之后
+    void splice_after(iterator pos, iterator prev)
+    {
+        __slist_splice_after(pos.node, prev.node, prev.node->next);
+    }
+
+    void reverse()
+    {
+        if(head.next)
+            head.next = __slist_reverse(head.next);
+    }
+
+    void remove(const T& value)
+    {
+        list_node_base* cur = &head;
+        while(cur && cur->next)
+        {
+            if(((list_node*)cur->next)->data == value)
+                erase_after(iterator(cur));
+            else
+                cur = cur->next;
+        }
+    }
+
+    // 删除连续重复的元素
+    void unique()
+    {
+        list_node_base* cur = head.next;
+        if(cur)
+        {
+            while(cur->next)
+            {
+                if(((list_node*)cur)->data == ((list_node*)cur->next)->data)
+                    erase_after(iterator(cur));
+                else
+                    cur = cur->next;
+            }
+        }
+    }
+};
+
+template<class T, class Alloc>
+inline bool operator==(const slist<T, Alloc>& x, const slist<T, Alloc>& y)
+{
+    typedef typename slist<T, Alloc>::const_iterator const_iterator;
+    const_iterator end1 = x.end();
+    const_iterator end2 = y.end();
+    const_iterator i1 = x.begin();
+    const_iterator i2 = y.begin();
+    for(; i1 != end1 && i2 != end2 && *i1 == *i2; ++i1, ++i2)
+        ;
+    return i1 == end1 && i2 == end2;
+}
+
+template<class T, class Alloc>
+inline bool operator<(const slist<T, Alloc>& x, const slist<T, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#endif // __STL_SLIST_H
\ No newline at end of file
@@ -0,0 +1,303 @@
+#ifndef __STL_SLOT_MAP_H
+#define __STL_SLOT_MAP_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_uninitialized.h"
+
+// slot_map: 元素紧密地存放在一段连续空间中, 插入时返回一个句柄(槽位下标, 代数), 以句柄访问元素
+// 1. values[0, size) 是所有元素, 遍历就是顺序扫描一个数组
+// 2. slots[i] 记录句柄i对应的元素在values中的位置, 以及该槽位的代数;
+//    dense_to_slot[j] 反过来记录 values[j] 属于哪个槽位, 删除时用来修正被移动元素的槽位
+// 3. 删除时把最后一个元素移到被删除的位置, values 始终没有空洞; 其他元素的句柄不受影响,
+//    但元素的地址与迭代器会改变, 需要长期保存的只能是句柄
+// 4. 槽位的代数在插入和删除时各加一, 奇数表示正在使用; 句柄的代数与槽位的不同时说明元素已被删除,
+//    即使槽位已被新的元素复用, 旧句柄也不会访问到新元素 (同一个槽位复用 2^31 次之后代数才会回绕)
+// 5. 空闲的槽位串成链表(借用 index 字段), 后删除的先复用
+// 增长时元素经由 uninitialized_copy 搬到新空间再 destroy 旧元素, POD类型就是一次 memmove, 析构为空操作
+//
+//  slot_map<entity> m;
+//  slot_map<entity>::handle h = m.insert(e);
+//  if(entity* p = m.find(h)) ...                 // h 已被删除时返回0
+//  for_each(m.begin(), m.end(), update());       // 顺序遍历所有元素
+
+struct slot_map_handle
+{
+    unsigned int index;
+    unsigned int generation;
+};
+
+inline bool operator==(const slot_map_handle& x, const slot_map_handle& y)
+{
+    return x.index == y.index && x.generation == y.generation;
+}
+
+inline bool operator!=(const slot_map_handle& x, const slot_map_handle& y)  {   return !(x == y);   }
+
+struct __slot_map_slot
+{
+    unsigned int index;         // 使用中: 元素在values中的位置; 空闲: 下一个空闲槽位
+    unsigned int generation;
+};
+
+template<>
+struct __type_traits<__slot_map_slot>
+{
+    typedef __true_type has_trivial_default_constructor;
+    typedef __true_type has_trivial_copy_constructor;
+    typedef __true_type has_trivial_assignment_operator;
+    typedef __true_type has_trivial_destructor;
+    typedef __true_type is_POD_type;
+};
+
+static const unsigned int __slot_map_npos = ~0u;
+
+template<class T, class Alloc = alloc>
+class slot_map
+{
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef slot_map_handle handle;
+
+protected:
+    typedef simple_alloc<value_type, Alloc> data_allocator;
+    typedef simple_alloc<unsigned int, Alloc> index_allocator;
+    typedef simple_alloc<__slot_map_slot, Alloc> slot_allocator;
+
+protected:
+    T* values;                      // [0, num_elements) 为元素
+    unsigned int* dense_to_slot;    // 与values等长
+    size_type num_elements;
+    size_type value_capacity;
+    __slot_map_slot* slots;
+    size_type num_slots;
+    size_type slot_capacity;
+    unsigned int free_head;         // 第一个空闲槽位, 没有时为 __slot_map_npos
+
+protected:
+    void initialize()
+    {
+        values = 0;
+        dense_to_slot = 0;
+        num_elements = value_capacity = 0;
+        slots = 0;
+        num_slots = slot_capacity = 0;
+        free_head = __slot_map_npos;
+    }
+
+    // 元素与反向下标搬到容量为n的新空间
+    void reallocate_values(size_type n)
+    {
+        T* new_values = data_allocator::allocate(n);
+        unsigned int* new_dense = index_allocator::allocate(n);
+        uninitialized_copy(values, values + num_elements, new_values);
+        uninitialized_copy(dense_to_slot, dense_to_slot + num_elements, new_dense);
+        destroy(values, values + num_elements);
+        data_allocator::deallocate(values, value_capacity);
+        index_allocator::deallocate(dense_to_slot, value_capacity);
+        values = new_values;
+        dense_to_slot = new_dense;
+        value_capacity = n;
+    }
+
+    void reallocate_slots(size_type n)
+    {
+        __slot_map_slot* new_slots = slot_allocator::allocate(n);
+        uninitialized_copy(slots, slots + num_slots, new_slots);
+        slot_allocator::deallocate(slots, slot_capacity);
+        slots = new_slots;
+        slot_capacity = n;
+    }
+
+    // 取得一个空闲槽位, 没有时在末尾新增一个
+    unsigned int take_slot()
+    {
+        if(free_head != __slot_map_npos)
+        {
+            unsigned int s = free_head;
+            free_head = slots[s].index;
+            return s;
+        }
+        if(num_slots == slot_capacity)
+            reallocate_slots(slot_capacity ? 2 * slot_capacity : 8);
+        slots[num_slots].generation = 0;
+        return static_cast<unsigned int>(num_slots++);
+    }
+
+    void release_slot(unsigned int s)
+    {
+        ++slots[s].generation;
+        slots[s].index = free_head;
+        free_head = s;
+    }
+
+    // 删除 values[d]: 最后一个元素移到d, 修正它的槽位
+    void erase_dense(size_type d)
+    {
+        const size_type last = num_elements - 1;
+        release_slot(dense_to_slot[d]);
+        if(d != last)
+        {
+            values[d] = values[last];
+            dense_to_slot[d] = dense_to_slot[last];
+            slots[dense_to_slot[d]].index = static_cast<unsigned int>(d);
+        }
+        destroy(values + last);
+        --num_elements;
+    }
+
+public:
+    slot_map()  {   initialize();   }
+    slot_map(const slot_map& x)
+    {
+        initialize();
+        *this = x;
+    }
+    ~slot_map()
+    {
+        destroy(values, values + num_elements);
+        data_allocator::deallocate(values, value_capacity);
+        index_allocator::deallocate(dense_to_slot, value_capacity);
+        slot_allocator::deallocate(slots, slot_capacity);
+    }
+
+    // 复制后x的句柄在新容器中同样有效
+    slot_map& operator=(const slot_map& x)
+    {
+        if(this != &x)
+        {
+            clear();
+            if(value_capacity < x.num_elements)
+                reallocate_values(x.num_elements);
+            if(slot_capacity < x.num_slots)
+                reallocate_slots(x.num_slots);
+            uninitialized_copy(x.values, x.values + x.num_elements, values);
+            uninitialized_copy(x.dense_to_slot, x.dense_to_slot + x.num_elements, dense_to_slot);
+            uninitialized_copy(x.slots, x.slots + x.num_slots, slots);
+            num_elements = x.num_elements;
+            num_slots = x.num_slots;
+            free_head = x.free_head;
+        }
+        return *this;
+    }
+
+public:
+    iterator begin()                {   return values;  }
+    const_iterator begin() const    {   return values;  }
+    iterator end()                  {   return values + num_elements;   }
+    const_iterator end() const      {   return values + num_elements;   }
+    pointer data()                  {   return values;  }
+    const_pointer data() const      {   return values;  }
+
+    size_type size() const      {   return num_elements;    }
+    bool empty() const          {   return num_elements == 0;   }
+    size_type capacity() const  {   return value_capacity;  }
+
+    void reserve(size_type n)
+    {
+        if(n > value_capacity)
+            reallocate_values(n);
+        if(n > slot_capacity)
+            reallocate_slots(n);
+    }
+
+    // ------------------------------------- 句柄
+    bool contains(handle h) const
+    {
+        return h.index < num_slots && slots[h.index].generation == h.generation && (h.generation & 1);
+    }
+
+    // 句柄已失效时返回0
+    pointer find(handle h)
+    {
+        return contains(h) ? values + slots[h.index].index : 0;
+    }
+    const_pointer find(handle h) const
+    {
+        return contains(h) ? values + slots[h.index].index : 0;
+    }
+
+    // 不检查句柄是否有效
+    reference operator[](handle h)              {   return values[slots[h.index].index];    }
+    const_reference operator[](handle h) const  {   return values[slots[h.index].index];    }
+
+    // 遍历时由元素得到它的句柄
+    handle handle_of(const_iterator position) const
+    {
+        unsigned int s = dense_to_slot[position - values];
+        handle h = {s, slots[s].generation};
+        return h;
+    }
+
+    // ------------------------------------- 插入与删除
+    handle insert(const T& x)
+    {
+        if(num_elements == value_capacity)
+            reallocate_values(value_capacity ? 2 * value_capacity : 8);
+        unsigned int s = take_slot();
+        construct(values + num_elements, x);
+        dense_to_slot[num_elements] = s;
+        slots[s].index = static_cast<unsigned int>(num_elements);
+        ++slots[s].generation;
+        ++num_elements;
+        handle h = {s, slots[s].generation};
+        return h;
+    }
+
+    // 句柄已失效时返回false
+    bool erase(handle h)
+    {
+        if(!contains(h))
+            return false;
+        erase_dense(slots[h.index].index);
+        return true;
+    }
+
+    // 删除后position指向原来的最后一个元素, 遍历中删除时不要前进:
+    //  for(it = m.begin(); it != m.end(); ) it = dead(*it) ? m.erase(it) : it + 1;
+    iterator erase(iterator position)
+    {
+        erase_dense(position - values);
+        return position;
+    }
+
+    // 所有句柄失效, 槽位全部回到空闲链表
+    void clear()
+    {
+        destroy(values, values + num_elements);
+        for(size_type d = 0; d < num_elements; ++d)
+            release_slot(dense_to_slot[d]);
+        num_elements = 0;
+    }
+
+    void swap(slot_map& x)
+    {
+        ::swap(values, x.values);
+        ::swap(dense_to_slot, x.dense_to_slot);
+        ::swap(num_elements, x.num_elements);
+        ::swap(value_capacity, x.value_capacity);
+        ::swap(slots, x.slots);
+        ::swap(num_slots, x.num_slots);
+        ::swap(slot_capacity, x.slot_capacity);
+        ::swap(free_head, x.free_head);
+    }
+};
+
+template<class T, class Alloc>
+inline void swap(slot_map<T, Alloc>& x, slot_map<T, Alloc>& y)
+{
+    x.swap(y);
+}
+
+#endif // __STL_SLOT_MAP_H
\ No newline at end of file
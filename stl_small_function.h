@@ -0,0 +1,357 @@
+#ifndef __STL_SMALL_FUNCTION_H
+#define __STL_SMALL_FUNCTION_H
+
+#include <cstddef>  // size_t, nullptr_t, max_align_t
+#include <new>      // placement new
+
+#include "stl_alloc.h"
+#include "type_traits.h"
+
+// function<R(Args...), InlineSize>: 类型擦除的可调用对象, 可以保存函数指针、函数对象、lambda
+// 可调用对象不超过 InlineSize 字节(默认3个指针)且对齐要求不超过 max_align_t 时, 直接放在对象内部的缓冲区中,
+// 构造、复制、移动都不配置内存; 更大的对象才从alloc配置空间, 缓冲区中只保存指针
+// 每种可调用对象类型对应一张静态的操作表(调用、复制、移动、析构), function 只保存缓冲区和指向操作表的指针
+//
+//  function<void(int)> f = print_int;                  // 函数指针, 放在缓冲区中
+//  function<int(int), 32> g = bind2nd(plus<int>(), 1); // 32字节的缓冲区
+//  vector<function<void()> > callbacks;                // 捕获不超过24字节的lambda不会逐个配置内存
+//
+// 调用空的function是未定义行为, 调用前可以用 if(f) 检查
+// 只有能以 Args... 调用且结果可以转换为R(R为void时不要求)的类型才能转换为 function<R(Args...)>,
+// 以 function 为参数的重载可以按可调用对象的签名区分
+
+enum { __function_default_inline_size = 3 * sizeof(void*) };
+
+// R 为void时丢弃可调用对象的返回值
+template<class R>
+struct __function_invoker
+{
+    template<class F, class... Args>
+    static R call(F& f, Args&&... args) {   return f(static_cast<Args&&>(args)...); }
+};
+
+template<>
+struct __function_invoker<void>
+{
+    template<class F, class... Args>
+    static void call(F& f, Args&&... args)  {   f(static_cast<Args&&>(args)...);    }
+};
+
+// 以下只在不求值的语境(decltype, sizeof)中使用
+template<class T>
+T&& __function_declval();
+
+template<bool Condition, class T = void>
+struct __function_enable_if {};
+
+template<class T>
+struct __function_enable_if<true, T>
+{
+    typedef T type;
+};
+
+// From 能否隐式转换为 To; To 为void时丢弃结果, 总是可以
+template<class From, class To>
+struct __function_convertible
+{
+    static char test(To);
+    static long test(...);
+    enum { value = sizeof(test(__function_declval<From>())) == 1 };
+};
+
+template<class From>
+struct __function_convertible<From, void>
+{
+    enum { value = true };
+};
+
+template<class To>
+struct __function_convertible<void, To>
+{
+    enum { value = false };
+};
+
+template<>
+struct __function_convertible<void, void>
+{
+    enum { value = true };
+};
+
+struct __function_not_callable
+{
+    enum { value = false };
+};
+
+// F 的左值能否以 Args... 调用, 且结果可以转换为R
+template<class F, class R, class... Args>
+struct __function_callable
+{
+    template<class G>
+    static __function_convertible<decltype(__function_declval<G&>()(__function_declval<Args>()...)), R> test(int);
+    template<class G>
+    static __function_not_callable test(...);
+
+    enum { value = decltype(test<F>(0))::value };
+};
+
+template<class Signature, size_t InlineSize = __function_default_inline_size>
+class function;
+
+template<class R, class... Args, size_t InlineSize>
+class function<R(Args...), InlineSize>
+{
+public:
+    typedef R result_type;
+
+private:
+    union storage_type
+    {
+        void* heap;
+        alignas(std::max_align_t) unsigned char buffer[InlineSize < sizeof(void*) ? sizeof(void*) : InlineSize];
+    };
+
+    // 操作表, 每种可调用对象类型与存放方式一张
+    struct manager
+    {
+        R (*invoke)(storage_type& s, Args&&... args);
+        void (*copy)(const storage_type& from, storage_type& to);
+        void (*move)(storage_type& from, storage_type& to);     // 移动到to之后析构from
+        void (*destroy)(storage_type& s);
+        bool local;
+    };
+
+    // 放在缓冲区中
+    template<class F>
+    struct local_manager
+    {
+        static F* get(storage_type& s)              {   return reinterpret_cast<F*>(s.buffer);  }
+        static const F* get(const storage_type& s)  {   return reinterpret_cast<const F*>(s.buffer);    }
+
+        static R invoke(storage_type& s, Args&&... args)
+        {
+            return __function_invoker<R>::call(*get(s), static_cast<Args&&>(args)...);
+        }
+        static void copy(const storage_type& from, storage_type& to)    {   new (to.buffer) F(*get(from));  }
+        static void move(storage_type& from, storage_type& to)
+        {
+            new (to.buffer) F(static_cast<F&&>(*get(from)));
+            get(from)->~F();
+        }
+        static void destroy(storage_type& s)    {   get(s)->~F();   }
+
+        static const manager table;
+    };
+
+    // 从alloc配置空间, 缓冲区中只保存指针, 移动时只需转移指针
+    // alloc 只保证 __ALIGN 字节对齐, 对齐要求更高的 F 多配置 alignof(F) 字节再手动对齐,
+    // 缓冲区中保存的是配置得到的原始地址
+    template<class F>
+    struct heap_manager
+    {
+        typedef simple_alloc<char, alloc> data_allocator;
+
+        enum { over_aligned = alignof(F) > size_t(__ALIGN) };
+        enum { raw_size = sizeof(F) + (over_aligned ? alignof(F) : 0) };
+
+        static F* align(void* raw)
+        {
+            if(!over_aligned)
+                return static_cast<F*>(raw);
+            size_t offset = alignof(F) - reinterpret_cast<size_t>(raw) % alignof(F);
+            return reinterpret_cast<F*>(static_cast<char*>(raw) + offset % alignof(F));
+        }
+
+        // 持有配置好的空间, F 的构造函数抛出异常时由析构函数归还
+        struct holder
+        {
+            char* raw;
+            holder() : raw(data_allocator::allocate(raw_size))  {}
+            ~holder()
+            {
+                if(raw)
+                    data_allocator::deallocate(raw, raw_size);
+            }
+            char* release()
+            {
+                char* r = raw;
+                raw = 0;
+                return r;
+            }
+        };
+
+        template<class G>
+        static void* create(G&& g)
+        {
+            holder h;
+            new (align(h.raw)) F(static_cast<G&&>(g));
+            return h.release();
+        }
+
+        static F* get(const storage_type& s)    {   return align(s.heap);   }
+
+        static R invoke(storage_type& s, Args&&... args)
+        {
+            return __function_invoker<R>::call(*get(s), static_cast<Args&&>(args)...);
+        }
+        static void copy(const storage_type& from, storage_type& to)    {   to.heap = create(*get(from));   }
+        static void move(storage_type& from, storage_type& to)  {   to.heap = from.heap;    }
+        static void destroy(storage_type& s)
+        {
+            get(s)->~F();
+            data_allocator::deallocate(static_cast<char*>(s.heap), raw_size);
+        }
+
+        static const manager table;
+    };
+
+    template<class F>
+    struct fits_inline
+    {
+        typedef typename __type_bool<(sizeof(F) <= sizeof(storage_type) &&
+                                      alignof(F) <= alignof(storage_type))>::type type;
+    };
+
+    storage_type storage;
+    const manager* vtable;      // 空的function为0
+
+private:
+    template<class F>
+    void init(F&& f, __true_type)
+    {
+        new (storage.buffer) F(static_cast<F&&>(f));
+        vtable = &local_manager<F>::table;
+    }
+
+    template<class F>
+    void init(F&& f, __false_type)
+    {
+        storage.heap = heap_manager<F>::create(static_cast<F&&>(f));
+        vtable = &heap_manager<F>::table;
+    }
+
+    // this 为空时, 接管x的可调用对象, x变为空
+    void take(function& x)
+    {
+        if(x.vtable)
+        {
+            x.vtable->move(x.storage, storage);
+            vtable = x.vtable;
+            x.vtable = 0;
+        }
+    }
+
+public:
+    function() : vtable(0)  {}
+    function(std::nullptr_t) : vtable(0)    {}
+
+    template<class F, class = typename __function_enable_if<__function_callable<F, R, Args...>::value>::type>
+    function(F f) : vtable(0)
+    {
+        init(static_cast<F&&>(f), typename fits_inline<F>::type());
+    }
+
+    // 空函数指针得到空的function
+    function(R (*f)(Args...)) : vtable(0)
+    {
+        if(f)
+            init(static_cast<R (*&&)(Args...)>(f), __true_type());
+    }
+
+    function(const function& x) : vtable(0)
+    {
+        if(x.vtable)
+        {
+            x.vtable->copy(x.storage, storage);
+            vtable = x.vtable;
+        }
+    }
+
+    function(function&& x) : vtable(0)  {   take(x);    }
+
+    ~function() {   reset();    }
+
+    function& operator=(const function& x)
+    {
+        if(this != &x)
+        {
+            function tmp(x);
+            reset();
+            take(tmp);
+        }
+        return *this;
+    }
+
+    function& operator=(function&& x)
+    {
+        if(this != &x)
+        {
+            reset();
+            take(x);
+        }
+        return *this;
+    }
+
+    function& operator=(std::nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    template<class F>
+    typename __function_enable_if<__function_callable<F, R, Args...>::value, function&>::type operator=(F f)
+    {
+        function tmp(static_cast<F&&>(f));
+        reset();
+        take(tmp);
+        return *this;
+    }
+
+public:
+    void reset()
+    {
+        if(vtable)
+        {
+            vtable->destroy(storage);
+            vtable = 0;
+        }
+    }
+
+    void swap(function& x)
+    {
+        function tmp(static_cast<function&&>(x));
+        x.take(*this);
+        take(tmp);
+    }
+
+    explicit operator bool() const  {   return vtable != 0; }
+
+    // 可调用对象放在内部缓冲区中, 没有配置内存
+    bool stored_inline() const  {   return vtable == 0 || vtable->local;    }
+
+    R operator()(Args... args) const
+    {
+        return vtable->invoke(const_cast<storage_type&>(storage), static_cast<Args&&>(args)...);
+    }
+};
+
+template<class R, class... Args, size_t InlineSize>
+template<class F>
+const typename function<R(Args...), InlineSize>::manager
+function<R(Args...), InlineSize>::local_manager<F>::table = {
+    &local_manager<F>::invoke, &local_manager<F>::copy, &local_manager<F>::move, &local_manager<F>::destroy, true
+};
+
+template<class R, class... Args, size_t InlineSize>
+template<class F>
+const typename function<R(Args...), InlineSize>::manager
+function<R(Args...), InlineSize>::heap_manager<F>::table = {
+    &heap_manager<F>::invoke, &heap_manager<F>::copy, &heap_manager<F>::move, &heap_manager<F>::destroy, false
+};
+
+template<class Signature, size_t InlineSize>
+inline void swap(function<Signature, InlineSize>& x, function<Signature, InlineSize>& y)
+{
+    x.swap(y);
+}
+
+#endif // __STL_SMALL_FUNCTION_H
\ No newline at end of file
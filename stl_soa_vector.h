@@ -0,0 +1,290 @@
+#ifndef __STL_SOA_VECTOR_H
+#define __STL_SOA_VECTOR_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_uninitialized.h"
+
+// soa_vector<Fields...>: 按字段分列存放的vector, 每个字段一段独立的连续空间(structure of arrays)
+// 第i条记录的第I个字段是 data<I>()[i]; 只用到一两个字段的循环只读取这几列, 不会把整条记录读入缓存
+// 每一列的迭代器就是指针, 可以直接交给 for_each / accumulate 等算法, 算术类型的列会走 stl_numeric.h 的向量化版本
+//
+//  soa_vector<int, double, float> v;
+//  v.push_back(1, 2.0, 3.0f);
+//  double s = accumulate(v.begin<1>(), v.end<1>(), 0.0);     // 只扫描第1列
+//  v.get<2>(0) = 4.0f;
+//
+// 所有列共用同一个长度和容量, 增长时先配置所有列的新空间, 再逐列经由 uninitialized_copy 搬过去并 destroy 旧元素,
+// 算术类型等 POD 列就是一次 memmove; 增长后所有列的指针都会失效
+// 字段数目不定, 空间配置器只能固定为 alloc
+// 依赖可变参数模板, 需要C++11
+
+// ========================================= 字段类型
+template<size_t I, class... Fields>
+struct __soa_field;
+
+template<class Head, class... Tail>
+struct __soa_field<0, Head, Tail...>
+{
+    typedef Head type;
+};
+
+template<size_t I, class Head, class... Tail>
+struct __soa_field<I, Head, Tail...>
+{
+    typedef typename __soa_field<I - 1, Tail...>::type type;
+};
+
+// ========================================= 列
+// __soa_columns<I, Fi, ..., Fn> 保存第I列, 并继承其后各列; 每个操作处理本列后交给基类
+template<size_t I, class... Fields>
+struct __soa_columns
+{
+    void initialize()   {}
+    void allocate(size_t)   {}
+    void move_from(__soa_columns&, size_t, size_t)  {}
+    void construct_back(size_t) {}
+    void fill(size_t, size_t)   {}
+    void destroy_range(size_t, size_t)  {}
+    void deallocate(size_t) {}
+    void copy_from(const __soa_columns&, size_t)    {}
+    void swap(__soa_columns&)   {}
+};
+
+template<size_t I, class Head, class... Tail>
+struct __soa_columns<I, Head, Tail...> : public __soa_columns<I + 1, Tail...>
+{
+    typedef __soa_columns<I + 1, Tail...> base_type;
+    typedef simple_alloc<Head, alloc> column_allocator;
+
+    Head* column;
+
+    void initialize()
+    {
+        column = 0;
+        base_type::initialize();
+    }
+
+    void allocate(size_t capacity)
+    {
+        column = column_allocator::allocate(capacity);
+        base_type::allocate(capacity);
+    }
+
+    // x 的前n个元素搬到本对象已配置好的空间, 然后归还x的空间
+    void move_from(__soa_columns& x, size_t n, size_t old_capacity)
+    {
+        uninitialized_copy(x.column, x.column + n, column);
+        destroy(x.column, x.column + n);
+        column_allocator::deallocate(x.column, old_capacity);
+        base_type::move_from(x, n, old_capacity);
+    }
+
+    // 在位置n构造一条记录
+    void construct_back(size_t n, const Head& x, const Tail&... rest)
+    {
+        construct(column + n, x);
+        base_type::construct_back(n, rest...);
+    }
+
+    // [first, last) 构造为各字段的默认值
+    void fill(size_t first, size_t last)
+    {
+        uninitialized_fill_n(column + first, last - first, Head());
+        base_type::fill(first, last);
+    }
+
+    void destroy_range(size_t first, size_t last)
+    {
+        destroy(column + first, column + last);
+        base_type::destroy_range(first, last);
+    }
+
+    void deallocate(size_t capacity)
+    {
+        column_allocator::deallocate(column, capacity);
+        base_type::deallocate(capacity);
+    }
+
+    // 空间已足够, 构造x的前n个元素
+    void copy_from(const __soa_columns& x, size_t n)
+    {
+        uninitialized_copy(x.column, x.column + n, column);
+        base_type::copy_from(x, n);
+    }
+
+    void swap(__soa_columns& x)
+    {
+        ::swap(column, x.column);
+        base_type::swap(x);
+    }
+};
+
+// 取第I列: 由派生类转换到 __soa_columns<I, ...> 时推导出该列的类型
+template<size_t I, class Head, class... Tail>
+inline Head* __soa_column(const __soa_columns<I, Head, Tail...>& c)
+{
+    return c.column;
+}
+
+// ========================================= soa_vector
+template<class... Fields>
+class soa_vector
+{
+public:
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    // 第I列的元素类型与迭代器
+    template<size_t I>
+    struct field
+    {
+        typedef typename __soa_field<I, Fields...>::type type;
+        typedef type* iterator;
+        typedef const type* const_iterator;
+    };
+
+protected:
+    typedef __soa_columns<0, Fields...> columns_type;
+
+    columns_type columns;
+    size_type num_elements;
+    size_type num_capacity;
+
+protected:
+    void reallocate(size_type n)
+    {
+        columns_type fresh;
+        fresh.allocate(n);
+        fresh.move_from(columns, num_elements, num_capacity);
+        columns.swap(fresh);
+        num_capacity = n;
+    }
+
+    // 与 vector::insert_aux 相同: 先在新空间中构造新记录, 再搬移旧元素,
+    // fields 可以引用本对象中的元素(包括其他列)
+    void push_back_aux(const Fields&... fields)
+    {
+        const size_type n = num_capacity ? 2 * num_capacity : 8;
+        columns_type fresh;
+        fresh.allocate(n);
+        fresh.construct_back(num_elements, fields...);
+        fresh.move_from(columns, num_elements, num_capacity);
+        columns.swap(fresh);
+        num_capacity = n;
+    }
+
+public:
+    soa_vector() : num_elements(0), num_capacity(0)  {   columns.initialize();   }
+    explicit soa_vector(size_type n) : num_elements(0), num_capacity(0)
+    {
+        columns.initialize();
+        resize(n);
+    }
+    soa_vector(const soa_vector& x) : num_elements(0), num_capacity(0)
+    {
+        columns.initialize();
+        *this = x;
+    }
+    ~soa_vector()
+    {
+        columns.destroy_range(0, num_elements);
+        columns.deallocate(num_capacity);
+    }
+
+    soa_vector& operator=(const soa_vector& x)
+    {
+        if(this != &x)
+        {
+            clear();
+            if(num_capacity < x.num_elements)
+                reallocate(x.num_elements);
+            columns.copy_from(x.columns, x.num_elements);
+            num_elements = x.num_elements;
+        }
+        return *this;
+    }
+
+public:
+    template<size_t I>
+    typename field<I>::iterator begin()              {   return __soa_column<I>(columns);    }
+    template<size_t I>
+    typename field<I>::const_iterator begin() const  {   return __soa_column<I>(columns);    }
+    template<size_t I>
+    typename field<I>::iterator end()                {   return __soa_column<I>(columns) + num_elements; }
+    template<size_t I>
+    typename field<I>::const_iterator end() const    {   return __soa_column<I>(columns) + num_elements; }
+    template<size_t I>
+    typename field<I>::iterator data()               {   return __soa_column<I>(columns);    }
+    template<size_t I>
+    typename field<I>::const_iterator data() const   {   return __soa_column<I>(columns);    }
+
+    // 第i条记录的第I个字段
+    template<size_t I>
+    typename field<I>::type& get(size_type i)               {   return __soa_column<I>(columns)[i]; }
+    template<size_t I>
+    const typename field<I>::type& get(size_type i) const   {   return __soa_column<I>(columns)[i]; }
+
+    size_type size() const      {   return num_elements;    }
+    size_type capacity() const  {   return num_capacity;    }
+    bool empty() const          {   return num_elements == 0;   }
+
+    void reserve(size_type n)
+    {
+        if(n > num_capacity)
+            reallocate(n);
+    }
+
+    // ------------------------------------- 插入与删除
+    void push_back(const Fields&... fields)
+    {
+        if(num_elements == num_capacity)
+            push_back_aux(fields...);
+        else
+            columns.construct_back(num_elements, fields...);
+        ++num_elements;
+    }
+
+    void pop_back()
+    {
+        --num_elements;
+        columns.destroy_range(num_elements, num_elements + 1);
+    }
+
+    // 新增的记录各字段为默认值
+    void resize(size_type n)
+    {
+        if(n < num_elements)
+            columns.destroy_range(n, num_elements);
+        else if(n > num_elements)
+        {
+            reserve(n);
+            columns.fill(num_elements, n);
+        }
+        num_elements = n;
+    }
+
+    void clear()
+    {
+        columns.destroy_range(0, num_elements);
+        num_elements = 0;
+    }
+
+    void swap(soa_vector& x)
+    {
+        columns.swap(x.columns);
+        ::swap(num_elements, x.num_elements);
+        ::swap(num_capacity, x.num_capacity);
+    }
+};
+
+template<class... Fields>
+inline void swap(soa_vector<Fields...>& x, soa_vector<Fields...>& y)
+{
+    x.swap(y);
+}
+
+#endif // __STL_SOA_VECTOR_H
\ No newline at end of file
@@ -0,0 +1,560 @@
+#ifndef __STL_STRING_H
+#define __STL_STRING_H
+
+#include <cstddef>  // size_t, ptrdiff_t
+#include <cstring>  // memchr, memcmp, strlen
+#include <cwchar>   // wmemchr, wmemcmp, wcslen
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_hash_fun.h"
+#include "stl_uninitialized.h"
+
+// basic_string<CharT>: 带短字符串优化(SSO)的字符串, string 与 wstring 是它的两个实例
+// 1. 对象本身24字节(64位平台): 长度不超过23个char(或5个wchar_t)的字符串直接存放在对象内部, 不分配空间
+// 2. 短字符串的最后一个字符位置存放 剩余容量 = 23 - size(), 长度恰好为23时它就是结尾的0
+// 3. 长字符串的内容放在 simple_alloc<CharT, Alloc> 分配的空间中, 对象中保存 指针、长度、容量;
+//    容量的最高位(小端平台上就是对象的最后一个字节的最高位)置1, 作为长字符串的标志
+//    短字符串的最后一个字节不超过23, 最高位总是0
+// 4. 长字符串增长时经由 simple_alloc::reallocate 原地扩展或整块搬移, 容量至少翻倍
+// 内容的复制使用 char / wchar_t 的 uninitialized_copy 与 copy (memmove),
+// find 使用 memchr / wmemchr 定位首字符, compare 使用 memcmp / wmemcmp
+//
+//  string key("user:42");          // 不分配空间
+//  key += ":session";              // 15个字符, 仍在对象内部
+//  if(key.find(':') != string::npos) ...
+//  hash_map<string, int> m;  m[key] = 1;
+
+// ========================================= 字符运算
+// char 与 wchar_t 使用C库函数, 其他字符类型逐个比较
+template<class CharT>
+inline const CharT* __string_find(const CharT* s, size_t n, CharT c)
+{
+    for(; n; --n, ++s)
+        if(*s == c)
+            return s;
+    return 0;
+}
+
+inline const char* __string_find(const char* s, size_t n, char c)
+{
+    return n ? static_cast<const char*>(memchr(s, c, n)) : 0;
+}
+
+inline const wchar_t* __string_find(const wchar_t* s, size_t n, wchar_t c)
+{
+    return n ? wmemchr(s, c, n) : 0;
+}
+
+template<class CharT>
+inline int __string_compare(const CharT* x, const CharT* y, size_t n)
+{
+    for(; n; --n, ++x, ++y)
+        if(*x != *y)
+            return *x < *y ? -1 : 1;
+    return 0;
+}
+
+// 与 char_traits<char> 相同, 按 unsigned char 比较
+inline int __string_compare(const char* x, const char* y, size_t n)
+{
+    return n ? memcmp(x, y, n) : 0;
+}
+
+inline int __string_compare(const wchar_t* x, const wchar_t* y, size_t n)
+{
+    return n ? wmemcmp(x, y, n) : 0;
+}
+
+template<class CharT>
+inline size_t __string_length(const CharT* s)
+{
+    const CharT* p = s;
+    while(*p != CharT())
+        ++p;
+    return p - s;
+}
+
+inline size_t __string_length(const char* s)    {   return strlen(s);   }
+inline size_t __string_length(const wchar_t* s) {   return wcslen(s);   }
+
+// ========================================= basic_string
+template<class CharT, class Alloc = alloc>
+class basic_string
+{
+public:
+    typedef CharT value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    static const size_type npos = size_type(-1);
+
+protected:
+    typedef simple_alloc<value_type, Alloc> data_allocator;
+
+    struct heap_rep
+    {
+        CharT* data;
+        size_type size;
+        size_type capacity;     // 带有长字符串标志, 见 encode_capacity
+    };
+
+    enum { local_chars = sizeof(heap_rep) / sizeof(CharT), max_local = local_chars - 1 };
+
+    union rep_type
+    {
+        heap_rep heap;
+        CharT local[local_chars];
+    };
+
+    rep_type rep;
+
+protected:
+    // 标志放在对象最后一个字节的最高位
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static size_type encode_capacity(size_type n)   {   return (n << 8) | 0x80; }
+    static size_type decode_capacity(size_type x)   {   return x >> 8;  }
+#else
+    static size_type encode_capacity(size_type n)   {   return n | ~(~size_type(0) >> 1);   }
+    static size_type decode_capacity(size_type x)   {   return x & (~size_type(0) >> 1);    }
+#endif
+
+    bool is_long() const
+    {
+        return (reinterpret_cast<const unsigned char*>(&rep)[sizeof(rep) - 1] & 0x80) != 0;
+    }
+
+    void set_size(size_type n)  {   set_size(data(), n);    }
+
+    // p 是当前的 data(), 刚刚增长过的调用者直接传入, 编译器不必再判断一次是否为长字符串
+    void set_size(CharT* p, size_type n)
+    {
+        p[n] = CharT();
+        if(is_long())
+            rep.heap.size = n;
+        else
+            rep.local[max_local] = CharT(max_local - n);
+    }
+
+    // 长字符串的空间, 多一个位置存放结尾的0
+    static CharT* allocate_chars(size_type capacity)    {   return data_allocator::allocate(capacity + 1);  }
+    static void deallocate_chars(CharT* p, size_type capacity) {   data_allocator::deallocate(p, capacity + 1);    }
+
+    void set_heap(CharT* p, size_type n, size_type capacity)
+    {
+        rep.heap.data = p;
+        rep.heap.size = n;
+        rep.heap.capacity = encode_capacity(capacity);
+    }
+
+    void release()
+    {
+        if(is_long())
+        {
+            destroy(rep.heap.data, rep.heap.data + rep.heap.size);
+            deallocate_chars(rep.heap.data, capacity());
+        }
+    }
+
+    void initialize(const CharT* s, size_type n)
+    {
+        if(n <= size_type(max_local))
+        {
+            uninitialized_copy(s, s + n, rep.local);
+            rep.local[n] = CharT();
+            rep.local[max_local] = CharT(max_local - n);
+        }
+        else
+        {
+            CharT* p = allocate_chars(n);
+            uninitialized_copy(s, s + n, p);
+            p[n] = CharT();
+            set_heap(p, n, n);
+        }
+    }
+
+    // 两个整数的区间构造等价于 basic_string(n, c), 与SGI的容器相同
+    template<class Integer>
+    void range_initialize(Integer n, Integer c, __true_type)    {   append(size_type(n), CharT(c)); }
+
+    template<class InputIterator>
+    void range_initialize(InputIterator first, InputIterator last, __false_type)
+    {
+        range_append(first, last, iterator_category(first));
+    }
+
+    template<class InputIterator>
+    void range_append(InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        for(; first != last; ++first)
+            push_back(*first);
+    }
+
+    // 先算出长度, 只增长一次
+    template<class ForwardIterator>
+    void range_append(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+    {
+        const size_type len = size();
+        const size_type n = distance(first, last);
+        CharT* p = reserve_more(n);
+        copy(first, last, p + len);
+        set_size(p, len + n);
+    }
+
+    // 容量增加到n(n > capacity()), 内容不变
+    void grow_to(size_type n)
+    {
+        const size_type len = size();
+        if(is_long())
+        {
+            const size_type old = capacity();
+            set_heap(data_allocator::reallocate(rep.heap.data, old + 1, n + 1), len, n);
+        }
+        else
+        {
+            CharT* p = allocate_chars(n);
+            uninitialized_copy(rep.local, rep.local + len + 1, p);
+            set_heap(p, len, n);
+        }
+    }
+
+    // 保证还能再放下extra个字符, 不够时容量至少翻倍; 返回此后的 data()
+    CharT* reserve_more(size_type extra)
+    {
+        const size_type len = size();
+        const size_type cap = capacity();
+        if(len + extra <= cap)
+            return data();
+        grow_to(max(len + extra, 2 * cap));
+        return rep.heap.data;   // 增长后一定是长字符串
+    }
+
+public:
+    basic_string()  {   initialize(0, 0);   }
+    basic_string(const CharT* s)    {   initialize(s, __string_length(s));  }
+    basic_string(const CharT* s, size_type n)   {   initialize(s, n);   }
+    // 模板而不是 (const CharT*, const CharT*), 否则 basic_string(p, 0) 中的0与上一个构造函数同样匹配
+    template<class InputIterator>
+    basic_string(InputIterator first, InputIterator last)
+    {
+        initialize(0, 0);
+        range_initialize(first, last, typename __is_integer<InputIterator>::type());
+    }
+    basic_string(size_type n, CharT c)
+    {
+        initialize(0, 0);
+        append(n, c);
+    }
+    basic_string(const basic_string& x) {   initialize(x.data(), x.size()); }
+    ~basic_string() {   release();  }
+
+    basic_string& operator=(const basic_string& x)
+    {
+        if(this != &x)
+            assign(x.data(), x.size());
+        return *this;
+    }
+    basic_string& operator=(const CharT* s) {   return assign(s, __string_length(s));   }
+
+    // s 可以指向自身的内容
+    basic_string& assign(const CharT* s, size_type n)
+    {
+        if(n > capacity())
+        {
+            // 原来的内容不再需要, 不必经由 reallocate 复制
+            CharT* p = allocate_chars(n);
+            uninitialized_copy(s, s + n, p);
+            release();
+            set_heap(p, n, n);
+            rep.heap.data[n] = CharT();
+            return *this;
+        }
+        copy(s, s + n, data());
+        set_size(n);
+        return *this;
+    }
+
+public:
+    iterator begin()                {   return data();  }
+    const_iterator begin() const    {   return data();  }
+    iterator end()                  {   return data() + size(); }
+    const_iterator end() const      {   return data() + size(); }
+
+    CharT* data()               {   return is_long() ? rep.heap.data : rep.local;   }
+    const CharT* data() const   {   return is_long() ? rep.heap.data : rep.local;   }
+    const CharT* c_str() const  {   return data();  }
+
+    size_type size() const
+    {
+        return is_long() ? rep.heap.size : size_type(max_local - rep.local[max_local]);
+    }
+    size_type length() const    {   return size();  }
+    bool empty() const          {   return size() == 0; }
+    size_type capacity() const  {   return is_long() ? decode_capacity(rep.heap.capacity) : size_type(max_local);   }
+    size_type max_size() const  {   return (~size_type(0) >> 1) / sizeof(CharT) - 1;    }
+
+    reference operator[](size_type n)               {   return data()[n];   }
+    const_reference operator[](size_type n) const   {   return data()[n];   }
+    reference back()                {   return data()[size() - 1];  }
+    const_reference back() const    {   return data()[size() - 1];  }
+
+    void reserve(size_type n)
+    {
+        if(n > capacity())
+            grow_to(n);
+    }
+
+    void resize(size_type n, CharT c = CharT())
+    {
+        const size_type len = size();
+        if(n > len)
+            append(n - len, c);
+        else
+            set_size(n);
+    }
+
+    void clear()    {   set_size(0);    }
+
+    // ------------------------------------- 追加
+    // s 可以指向自身的内容
+    basic_string& append(const CharT* s, size_type n)
+    {
+        const size_type len = size();
+        // 增长后原来的空间可能已经归还, 先记下s在自身中的位置
+        const CharT* old = data();
+        const bool inside = s >= old && s < old + len;
+        CharT* p = reserve_more(n);
+        if(inside)
+            s = p + (s - old);
+        copy(s, s + n, p + len);
+        set_size(p, len + n);
+        return *this;
+    }
+    basic_string& append(const CharT* s)                {   return append(s, __string_length(s));   }
+    basic_string& append(const basic_string& x)         {   return append(x.data(), x.size());  }
+    basic_string& append(size_type n, CharT c)
+    {
+        const size_type len = size();
+        CharT* p = reserve_more(n);
+        fill_n(p + len, n, c);
+        set_size(p, len + n);
+        return *this;
+    }
+
+    void push_back(CharT c)
+    {
+        const size_type len = size();
+        CharT* p = reserve_more(1);
+        p[len] = c;
+        set_size(p, len + 1);
+    }
+    void pop_back() {   set_size(size() - 1);   }
+
+    basic_string& operator+=(const basic_string& x) {   return append(x.data(), x.size());  }
+    basic_string& operator+=(const CharT* s)        {   return append(s);   }
+    basic_string& operator+=(CharT c)
+    {
+        push_back(c);
+        return *this;
+    }
+
+    // 删除从pos开始的n个字符
+    basic_string& erase(size_type pos, size_type n = npos)
+    {
+        const size_type len = size();
+        n = min(n, len - pos);
+        CharT* p = data();
+        copy(p + pos + n, p + len, p + pos);
+        set_size(len - n);
+        return *this;
+    }
+
+    basic_string substr(size_type pos, size_type n = npos) const
+    {
+        return basic_string(data() + pos, min(n, size() - pos));
+    }
+
+    // ------------------------------------- 查找
+    size_type find(CharT c, size_type pos = 0) const
+    {
+        const size_type len = size();
+        if(pos >= len)
+            return npos;
+        const CharT* p = __string_find(data() + pos, len - pos, c);
+        return p ? size_type(p - data()) : npos;
+    }
+
+    // memchr 定位首字符, 再用 memcmp 比较其余部分
+    size_type find(const CharT* s, size_type pos, size_type n) const
+    {
+        const size_type len = size();
+        if(n == 0)
+            return pos <= len ? pos : npos;
+        if(n > len || pos > len - n)
+            return npos;
+        const CharT* base = data();
+        const CharT* first = base + pos;
+        const CharT* last = base + len - n + 1;     // 匹配的起点不超过这里
+        while(first < last)
+        {
+            first = __string_find(first, last - first, s[0]);
+            if(!first)
+                return npos;
+            if(__string_compare(first + 1, s + 1, n - 1) == 0)
+                return first - base;
+            ++first;
+        }
+        return npos;
+    }
+    size_type find(const CharT* s, size_type pos = 0) const         {   return find(s, pos, __string_length(s));    }
+    size_type find(const basic_string& x, size_type pos = 0) const  {   return find(x.data(), pos, x.size());   }
+
+    size_type rfind(CharT c, size_type pos = npos) const
+    {
+        const size_type len = size();
+        if(len == 0)
+            return npos;
+        const CharT* base = data();
+        for(size_type i = min(pos, len - 1) + 1; i-- > 0; )
+            if(base[i] == c)
+                return i;
+        return npos;
+    }
+
+    // ------------------------------------- 比较
+    int compare(const CharT* s, size_type n) const
+    {
+        const size_type len = size();
+        int r = __string_compare(data(), s, min(len, n));
+        if(r)
+            return r;
+        return len < n ? -1 : (len > n ? 1 : 0);
+    }
+    int compare(const basic_string& x) const    {   return compare(x.data(), x.size()); }
+    int compare(const CharT* s) const           {   return compare(s, __string_length(s));  }
+
+    void swap(basic_string& x)
+    {
+        // 短字符串的内容就在对象中, 长字符串只有指针, 两者都可以整体交换
+        rep_type tmp = rep;
+        rep = x.rep;
+        x.rep = tmp;
+    }
+};
+
+template<class CharT, class Alloc>
+const typename basic_string<CharT, Alloc>::size_type basic_string<CharT, Alloc>::npos;
+
+typedef basic_string<char> string;
+typedef basic_string<wchar_t> wstring;
+
+// ========================================= 比较与连接
+template<class CharT, class Alloc>
+inline bool operator==(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y)
+{
+    return x.size() == y.size() && __string_compare(x.data(), y.data(), x.size()) == 0;
+}
+
+template<class CharT, class Alloc>
+inline bool operator==(const basic_string<CharT, Alloc>& x, const CharT* s) {   return x.compare(s) == 0;   }
+
+template<class CharT, class Alloc>
+inline bool operator==(const CharT* s, const basic_string<CharT, Alloc>& x) {   return x.compare(s) == 0;   }
+
+template<class CharT, class Alloc>
+inline bool operator!=(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y)    {   return !(x == y);   }
+
+template<class CharT, class Alloc>
+inline bool operator!=(const basic_string<CharT, Alloc>& x, const CharT* s) {   return !(x == s);   }
+
+template<class CharT, class Alloc>
+inline bool operator!=(const CharT* s, const basic_string<CharT, Alloc>& x) {   return !(x == s);   }
+
+template<class CharT, class Alloc>
+inline bool operator<(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y) {   return x.compare(y) < 0;    }
+
+template<class CharT, class Alloc>
+inline bool operator>(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y) {   return y < x;   }
+
+template<class CharT, class Alloc>
+inline bool operator<=(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y)    {   return !(y < x);    }
+
+template<class CharT, class Alloc>
+inline bool operator>=(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y)    {   return !(x < y);    }
+
+template<class CharT, class Alloc>
+inline basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& x, const basic_string<CharT, Alloc>& y)
+{
+    basic_string<CharT, Alloc> r;
+    r.reserve(x.size() + y.size());
+    r.append(x);
+    return r.append(y);
+}
+
+template<class CharT, class Alloc>
+inline basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& x, const CharT* s)
+{
+    basic_string<CharT, Alloc> r(x);
+    return r.append(s);
+}
+
+template<class CharT, class Alloc>
+inline basic_string<CharT, Alloc> operator+(const CharT* s, const basic_string<CharT, Alloc>& x)
+{
+    basic_string<CharT, Alloc> r(s);
+    return r.append(x);
+}
+
+template<class CharT, class Alloc>
+inline basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& x, CharT c)
+{
+    basic_string<CharT, Alloc> r(x);
+    r.push_back(c);
+    return r;
+}
+
+template<class CharT, class Alloc>
+inline void swap(basic_string<CharT, Alloc>& x, basic_string<CharT, Alloc>& y)
+{
+    x.swap(y);
+}
+
+// ========================================= 散列
+// 按内容的字节散列, 与 hash<const char*> 使用同一个函数
+template<class CharT, class Alloc>
+struct hash<basic_string<CharT, Alloc> >
+{
+    size_t operator()(const basic_string<CharT, Alloc>& s) const
+    {
+        return __hash_bytes(s.data(), s.size() * sizeof(CharT), 0);
+    }
+};
+
+template<class CharT, class Alloc>
+struct seeded_hash<basic_string<CharT, Alloc> >
+{
+    unsigned long long seed;
+
+    seeded_hash() : seed(__hash_random_seed())  {}
+    explicit seeded_hash(unsigned long long s) : seed(s)    {}
+
+    size_t operator()(const basic_string<CharT, Alloc>& s) const
+    {
+        return __hash_bytes(s.data(), s.size() * sizeof(CharT), seed);
+    }
+};
+
+template<class CharT, class Alloc>
+struct __hash_is_avalanching<hash<basic_string<CharT, Alloc> > > : public __avalanching_hash {};
+
+template<class CharT, class Alloc>
+struct __hash_is_avalanching<seeded_hash<basic_string<CharT, Alloc> > > : public __avalanching_hash {};
+
+#endif // __STL_STRING_H
\ No newline at end of file
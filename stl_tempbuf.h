@@ -0,0 +1,42 @@
+#ifndef __STL_TEMPBUF_H
+#define __STL_TEMPBUF_H
+
+#include <cstddef>  // ptrdiff_t
+
+#include "stl_alloc.h"
+
+// 算法内部使用的临时缓冲区, 例如 stable_sort 的归并缓冲区
+// 空间从alloc配置, 小块直接取自内存池的自由链表, 不经过 operator new
+// 缓冲区只负责空间, 元素由使用者通过 uninitialized_copy 构造并负责析构
+
+template<class T, class Alloc = alloc>
+class temporary_buffer
+{
+private:
+    typedef simple_alloc<T, Alloc> data_allocator;
+
+    ptrdiff_t len;
+    T* buffer;
+
+    temporary_buffer(const temporary_buffer&);
+    temporary_buffer& operator=(const temporary_buffer&);
+
+public:
+    explicit temporary_buffer(ptrdiff_t n) : len(n > 0 ? n : 0), buffer(0)
+    {
+        if(len > 0)
+            buffer = data_allocator::allocate(len);
+    }
+
+    ~temporary_buffer()
+    {
+        if(buffer)
+            data_allocator::deallocate(buffer, len);
+    }
+
+    ptrdiff_t size() const  {   return len; }
+    T* begin()  {   return buffer;  }
+    T* end()    {   return buffer + len;    }
+};
+
+#endif // __STL_TEMPBUF_H
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <cstring> // memmove
 
+#include "stl_algobase.h"
+#include "stl_config.h"
 #include "stl_construct.h"
 #include "stl_iterator.h"
 #include "type_traits.h"
@@ -77,6 +79,7 @@ template <class InputIterator, class ForwardIterator>
 inline ForwardIterator 
 __uninitialized_copy_aux(InputIterator first, InputIterator last, ForwardIterator result, __true_type) 
 {
+    __STL_PERF_SCOPE("uninitialized_copy(POD)");
     return copy(first, last, result);
 }
 
@@ -84,6 +87,7 @@ template <class InputIterator, class ForwardIterator>
 ForwardIterator
 __uninitialized_copy_aux(InputIterator first, InputIterator last, ForwardIterator result, __false_type) 
 {
+    __STL_PERF_SCOPE("uninitialized_copy");
     ForwardIterator cur = result;
     while(first != last)
         construct(&*cur++, *first++);
@@ -106,13 +110,15 @@ inline ForwardIterator uninitialized_copy(InputIterator first, InputIterator las
 
 inline char* uninitialized_copy(const char* first, const char* last, char* result) 
 {
-    memmove(result, first, last - first);
+    if(first != last)
+        memmove(result, first, last - first);
     return result + (last - first);
 }
 
 inline wchar_t* uninitialized_copy(const wchar_t* first, const wchar_t* last, wchar_t* result) 
 {
-    memmove(result, first, sizeof(wchar_t) * (last - first));
+    if(first != last)
+        memmove(result, first, sizeof(wchar_t) * (last - first));
     return result + (last - first);
 }
 
@@ -0,0 +1,419 @@
+#ifndef __STL_VECTOR_H
+#define __STL_VECTOR_H
+
+#include "stl_alloc.h"
+#include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_iterator.h"
+#include "stl_uninitialized.h"
+
+// vector: 连续线性空间, 迭代器就是原生指针
+// 空间不足时配置原来两倍大小的新空间, 将原有元素复制过去, 再释放原空间
+// 元素的复制和填充都经过 uninitialized_copy / uninitialized_fill_n, POD类型直接memmove
+
+template<class T, class Alloc = alloc>
+class vector
+{
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+protected:
+    typedef simple_alloc<value_type, Alloc> data_allocator;
+
+    iterator start;             // 目前使用空间的头
+    iterator finish;            // 目前使用空间的尾
+    iterator end_of_storage;    // 目前可用空间的尾
+
+protected:
+    void deallocate()
+    {
+        if(start)
+            data_allocator::deallocate(start, end_of_storage - start);
+    }
+
+    iterator allocate_and_fill(size_type n, const T& x)
+    {
+        iterator result = data_allocator::allocate(n);
+        uninitialized_fill_n(result, n, x);
+        return result;
+    }
+
+    template<class ForwardIterator>
+    iterator allocate_and_copy(size_type n, ForwardIterator first, ForwardIterator last)
+    {
+        iterator result = data_allocator::allocate(n);
+        uninitialized_copy(first, last, result);
+        return result;
+    }
+
+    void fill_initialize(size_type n, const T& value)
+    {
+        start = allocate_and_fill(n, value);
+        finish = start + n;
+        end_of_storage = finish;
+    }
+
+    template<class InputIterator>
+    void range_initialize(InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        start = finish = end_of_storage = 0;
+        for(; first != last; ++first)
+            push_back(*first);
+    }
+
+    template<class ForwardIterator>
+    void range_initialize(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+    {
+        size_type n = distance(first, last);
+        start = allocate_and_copy(n, first, last);
+        finish = start + n;
+        end_of_storage = finish;
+    }
+
+    // 新的容量: 原来的两倍, 且至少容纳新增的n个元素
+    size_type next_capacity(size_type n) const
+    {
+        const size_type old_size = size();
+        return old_size + max(old_size, n);
+    }
+
+    void insert_aux(iterator position, const T& x);
+
+    template<class InputIterator>
+    void range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        for(; first != last; ++first)
+        {
+            position = insert(position, *first);
+            ++position;
+        }
+    }
+
+    template<class ForwardIterator>
+    void range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+    // 两个参数都是整数时区间模板比 (n, value) 的重载匹配得更好, 如 vector<long>(3, 7), 此时按 (n, value) 处理
+    template<class Integer>
+    void initialize_dispatch(Integer n, Integer value, __true_type) {   fill_initialize(size_type(n), T(value));    }
+
+    template<class InputIterator>
+    void initialize_dispatch(InputIterator first, InputIterator last, __false_type)
+    {
+        range_initialize(first, last, iterator_category(first));
+    }
+
+    template<class Integer>
+    void insert_dispatch(iterator position, Integer n, Integer x, __true_type)  {   insert(position, size_type(n), T(x));   }
+
+    template<class InputIterator>
+    void insert_dispatch(iterator position, InputIterator first, InputIterator last, __false_type)
+    {
+        range_insert(position, first, last, iterator_category(first));
+    }
+
+public:
+    vector() : start(0), finish(0), end_of_storage(0)   {}
+    vector(size_type n, const T& value) {   fill_initialize(n, value);  }
+    vector(int n, const T& value)       {   fill_initialize(n, value);  }
+    vector(long n, const T& value)      {   fill_initialize(n, value);  }
+    explicit vector(size_type n)        {   fill_initialize(n, T());    }
+
+    template<class InputIterator>
+    vector(InputIterator first, InputIterator last)
+    {
+        initialize_dispatch(first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    vector(const vector& x)
+    {
+        start = allocate_and_copy(x.size(), x.begin(), x.end());
+        finish = start + x.size();
+        end_of_storage = finish;
+    }
+
+    vector& operator=(const vector& x);
+
+    ~vector()
+    {
+        destroy(start, finish);
+        deallocate();
+    }
+
+public:
+    iterator begin()    {   return start;   }
+    iterator end()      {   return finish;  }
+    const_iterator begin() const    {   return start;   }
+    const_iterator end() const      {   return finish;  }
+
+    size_type size() const      {   return size_type(finish - start);   }
+    size_type max_size() const  {   return size_type(-1) / sizeof(T);   }
+    size_type capacity() const  {   return size_type(end_of_storage - start);   }
+    bool empty() const          {   return start == finish; }
+
+    reference operator[](size_type n)   {   return *(start + n);    }
+    const_reference operator[](size_type n) const   {   return *(start + n);    }
+
+    reference front()   {   return *start;  }
+    reference back()    {   return *(finish - 1);   }
+    const_reference front() const   {   return *start;  }
+    const_reference back() const    {   return *(finish - 1);   }
+
+    pointer data()  {   return start;   }
+    const_pointer data() const  {   return start;   }
+
+    void swap(vector& x)
+    {
+        ::swap(start, x.start);
+        ::swap(finish, x.finish);
+        ::swap(end_of_storage, x.end_of_storage);
+    }
+
+    void reserve(size_type n)
+    {
+        if(capacity() < n)
+        {
+            const size_type old_size = size();
+            iterator tmp = allocate_and_copy(n, start, finish);
+            destroy(start, finish);
+            deallocate();
+            start = tmp;
+            finish = tmp + old_size;
+            end_of_storage = start + n;
+        }
+    }
+
+public:
+    void push_back(const T& x)
+    {
+        if(finish != end_of_storage)
+        {
+            construct(finish, x);
+            ++finish;
+        }
+        else
+            insert_aux(end(), x);
+    }
+
+    void pop_back()
+    {
+        --finish;
+        destroy(finish);
+    }
+
+    iterator insert(iterator position, const T& x)
+    {
+        size_type n = position - begin();
+        if(finish != end_of_storage && position == end())
+        {
+            construct(finish, x);
+            ++finish;
+        }
+        else
+            insert_aux(position, x);
+        return begin() + n;
+    }
+
+    void insert(iterator position, size_type n, const T& x);
+    void insert(iterator position, int n, const T& x)   {   insert(position, (size_type)n, x);  }
+    void insert(iterator position, long n, const T& x)  {   insert(position, (size_type)n, x);  }
+
+    template<class InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last)
+    {
+        insert_dispatch(position, first, last, typename __is_integer<InputIterator>::type());
+    }
+
+    iterator erase(iterator position)
+    {
+        if(position + 1 != end())
+            copy(position + 1, finish, position);
+        --finish;
+        destroy(finish);
+        return position;
+    }
+
+    iterator erase(iterator first, iterator last)
+    {
+        iterator i = copy(last, finish, first);
+        destroy(i, finish);
+        finish = finish - (last - first);
+        return first;
+    }
+
+    void resize(size_type new_size, const T& x)
+    {
+        if(new_size < size())
+            erase(begin() + new_size, end());
+        else
+            insert(end(), new_size - size(), x);
+    }
+    void resize(size_type new_size) {   resize(new_size, T());  }
+
+    void clear()    {   erase(begin(), end());  }
+};
+
+template<class T, class Alloc>
+vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& x)
+{
+    if(&x != this)
+    {
+        const size_type xlen = x.size();
+        if(xlen > capacity())
+        {
+            iterator tmp = allocate_and_copy(xlen, x.begin(), x.end());
+            destroy(start, finish);
+            deallocate();
+            start = tmp;
+            end_of_storage = start + xlen;
+        }
+        else if(size() >= xlen)
+        {
+            iterator i = copy(x.begin(), x.end(), begin());
+            destroy(i, finish);
+        }
+        else
+        {
+            copy(x.begin(), x.begin() + size(), start);
+            uninitialized_copy(x.begin() + size(), x.end(), finish);
+        }
+        finish = start + xlen;
+    }
+    return *this;
+}
+
+template<class T, class Alloc>
+void vector<T, Alloc>::insert_aux(iterator position, const T& x)
+{
+    if(finish != end_of_storage)    // 还有备用空间
+    {
+        construct(finish, *(finish - 1));
+        ++finish;
+        T x_copy = x;
+        copy_backward(position, finish - 2, finish - 1);
+        *position = x_copy;
+    }
+    else    // 配置两倍大小的新空间
+    {
+        const size_type len = next_capacity(1);
+        iterator new_start = data_allocator::allocate(len);
+        iterator new_finish = uninitialized_copy(start, position, new_start);
+        construct(new_finish, x);
+        ++new_finish;
+        new_finish = uninitialized_copy(position, finish, new_finish);
+
+        destroy(begin(), end());
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + len;
+    }
+}
+
+template<class T, class Alloc>
+void vector<T, Alloc>::insert(iterator position, size_type n, const T& x)
+{
+    if(n == 0)
+        return;
+    if(size_type(end_of_storage - finish) >= n)
+    {
+        T x_copy = x;
+        const size_type elems_after = finish - position;
+        iterator old_finish = finish;
+        if(elems_after > n)
+        {
+            uninitialized_copy(finish - n, finish, finish);
+            finish += n;
+            copy_backward(position, old_finish - n, old_finish);
+            fill(position, position + n, x_copy);
+        }
+        else
+        {
+            uninitialized_fill_n(finish, n - elems_after, x_copy);
+            finish += n - elems_after;
+            uninitialized_copy(position, old_finish, finish);
+            finish += elems_after;
+            fill(position, old_finish, x_copy);
+        }
+    }
+    else
+    {
+        const size_type len = next_capacity(n);
+        iterator new_start = data_allocator::allocate(len);
+        iterator new_finish = uninitialized_copy(start, position, new_start);
+        new_finish = uninitialized_fill_n(new_finish, n, x);
+        new_finish = uninitialized_copy(position, finish, new_finish);
+
+        destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + len;
+    }
+}
+
+template<class T, class Alloc>
+template<class ForwardIterator>
+void vector<T, Alloc>::range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+{
+    if(first == last)
+        return;
+    size_type n = distance(first, last);
+    if(size_type(end_of_storage - finish) >= n)
+    {
+        const size_type elems_after = finish - position;
+        iterator old_finish = finish;
+        if(elems_after > n)
+        {
+            uninitialized_copy(finish - n, finish, finish);
+            finish += n;
+            copy_backward(position, old_finish - n, old_finish);
+            copy(first, last, position);
+        }
+        else
+        {
+            ForwardIterator mid = first;
+            advance(mid, elems_after);
+            uninitialized_copy(mid, last, finish);
+            finish += n - elems_after;
+            uninitialized_copy(position, old_finish, finish);
+            finish += elems_after;
+            copy(first, mid, position);
+        }
+    }
+    else
+    {
+        const size_type len = next_capacity(n);
+        iterator new_start = data_allocator::allocate(len);
+        iterator new_finish = uninitialized_copy(start, position, new_start);
+        new_finish = uninitialized_copy(first, last, new_finish);
+        new_finish = uninitialized_copy(position, finish, new_finish);
+
+        destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + len;
+    }
+}
+
+template<class T, class Alloc>
+inline bool operator==(const vector<T, Alloc>& x, const vector<T, Alloc>& y)
+{
+    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template<class T, class Alloc>
+inline bool operator<(const vector<T, Alloc>& x, const vector<T, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#endif // __STL_VECTOR_H
\ No newline at end of file
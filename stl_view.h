@@ -0,0 +1,371 @@
+#ifndef __STL_VIEW_H
+#define __STL_VIEW_H
+
+#include <cstddef>  // ptrdiff_t
+
+#include "stl_function.h"
+#include "stl_iterator.h"
+#include "stl_pair.h"
+
+// 惰性视图: transform, filter, take, zip, enumerate
+// 视图只保存底层区间的迭代器与函数对象, 不复制元素; 解引用视图的迭代器时才对元素调用函数对象
+// 多个视图叠加后, 对最外层视图的一次遍历就是对底层数据的一次遍历, 中间不产生临时缓冲区
+// 各层迭代器的操作都是内联的小函数, for_each / accumulate 展开后就是一个循环
+//
+//  // 所有正数的平方和, 只读一遍数据, 不分配内存
+//  range_view<...> r = view_transform(view_filter(v, bind2nd(greater<int>(), 0)), square());
+//  int s = accumulate(r.begin(), r.end(), 0);
+//
+// 连续的 view_transform 在编译期用 compose1 合成一个函数对象, 连续的 view_filter 合成一个谓词,
+// 叠加多层后迭代器也只有一层
+// 函数对象需要是可配接的(提供 result_type), 普通函数可以用 ptr_fun 包装
+// view_filter 之前的 view_transform 会在判断谓词与解引用时各计算一次
+
+// ========================================= range_view
+// 一对迭代器表示的区间, 所有视图都是 range_view, 可以作为其他视图的输入
+template<class Iterator>
+class range_view
+{
+public:
+    typedef Iterator iterator;
+    typedef Iterator const_iterator;
+    typedef typename iterator_traits<Iterator>::value_type value_type;
+    typedef typename iterator_traits<Iterator>::difference_type difference_type;
+
+private:
+    Iterator first;
+    Iterator last;
+
+public:
+    range_view()    {}
+    range_view(Iterator f, Iterator l) : first(f), last(l)  {}
+
+    iterator begin() const  {   return first;   }
+    iterator end() const    {   return last;    }
+    bool empty() const      {   return first == last;   }
+};
+
+template<class Iterator>
+inline range_view<Iterator> make_view(Iterator first, Iterator last)
+{
+    return range_view<Iterator>(first, last);
+}
+
+template<class Range>
+inline range_view<typename Range::const_iterator> make_view(const Range& r)
+{
+    return range_view<typename Range::const_iterator>(r.begin(), r.end());
+}
+
+// ========================================= transform
+// 解引用时返回 op(*current), 按值返回; 保持底层迭代器的类型(随机访问仍是随机访问)
+template<class Iterator, class Operation>
+struct __transform_iterator
+{
+    typedef __transform_iterator<Iterator, Operation> self;
+
+    typedef typename iterator_traits<Iterator>::iterator_category iterator_category;
+    typedef typename Operation::result_type value_type;
+    typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    typedef const value_type* pointer;
+    typedef value_type reference;
+
+    Iterator current;
+    Operation op;
+
+    __transform_iterator()  {}
+    __transform_iterator(Iterator x, const Operation& f) : current(x), op(f)    {}
+
+    bool operator==(const self& x) const    {   return current == x.current;    }
+    bool operator!=(const self& x) const    {   return current != x.current;    }
+    bool operator<(const self& x) const     {   return current < x.current; }
+
+    reference operator*() const {   return op(*current);    }
+    reference operator[](difference_type n) const   {   return op(current[n]);  }
+
+    self& operator++()
+    {
+        ++current;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++current;
+        return tmp;
+    }
+    self& operator--()
+    {
+        --current;
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        --current;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n)
+    {
+        current += n;
+        return *this;
+    }
+    self& operator-=(difference_type n)
+    {
+        current -= n;
+        return *this;
+    }
+    self operator+(difference_type n) const {   return self(current + n, op);   }
+    self operator-(difference_type n) const {   return self(current - n, op);   }
+    difference_type operator-(const self& x) const  {   return current - x.current; }
+};
+
+template<class Range, class Operation>
+inline range_view<__transform_iterator<typename Range::const_iterator, Operation> >
+view_transform(const Range& r, const Operation& op)
+{
+    typedef __transform_iterator<typename Range::const_iterator, Operation> iterator;
+    return range_view<iterator>(iterator(r.begin(), op), iterator(r.end(), op));
+}
+
+// transform 的 transform: 合成为 compose1(op, 内层的op)
+template<class Iterator, class Operation1, class Operation2>
+inline range_view<__transform_iterator<Iterator, unary_compose<Operation2, Operation1> > >
+view_transform(const range_view<__transform_iterator<Iterator, Operation1> >& r, const Operation2& op)
+{
+    typedef __transform_iterator<Iterator, unary_compose<Operation2, Operation1> > iterator;
+    unary_compose<Operation2, Operation1> f = compose1(op, r.begin().op);
+    return range_view<iterator>(iterator(r.begin().current, f), iterator(r.end().current, f));
+}
+
+// ========================================= filter
+// 只经过满足谓词的元素, ++ 时跳过不满足的元素, 需要知道底层区间的尾端
+template<class Iterator, class Predicate>
+struct __filter_iterator
+{
+    typedef __filter_iterator<Iterator, Predicate> self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef typename iterator_traits<Iterator>::value_type value_type;
+    typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    typedef typename iterator_traits<Iterator>::pointer pointer;
+    typedef typename iterator_traits<Iterator>::reference reference;
+
+    Iterator current;
+    Iterator last;
+    Predicate pred;
+
+    void satisfy()
+    {
+        while(current != last && !pred(*current))
+            ++current;
+    }
+
+    __filter_iterator() {}
+    __filter_iterator(Iterator x, Iterator l, const Predicate& p) : current(x), last(l), pred(p)
+    {
+        satisfy();
+    }
+
+    bool operator==(const self& x) const    {   return current == x.current;    }
+    bool operator!=(const self& x) const    {   return current != x.current;    }
+
+    reference operator*() const {   return *current;    }
+    pointer operator->() const  {   return &*current;   }
+
+    self& operator++()
+    {
+        ++current;
+        satisfy();
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+// 两个谓词都满足, 第一个不满足时不再计算第二个
+template<class Predicate1, class Predicate2>
+struct __and_predicate
+{
+    Predicate1 pred1;
+    Predicate2 pred2;
+
+    __and_predicate(const Predicate1& p1, const Predicate2& p2) : pred1(p1), pred2(p2)  {}
+
+    template<class T>
+    bool operator()(const T& x) const   {   return pred1(x) && pred2(x);    }
+};
+
+template<class Range, class Predicate>
+inline range_view<__filter_iterator<typename Range::const_iterator, Predicate> >
+view_filter(const Range& r, const Predicate& pred)
+{
+    typedef __filter_iterator<typename Range::const_iterator, Predicate> iterator;
+    return range_view<iterator>(iterator(r.begin(), r.end(), pred), iterator(r.end(), r.end(), pred));
+}
+
+// filter 的 filter: 合成为一个谓词, 迭代器只跳过一次
+template<class Iterator, class Predicate1, class Predicate2>
+inline range_view<__filter_iterator<Iterator, __and_predicate<Predicate1, Predicate2> > >
+view_filter(const range_view<__filter_iterator<Iterator, Predicate1> >& r, const Predicate2& pred)
+{
+    typedef __and_predicate<Predicate1, Predicate2> predicate;
+    typedef __filter_iterator<Iterator, predicate> iterator;
+    const Iterator last = r.end().current;
+    predicate p(r.begin().pred, pred);
+    // 内层的起点已经满足第一个谓词, 从它开始再检查合成的谓词
+    return range_view<iterator>(iterator(r.begin().current, last, p), iterator(last, last, p));
+}
+
+// ========================================= take
+// 最多n个元素; 剩余个数为0或到达底层区间的尾端时即为结束, 不需要预先计算区间长度
+template<class Iterator>
+struct __counted_iterator
+{
+    typedef __counted_iterator<Iterator> self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef typename iterator_traits<Iterator>::value_type value_type;
+    typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    typedef typename iterator_traits<Iterator>::pointer pointer;
+    typedef typename iterator_traits<Iterator>::reference reference;
+
+    Iterator current;
+    Iterator last;
+    difference_type count;  // 还可以经过的元素个数
+
+    __counted_iterator() : count(0) {}
+    __counted_iterator(Iterator x, Iterator l, difference_type n) : current(x), last(l), count(n)   {}
+
+    bool at_end() const {   return count == 0 || current == last;   }
+
+    bool operator==(const self& x) const
+    {
+        return at_end() ? x.at_end() : !x.at_end() && count == x.count;
+    }
+    bool operator!=(const self& x) const    {   return !(*this == x);   }
+
+    reference operator*() const {   return *current;    }
+    pointer operator->() const  {   return &*current;   }
+
+    self& operator++()
+    {
+        ++current;
+        --count;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+template<class Range>
+inline range_view<__counted_iterator<typename Range::const_iterator> >
+view_take(const Range& r, typename iterator_traits<typename Range::const_iterator>::difference_type n)
+{
+    typedef __counted_iterator<typename Range::const_iterator> iterator;
+    return range_view<iterator>(iterator(r.begin(), r.end(), n), iterator(r.end(), r.end(), 0));
+}
+
+// ========================================= zip
+// 同时遍历两个区间, 解引用得到 pair(*i1, *i2), 任一区间结束即结束
+template<class Iterator1, class Iterator2>
+struct __zip_iterator
+{
+    typedef __zip_iterator<Iterator1, Iterator2> self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef pair<typename iterator_traits<Iterator1>::value_type,
+                 typename iterator_traits<Iterator2>::value_type> value_type;
+    typedef typename iterator_traits<Iterator1>::difference_type difference_type;
+    typedef const value_type* pointer;
+    typedef value_type reference;
+
+    Iterator1 first;
+    Iterator2 second;
+
+    __zip_iterator()    {}
+    __zip_iterator(Iterator1 x, Iterator2 y) : first(x), second(y)  {}
+
+    // 尾端迭代器由两个区间的尾端组成, 任一分量相等即到达尾端
+    bool operator==(const self& x) const    {   return first == x.first || second == x.second;  }
+    bool operator!=(const self& x) const    {   return !(*this == x);   }
+
+    reference operator*() const {   return value_type(*first, *second); }
+
+    self& operator++()
+    {
+        ++first;
+        ++second;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+template<class Range1, class Range2>
+inline range_view<__zip_iterator<typename Range1::const_iterator, typename Range2::const_iterator> >
+view_zip(const Range1& r1, const Range2& r2)
+{
+    typedef __zip_iterator<typename Range1::const_iterator, typename Range2::const_iterator> iterator;
+    return range_view<iterator>(iterator(r1.begin(), r2.begin()), iterator(r1.end(), r2.end()));
+}
+
+// ========================================= enumerate
+// 解引用得到 pair(下标, *current), 下标从0开始
+template<class Iterator>
+struct __enumerate_iterator
+{
+    typedef __enumerate_iterator<Iterator> self;
+
+    typedef forward_iterator_tag iterator_category;
+    typedef typename iterator_traits<Iterator>::difference_type difference_type;
+    typedef pair<difference_type, typename iterator_traits<Iterator>::value_type> value_type;
+    typedef const value_type* pointer;
+    typedef value_type reference;
+
+    Iterator current;
+    difference_type index;
+
+    __enumerate_iterator() : index(0)   {}
+    __enumerate_iterator(Iterator x, difference_type i) : current(x), index(i)  {}
+
+    bool operator==(const self& x) const    {   return current == x.current;    }
+    bool operator!=(const self& x) const    {   return current != x.current;    }
+
+    reference operator*() const {   return value_type(index, *current); }
+
+    self& operator++()
+    {
+        ++current;
+        ++index;
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+template<class Range>
+inline range_view<__enumerate_iterator<typename Range::const_iterator> > view_enumerate(const Range& r)
+{
+    typedef __enumerate_iterator<typename Range::const_iterator> iterator;
+    return range_view<iterator>(iterator(r.begin(), 0), iterator(r.end(), 0));
+}
+
+#endif // __STL_VIEW_H
\ No newline at end of file
@@ -0,0 +1,343 @@
+#include "stl_algo.h"
+#include "stl_function.h"
+#include "stl_list.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// stl_algo.h 的测试文件, 测试 各种输入模式下的sort、partial_sort、nth_element、stable_sort的稳定性, 向量化的find、count、search与逐个比较的结果一致, 无分支的二分查找, galloping的merge与集合算法
+
+struct record
+{
+    int key;
+    int order;  // 原来的位置, 用于检查稳定性
+};
+
+struct record_less
+{
+    bool operator()(const record& x, const record& y) const {   return x.key < y.key;   }
+};
+
+// 生成各种模式的输入: 随机、有序、逆序、大量重复、锯齿、几乎有序
+static void make_input(vector<int>& v, int n, int pattern)
+{
+    v.clear();
+    for(int i = 0; i < n; ++i)
+    {
+        switch(pattern)
+        {
+        case 0: v.push_back(rand()); break;
+        case 1: v.push_back(i); break;
+        case 2: v.push_back(n - i); break;
+        case 3: v.push_back(rand() % 4); break;
+        case 4: v.push_back(i % 100); break;
+        default: v.push_back(i % 1000 == 0 ? rand() : i); break;
+        }
+    }
+}
+
+int main()
+{
+    srand(3);
+    int sizes[5] = {0, 1, 23, 500, 100000};
+    for(int s = 0; s < 5; ++s)
+    {
+        for(int pattern = 0; pattern < 6; ++pattern)
+        {
+            vector<int> v;
+            make_input(v, sizes[s], pattern);
+            vector<int> ref(v);
+            // 堆排序作为参照
+            make_heap(ref.begin(), ref.end());
+            sort_heap(ref.begin(), ref.end());
+
+            vector<int> a(v);
+            sort(a.begin(), a.end());
+            assert(a == ref);
+
+            a = v;
+            sort(a.begin(), a.end(), greater<int>());
+            assert(is_sorted(a.begin(), a.end(), greater<int>()));
+
+            a = v;
+            sort(a.begin(), a.end(), not2(greater_equal<int>()));
+            assert(a == ref);
+
+            a = v;
+            stable_sort(a.begin(), a.end());
+            assert(a == ref);
+
+            if(v.empty())
+                continue;
+            int k = sizes[s] / 3;
+            a = v;
+            nth_element(a.begin(), a.begin() + k, a.end());
+            assert(a[k] == ref[k]);
+            for(int i = 0; i < k; ++i)
+                assert(!(a[k] < a[i]));
+            for(int i = k + 1; i < sizes[s]; ++i)
+                assert(!(a[i] < a[k]));
+
+            a = v;
+            partial_sort(a.begin(), a.begin() + k, a.end());
+            for(int i = 0; i < k; ++i)
+                assert(a[i] == ref[i]);
+        }
+    }
+
+    // stable_sort 保持相等元素的原有顺序
+    vector<record> r;
+    for(int i = 0; i < 10000; ++i)
+    {
+        record x = {rand() % 50, i};
+        r.push_back(x);
+    }
+    stable_sort(r.begin(), r.end(), record_less());
+    for(size_t i = 1; i < r.size(); ++i)
+        assert(r[i - 1].key < r[i].key || (r[i - 1].key == r[i].key && r[i - 1].order < r[i].order));
+
+    // 基数排序: 有符号整数、64位整数、浮点数、降序、按select1st排序的记录
+    vector<long long> ll;
+    vector<double> d;
+    vector<short> sh;
+    for(int i = 0; i < 5000; ++i)
+    {
+        ll.push_back((long long)((unsigned long long)rand() << 33 ^ (unsigned long long)rand()));
+        d.push_back((rand() - RAND_MAX / 2) / 7.0);
+        sh.push_back((short)rand());
+    }
+    d.push_back(-0.0);
+    d.push_back(0.0);
+    sort(ll.begin(), ll.end());
+    assert(is_sorted(ll.begin(), ll.end()));
+    sort(ll.begin(), ll.end(), greater<long long>());
+    assert(is_sorted(ll.begin(), ll.end(), greater<long long>()));
+    radix_sort(d.begin(), d.end());
+    assert(is_sorted(d.begin(), d.end()));
+    radix_sort(sh.begin(), sh.end(), greater<short>());
+    assert(is_sorted(sh.begin(), sh.end(), greater<short>()));
+
+    vector<pair<int, int> > pr;
+    for(int i = 0; i < 3000; ++i)
+        pr.push_back(pair<int, int>(rand() % 100 - 50, i));
+    radix_sort(pr.begin(), pr.end(), select1st<pair<int, int> >());
+    for(size_t i = 1; i < pr.size(); ++i)
+        assert(pr[i - 1].first < pr[i].first || (pr[i - 1].first == pr[i].first && pr[i - 1].second < pr[i].second));
+
+    // find / count / search: 各种长度与匹配位置, 与逐个比较的结果一致
+    for(int n = 0; n < 300; n += 7)
+    {
+        vector<char> text;
+        vector<int> nums;
+        for(int i = 0; i < n; ++i)
+        {
+            text.push_back(char('a' + rand() % 3));
+            nums.push_back(rand() % 5 - 2);
+        }
+        list<char> ltext(text.begin(), text.end());
+        const char* t = text.data();
+        for(char c = 'a'; c <= 'd'; ++c)
+        {
+            assert(find(t, t + n, c) - t == distance(ltext.begin(), find(ltext.begin(), ltext.end(), c)));
+            assert(find_if(text.begin(), text.end(), bind2nd(equal_to<char>(), c)) == find(text.begin(), text.end(), c));
+            assert(count(t, t + n, c) == count(ltext.begin(), ltext.end(), c));
+        }
+        for(int x = -3; x <= 3; ++x)
+        {
+            int expect = 0;
+            while(expect < n && nums[expect] != x)
+                ++expect;
+            assert(find(nums.begin(), nums.end(), x) - nums.begin() == expect);
+            assert(find_if(nums.begin(), nums.end(), bind1st(equal_to<int>(), x)) - nums.begin() == expect);
+            assert(count(nums.begin(), nums.end(), x) == count_if(nums.begin(), nums.end(), bind2nd(equal_to<int>(), x)));
+        }
+        // 模式串取自文本本身(一定出现)或随机生成, 长度覆盖向量过滤与 Horspool 两种情况
+        for(int len = 0; len <= 40 && len <= n; len += 3)
+        {
+            for(int k = 0; k < 2; ++k)
+            {
+                vector<char> pat;
+                int from = rand() % (n - len + 1);
+                for(int i = 0; i < len; ++i)
+                    pat.push_back(k ? char('a' + rand() % 3) : text[from + i]);
+                list<char> lpat(pat.begin(), pat.end());
+                int expect = distance(ltext.begin(), search(ltext.begin(), ltext.end(), lpat.begin(), lpat.end()));
+                assert(search(t, t + n, pat.begin(), pat.end()) - t == expect);
+                assert(search(text.begin(), text.end(), pat.begin(), pat.end(), equal_to<char>()) - text.begin() == expect);
+                if(k == 0)
+                    assert(expect <= from);
+            }
+            vector<int> ipat(nums.begin() + n / 2, nums.begin() + n / 2 + len / 2);
+            int* found = search(nums.begin(), nums.end(), ipat.begin(), ipat.end());
+            assert(found - nums.begin() <= n / 2);
+            assert(equal(ipat.begin(), ipat.end(), found));
+        }
+    }
+    // equal_to<T> 先把元素转换为 T 再比较, 元素类型不同时与 find 的结果不同
+    {
+        double d[3] = {2.5, 1.5, 1.0};
+        list<double> ld(d, d + 3);
+        assert(find_if(d, d + 3, bind2nd(equal_to<int>(), 1)) == d + 1 && find(d, d + 3, 1) == d + 2);
+        assert(find_if(ld.begin(), ld.end(), bind1st(equal_to<int>(), 2)) == ld.begin());
+        assert(find_if(d, d + 3, bind2nd(equal_to<double>(), 1.0)) == d + 2);
+    }
+    printf("find / count / search ok\n");
+
+    // 二分查找: 随机访问迭代器(无分支版本)与双向迭代器的结果一致
+    for(int n = 0; n < 200; n += 3)
+    {
+        vector<int> v;
+        for(int i = 0; i < n; ++i)
+            v.push_back(rand() % 50);
+        sort(v.begin(), v.end());
+        list<int> l(v.begin(), v.end());
+        for(int x = -1; x <= 51; ++x)
+        {
+            vector<int>::iterator lb = lower_bound(v.begin(), v.end(), x);
+            assert(lb - v.begin() == distance(l.begin(), lower_bound(l.begin(), l.end(), x)));
+            assert(lb == v.end() || *lb >= x);
+            assert(lb == v.begin() || *(lb - 1) < x);
+            vector<int>::iterator ub = upper_bound(v.begin(), v.end(), x);
+            assert(ub - v.begin() == distance(l.begin(), upper_bound(l.begin(), l.end(), x)));
+            assert(ub - lb == count(v.begin(), v.end(), x));
+            pair<vector<int>::iterator, vector<int>::iterator> r = equal_range(v.begin(), v.end(), x);
+            assert(r.first == lb && r.second == ub);
+            assert(binary_search(v.begin(), v.end(), x) == (lb != ub));
+            // 降序
+            vector<int> rv;
+            for(int i = n - 1; i >= 0; --i)
+                rv.push_back(v[i]);
+            assert(lower_bound(rv.begin(), rv.end(), x, greater<int>()) - rv.begin() == v.end() - ub);
+            assert(upper_bound(rv.begin(), rv.end(), x, greater<int>()) - rv.begin() == v.end() - lb);
+        }
+    }
+
+    // value 与元素类型不同时直接比较, 不转换为元素类型
+    {
+        int a[4] = {1, 2, 3, 4};
+        list<int> la(a, a + 4);
+        assert(lower_bound(a, a + 4, 2.5) == a + 2 && upper_bound(a, a + 4, 2.5) == a + 2);
+        assert(distance(la.begin(), lower_bound(la.begin(), la.end(), 2.5)) == 2);
+        assert(distance(la.begin(), upper_bound(la.begin(), la.end(), 2.5)) == 2);
+        assert(equal_range(a, a + 4, 2.5).first == equal_range(a, a + 4, 2.5).second);
+        assert(!binary_search(a, a + 4, 2.5) && binary_search(a, a + 4, 3.0));
+    }
+    printf("binary search ok\n");
+
+    // merge / 集合算法: 随机访问区间(galloping)与链表(逐个比较)的结果一致, 包括长度相差悬殊的区间
+    int pair_sizes[][2] = {{0, 0}, {0, 9}, {5, 0}, {40, 37}, {3, 5000}, {5000, 2}, {300, 300}, {1, 1000}};
+    for(int k = 0; k < 8; ++k)
+    {
+        for(int range = 3; range <= 100000; range *= 10)
+        {
+            vector<int> x, y;
+            for(int i = 0; i < pair_sizes[k][0]; ++i)
+                x.push_back(rand() % range);
+            for(int i = 0; i < pair_sizes[k][1]; ++i)
+                y.push_back(rand() % range);
+            sort(x.begin(), x.end());
+            sort(y.begin(), y.end());
+            list<int> lx(x.begin(), x.end()), ly(y.begin(), y.end());
+            vector<int> r1(x.size() + y.size()), r2(x.size() + y.size());
+
+            int* e1 = merge(x.begin(), x.end(), y.begin(), y.end(), r1.begin());
+            int* e2 = merge(lx.begin(), lx.end(), ly.begin(), ly.end(), r2.begin());
+            assert(e1 - r1.begin() == e2 - r2.begin() && r1 == r2 && is_sorted(r1.begin(), r1.end()));
+
+            e1 = set_union(x.begin(), x.end(), y.begin(), y.end(), r1.begin());
+            e2 = set_union(lx.begin(), lx.end(), ly.begin(), ly.end(), r2.begin());
+            assert(e1 - r1.begin() == e2 - r2.begin() && equal(r1.begin(), e1, r2.begin()));
+
+            e1 = set_intersection(x.begin(), x.end(), y.begin(), y.end(), r1.begin());
+            e2 = set_intersection(lx.begin(), lx.end(), ly.begin(), ly.end(), r2.begin());
+            assert(e1 - r1.begin() == e2 - r2.begin() && equal(r1.begin(), e1, r2.begin()));
+
+            e1 = set_difference(x.begin(), x.end(), y.begin(), y.end(), r1.begin());
+            e2 = set_difference(lx.begin(), lx.end(), ly.begin(), ly.end(), r2.begin());
+            assert(e1 - r1.begin() == e2 - r2.begin() && equal(r1.begin(), e1, r2.begin()));
+
+            assert(includes(x.begin(), x.end(), y.begin(), y.end()) == includes(lx.begin(), lx.end(), ly.begin(), ly.end()));
+            vector<int> sub;
+            for(size_t i = 0; i < x.size(); i += 3)
+                sub.push_back(x[i]);
+            assert(includes(x.begin(), x.end(), sub.begin(), sub.end()));
+
+            // inplace_merge: 左右两半分别有序
+            vector<int> z(x);
+            z.insert(z.end(), y.begin(), y.end());
+            inplace_merge(z.begin(), z.begin() + x.size(), z.end());
+            merge(x.begin(), x.end(), y.begin(), y.end(), r1.begin());
+            assert(z == r1);
+        }
+    }
+    // inplace_merge 的稳定性, 两种缓冲方向
+    for(int left = 1; left < 60; left += 11)
+    {
+        vector<record> recs;
+        for(int i = 0; i < left; ++i)
+        {
+            record r = {i / 3, i};
+            recs.push_back(r);
+        }
+        for(int i = 0; i < 60 - left; ++i)
+        {
+            record r = {i / 4, 100 + i};
+            recs.push_back(r);
+        }
+        inplace_merge(recs.begin(), recs.begin() + left, recs.end(), record_less());
+        for(size_t i = 1; i < recs.size(); ++i)
+            assert(recs[i - 1].key < recs[i].key || (recs[i - 1].key == recs[i].key && recs[i - 1].order < recs[i].order));
+    }
+    // 双向迭代器的 inplace_merge: 逐个比较, 两种缓冲方向
+    for(int left = 0; left <= 40; left += 5)
+    {
+        list<record> l;
+        for(int i = 0; i < left; ++i)
+        {
+            record r = {i / 2, i};
+            l.push_back(r);
+        }
+        for(int i = 0; i < 40 - left; ++i)
+        {
+            record r = {i / 3, 100 + i};
+            l.push_back(r);
+        }
+        list<record>::iterator mid = l.begin();
+        advance(mid, left);
+        inplace_merge(l.begin(), mid, l.end(), record_less());
+        assert(l.size() == 40);
+        list<record>::iterator prev = l.begin(), cur = prev;
+        for(++cur; cur != l.end(); ++prev, ++cur)
+            assert(prev->key < cur->key || (prev->key == cur->key && prev->order < cur->order));
+    }
+    // 两个区间的元素类型不同时直接比较, 不把第二个区间的元素转换为第一个区间的类型
+    {
+        int xi[4] = {-1, 1, 2, 3};
+        double yd[2] = {-1.5, 2.5};
+        list<int> lxi(xi, xi + 4);
+        list<double> lyd(yd, yd + 2);
+        double out[6], lout[6];
+        double merged[6] = {-1.5, -1, 1, 2, 2.5, 3};
+        assert(merge(xi, xi + 4, yd, yd + 2, out) == out + 6 && equal(out, out + 6, merged));
+        assert(merge(lxi.begin(), lxi.end(), lyd.begin(), lyd.end(), lout) == lout + 6 && equal(lout, lout + 6, merged));
+        assert(set_union(xi, xi + 4, yd, yd + 2, out) == out + 6 && equal(out, out + 6, merged));
+        assert(set_union(lxi.begin(), lxi.end(), lyd.begin(), lyd.end(), lout) == lout + 6);
+        assert(set_intersection(xi, xi + 4, yd, yd + 2, out) == out);
+        assert(set_intersection(lxi.begin(), lxi.end(), lyd.begin(), lyd.end(), lout) == lout);
+        assert(set_difference(xi, xi + 4, yd, yd + 2, out) == out + 4 && equal(xi, xi + 4, out));
+        assert(set_difference(lxi.begin(), lxi.end(), lyd.begin(), lyd.end(), lout) == lout + 4);
+        assert(!includes(xi, xi + 4, yd + 1, yd + 2));
+        assert(!includes(lxi.begin(), lxi.end(), ++lyd.begin(), lyd.end()));
+    }
+    printf("merge / set ok\n");
+
+    int a[10] = {5, 3, 8, 1, 9, 2, 7, 4, 6, 0};
+    sort(a, a + 10);
+    for(int i = 0; i < 10; ++i)
+        printf("%d ", a[i]);
+    printf("\n");
+    printf("sort ok\n");
+
+    return 0;
+}
\ No newline at end of file
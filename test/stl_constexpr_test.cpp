@@ -0,0 +1,96 @@
+#include "stl_algo.h"
+#include "stl_function.h"
+#include "stl_heap.h"
+#include "stl_numeric.h"
+#include "stl_pair.h"
+#include <cassert>
+#include <cstdio>
+
+// constexpr 的测试文件, 测试 函数对象、适配器、pair、min/max 在C++11的常量表达式中可用,
+// C++14起 distance/advance、find/count、二分查找、堆与排序、accumulate/iota 可以在编译期执行, 且与运行期的结果一致
+
+// ========================================= C++11
+static_assert(plus<int>()(2, 3) == 5, "plus");
+static_assert(negate<int>()(4) == -4, "negate");
+static_assert(identity_element(multiplies<int>()) == 1, "identity_element");
+static_assert(not1(bind2nd(less<int>(), 3))(5), "not1 bind2nd");
+static_assert(bind1st(minus<int>(), 10)(4) == 6, "bind1st");
+static_assert(compose1(negate<int>(), bind2nd(multiplies<int>(), 3))(2) == -6, "compose1");
+static_assert(compose2(logical_and<bool>(), bind2nd(greater<int>(), 0), bind2nd(less<int>(), 10))(5), "compose2");
+static_assert(not2(less<int>())(3, 3), "not2");
+
+static_assert(make_pair(1, 2) < make_pair(1, 3), "pair <");
+static_assert(make_pair(1, 2) == pair<int, int>(1, 2), "pair ==");
+static_assert(select2nd<pair<int, char> >()(make_pair(1, 'x')) == 'x', "select2nd");
+static_assert(min(3, 4) == 3 && max(3, 4, greater<int>()) == 3, "min / max");
+
+#if __cplusplus >= 201402L
+// ========================================= C++14
+constexpr int sorted_copy(int i)
+{
+    int a[9] = {5, 3, 8, 1, 9, 2, 7, 4, 6};
+    sort(a, a + 9);
+    return a[i];
+}
+static_assert(sorted_copy(0) == 1 && sorted_copy(4) == 5 && sorted_copy(8) == 9, "sort");
+
+constexpr bool sort_descending()
+{
+    int a[6] = {2, 6, 1, 5, 3, 4};
+    sort(a, a + 6, greater<int>());
+    return is_sorted(a, a + 6, greater<int>()) && a[0] == 6;
+}
+static_assert(sort_descending(), "sort greater");
+
+constexpr bool heap_ops()
+{
+    int a[7] = {4, 1, 7, 3, 6, 2, 5};
+    make_heap(a, a + 7);
+    if(!is_heap(a, a + 7) || a[0] != 7)
+        return false;
+    pop_heap(a, a + 7);
+    return a[6] == 7 && a[0] == 6;
+}
+static_assert(heap_ops(), "heap");
+
+constexpr bool search_ops()
+{
+    int a[8] = {0};
+    iota(a, a + 8, 10);
+    const int* lo = lower_bound(a, a + 8, 13);
+    const int* hi = upper_bound(a, a + 8, 13);
+    pair<int*, int*> range = equal_range(a, a + 8, 20);
+    return *lo == 13 && hi - lo == 1 && range.first == range.second && binary_search(a, a + 8, 17)
+        && find(a, a + 8, 15) - a == 5 && count(a, a + 8, 11) == 1
+        && find_if(a, a + 8, bind2nd(greater<int>(), 15)) - a == 6
+        && count_if(a, a + 8, bind2nd(modulus<int>(), 2)) == 4;
+}
+static_assert(search_ops(), "find / count / binary search");
+
+constexpr int sum_and_product()
+{
+    char s[5] = {'a', 'b', 'c', 'b', 'a'};
+    int v[5] = {1, 2, 3, 4, 5};
+    const char* p = s + 1;
+    advance(p, 2);
+    return accumulate(v, v + 5, 0) * 1000 + accumulate(v, v + 5, 1, multiplies<int>())
+         + int(count(s, s + 5, 'b')) * 100000 + int(distance(static_cast<const char*>(s), p)) * 1000000;
+}
+static_assert(sum_and_product() == 3 * 1000000 + 2 * 100000 + 15 * 1000 + 120, "accumulate / distance / advance");
+#endif
+
+int main()
+{
+    // 同样的调用在运行期走向量化与基数排序的路径, 结果相同
+    int a[9] = {5, 3, 8, 1, 9, 2, 7, 4, 6};
+    sort(a, a + 9);
+    for(int i = 0; i < 9; ++i)
+        assert(a[i] == i + 1);
+    assert(accumulate(a, a + 9, 0) == 45);
+    assert(*lower_bound(a, a + 9, 4) == 4);
+    char s[5] = {'a', 'b', 'c', 'b', 'a'};
+    assert(count(s, s + 5, 'b') == 2);
+    assert(find(s, s + 5, 'c') == s + 2);
+    printf("constexpr ok\n");
+    return 0;
+}
\ No newline at end of file
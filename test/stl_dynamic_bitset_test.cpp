@@ -0,0 +1,119 @@
+#include "stl_dynamic_bitset.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// stl_dynamic_bitset.h 的测试文件, 测试 单个位的读写, count 与参照模型一致(覆盖 AVX2 的整块与剩余部分),
+// find_first / find_next 与遍历为1的位, 集合运算与 combine 的整字及逐位版本, resize 与 push_back 时末尾多余的位为0
+
+struct collect
+{
+    vector<size_t>* out;
+    void operator()(size_t i) const {   out->push_back(i);  }
+};
+
+// 逐位的函数对象, 走 combine 的通用版本
+struct implies
+{
+    bool operator()(bool x, bool y) const   {   return !x || y; }
+};
+
+static size_t naive_count(const vector<bool>& v)
+{
+    size_t n = 0;
+    for(size_t i = 0; i < v.size(); ++i)
+        n += v[i];
+    return n;
+}
+
+int main()
+{
+    // 单个位
+    dynamic_bitset<> b(130);
+    assert(b.size() == 130 && b.num_blocks() == 3 && b.none() && b.count() == 0);
+    b.set(0).set(64).set(129);
+    assert(b.test(0) && b[64] && b.test(129) && !b.test(1) && b.count() == 3);
+    b.reset(64).flip(1).set(5, true).set(0, false);
+    assert(!b.test(0) && b.test(1) && b.test(5) && !b.test(64) && b.count() == 3);
+    b.flip();
+    assert(b.count() == 127 && !b.test(1));
+    b.set();
+    assert(b.all() && b.count() == 130);
+    b.reset();
+    assert(b.none());
+
+    // 随机内容: count、find、遍历与参照模型比较; 长度覆盖 0 ~ 1100 位
+    srand(7);
+    for(size_t n = 0; n < 1100; n += 37)
+    {
+        dynamic_bitset<> r(n);
+        vector<bool> model(n, false);
+        for(size_t i = 0; i < n; ++i)
+            if(rand() % 7 == 0)
+            {
+                r.set(i);
+                model[i] = true;
+            }
+        assert(r.count() == naive_count(model));
+
+        vector<size_t> expected;
+        for(size_t i = 0; i < n; ++i)
+            if(model[i])
+                expected.push_back(i);
+        vector<size_t> found;
+        for(size_t i = r.find_first(); i != dynamic_bitset<>::npos; i = r.find_next(i))
+            found.push_back(i);
+        assert(found == expected);
+        vector<size_t> iterated;
+        for(dynamic_bitset<>::set_iterator it = r.begin_set(); it != r.end_set(); ++it)
+            iterated.push_back(*it);
+        assert(iterated == expected);
+        vector<size_t> visited;
+        collect c = {&visited};
+        r.for_each_set(c);
+        assert(visited == expected);
+    }
+    printf("count / find ok\n");
+
+    // 集合运算
+    dynamic_bitset<> x(200), y(200);
+    for(size_t i = 0; i < 200; i += 2)
+        x.set(i);
+    for(size_t i = 0; i < 200; i += 3)
+        y.set(i);
+    assert((x & y).count() == 34 && (x | y).count() == 133 && (x ^ y).count() == 99 && (x - y).count() == 66);
+    assert((x & y).is_subset_of(x) && !x.is_subset_of(y) && x.intersects(y));
+
+    // combine: 逻辑运算映射到整字运算, 同或之后末尾多余的位仍为0
+    dynamic_bitset<> z = x;
+    assert(z.combine(y, logical_and<bool>()) == (x & y));
+    z = x;
+    assert(z.combine(y, logical_or<bool>()) == (x | y));
+    z = x;
+    assert(z.combine(y, not_equal_to<bool>()) == (x ^ y));
+    z = x;
+    z.combine(y, equal_to<bool>());
+    assert(z.count() == 200 - (x ^ y).count());
+    z = x;
+    z.combine(y, implies());
+    assert(z.count() == 200 - (x - y).count());
+    printf("combine ok\n");
+
+    // resize、push_back: 新增位的值, 以及缩短后再增长时原来的位不会复活
+    dynamic_bitset<> g(10, true);
+    assert(g.count() == 10);
+    g.resize(100, true);
+    assert(g.count() == 100 && g.num_blocks() == 2);
+    g.resize(70);
+    g.resize(200);
+    assert(g.count() == 70 && g.find_next(69) == dynamic_bitset<>::npos);
+    dynamic_bitset<> p;
+    for(int i = 0; i < 1000; ++i)
+        p.push_back(i % 5 == 0);
+    assert(p.size() == 1000 && p.count() == 200 && p.test(995) && !p.test(996));
+    swap(p, g);
+    assert(p.size() == 200 && g.size() == 1000);
+    printf("resize ok\n");
+    return 0;
+}
\ No newline at end of file
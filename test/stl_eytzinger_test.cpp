@@ -0,0 +1,110 @@
+#include "stl_algo.h"
+#include "stl_eytzinger.h"
+#include "stl_function.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// eytzinger_index 的测试文件, 测试 各种大小下的查找结果与有序数组上的 lower_bound / upper_bound 一致、降序比较、复制
+
+// 复制到第 throw_after 次时抛出异常, 负数表示不抛出; alive 为存活的对象个数
+static int throw_after = -1;
+static int alive = 0;
+
+struct throwing
+{
+    int value;
+    throwing(int v) : value(v)  {   ++alive;    }
+    throwing(const throwing& x) : value(x.value)
+    {
+        if(throw_after >= 0 && throw_after-- == 0)
+            throw 1;
+        ++alive;
+    }
+    ~throwing() {   --alive;    }
+    bool operator<(const throwing& x) const {   return value < x.value; }
+};
+
+int main()
+{
+    for(int n = 0; n < 600; n += (n < 40 ? 1 : 37))
+    {
+        vector<int> v;
+        for(int i = 0; i < n; ++i)
+            v.push_back(rand() % (n + 1) * 2);
+        sort(v.begin(), v.end());
+        eytzinger_index<int> idx(v.begin(), v.end());
+        assert(int(idx.size()) == n);
+        // 层序排列后的元素与原数组相同
+        vector<int> w(idx.begin(), idx.end());
+        sort(w.begin(), w.end());
+        assert(w == v);
+
+        for(int x = -1; x <= 2 * n + 2; ++x)
+        {
+            vector<int>::iterator lb = lower_bound(v.begin(), v.end(), x);
+            vector<int>::iterator ub = upper_bound(v.begin(), v.end(), x);
+            eytzinger_index<int>::const_iterator i = idx.lower_bound(x);
+            eytzinger_index<int>::const_iterator j = idx.upper_bound(x);
+            assert(lb == v.end() ? i == idx.end() : *i == *lb);
+            assert(ub == v.end() ? j == idx.end() : *j == *ub);
+            assert(idx.contains(x) == binary_search(v.begin(), v.end(), x));
+        }
+    }
+
+    // 降序
+    double d[6] = {9.5, 7.0, 7.0, 3.25, 1.0, -2.0};
+    eytzinger_index<double, greater<double> > desc(d, d + 6);
+    assert(*desc.lower_bound(7.0) == 7.0 && *desc.upper_bound(7.0) == 3.25);
+    assert(desc.lower_bound(-3.0) == desc.end() && *desc.lower_bound(100.0) == 9.5);
+
+    eytzinger_index<double, greater<double> > copy(desc);
+    eytzinger_index<double, greater<double> > empty;
+    assert(empty.find(1.0) == empty.end());
+    empty = copy;
+    assert(empty.size() == 6 && empty.contains(3.25) && !empty.contains(3.0));
+
+    // 构造元素时抛出异常, 已构造的元素被析构, 空间被归还
+    {
+        vector<throwing> src;
+        for(int i = 0; i < 20; ++i)
+            src.push_back(throwing(i));
+        for(int k = 0; k < 20; k += 3)
+        {
+            bool thrown = false;
+            throw_after = k;
+            try
+            {
+                eytzinger_index<throwing, less<throwing>, malloc_alloc> bad(src.begin(), src.end());
+            }
+            catch(int)
+            {
+                thrown = true;
+            }
+            assert(thrown && alive == 20);
+        }
+        throw_after = -1;
+        eytzinger_index<throwing, less<throwing>, malloc_alloc> good(src.begin(), src.end());
+        assert(alive == 40 && good.contains(throwing(7)));
+        for(int k = 0; k < 20; k += 3)
+        {
+            bool thrown = false;
+            throw_after = k;
+            try
+            {
+                eytzinger_index<throwing, less<throwing>, malloc_alloc> bad(good);
+            }
+            catch(int)
+            {
+                thrown = true;
+            }
+            assert(thrown && alive == 40);
+        }
+        throw_after = -1;
+    }
+    assert(alive == 0);
+    printf("eytzinger ok\n");
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "stl_flat_map.h"
+#include "stl_flat_set.h"
+#include "stl_set.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// flat_map / flat_set 的测试文件, 测试 批量插入的排序去重与归并、单个插入删除、pair的type_traits
+
+static bool is_true(__true_type)    {   return true;    }
+static bool is_true(__false_type)   {   return false;   }
+
+int main()
+{
+    // 批量插入: 乱序且有重复, 部分键已经存在
+    int a[10] = {5, 3, 8, 1, 9, 3, 7, 5, 6, 0};
+    flat_set<int> s(a, a + 10);
+    assert(s.size() == 8);
+    int b[6] = {4, 2, 9, 11, 2, -1};
+    s.insert(b, b + 6);
+    for(flat_set<int>::iterator it = s.begin(); it != s.end(); ++it)
+        printf("%d ", *it);
+    printf("\n");
+    assert(s.size() == 12 && *s.begin() == -1 && *(s.end() - 1) == 11);
+    for(int i = 0; i < 10; ++i)
+        assert(s.count(i) == 1);
+
+    // 随机批量插入与删除, 与B树实现的set对照
+    flat_set<int> fs;
+    set<int> ref;
+    srand(2);
+    for(int round = 0; round < 200; ++round)
+    {
+        vector<int> batch;
+        int k = rand() % 50;
+        for(int i = 0; i < k; ++i)
+            batch.push_back(rand() % 2000);
+        fs.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+        int x = rand() % 2000;
+        assert(fs.erase(x) == ref.erase(x));
+        assert(fs.insert(x).second == ref.insert(x).second);
+        x = rand() % 2000;
+        assert(fs.erase(x) == ref.erase(x));
+    }
+    assert(fs.size() == ref.size());
+    set<int>::iterator ri = ref.begin();
+    for(flat_set<int>::iterator it = fs.begin(); it != fs.end(); ++it, ++ri)
+        assert(*it == *ri);
+
+    // flat_map
+    flat_map<int, int> m;
+    for(int i = 0; i < 10; ++i)
+        m[a[i]] += 1;
+    assert(m.size() == 8 && m[3] == 2 && m[5] == 2 && m[0] == 1);
+    pair<int, int> p[3] = {pair<int, int>(3, 100), pair<int, int>(42, 1), pair<int, int>(-5, 1)};
+    m.insert(p, p + 3);
+    assert(m.size() == 10 && m[3] == 2 && m.begin()->first == -5 && (m.end() - 1)->first == 42);
+    assert(m.find(4) == m.end() && m.find(42)->second == 1);
+    m.erase(m.find(42));
+    assert(m.lower_bound(10) == m.end());
+
+    // pair<int, int> 是POD, 复制和搬移直接memmove
+    assert(is_true(__type_traits<pair<int, int> >::is_POD_type()));
+    assert(!is_true(__type_traits<pair<int, vector<int> > >::is_POD_type()));
+    printf("flat_map ok\n");
+
+    return 0;
+}
\ No newline at end of file
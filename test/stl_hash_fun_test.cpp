@@ -0,0 +1,124 @@
+#include "stl_hash_fun.h"
+#include "stl_hash_map.h"
+#include "stl_hash_set.h"
+#include "stl_string.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// stl_hash_fun.h 的测试文件, 测试 整数散列的雪崩效果与低位分布, 各种长度的字节串互不碰撞且与地址无关,
+// seeded_hash 的种子, 以及 hashtable 对已打散的散列值不再打散
+
+struct str_equal
+{
+    bool operator()(const char* a, const char* b) const {   return strcmp(a, b) == 0;   }
+};
+
+struct identity_hash
+{
+    size_t operator()(int x) const  {   return size_t(x);   }
+};
+
+// 用户为自己的类型特化的 hash, 只用到低位
+struct point
+{
+    int x, y;
+    bool operator==(const point& p) const   {   return x == p.x && y == p.y;    }
+};
+
+template<>
+struct hash<point>
+{
+    size_t operator()(const point& p) const {   return size_t(p.x) * 31 + size_t(p.y);  }
+};
+
+static bool is_true(__true_type)     {   return true;    }
+static bool is_true(__false_type)    {   return false;   }
+
+static int popcount64(unsigned long long x)
+{
+    return __builtin_popcountll(x);
+}
+
+int main()
+{
+    // 翻转输入的任意一位, 输出平均约一半的位发生变化
+    hash<unsigned long long> hu;
+    unsigned long long x = 0x123456789abcdefULL;
+    long flips = 0, trials = 0;
+    for(int i = 0; i < 1000; ++i)
+    {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        for(int bit = 0; bit < 64; ++bit, ++trials)
+            flips += popcount64((unsigned long long)hu(x) ^ (unsigned long long)hu(x ^ (1ULL << bit)));
+    }
+    double average = double(flips) / double(trials);
+    printf("average flipped bits = %.2f\n", average);
+    assert(average > 28 && average < 36);
+
+    // 连续的整数在低7位(hashtable的h2)上均匀分布
+    int buckets[128] = {0};
+    hash<int> hi;
+    for(int i = 0; i < 128 * 100; ++i)
+        ++buckets[hi(i) & 0x7f];
+    for(int b = 0; b < 128; ++b)
+        assert(buckets[b] > 50 && buckets[b] < 150);
+    assert(hash<long>()(-1) == hash<long long>()(-1));
+    int obj[2];
+    assert(hash<int*>()(obj) != hash<int*>()(obj + 1));
+
+    // 长度0~200的前缀互不相同, 跨越各个分支; 内容相同、地址不同的字符串散列值相同
+    char text[256];
+    for(int i = 0; i < 256; ++i)
+        text[i] = char('a' + i % 26);
+    hash_set<size_t> seen;
+    for(size_t len = 0; len <= 200; ++len)
+    {
+        char copy[256];
+        memcpy(copy + 3, text, len);
+        assert(__hash_bytes(text, len, 0) == __hash_bytes(copy + 3, len, 0));
+        seen.insert(__hash_bytes(text, len, 0));
+    }
+    assert(seen.size() == 201);
+    char s1[] = "construct", s2[] = "construct";
+    assert(hash<char*>()(s1) == hash<const char*>()(s2));
+    assert(hash<const char*>()("alloc") != hash<const char*>()("allod"));
+    printf("strings ok\n");
+
+    // 种子: 相同的种子结果相同, 不同的种子结果不同, 默认构造时各取一个随机种子
+    seeded_hash<int> a(1), b(1), c(2);
+    assert(a(42) == b(42) && a(42) != c(42));
+    seeded_hash<const char*> sa(7), sb(8);
+    assert(sa("key") != sb("key") && sa("key") == seeded_hash<char*>(7)("key"));
+    assert(seeded_hash<int>().seed != seeded_hash<int>().seed);
+    assert(seeded_hash<int*>(3)(obj) != seeded_hash<int*>(4)(obj));
+
+    hash_map<int, int, seeded_hash<int> > hm;
+    for(int i = 0; i < 1000; ++i)
+        hm[i] = i;
+    assert(hm.size() == 1000 && hm[777] == 777 && hm.find(1000) == hm.end());
+
+    const char* words[] = {"alloc", "construct", "uninitialized", "function", "alloc"};
+    hash_set<const char*, seeded_hash<const char*>, str_equal> hs(words, words + 5);
+    assert(hs.size() == 4 && hs.count("function") == 1);
+
+    // 用户的散列函数默认要经过 hashtable 的 __hash_mix, 恒等散列也能正常工作
+    assert(!is_true(__hash_is_avalanching<identity_hash>::type()) && is_true(__hash_is_avalanching<hash<int> >::type()));
+    assert(!is_true(__hash_is_avalanching<hash<point> >::type()));
+    assert(is_true(__hash_is_avalanching<hash<int*> >::type()) && is_true(__hash_is_avalanching<hash<const char*> >::type()));
+    assert(is_true(__hash_is_avalanching<hash<string> >::type()) && is_true(__hash_is_avalanching<seeded_hash<long> >::type()));
+    hash_set<point> ps;
+    for(int i = 0; i < 100; ++i)
+        for(int j = 0; j < 10; ++j)
+        {
+            point p = {i << 7, j << 7};
+            ps.insert(p);
+        }
+    assert(ps.size() == 1000);
+    hash_map<int, int, identity_hash> ih;
+    for(int i = 0; i < 1000; ++i)
+        ih[i << 7] = i;
+    assert(ih.size() == 1000 && ih[500 << 7] == 500);
+    printf("seeded_hash ok\n");
+    return 0;
+}
\ No newline at end of file
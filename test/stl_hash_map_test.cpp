@@ -0,0 +1,73 @@
+#include "stl_hash_map.h"
+#include "stl_hash_set.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// hash_map 和 hash_set 的测试文件, 测试 插入、查找、删除、扩容 过程
+
+// 按内容比较字符串, 而不是比较指针
+struct str_equal
+{
+    bool operator()(const char* a, const char* b) const {   return strcmp(a, b) == 0;   }
+};
+
+int main()
+{
+    hash_map<int, int> hm;
+    for(int i = 0; i < 1000; ++i)
+        hm[i] = i * i;
+    printf("size = %lu, bucket_count = %lu\n", hm.size(), hm.bucket_count());
+    assert(hm.size() == 1000);
+
+    printf("hm[30] = %d\n", hm[30]);
+    assert(hm.find(999)->second == 999 * 999);
+    assert(hm.find(1000) == hm.end());
+
+    // 插入已存在的键值不会覆盖
+    pair<hash_map<int, int>::iterator, bool> p = hm.insert(pair<const int, int>(10, -1));
+    assert(!p.second && p.first->second == 100);
+
+    // 删除偶数键值
+    for(int i = 0; i < 1000; i += 2)
+        assert(hm.erase(i) == 1);
+    assert(hm.size() == 500 && hm.count(2) == 0 && hm.count(3) == 1);
+
+    // 反复插入删除, 墓碑不会导致无限扩容
+    size_t buckets = hm.bucket_count();
+    for(int round = 0; round < 100; ++round)
+    {
+        for(int i = 0; i < 1000; i += 2)
+            hm[i + 10000 * round] = i;
+        for(int i = 0; i < 1000; i += 2)
+            hm.erase(i + 10000 * round);
+    }
+    printf("size = %lu, bucket_count = %lu -> %lu\n", hm.size(), buckets, hm.bucket_count());
+    assert(hm.size() == 500 && hm.bucket_count() <= buckets * 2);
+
+    long sum = 0;
+    for(hash_map<int, int>::iterator it = hm.begin(); it != hm.end(); ++it)
+        sum += it->first;
+    printf("sum of keys = %ld\n", sum);
+    assert(sum == 250000);
+
+    hash_map<int, int> copy = hm;
+    assert(copy.size() == hm.size() && copy[501] == 501 * 501);
+
+    // hash_set, 字符串键值
+    const char* words[] = {"alloc", "construct", "uninitialized", "function", "alloc"};
+    hash_set<const char*, hash<const char*>, str_equal> hs(words, words + 5);
+    printf("hash_set size = %lu\n", hs.size());
+    for(hash_set<const char*, hash<const char*>, str_equal>::iterator it = hs.begin(); it != hs.end(); ++it)
+        printf("%s\n", *it);
+    assert(hs.size() == 4);
+    // 内容相同但地址不同的字符串也是重复的
+    char buffer[16];
+    strcpy(buffer, "construct");
+    assert(!hs.insert(buffer).second && hs.size() == 4 && hs.count(buffer) == 1);
+    strcpy(buffer, "hashtable");
+    assert(hs.count(buffer) == 0);
+
+    hm.clear();
+    assert(hm.empty() && hm.begin() == hm.end());
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "stl_algo.h"
+#include "stl_queue.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// 堆算法与 priority_queue 的测试文件, 测试 二叉堆算法、不同叉数的堆、批量插入后的堆性质
+
+int main()
+{
+    int a[10] = {5, 3, 8, 1, 9, 2, 7, 4, 6, 0};
+
+    // 二叉堆
+    vector<int> v(a, a + 10);
+    make_heap(v.begin(), v.end());
+    assert(is_heap(v.begin(), v.end()) && v.front() == 9);
+    v.push_back(11);
+    push_heap(v.begin(), v.end());
+    assert(v.front() == 11);
+    pop_heap(v.begin(), v.end());
+    assert(v.back() == 11);
+    v.pop_back();
+    sort_heap(v.begin(), v.end());
+    for(vector<int>::iterator it = v.begin(); it != v.end(); ++it)
+        printf("%d ", *it);
+    printf("\n");
+    for(int i = 0; i < 10; ++i)
+        assert(v[i] == i);
+
+    // 指定比较函数: 小顶堆
+    make_heap(a, a + 10, greater<int>());
+    assert(a[0] == 0 && is_heap(a, a + 10, greater<int>()));
+    sort_heap(a, a + 10, greater<int>());
+    assert(a[0] == 9 && a[9] == 0);
+
+    // 4叉堆的 priority_queue, 逐个插入与批量插入混合, 弹出顺序与排序结果一致
+    priority_queue<int> pq;
+    vector<int> all;
+    srand(1);
+    for(int round = 0; round < 20; ++round)
+    {
+        vector<int> batch;
+        int k = round % 2 ? rand() % 200 : rand() % 5;
+        for(int i = 0; i < k; ++i)
+            batch.push_back(rand() % 1000);
+        pq.push_range(batch.begin(), batch.end());
+        all.insert(all.end(), batch.begin(), batch.end());
+        pq.push(round);
+        all.push_back(round);
+    }
+    assert(pq.size() == all.size());
+    sort_heap((make_heap(all.begin(), all.end()), all.begin()), all.end());
+    for(size_t i = all.size(); i > 0; --i)
+    {
+        assert(pq.top() == all[i - 1]);
+        pq.pop();
+    }
+    assert(pq.empty());
+
+    // 二叉和8叉, 小顶堆用于top-K
+    int b[8] = {4, 1, 7, 3, 8, 5, 2, 6};
+    priority_queue<int, vector<int>, greater<int>, 2> pq2(b, b + 8);
+    priority_queue<int, vector<int>, greater<int>, 8> pq8(b, b + 8);
+    for(int i = 1; i <= 8; ++i)
+    {
+        assert(pq2.top() == i && pq8.top() == i);
+        pq2.pop();
+        pq8.pop();
+    }
+    printf("priority_queue ok\n");
+
+    return 0;
+}
\ No newline at end of file
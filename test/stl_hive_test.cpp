@@ -0,0 +1,148 @@
+#include "stl_hive.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// stl_hive.h 的测试文件, 测试 插入删除后元素地址不变, 跳跃字段的正反向遍历, 空洞的复用, 空块的归还,
+// 随机插入删除与参照模型一致, 以及非trivial类型的析构次数
+
+struct counted
+{
+    static int alive;
+    int value;
+    counted(int v) : value(v)   {   ++alive;    }
+    counted(const counted& x) : value(x.value)  {   ++alive;    }
+    ~counted()  {   --alive;    }
+};
+int counted::alive = 0;
+
+template<class Hive>
+static long forward_sum(const Hive& h, size_t& n)
+{
+    long sum = 0;
+    n = 0;
+    for(typename Hive::const_iterator it = h.begin(); it != h.end(); ++it, ++n)
+        sum += *it;
+    return sum;
+}
+
+template<class Hive>
+static long backward_sum(const Hive& h, size_t& n)
+{
+    long sum = 0;
+    n = 0;
+    typename Hive::const_iterator it = h.end();
+    while(it != h.begin())
+    {
+        --it;
+        sum += *it;
+        ++n;
+    }
+    return sum;
+}
+
+int main()
+{
+    // 元素地址在其他元素插入删除后保持不变
+    hive<int> h;
+    vector<int*> pointers;
+    for(int i = 0; i < 10000; ++i)
+        pointers.push_back(&*h.insert(i));
+    assert(h.size() == 10000);
+    for(hive<int>::iterator it = h.begin(); it != h.end(); )
+        it = (*it % 3 == 0) ? h.erase(it) : ++it;
+    assert(h.size() == 6666);
+    for(int i = 0; i < 10000; ++i)
+        if(i % 3 != 0)
+            assert(*pointers[i] == i);
+
+    size_t n1, n2;
+    long s1 = forward_sum(h, n1), s2 = backward_sum(h, n2);
+    assert(n1 == h.size() && n2 == h.size() && s1 == s2);
+    printf("size = %lu, capacity = %lu, sum = %ld\n", h.size(), h.capacity(), s1);
+
+    // 再插入时复用空洞, 容量不变
+    size_t capacity = h.capacity();
+    for(int i = 0; i < 3334; ++i)
+        h.insert(-1);
+    assert(h.size() == 10000 && h.capacity() == capacity);
+    for(int i = 0; i < 10000; ++i)
+        if(i % 3 != 0)
+            assert(*pointers[i] == i);
+    assert(*h.get_iterator(pointers[5]) == 5);
+
+    // 全部删除后归还所有块, 只保留一块备用
+    h.erase(h.begin(), h.end());
+    assert(h.empty() && h.begin() == h.end());
+    assert(h.capacity() <= 8192);
+    h.trim();
+    assert(h.capacity() == 0);
+    printf("reuse ok\n");
+
+    // 随机插入删除, 与参照模型比较; 小块容量让操作跨越许多块
+    hive<int> r(hive_limits(4, 16));
+    vector<int*> live;
+    long expected = 0;
+    srand(7);
+    for(int step = 0; step < 20000; ++step)
+    {
+        if(live.empty() || rand() % 5 < 3)
+        {
+            int v = rand() % 1000;
+            live.push_back(&*r.insert(v));
+            expected += v;
+        }
+        else
+        {
+            size_t k = rand() % live.size();
+            expected -= *live[k];
+            r.erase(r.get_iterator(live[k]));
+            live[k] = live.back();
+            live.pop_back();
+        }
+        if(step % 1000 == 0)
+        {
+            assert(forward_sum(r, n1) == expected && n1 == live.size());
+            assert(backward_sum(r, n2) == expected && n2 == live.size());
+        }
+    }
+    assert(r.size() == live.size() && forward_sum(r, n1) == expected);
+    printf("random ok, size = %lu\n", r.size());
+
+    // 复制、交换
+    hive<int> c = r;
+    assert(c.size() == r.size() && forward_sum(c, n1) == expected);
+    hive<int> e(3, 7);
+    assert(e.size() == 3 && *e.begin() == 7);
+    swap(c, e);
+    assert(c.size() == 3 && e.size() == r.size());
+
+    // 两个整数参数的 insert 按 (个数, 值) 处理, T 不是 int 时也一样
+    hive<long> hl(2, 7);
+    hl.insert(5, 7);
+    assert(hl.size() == 7 && *hl.begin() == 7);
+    hl.insert(c.begin(), c.end());
+    assert(hl.size() == 10 && forward_sum(hl, n1) == 70);
+
+    // 非trivial类型: clear、erase、析构时每个元素恰好析构一次
+    {
+        hive<counted> hc;
+        for(int i = 0; i < 1000; ++i)
+            hc.insert(counted(i));
+        assert(counted::alive == 1000);
+        hive<counted>::iterator it = hc.begin();
+        for(int i = 0; i < 100; ++i)
+            it = hc.erase(it);
+        assert(counted::alive == 900);
+        hive<counted> copy(hc);
+        assert(counted::alive == 1800);
+        copy.clear();
+        assert(counted::alive == 900 && copy.empty());
+        hc.insert(5, counted(-1));
+        assert(counted::alive == 905);
+    }
+    assert(counted::alive == 0);
+    printf("destroy ok\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "stl_list.h"
+#include "stl_slist.h"
+#include "stl_intrusive_list.h"
+#include <cassert>
+#include <cstdio>
+
+// list / slist / intrusive_list 的测试文件, 测试 整段分配节点、整段归还节点、splice 过程
+
+struct task : public intrusive_list_hook<>, public intrusive_slist_hook<>
+{
+    int id;
+    explicit task(int i) : id(i)    {}
+};
+
+int main()
+{
+    int a[10] = {5, 3, 8, 1, 9, 2, 7, 4, 6, 0};
+
+    // 由区间构造, 节点一次取得
+    list<int> l(a, a + 10);
+    l.sort();
+    for(list<int>::iterator it = l.begin(); it != l.end(); ++it)
+        printf("%d ", *it);
+    printf("\n");
+    assert(l.size() == 10 && l.front() == 0 && l.back() == 9);
+
+    // clear 将整段节点接回自由链表头部, 再次分配时按原来的顺序取回
+    // (l2的哨兵节点取走第一个节点, 第一个元素使用第二个节点)
+    int* second_addr = &*++l.begin();
+    l.clear();
+    assert(l.empty());
+    list<int> l2(3, 42);
+    printf("reused node: %d\n", &l2.front() == second_addr);
+    assert(&l2.front() == second_addr);
+
+    // erase(first, last) 整段归还
+    list<int> l3(a, a + 10);
+    list<int>::iterator first = l3.begin(), last = l3.end();
+    ++first;
+    --last;
+    l3.erase(first, last);
+    assert(l3.size() == 2 && l3.front() == 5 && l3.back() == 0);
+
+    l3.splice(l3.end(), l2);
+    assert(l2.empty() && l3.size() == 5 && l3.back() == 42);
+    l3.unique();
+    assert(l3.size() == 3);
+
+    // slist
+    slist<int> sl(a, a + 10);
+    sl.reverse();
+    assert(sl.front() == 0 && sl.size() == 10);
+    sl.remove(9);
+    sl.erase_after(sl.begin());
+    assert(sl.size() == 8);
+    for(slist<int>::iterator it = sl.begin(); it != sl.end(); ++it)
+        printf("%d ", *it);
+    printf("\n");
+    sl.clear();
+    assert(sl.empty());
+
+    // 两个参数都是整数时按 (个数, 值) 处理, 而不是当作迭代器区间
+    list<long> ll(3, 7);
+    assert(ll.size() == 3 && ll.front() == 7 && ll.back() == 7);
+    ll.insert(ll.begin(), 2, 5);
+    assert(ll.size() == 5 && ll.front() == 5 && *(++ll.begin()) == 5 && ll.back() == 7);
+    slist<long> sll(3, 7);
+    assert(sll.size() == 3 && sll.front() == 7);
+    sll.insert_after(sll.before_begin(), 2, 5);
+    assert(sll.size() == 5 && sll.front() == 5 && *(++sll.begin()) == 5 && *(++++sll.begin()) == 7);
+    list<double> ld(2, 1);
+    assert(ld.size() == 2 && ld.back() == 1.0);
+    printf("fill ok\n");
+
+    // 侵入式链表, 同一个对象同时挂在两条链表上, 不分配内存
+    task t1(1), t2(2), t3(3);
+    intrusive_list<task> ready;
+    intrusive_slist<task> stack;
+    ready.push_back(t1);
+    ready.push_back(t2);
+    ready.push_back(t3);
+    stack.push_front(t1);
+    stack.push_front(t3);
+    assert(ready.size() == 3 && stack.size() == 2 && stack.front().id == 3);
+
+    ready.erase(intrusive_list<task>::iterator_to(t2));
+    assert(!t2.intrusive_list_hook<>::is_linked() && ready.size() == 2);
+    t1.intrusive_list_hook<>::unlink();
+    assert(ready.front().id == 3);
+
+    intrusive_list<task> done;
+    done.splice(done.end(), ready);
+    assert(ready.empty() && done.size() == 1 && done.back().id == 3);
+    printf("intrusive ok\n");
+}
\ No newline at end of file
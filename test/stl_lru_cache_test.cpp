@@ -0,0 +1,195 @@
+#include "stl_lru_cache.h"
+#include "stl_string.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// stl_lru_cache.h 的测试文件, 测试 LRU的淘汰顺序, CLOCK的第二次机会, 删除后索引仍然正确(backward shift),
+// 随机操作与参照模型一致, 批量查找与插入, 命中率统计, 非trivial类型的析构次数, 以及多线程下的分片缓存(包括值需要配置空间的情况)
+
+struct counted
+{
+    static int alive;
+    int value;
+    counted() : value(0)    {   ++alive;    }
+    counted(int v) : value(v)   {   ++alive;    }
+    counted(const counted& x) : value(x.value)  {   ++alive;    }
+    counted& operator=(const counted& x)
+    {
+        value = x.value;
+        return *this;
+    }
+    ~counted()  {   --alive;    }
+};
+int counted::alive = 0;
+
+// 所有键散列到同一处, 让探测序列很长
+struct bad_hash
+{
+    size_t operator()(int) const    {   return 0;   }
+};
+
+int main()
+{
+    // LRU: 命中的键移到最前, 淘汰最久没有使用的
+    lru_cache<int, int> c(3);
+    assert(c.put(1, 10) && c.put(2, 20) && c.put(3, 30));
+    assert(*c.get(1) == 10);
+    assert(c.put(4, 40));               // 淘汰2
+    assert(c.get(2) == 0 && c.size() == 3);
+    assert(!c.put(3, 31) && *c.get(3) == 31);
+    c.put(5, 50);                       // 淘汰1
+    assert(!c.contains(1) && c.contains(4) && c.contains(3) && c.contains(5));
+    assert(c.stats().hits == 2 && c.stats().misses == 1 && c.stats().evictions == 2 && c.stats().insertions == 5);
+    int v = 0;
+    assert(c.get(4, v) && v == 40 && !c.get(1, v));
+    printf("lru ok, hit ratio = %.2f\n", c.stats().hit_ratio());
+
+    // CLOCK: 命中只做标记, 被标记的键得到第二次机会
+    lru_cache<int, int> k(3, cache_clock);
+    k.put(1, 10);
+    k.put(2, 20);
+    k.put(3, 30);
+    k.get(1);
+    k.put(4, 40);                       // 1 被引用过, 跳过, 淘汰2
+    assert(k.contains(1) && !k.contains(2) && k.contains(3) && k.contains(4));
+    k.put(5, 50);                       // 淘汰3
+    assert(k.contains(1) && !k.contains(3));
+    k.put(6, 60);                       // 1 的标志已被清除, 淘汰1
+    assert(!k.contains(1) && k.size() == 3);
+    printf("clock ok\n");
+
+    // 随机操作, 与参照模型比较; 所有键挤在一起的散列检查删除时槽位的前移
+    for(int round = 0; round < 2; ++round)
+    {
+        lru_cache<int, int> r(64);
+        lru_cache<int, int, bad_hash> b(64);
+        vector<int> model;                  // 按最近使用排序, 最近的在后
+        srand(11);
+        for(int step = 0; step < 20000; ++step)
+        {
+            int key = rand() % 200;
+            int op = rand() % 3;
+            size_t pos = 0;
+            while(pos < model.size() && model[pos] != key)
+                ++pos;
+            const bool present = pos < model.size();
+            if(op == 0)
+            {
+                assert((r.get(key) != 0) == present && (b.get(key) != 0) == present);
+                if(present)
+                {
+                    model.erase(model.begin() + pos);
+                    model.push_back(key);
+                }
+            }
+            else if(op == 1)
+            {
+                assert(r.put(key, key * 2) == !present && b.put(key, key * 2) == !present);
+                if(present)
+                    model.erase(model.begin() + pos);
+                else if(model.size() == 64)
+                    model.erase(model.begin());
+                model.push_back(key);
+            }
+            else
+            {
+                assert(r.erase(key) == present && b.erase(key) == present);
+                if(present)
+                    model.erase(model.begin() + pos);
+            }
+            assert(r.size() == model.size() && b.size() == model.size());
+        }
+        for(size_t i = 0; i < model.size(); ++i)
+            assert(*r.get(model[i]) == model[i] * 2 && *b.get(model[i]) == model[i] * 2);
+    }
+    printf("random ok\n");
+
+    // 批量查找与插入
+    lru_cache<int, int> m(100);
+    vector<pair<int, int> > entries;
+    for(int i = 0; i < 50; ++i)
+        entries.push_back(make_pair(i, i * i));
+    assert(m.put_many(entries.begin(), entries.end()) == 50);
+    assert(m.put_many(entries.begin(), entries.begin() + 10) == 0);
+    vector<int> keys;
+    for(int i = 0; i < 100; i += 3)
+        keys.push_back(i);
+    vector<int*> found(keys.size(), (int*)0);
+    assert(m.get_many(keys.begin(), keys.end(), found.begin()) == 17);
+    for(size_t i = 0; i < keys.size(); ++i)
+        assert(keys[i] < 50 ? *found[i] == keys[i] * keys[i] : found[i] == 0);
+    m.clear();
+    assert(m.empty() && !m.contains(3));
+    m.reset_stats();
+    assert(m.stats().hits == 0 && m.stats().hit_ratio() == 0.0);
+
+    // 非trivial类型: 淘汰、删除、clear、析构时每个值恰好析构一次
+    {
+        lru_cache<string, counted> s(10);
+        for(int i = 0; i < 30; ++i)
+        {
+            string key("a key that does not fit in the short buffer #");
+            key += char('a' + i);
+            s.put(key, counted(i));
+        }
+        assert(counted::alive == 10 && s.size() == 10);
+        assert(s.get(string("a key that does not fit in the short buffer #") + char('a' + 25))->value == 25);
+        assert(s.erase(string("a key that does not fit in the short buffer #") + char('a' + 29)));
+        assert(counted::alive == 9);
+        s.clear();
+        assert(counted::alive == 0);
+        s.put(string("x"), counted(1));
+    }
+    assert(counted::alive == 0);
+    printf("destroy ok\n");
+
+    // 分片缓存: 多个线程同时读写不同与相同的键
+    sharded_lru_cache<int, int> sc(1024, 8);
+    assert(sc.shard_count() == 8);
+    std::thread threads[4];
+    for(int t = 0; t < 4; ++t)
+        threads[t] = std::thread([&sc, t]() {
+            for(int i = 0; i < 20000; ++i)
+            {
+                int key = (i * 7 + t) % 2000;
+                int value;
+                if(sc.get(key, value))
+                    assert(value == key + 1);
+                else
+                    sc.put(key, key + 1);
+            }
+        });
+    for(int t = 0; t < 4; ++t)
+        threads[t].join();
+    cache_stats st = sc.stats();
+    assert(st.hits + st.misses == 80000 && sc.size() <= 1024 + 8);
+    printf("sharded ok, size = %lu, hit ratio = %.2f\n", sc.size(), st.hit_ratio());
+    sc.clear();
+    assert(sc.size() == 0);
+
+    // 值会配置堆空间的分片缓存: 值的配置器必须是线程安全的, 这里用 malloc_alloc
+    typedef basic_string<char, malloc_alloc> shared_string;
+    sharded_lru_cache<int, shared_string> ss(256, 4);
+    for(int t = 0; t < 4; ++t)
+        threads[t] = std::thread([&ss, t]() {
+            for(int i = 0; i < 5000; ++i)
+            {
+                int key = (i * 5 + t) % 500;
+                shared_string expected("a value that is long enough to live on the heap #");
+                expected.push_back(char('a' + key % 26));
+                shared_string value;
+                if(ss.get(key, value))
+                    assert(value == expected);
+                else
+                    ss.put(key, expected);
+            }
+        });
+    for(int t = 0; t < 4; ++t)
+        threads[t].join();
+    assert(ss.size() <= 256 + 4);
+    printf("sharded string ok, size = %lu\n", ss.size());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "stl_map.h"
+#include "stl_multimap.h"
+#include "stl_set.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// map / set / multimap (B树) 的测试文件, 测试 插入、查找、删除时节点的分裂与合并
+
+int main()
+{
+    map<int, int> m;
+    for(int i = 0; i < 10; ++i)
+        m[i * 10] = i;
+    for(map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+        printf("(%d, %d) ", it->first, it->second);
+    printf("\n");
+    printf("lower_bound(25) = %d, upper_bound(30) = %d\n", m.lower_bound(25)->first, m.upper_bound(30)->first);
+
+    // 随机插入删除, 与标记数组对照, 覆盖分裂、合并、借元素等所有情况
+    const int N = 20000;
+    static bool present[N];
+    set<int> s;
+    srand(1);
+    for(int round = 0; round < 200000; ++round)
+    {
+        int k = rand() % N;
+        if(rand() % 3 != 0)
+        {
+            bool inserted = s.insert(k).second;
+            assert(inserted == !present[k]);
+            present[k] = true;
+        }
+        else
+        {
+            assert(s.erase(k) == (present[k] ? 1u : 0u));
+            present[k] = false;
+        }
+    }
+    size_t n = 0;
+    int prev = -1;
+    for(set<int>::iterator it = s.begin(); it != s.end(); ++it, ++n)
+    {
+        assert(prev < *it && present[*it]);
+        prev = *it;
+    }
+    assert(n == s.size());
+    printf("set size = %lu\n", s.size());
+
+    // 反向遍历
+    n = 0;
+    for(set<int>::iterator it = s.end(); it != s.begin(); ++n)
+        --it;
+    assert(n == s.size());
+
+    // erase 返回下一个元素
+    set<int>::iterator it = s.begin();
+    while(it != s.end())
+    {
+        int k = *it;
+        it = s.erase(it);
+        assert(it == s.end() || *it > k);
+    }
+    assert(s.empty());
+
+    // 两端反复插入删除, 最左、最右叶子节点分裂与合并后 begin() / end() 仍然正确
+    int lo = 0, hi = 0;
+    for(int round = 0; round < 20000; ++round)
+    {
+        int op = rand() % 4;
+        if(op == 0 || s.empty())
+            s.insert(--lo);
+        else if(op == 1)
+            s.insert(hi++);
+        else if(op == 2)
+            s.erase(lo++);
+        else
+            s.erase(--hi);
+        if(lo == hi)
+            assert(s.empty() && s.begin() == s.end());
+        else
+        {
+            set<int>::iterator last = s.end();
+            --last;
+            assert(*s.begin() == lo && *last == hi - 1 && s.size() == size_t(hi - lo));
+        }
+    }
+    s.clear();
+
+    // 有序批量插入走 end() 提示的快速路径
+    int keys[1000];
+    for(int i = 0; i < 1000; ++i)
+        keys[i] = i;
+    set<int> sorted(keys, keys + 1000);
+    set<int> copy = sorted;
+    assert(sorted.size() == 1000 && copy == sorted && *copy.find(777) == 777);
+
+    multimap<int, int> mm;
+    for(int i = 0; i < 300; ++i)
+        mm.insert(pair<const int, int>(i % 3, i));
+    printf("multimap count(1) = %lu\n", mm.count(1));
+    assert(mm.count(1) == 100);
+    int last = -1;
+    for(multimap<int, int>::iterator i = mm.lower_bound(2); i != mm.end(); ++i)
+    {
+        assert(i->first == 2 && i->second > last);  // 等价元素保持插入顺序
+        last = i->second;
+    }
+    assert(mm.erase(0) == 100 && mm.size() == 200);
+}
\ No newline at end of file
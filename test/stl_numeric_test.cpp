@@ -0,0 +1,102 @@
+#include "stl_list.h"
+#include "stl_numeric.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// 数值算法的测试文件, 测试 向量化版本与逐个计算的结果一致、非指针迭代器、原地计算、浮点的重排模式
+
+// 不是 plus<int>, 不会被分派到向量化版本
+struct plain_plus
+{
+    int operator()(int x, int y) const  {   return x + y;   }
+};
+
+int main()
+{
+    // 覆盖尾部处理的各种长度
+    for(int n = 0; n < 100; ++n)
+    {
+        vector<int> v;
+        for(int i = 0; i < n; ++i)
+            v.push_back(rand() % 1000 - 500);
+        const int* p = v.data();
+
+        int sum = 7;
+        for(int i = 0; i < n; ++i)
+            sum += v[i];
+        assert(accumulate(v.begin(), v.end(), 7) == sum);
+        assert(accumulate(p, p + n, 7, plain_plus()) == sum);
+        assert(accumulate(v.begin(), v.end(), 7, minus<int>()) == 14 - sum);
+
+        unsigned int prod = 3;
+        vector<unsigned int> u;
+        for(int i = 0; i < n; ++i)
+        {
+            u.push_back(rand());
+            prod *= u[i];
+        }
+        assert(accumulate(u.begin(), u.end(), 3u, multiplies<unsigned int>()) == prod);
+
+        int dot = 1;
+        vector<int> w;
+        for(int i = 0; i < n; ++i)
+        {
+            w.push_back(rand() % 100);
+            dot += v[i] * w[i];
+        }
+        assert(inner_product(v.begin(), v.end(), w.begin(), 1) == dot);
+        assert(inner_product(p, p + n, w.begin(), 1, plus<int>(), multiplies<int>()) == dot);
+
+        // 前缀和: 向量化版本、非指针版本、原地
+        vector<int> s1(n), s2(n), s3(v);
+        assert(partial_sum(v.begin(), v.end(), s1.begin()) == s1.end());
+        partial_sum(p, p + n, s2.begin(), plain_plus());
+        partial_sum(s3.begin(), s3.end(), s3.begin());
+        assert(s1 == s2 && s1 == s3);
+        for(int i = 0; i < n; ++i)
+            assert(s1[i] == (i ? s1[i - 1] : 0) + v[i]);
+
+        // 相邻差: 原地计算后再求前缀和应还原
+        vector<int> d(v);
+        assert(adjacent_difference(d.begin(), d.end(), d.begin()) == d.end());
+        for(int i = 1; i < n; ++i)
+            assert(d[i] == v[i] - v[i - 1]);
+        partial_sum(d.begin(), d.end(), d.begin());
+        assert(d == v);
+
+        vector<long> r(n);
+        iota(r.begin(), r.end(), -5L);
+        for(int i = 0; i < n; ++i)
+            assert(r[i] == i - 5);
+    }
+
+    // 浮点: 默认按顺序计算, 结果与逐个累加完全相同
+    vector<float> f;
+    for(int i = 0; i < 1000; ++i)
+        f.push_back(float(rand()) / RAND_MAX);
+    float seq = 0.0f;
+    for(int i = 0; i < 1000; ++i)
+        seq += f[i];
+    assert(accumulate(f.begin(), f.end(), 0.0f) == seq);
+    // 允许重排后结果只在舍入误差范围内
+    float fast = accumulate(f.begin(), f.end(), 0.0f, reassociate(plus<float>()));
+    printf("sequential %f, reassociated %f\n", seq, fast);
+    assert(std::fabs(fast - seq) < 1e-3f);
+    double dot = inner_product(f.begin(), f.end(), f.begin(), 0.0f, reassociate(plus<float>()), multiplies<float>());
+    assert(dot > 0);
+
+    vector<float> fs(f.size());
+    partial_sum(f.begin(), f.end(), fs.begin(), reassociate(plus<float>()));
+    assert(std::fabs(fs.back() - seq) < 1e-3f);
+
+    // 非指针迭代器
+    int a[5] = {1, 2, 3, 4, 5};
+    list<int> l(a, a + 5);
+    assert(accumulate(l.begin(), l.end(), 0) == 15);
+    assert(inner_product(l.begin(), l.end(), a, 0) == 55);
+
+    return 0;
+}
\ No newline at end of file
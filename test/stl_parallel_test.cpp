@@ -0,0 +1,84 @@
+#define __STL_PARALLEL_THREADS 4
+
+#include "stl_parallel.h"
+#include "stl_list.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// 并行算法的测试文件, 固定使用4个线程, 测试 各执行策略的结果与顺序版本一致
+// 编译时需要 -pthread
+
+struct square : public unary_function<int, long long>
+{
+    long long operator()(int x) const   {   return (long long)x * x;    }
+};
+
+struct add_one
+{
+    void operator()(int& x) const   {   ++x;    }
+};
+
+int main()
+{
+    const int n = 1000003;
+    vector<int> v;
+    srand(4);
+    for(int i = 0; i < n; ++i)
+        v.push_back(rand() % 100000);
+
+    // for_each
+    vector<int> a(v);
+    for_each(par, a.begin(), a.end(), add_one());
+    for(int i = 0; i < n; ++i)
+        assert(a[i] == v[i] + 1);
+
+    // transform
+    vector<long long> sq(n);
+    transform(par_unseq, v.begin(), v.end(), sq.begin(), square());
+    for(int i = 0; i < n; ++i)
+        assert(sq[i] == (long long)v[i] * v[i]);
+
+    // accumulate
+    long long total = accumulate(v.begin(), v.end(), 0LL);
+    assert(accumulate(par, v.begin(), v.end(), 0LL) == total);
+    assert(accumulate(seq, v.begin(), v.end(), 0LL) == total);
+    assert(accumulate(par, sq.begin(), sq.end(), 0LL, plus<long long>()) == accumulate(sq.begin(), sq.end(), 0LL));
+
+    // count_if, 使用 stl_function.h 中的适配器
+    assert(count_if(par, v.begin(), v.end(), bind2nd(less<int>(), 5000)) ==
+           count_if(v.begin(), v.end(), bind2nd(less<int>(), 5000)));
+    assert(count_if(par, v.begin(), v.end(), not1(bind2nd(less<int>(), 5000))) ==
+           count_if(v.begin(), v.end(), not1(bind2nd(less<int>(), 5000))));
+
+    // find_if 返回第一个满足条件的位置
+    vector<int> b(n, 0);
+    b[700000] = 1;
+    b[900000] = 1;
+    b[300] = 2;
+    assert(find_if(par, b.begin(), b.end(), bind2nd(equal_to<int>(), 1)) - b.begin() == 700000);
+    assert(find_if(par, b.begin(), b.end(), bind2nd(greater<int>(), 0)) - b.begin() == 300);
+    assert(find_if(par, b.begin(), b.end(), bind2nd(greater<int>(), 5)) == b.end());
+
+    // sort
+    a = v;
+    vector<int> ref(v);
+    sort(ref.begin(), ref.end());
+    sort(par, a.begin(), a.end());
+    assert(a == ref);
+    a = v;
+    sort(par, a.begin(), a.end(), greater<int>());
+    assert(is_sorted(a.begin(), a.end(), greater<int>()));
+    vector<int> dup(n, 7);
+    sort(par, dup.begin(), dup.end(), not2(greater_equal<int>()));
+
+    // 非随机访问迭代器退化为顺序执行
+    list<int> l(v.begin(), v.begin() + 1000);
+    assert(accumulate(par, l.begin(), l.end(), 0LL) == accumulate(v.begin(), v.begin() + 1000, 0LL));
+
+    printf("threads: %d\n", (int)__parallel_pool::instance().concurrency());
+    printf("parallel ok\n");
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "stl_perf.h"
+#include <cassert>
+#include <cstdio>
+
+// stl_perf.h 的测试文件, 测试 计数器不可用时退化为只计时、嵌套与递归进入同一区域、区域的注册与摘除、报告输出
+
+perf_region recursive_region("recursive");
+
+long recursive_sum(int n)
+{
+    perf_scope scope(recursive_region);
+    return n == 0 ? 0 : n + recursive_sum(n - 1);
+}
+
+int main()
+{
+    perf_counters& counters = perf_counters::this_thread();
+    printf("hardware counters available: %s\n", counters.available() ? "yes" : "no");
+    for(int k = 0; k < perf_event_count; ++k)
+        printf("  %-16s %s\n", perf_event_name(k), counters.available(k) ? "yes" : "no");
+
+    perf_sample before, after;
+    counters.read(before);
+    volatile long x = 0;
+    for(long i = 0; i < 1000000; ++i)
+        x += i;
+    counters.read(after);
+    assert(after.seconds > before.seconds);
+    for(int k = 0; k < perf_event_count; ++k)
+        if(!counters.available(k))
+            assert(before.value[k] == 0 && after.value[k] == 0);
+    if(counters.available(perf_instructions))
+        assert(after.value[perf_instructions] > before.value[perf_instructions]);
+
+    // 递归进入同一区域只计量最外层
+    assert(recursive_sum(100) == 5050);
+    assert(recursive_sum(10) == 55);
+    assert(recursive_region.calls == 2 && recursive_region.depth == 0 && recursive_region.seconds > 0);
+
+    {
+        perf_region local("local");
+        assert(perf_region::list() == &local);
+        for(int i = 0; i < 3; ++i)
+        {
+            perf_scope scope(local);
+            x += i;
+        }
+        assert(local.calls == 3);
+        perf_report(stdout);
+    }
+    // 离开作用域的区域已经从链表上摘下
+    for(const perf_region* r = perf_region::list(); r; r = r->next)
+        assert(r == &recursive_region);
+
+    recursive_region.reset();
+    assert(recursive_region.calls == 0);
+
+    printf("perf test passed\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "stl_algo.h"
+#include "stl_function.h"
+#include "stl_poly_collection.h"
+#include <cassert>
+#include <cstdio>
+
+// stl_poly_collection.h 的测试文件, 测试 按类型分段存放、逐段遍历、mem_fun 与指明具体类型的 for_each、复制与清空
+
+class shape
+{
+public:
+    int id;
+    explicit shape(int i) : id(i)   {}
+    virtual ~shape()    {}
+    virtual int kind() const = 0;
+    virtual void grow() = 0;
+};
+
+class Rect : public shape
+{
+public:
+    int w, h;
+    Rect(int i, int a, int b) : shape(i), w(a), h(b)    {}
+    virtual int kind() const    {   return 1;   }
+    virtual void grow() {   ++w;    }
+};
+
+class Circle final : public shape
+{
+public:
+    double r;
+    Circle(int i, double x) : shape(i), r(x)    {}
+    virtual int kind() const    {   return 2;   }
+    virtual void grow() {   r += 1; }
+};
+
+class Square : public Rect
+{
+public:
+    Square(int i, int a) : Rect(i, a, a)    {}
+    virtual int kind() const    {   return 3;   }
+    virtual void grow() {   ++w;    ++h;    }
+};
+
+// 累加经过元素的 id, 并检查同一类型的元素是连续经过的
+struct visit
+{
+    int sum;
+    int count;
+    int switches;   // kind 变化的次数
+    int last_kind;
+    visit() : sum(0), count(0), switches(0), last_kind(0) {}
+    void operator()(const shape& x)
+    {
+        sum += x.id;
+        ++count;
+        if(x.kind() != last_kind)
+            ++switches;
+        last_kind = x.kind();
+    }
+};
+
+// 对 Circle 以派生类型调用, 对其他类型以基类调用
+struct typed_visit
+{
+    int circles;
+    int others;
+    typed_visit() : circles(0), others(0)   {}
+    void operator()(Circle& x)  {   x.grow();   ++circles;  }
+    void operator()(shape&)     {   ++others;   }
+};
+
+int main()
+{
+    poly_collection<shape> c;
+    assert(c.empty() && c.begin() == c.end());
+
+    int expected = 0;
+    for(int i = 0; i < 300; ++i)
+    {
+        if(i % 3 == 0)
+            c.insert(Rect(i, i, 1));
+        else if(i % 3 == 1)
+            c.insert(Circle(i, 0.5));
+        else
+            c.insert(Square(i, 2));
+        expected += i;
+    }
+    assert(c.size() == 300 && c.segment_count() == 3);
+    assert(c.size<Rect>() == 100 && c.size<Circle>() == 100 && c.size<Square>() == 100);
+    assert(c.end<Circle>() - c.begin<Circle>() == 100);
+
+    // 每段内部保持插入顺序
+    for(Circle* p = c.begin<Circle>(); p + 1 != c.end<Circle>(); ++p)
+        assert(p->id + 3 == p[1].id);
+
+    // 逐段遍历: 每种类型只出现一次切换
+    visit v = for_each(c.begin(), c.end(), visit());
+    assert(v.sum == expected && v.count == 300 && v.switches == 3);
+    v = for_each(c, visit());
+    assert(v.sum == expected && v.count == 300 && v.switches == 3);
+
+    // mem_fun 直接作用于集合
+    for_each(c, mem_fun(&shape::grow));
+    assert(c.begin<Rect>()[0].w == 1 && c.begin<Square>()[0].w == 3 && c.begin<Square>()[0].h == 3);
+    assert(c.begin<Circle>()[0].r == 1.5);
+    int kinds = 0;
+    const poly_collection<shape>& cc = c;
+    for(poly_collection<shape>::const_iterator i = cc.begin(); i != cc.end(); ++i)
+        kinds += i->kind();
+    assert(kinds == 100 * (1 + 2 + 3));
+    assert(count_if(c.begin(), c.end(), compose1(bind2nd(equal_to<int>(), 2), mem_fun_ref(&shape::kind))) == 100);
+
+    // 指明具体类型
+    typed_visit t = for_each<Circle>(c, typed_visit());
+    assert(t.circles == 100 && t.others == 200);
+    assert(c.begin<Circle>()[99].r == 2.5);
+
+    // 删除与空段
+    Rect* r = c.erase(c.begin<Rect>());
+    assert(r->id == 3 && c.size<Rect>() == 99);
+    while(c.size<Square>())
+        c.erase(c.begin<Square>());
+    v = for_each(c, visit());
+    assert(v.count == 199 && v.switches == 2);
+
+    // 复制
+    poly_collection<shape> d(c);
+    c.clear();
+    assert(c.empty() && c.segment_count() == 3 && c.begin() == c.end());
+    assert(d.size() == 199 && d.size<Circle>() == 100);
+    assert(d.begin<Circle>()[0].r == 1.5 + 1);
+    c = d;
+    swap(c, d);
+    assert(c.size() == 199 && d.size() == 199);
+    c.insert(Square(1000, 5));
+    assert(c.size() == 200 && d.size() == 199);
+
+    // 不存在的段
+    assert(poly_collection<shape>().begin<Circle>() == 0 && d.size<Square>() == 0);
+
+    printf("poly_collection test passed\n");
+    return 0;
+}
\ No newline at end of file
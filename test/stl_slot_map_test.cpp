@@ -0,0 +1,135 @@
+#include "stl_slot_map.h"
+#include "stl_vector.h"
+#include "stl_numeric.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// stl_slot_map.h 的测试文件, 测试 句柄在其他元素删除后仍然有效, 删除后旧句柄失效且不会访问到复用槽位的新元素,
+// 元素始终连续存放, 随机插入删除与参照模型一致, 复制后句柄仍然有效, 以及非trivial类型的析构次数
+
+struct counted
+{
+    static int alive;
+    int value;
+    counted(int v) : value(v)   {   ++alive;    }
+    counted(const counted& x) : value(x.value)  {   ++alive;    }
+    counted& operator=(const counted& x)
+    {
+        value = x.value;
+        return *this;
+    }
+    ~counted()  {   --alive;    }
+};
+int counted::alive = 0;
+
+int main()
+{
+    // 插入与按句柄访问, 删除一半后其余句柄不变
+    slot_map<int> m;
+    vector<slot_map_handle> handles;
+    for(int i = 0; i < 10000; ++i)
+        handles.push_back(m.insert(i));
+    assert(m.size() == 10000);
+    for(int i = 0; i < 10000; i += 2)
+        assert(m.erase(handles[i]));
+    assert(m.size() == 5000);
+    for(int i = 0; i < 10000; ++i)
+    {
+        if(i % 2)
+            assert(m.contains(handles[i]) && *m.find(handles[i]) == i && m[handles[i]] == i);
+        else
+            assert(!m.contains(handles[i]) && m.find(handles[i]) == 0);
+    }
+    assert(!m.erase(handles[0]));
+
+    // 元素连续存放, 可以直接交给算法
+    assert(m.end() - m.begin() == 5000);
+    long sum = accumulate(m.begin(), m.end(), 0L);
+    assert(sum == 5000L * 5000L);
+    for(slot_map<int>::iterator it = m.begin(); it != m.end(); ++it)
+        assert(m[m.handle_of(it)] == *it);
+    printf("size = %lu, sum = %ld\n", m.size(), sum);
+
+    // 复用槽位后旧句柄仍然失效
+    slot_map_handle h = m.insert(-1);
+    assert(h.index == handles[9998].index && h != handles[9998]);
+    assert(!m.contains(handles[9998]) && m[h] == -1);
+
+    // 遍历中删除
+    for(slot_map<int>::iterator it = m.begin(); it != m.end(); )
+        it = (*it % 3 == 0) ? m.erase(it) : it + 1;
+    for(slot_map<int>::iterator it = m.begin(); it != m.end(); ++it)
+        assert(*it % 3 != 0);
+    for(int i = 1; i < 10000; i += 2)
+        assert(m.contains(handles[i]) == (i % 3 != 0));
+    printf("erase ok\n");
+
+    // 随机插入删除, 与参照模型比较
+    slot_map<int> r;
+    vector<slot_map_handle> live;
+    vector<int> values;
+    vector<slot_map_handle> dead;
+    srand(7);
+    for(int step = 0; step < 20000; ++step)
+    {
+        if(live.empty() || rand() % 5 < 3)
+        {
+            int v = rand() % 1000;
+            live.push_back(r.insert(v));
+            values.push_back(v);
+        }
+        else
+        {
+            size_t k = rand() % live.size();
+            assert(r.erase(live[k]));
+            dead.push_back(live[k]);
+            live[k] = live.back();
+            live.pop_back();
+            values[k] = values.back();
+            values.pop_back();
+        }
+        if(step % 1000 == 0)
+        {
+            assert(r.size() == live.size());
+            for(size_t i = 0; i < live.size(); ++i)
+                assert(r[live[i]] == values[i]);
+            for(size_t i = 0; i < dead.size(); ++i)
+                assert(!r.contains(dead[i]));
+        }
+    }
+    printf("random ok, size = %lu\n", r.size());
+
+    // 复制后句柄在副本中同样有效; 交换; clear 后所有句柄失效
+    slot_map<int> c = r;
+    for(size_t i = 0; i < live.size(); ++i)
+        assert(c[live[i]] == values[i]);
+    slot_map<int> e;
+    e.insert(3);
+    swap(c, e);
+    assert(c.size() == 1 && e.size() == r.size());
+    r.clear();
+    assert(r.empty() && r.begin() == r.end());
+    for(size_t i = 0; i < live.size(); ++i)
+        assert(!r.contains(live[i]) && e.contains(live[i]));
+
+    // 非trivial类型: erase、clear、析构时每个元素恰好析构一次
+    {
+        slot_map<counted> mc;
+        vector<slot_map_handle> hc;
+        for(int i = 0; i < 1000; ++i)
+            hc.push_back(mc.insert(counted(i)));
+        assert(counted::alive == 1000);
+        for(int i = 0; i < 100; ++i)
+            mc.erase(hc[i * 7]);
+        assert(counted::alive == 900);
+        slot_map<counted> copy(mc);
+        assert(counted::alive == 1800);
+        copy.clear();
+        assert(counted::alive == 900 && copy.empty());
+        assert(mc[hc[1]].value == 1);
+    }
+    assert(counted::alive == 0);
+    printf("destroy ok\n");
+    return 0;
+}
\ No newline at end of file
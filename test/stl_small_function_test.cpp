@@ -0,0 +1,204 @@
+#include "stl_function.h"
+#include "stl_small_function.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+// function<> 与函数适配器的测试文件, 测试 空函数对象不占空间、小对象放在缓冲区中、大对象从alloc配置、复制移动与析构的次数,
+// 按签名区分以 function 为参数的重载, 复制可调用对象时抛出异常不泄漏空间
+
+static int add(int x, int y)    {   return x + y;   }
+
+// 记录存活的对象个数, 检查复制、移动、析构是否配对
+static int alive = 0;
+
+struct tracked
+{
+    int value;
+    explicit tracked(int v) : value(v)  {   ++alive;    }
+    tracked(const tracked& x) : value(x.value)  {   ++alive;    }
+    ~tracked()  {   --alive;    }
+    int operator()(int x) const {   return x + value;   }
+};
+
+struct big_functor
+{
+    long data[8];
+    tracked t;
+    explicit big_functor(int v) : t(v)
+    {
+        for(int i = 0; i < 8; ++i)
+            data[i] = i;
+    }
+    int operator()(int x) const {   return x + t.value + int(data[7]);  }
+};
+
+// 复制到第 throw_after 次时抛出异常, 负数表示不抛出; 大到只能从alloc配置
+static int throw_after = -1;
+
+struct throwing_functor
+{
+    long data[32];
+    tracked t;
+    explicit throwing_functor(int v) : t(v) {}
+    throwing_functor(const throwing_functor& x) : t(x.t)
+    {
+        if(throw_after >= 0 && throw_after-- == 0)
+            throw 1;
+    }
+    int operator()(int x) const {   return x + t.value; }
+};
+
+// 对齐要求高于alloc所保证的, 返回自身地址相对 A 的余数
+template<size_t A>
+struct alignas(A) aligned_functor
+{
+    char c;
+    uintptr_t operator()(int) const {   return reinterpret_cast<uintptr_t>(this) % alignof(aligned_functor);    }
+};
+
+// 只有签名相符的 function 参与重载
+static int which(const function<int(int)>&)             {   return 1;   }
+static int which(const function<void(const char*)>&)    {   return 2;   }
+
+struct is_odd : public unary_function<int, bool>
+{
+    bool operator()(int x) const    {   return x % 2 != 0;  }
+};
+
+int main()
+{
+    // 空函数对象不占空间
+    assert(sizeof(bind2nd(plus<int>(), 1)) == sizeof(int));
+    assert(sizeof(bind1st(less<double>(), 1.0)) == sizeof(double));
+    assert(sizeof(compose1(negate<int>(), negate<int>())) <= 2);
+    assert(sizeof(not1(not1(is_odd()))) == 1);
+    assert(sizeof(compose2(logical_and<bool>(), bind2nd(greater<int>(), 2), bind2nd(less<int>(), 9))) == 2 * sizeof(int));
+    assert(compose2(logical_and<bool>(), bind2nd(greater<int>(), 2), bind2nd(less<int>(), 9))(5));
+    assert(compose2(plus<int>(), bind2nd(multiplies<int>(), 2), bind2nd(plus<int>(), 3))(5) == 18);
+    assert(not1(not1(is_odd()))(3) && !not2(less<int>())(1, 2));
+    assert(compose1(negate<int>(), bind1st(minus<int>(), 10))(3) == -7);
+
+    // 函数指针与空的function
+    function<int(int, int)> f;
+    assert(!f && f.stored_inline());
+    f = add;
+    assert(f && f(2, 3) == 5);
+    int (*null_fp)(int, int) = 0;
+    function<int(int, int)> g(null_fp);
+    assert(!g);
+    f = nullptr;
+    assert(!f);
+
+    // 小对象放在缓冲区中, 大对象从alloc配置
+    {
+        int base = 100;
+        function<int(int)> small = [base](int x) { return x + base; };
+        assert(small.stored_inline() && small(1) == 101);
+
+        function<int(int)> adapter = bind2nd(plus<int>(), 7);
+        assert(adapter.stored_inline() && adapter(1) == 8);
+
+        function<int(int)> big = big_functor(1);
+        assert(!big.stored_inline() && big(1) == 9);
+        // 更大的缓冲区可以容纳同样的对象
+        function<int(int), sizeof(big_functor)> roomy = big_functor(2);
+        assert(roomy.stored_inline() && roomy(1) == 10);
+
+        // 复制、移动、交换
+        function<int(int)> c(big);
+        assert(c(0) == 8 && big(0) == 8);
+        function<int(int)> m(static_cast<function<int(int)>&&>(c));
+        assert(!c && m(0) == 8);
+        small.swap(m);
+        assert(small(0) == 8 && m(0) == 100 && m.stored_inline() && !small.stored_inline());
+        c = small;
+        c = m;
+        assert(c(1) == 101);
+
+        function<int(int)> t = tracked(5);
+        function<int(int)> t2 = t;
+        assert(t(1) == 6 && t2(1) == 6);
+        t2 = big;
+    }
+    assert(alive == 0);
+
+    // void 返回值丢弃结果
+    int calls = 0;
+    function<void()> v = [&calls]() { return ++calls; };
+    v();
+    v();
+    assert(calls == 2);
+
+    // 不可调用或签名不符的类型不能转换为 function
+    assert(which([](int x) { return x; }) == 1);
+    assert(which([](const char*) {}) == 2);
+    assert(which(bind2nd(plus<int>(), 1)) == 1);
+
+    // 复制到配置好的空间时抛出异常, 空间被归还
+    {
+        throwing_functor tf(3);
+        bool thrown = false;
+        throw_after = 1;                // 参数的复制成功, 放到配置的空间时抛出
+        try
+        {
+            function<int(int)> h = tf;
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+        assert(thrown && alive == 1);
+
+        throw_after = -1;
+        function<int(int)> h = tf;
+        assert(!h.stored_inline() && h(1) == 4);
+        thrown = false;
+        throw_after = 0;                // 复制 function 时抛出
+        try
+        {
+            function<int(int)> h2(h);
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+        throw_after = -1;
+        assert(thrown && alive == 2 && h(1) == 4);
+    }
+    assert(alive == 0);
+
+    // 对齐要求高的可调用对象放在配置的空间时仍然对齐, 复制与移动之后也一样
+    {
+        vector<function<uintptr_t(int)> > fs;
+        for(int i = 0; i < 8; ++i)
+        {
+            fs.push_back(aligned_functor<32>());
+            fs.push_back(aligned_functor<64>());
+            fs.push_back(aligned_functor<256>());
+        }
+        vector<function<uintptr_t(int)> > copies(fs);
+        for(size_t i = 0; i < fs.size(); ++i)
+        {
+            assert(!fs[i].stored_inline() && fs[i](0) == 0 && copies[i](0) == 0);
+            function<uintptr_t(int)> moved(static_cast<function<uintptr_t(int)>&&>(fs[i]));
+            assert(moved(0) == 0);
+        }
+    }
+
+    // 回调表
+    vector<function<int(int)> > callbacks;
+    for(int i = 0; i < 10; ++i)
+        callbacks.push_back(bind2nd(plus<int>(), i));
+    int sum = 0;
+    for(size_t i = 0; i < callbacks.size(); ++i)
+    {
+        assert(callbacks[i].stored_inline());
+        sum += callbacks[i](1);
+    }
+    assert(sum == 55);
+    printf("function ok\n");
+
+    return 0;
+}
\ No newline at end of file
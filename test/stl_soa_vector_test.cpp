@@ -0,0 +1,96 @@
+#include "stl_soa_vector.h"
+#include "stl_numeric.h"
+#include "stl_algo.h"
+#include <cassert>
+#include <cstdio>
+
+// stl_soa_vector.h 的测试文件, 测试 各列独立连续存放, 按列使用 accumulate / for_each, 增长后数据不变,
+// resize、pop_back、复制、交换, 容量已满时 push_back 自身的元素, 以及非trivial类型的列的析构次数
+
+struct counted
+{
+    static int alive;
+    int value;
+    counted() : value(0)    {   ++alive;    }
+    counted(int v) : value(v)   {   ++alive;    }
+    counted(const counted& x) : value(x.value)  {   ++alive;    }
+    ~counted()  {   --alive;    }
+};
+int counted::alive = 0;
+
+struct scale
+{
+    double factor;
+    void operator()(double& x) const    {   x *= factor;    }
+};
+
+int main()
+{
+    // 逐条插入, 跨越多次增长
+    soa_vector<int, double, char> v;
+    for(int i = 0; i < 1000; ++i)
+        v.push_back(i, i * 0.5, char('a' + i % 26));
+    assert(v.size() == 1000 && v.capacity() >= 1000);
+    for(int i = 0; i < 1000; ++i)
+        assert(v.get<0>(i) == i && v.get<1>(i) == i * 0.5 && v.get<2>(i) == char('a' + i % 26));
+
+    // 每一列是独立的连续空间
+    assert(v.end<0>() - v.begin<0>() == 1000 && v.end<1>() - v.begin<1>() == 1000);
+    assert(v.data<2>() + 1000 == v.end<2>());
+    long sum = accumulate(v.begin<0>(), v.end<0>(), 0L);
+    assert(sum == 999L * 1000 / 2);
+    scale s = {2.0};
+    for_each(v.begin<1>(), v.end<1>(), s);
+    assert(accumulate(v.begin<1>(), v.end<1>(), 0.0) == double(sum));
+    assert(count(v.begin<2>(), v.end<2>(), 'a') == 39);
+    printf("size = %lu, sum = %ld\n", v.size(), sum);
+
+    // resize, pop_back
+    v.pop_back();
+    assert(v.size() == 999 && v.get<0>(998) == 998);
+    v.resize(1200);
+    assert(v.size() == 1200 && v.get<0>(998) == 998 && v.get<0>(1100) == 0 && v.get<1>(1199) == 0.0);
+    v.resize(10);
+    assert(v.size() == 10 && accumulate(v.begin<0>(), v.end<0>(), 0) == 45);
+
+    // 复制, 交换, clear
+    soa_vector<int, double, char> c = v;
+    assert(c.size() == 10 && c.get<1>(9) == 9.0 && c.data<0>() != v.data<0>());
+    soa_vector<int, double, char> e(3);
+    assert(e.size() == 3 && e.get<0>(2) == 0);
+    swap(c, e);
+    assert(c.size() == 3 && e.size() == 10 && e.get<2>(1) == 'b');
+    e.clear();
+    assert(e.empty() && e.begin<0>() == e.end<0>());
+    printf("copy ok\n");
+
+    // 容量已满时 push_back 自身的元素, 其中一个字段引用另一列
+    soa_vector<int, double, int> self;
+    self.push_back(100, 7.0, 5);
+    while(self.size() < self.capacity())
+        self.push_back(1, 1.0, 1);
+    self.push_back(self.get<0>(0), self.get<1>(0), self.get<0>(0));
+    assert(self.size() == 9 && self.capacity() == 16);
+    assert(self.get<0>(8) == 100 && self.get<1>(8) == 7.0 && self.get<2>(8) == 100);
+
+    // 非trivial类型的列: pop_back、resize、clear、析构时每个元素恰好析构一次
+    {
+        soa_vector<counted, int> vc;
+        for(int i = 0; i < 100; ++i)
+            vc.push_back(counted(i), i);
+        assert(counted::alive == 100);
+        vc.pop_back();
+        assert(counted::alive == 99);
+        vc.resize(150);
+        assert(counted::alive == 150 && vc.get<0>(98).value == 98 && vc.get<0>(149).value == 0);
+        soa_vector<counted, int> copy(vc);
+        assert(counted::alive == 300);
+        copy.clear();
+        assert(counted::alive == 150);
+        vc.resize(50);
+        assert(counted::alive == 50);
+    }
+    assert(counted::alive == 0);
+    printf("destroy ok\n");
+    return 0;
+}
\ No newline at end of file
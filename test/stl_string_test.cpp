@@ -0,0 +1,113 @@
+#include "stl_string.h"
+#include "stl_hash_map.h"
+#include "stl_list.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// stl_string.h 的测试文件, 测试 短字符串不分配空间且对象为24字节, 短长字符串之间的转换, 追加自身的内容,
+// 各种区间构造, find / rfind / compare 与C库函数的结果一致, erase / substr / resize, wstring, 以及作为 hash_map 的键
+
+int main()
+{
+    // 短字符串: 最多23个字符存放在对象内部
+    assert(sizeof(string) == 3 * sizeof(void*));
+    string empty;
+    assert(empty.empty() && empty.size() == 0 && empty.c_str()[0] == 0);
+    string s("hello");
+    assert(s.size() == 5 && strcmp(s.c_str(), "hello") == 0);
+    const char* inside = reinterpret_cast<const char*>(&s);
+    assert(s.data() >= inside && s.data() < inside + sizeof(s));
+    string full("abcdefghijklmnopqrstuvw");
+    assert(full.size() == 23 && full.capacity() == 23 && full.c_str()[23] == 0);
+    inside = reinterpret_cast<const char*>(&full);
+    assert(full.data() >= inside && full.data() < inside + sizeof(full));
+
+    // 超过23个字符后转到堆上, 内容不变
+    full.push_back('x');
+    assert(full.size() == 24 && full.capacity() >= 24 && strcmp(full.c_str(), "abcdefghijklmnopqrstuvwx") == 0);
+    inside = reinterpret_cast<const char*>(&full);
+    assert(full.data() < inside || full.data() >= inside + sizeof(full));
+    string grown;
+    for(int i = 0; i < 1000; ++i)
+        grown += char('a' + i % 26);
+    assert(grown.size() == 1000 && grown[999] == char('a' + 999 % 26) && grown.c_str()[1000] == 0);
+    printf("sso ok, capacity = %lu\n", grown.capacity());
+
+    // 区间构造: string(p, 0) 是长度为0的 (指针, 长度), 两个整数是 (个数, 字符)
+    const char* text = "a string that is longer than the local buffer";
+    string none(text, 0);
+    assert(none.empty());
+    string range(text, text + strlen(text));
+    assert(range.size() == strlen(text) && range.compare(text) == 0);
+    string repeated(3, 65);
+    assert(repeated.compare("AAA") == 0);
+    list<char> chars(text, text + 8);
+    string from_list(chars.begin(), chars.end());
+    assert(from_list.compare("a string") == 0);
+
+    // 追加自身的内容, 增长时原来的空间已经归还
+    string self("0123456789");
+    for(int i = 0; i < 6; ++i)
+        self.append(self.data(), self.size());
+    assert(self.size() == 640 && self.compare(0 + self.c_str()) == 0);
+    for(size_t i = 0; i < self.size(); ++i)
+        assert(self[i] == char('0' + i % 10));
+    self.assign(self.data() + 5, 3);
+    assert(self == "567");
+
+    // 查找与比较
+    string t("the quick brown fox jumps over the lazy dog");
+    assert(t.find('q') == 4 && t.find('z') == 37 && t.find('!') == string::npos);
+    assert(t.find("the") == 0 && t.find("the", 1) == 31 && t.find("dog") == 40 && t.find("cat") == string::npos);
+    assert(t.find("") == 0 && t.find("g", 43) == string::npos && t.rfind('o') == 41 && t.rfind('t', 30) == 0);
+    assert(t.find(string("fox")) == 16);
+    assert(string("abc") < string("abd") && string("ab") < string("abc") && string("b") > string("abc"));
+    assert(string("abc").compare("abc") == 0 && string("abc") != "abd");
+    assert(string("\xff") > string("a"));   // 与 memcmp 相同, 按 unsigned char 比较
+
+    // erase, substr, resize, 连接
+    string u("hello, world");
+    assert(u.substr(7) == "world" && u.substr(0, 5) == "hello");
+    u.erase(5, 7);
+    assert(u == "hello");
+    u.resize(8, '!');
+    assert(u == "hello!!!");
+    u.resize(2);
+    assert(u == "he" && u.size() == 2);
+    assert(u + "llo" == "hello" && "say " + u == "say he" && u + '!' == "he!" && u + t.substr(0, 3) == "hethe");
+
+    // 复制与交换短字符串和长字符串
+    string a("short"), b(grown);
+    swap(a, b);
+    assert(a.size() == 1000 && b == "short");
+    a = b;
+    assert(a == "short" && a.size() == 5);
+    a = "a string that is longer than twenty three characters";
+    assert(a.size() == 52);
+    string c(a);
+    assert(c == a && c.data() != a.data());
+    string rep(30, 'z');
+    assert(rep.size() == 30 && rep.find('z') == 0 && rep.rfind('z') == 29);
+    printf("string ok\n");
+
+    // wstring: 5个wchar_t以内在对象内部
+    wstring w(L"abcde");
+    assert(w.size() == 5 && w.capacity() == 5);
+    w += L"fgh";
+    assert(w.size() == 8 && w.find(L'g') == 6 && w.find(L"def") == 3 && w.compare(L"abcdefgh") == 0);
+
+    // 作为 hash_map 的键
+    hash_map<string, int> m;
+    for(int i = 0; i < 1000; ++i)
+    {
+        string key("key:");
+        key.append(1, char('a' + i % 26)).append(1, char('a' + i / 26 % 26)).append(1, char('a' + i / 676));
+        key.append(i % 3 ? "" : "-with-a-long-suffix");
+        m[key] = i;
+    }
+    assert(m.size() == 1000 && m[string("key:aaa-with-a-long-suffix")] == 0 && m[string("key:bab")] == 677);
+    assert(hash<string>()(string("abc")) == hash<const char*>()("abc"));
+    printf("hash ok\n");
+    return 0;
+}
\ No newline at end of file
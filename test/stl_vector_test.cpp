@@ -0,0 +1,42 @@
+#include "stl_list.h"
+#include "stl_vector.h"
+#include <cassert>
+#include <cstdio>
+
+// stl_vector.h 的测试文件, 测试 两个整数参数的构造与 insert 按 (个数, 值) 处理, 迭代器区间的构造与 insert
+
+template<class T>
+void check_fill()
+{
+    vector<T> v(3, 7);
+    assert(v.size() == 3 && v[0] == T(7) && v[2] == T(7));
+    v.insert(v.begin() + 1, 2, 5);
+    assert(v.size() == 5 && v[0] == T(7) && v[1] == T(5) && v[2] == T(5) && v[3] == T(7));
+}
+
+int main()
+{
+    // 两个参数都是整数时, 区间模板的匹配更好, 应当按 (个数, 值) 处理
+    check_fill<int>();
+    check_fill<unsigned>();
+    check_fill<long>();
+    check_fill<size_t>();
+    check_fill<double>();
+    check_fill<char>();
+    printf("fill ok\n");
+
+    // 迭代器区间: 指针与双向迭代器
+    int a[5] = {1, 2, 3, 4, 5};
+    vector<long> v(a, a + 5);
+    assert(v.size() == 5 && v[4] == 5);
+    list<long> l(v.begin(), v.end());
+    vector<long> w(l.begin(), l.end());
+    assert(w == v);
+    w.insert(w.begin() + 2, a, a + 2);
+    assert(w.size() == 7 && w[2] == 1 && w[3] == 2 && w[4] == 3);
+    w.insert(w.end(), l.begin(), l.end());
+    assert(w.size() == 12 && w[11] == 5);
+    printf("range ok\n");
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "stl_algo.h"
+#include "stl_function.h"
+#include "stl_list.h"
+#include "stl_numeric.h"
+#include "stl_vector.h"
+#include "stl_view.h"
+#include <cassert>
+#include <cstdio>
+
+// stl_view.h 的测试文件, 测试 各种视图的结果、视图的叠加与函数对象的合成、链表等非随机访问区间
+
+struct square : public unary_function<int, int>
+{
+    int operator()(int x) const {   return x * x;   }
+};
+
+struct is_even
+{
+    bool operator()(int x) const    {   return x % 2 == 0;  }
+};
+
+// 记录谓词被调用的次数
+struct counting_positive
+{
+    int* calls;
+    explicit counting_positive(int* c) : calls(c)   {}
+    bool operator()(int x) const
+    {
+        ++*calls;
+        return x > 0;
+    }
+};
+
+int main()
+{
+    int a[10] = {3, -1, 4, -1, 5, -9, 2, 6, -5, 3};
+    vector<int> v(a, a + 10);
+
+    // transform
+    range_view<__transform_iterator<const int*, square> > sq = view_transform(v, square());
+    int expect[10] = {9, 1, 16, 1, 25, 81, 4, 36, 25, 9};
+    assert(equal(sq.begin(), sq.end(), expect));
+    assert(sq.end() - sq.begin() == 10 && sq.begin()[5] == 81);
+
+    // transform 的 transform 合成为一层
+    range_view<__transform_iterator<const int*, unary_compose<negate<int>, square> > > neg = view_transform(sq, negate<int>());
+    assert(accumulate(neg.begin(), neg.end(), 0) == -207);
+
+    // filter 与 filter 的合成
+    int calls = 0;
+    range_view<__filter_iterator<const int*, counting_positive> > pos = view_filter(v, counting_positive(&calls));
+    assert(accumulate(pos.begin(), pos.end(), 0) == 23);
+    range_view<__filter_iterator<const int*, __and_predicate<counting_positive, is_even> > > pos_even = view_filter(pos, is_even());
+    vector<int> pe(pos_even.begin(), pos_even.end());
+    assert(pe.size() == 3 && pe[0] == 4 && pe[1] == 2 && pe[2] == 6);
+    // 合成后的谓词只跳过一次, 遍历一遍时每个元素只判断一次
+    calls = 0;
+    range_view<__filter_iterator<const int*, __and_predicate<counting_positive, is_even> > > fused = view_filter(pos, is_even());
+    assert(count_if(fused.begin(), fused.end(), is_even()) == 3);
+    assert(calls == 10);
+
+    // 正数的平方和, 一次遍历
+    assert(accumulate(view_transform(pos, square()).begin(), view_transform(pos, square()).end(), 0) == 9 + 16 + 25 + 4 + 36 + 9);
+
+    // take: n 小于或大于区间长度
+    list<int> l(a, a + 10);
+    range_view<__counted_iterator<list<int>::const_iterator> > t3 = view_take(l, 3);
+    assert(distance(t3.begin(), t3.end()) == 3 && accumulate(t3.begin(), t3.end(), 0) == 6);
+    assert(distance(view_take(l, 100).begin(), view_take(l, 100).end()) == 10);
+    assert(view_take(v, 0).empty());
+    // 前两个正偶数
+    vector<int> first_two(view_take(pos_even, 2).begin(), view_take(pos_even, 2).end());
+    assert(first_two.size() == 2 && first_two[0] == 4 && first_two[1] == 2);
+
+    // zip: 以较短的区间为准
+    vector<int> w(a, a + 4);
+    range_view<__zip_iterator<const int*, list<int>::const_iterator> > z = view_zip(w, l);
+    assert(distance(z.begin(), z.end()) == 4);
+    for(range_view<__zip_iterator<const int*, list<int>::const_iterator> >::iterator it = z.begin(); it != z.end(); ++it)
+        assert((*it).first == (*it).second);
+
+    // enumerate
+    long weighted = 0;
+    range_view<__enumerate_iterator<list<int>::const_iterator> > e = view_enumerate(l);
+    for(range_view<__enumerate_iterator<list<int>::const_iterator> >::iterator it = e.begin(); it != e.end(); ++it)
+    {
+        assert((*it).second == a[(*it).first]);
+        weighted += (*it).first * (*it).second;
+    }
+    long expect_weighted = 0;
+    for(int i = 0; i < 10; ++i)
+        expect_weighted += i * a[i];
+    assert(weighted == expect_weighted);
+
+    // 空区间
+    vector<int> empty;
+    assert(view_filter(view_transform(empty, square()), is_even()).empty());
+    printf("view ok\n");
+
+    return 0;
+}
\ No newline at end of file
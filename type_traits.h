@@ -19,7 +19,7 @@ struct __type_traits
 
     typedef __false_type has_trivial_default_constructor;
     typedef __false_type has_trivial_copy_constructor;
-    typedef __false_type has_trivial_assigment_operator;
+    typedef __false_type has_trivial_assignment_operator;
     typedef __false_type has_trivial_destructor;
     typedef __false_type is_POD_type;
 };
@@ -116,6 +116,46 @@ struct __type_traits<unsigned long>
    typedef __true_type    is_POD_type;
 };
 
+template <>
+struct __type_traits<long long> 
+{
+   typedef __true_type    has_trivial_default_constructor;
+   typedef __true_type    has_trivial_copy_constructor;
+   typedef __true_type    has_trivial_assignment_operator;
+   typedef __true_type    has_trivial_destructor;
+   typedef __true_type    is_POD_type;
+};
+
+template <>
+struct __type_traits<unsigned long long> 
+{
+   typedef __true_type    has_trivial_default_constructor;
+   typedef __true_type    has_trivial_copy_constructor;
+   typedef __true_type    has_trivial_assignment_operator;
+   typedef __true_type    has_trivial_destructor;
+   typedef __true_type    is_POD_type;
+};
+
+template <>
+struct __type_traits<bool> 
+{
+   typedef __true_type    has_trivial_default_constructor;
+   typedef __true_type    has_trivial_copy_constructor;
+   typedef __true_type    has_trivial_assignment_operator;
+   typedef __true_type    has_trivial_destructor;
+   typedef __true_type    is_POD_type;
+};
+
+template <>
+struct __type_traits<wchar_t> 
+{
+   typedef __true_type    has_trivial_default_constructor;
+   typedef __true_type    has_trivial_copy_constructor;
+   typedef __true_type    has_trivial_assignment_operator;
+   typedef __true_type    has_trivial_destructor;
+   typedef __true_type    is_POD_type;
+};
+
 template <>
 struct __type_traits<float> 
 {
@@ -157,5 +197,80 @@ struct __type_traits<T*>
    typedef __true_type    is_POD_type;
 };
 
+// 组合类型的特性: 所有成员都是trivial时才是trivial
+template <class Type1, class Type2>
+struct __type_and
+{
+    typedef __false_type type;
+};
+
+template <>
+struct __type_and<__true_type, __true_type>
+{
+    typedef __true_type type;
+};
+
+template <class Type1, class Type2>
+struct __type_or
+{
+    typedef __true_type type;
+};
+
+template <>
+struct __type_or<__false_type, __false_type>
+{
+    typedef __false_type type;
+};
+
+// 编译期的布尔常量转换为 __true_type / __false_type, 用于按条件分派
+template <bool Condition>
+struct __type_bool
+{
+    typedef __false_type type;
+};
+
+template <>
+struct __type_bool<true>
+{
+    typedef __true_type type;
+};
+
+// 算术类型的判断, 用于选择数值算法的向量化版本
+template <class T>
+struct __is_integer
+{
+    typedef __false_type type;
+};
+
+template <> struct __is_integer<bool> { typedef __true_type type; };
+template <> struct __is_integer<char> { typedef __true_type type; };
+template <> struct __is_integer<signed char> { typedef __true_type type; };
+template <> struct __is_integer<unsigned char> { typedef __true_type type; };
+template <> struct __is_integer<wchar_t> { typedef __true_type type; };
+template <> struct __is_integer<short> { typedef __true_type type; };
+template <> struct __is_integer<unsigned short> { typedef __true_type type; };
+template <> struct __is_integer<int> { typedef __true_type type; };
+template <> struct __is_integer<unsigned int> { typedef __true_type type; };
+template <> struct __is_integer<long> { typedef __true_type type; };
+template <> struct __is_integer<unsigned long> { typedef __true_type type; };
+template <> struct __is_integer<long long> { typedef __true_type type; };
+template <> struct __is_integer<unsigned long long> { typedef __true_type type; };
+
+template <class T>
+struct __is_floating
+{
+    typedef __false_type type;
+};
+
+template <> struct __is_floating<float> { typedef __true_type type; };
+template <> struct __is_floating<double> { typedef __true_type type; };
+template <> struct __is_floating<long double> { typedef __true_type type; };
+
+template <class T>
+struct __is_arithmetic
+{
+    typedef typename __type_or<typename __is_integer<T>::type, typename __is_floating<T>::type>::type type;
+};
+
 
 #endif // __TYPE_TRAITS_H
\ No newline at end of file